@@ -5,9 +5,12 @@
 
 static const char EMPTY_PAGE_DATA[PAGE_SIZE] = {0};
 
-BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager)
-    : pool_size_(pool_size), disk_manager_(disk_manager) {
+BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager, bool cache_child_frames)
+    : pool_size_(pool_size), disk_manager_(disk_manager), cache_child_frames_(cache_child_frames) {
   pages_ = new Page[pool_size_];
+  if (cache_child_frames_) {
+    child_frames_.resize(pool_size_);
+  }
   replacer_ = new LRUReplacer(pool_size_);
   for (size_t i = 0; i < pool_size_; i++) {
     free_list_.emplace_back(i);
@@ -33,7 +36,71 @@ Page *BufferPoolManager::FetchPage(page_id_t page_id) {
   // 2.     If R is dirty, write it back to the disk.
   // 3.     Delete R from the page table and insert P.
   // 4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
-  return nullptr;
+  lock_guard<recursive_mutex> guard(latch_);
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  auto it = page_table_.find(page_id);
+  if (it != page_table_.end()) {
+    Page &page = pages_[it->second];
+    page.pin_count_++;
+    replacer_->Pin(it->second);
+    return &page;
+  }
+  frame_id_t frame_id = TryToFindFreePage();
+  if (frame_id == INVALID_FRAME_ID) {
+    return nullptr;
+  }
+  Page &page = pages_[frame_id];
+  page.page_id_ = page_id;
+  page.pin_count_ = 1;
+  page.is_dirty_ = false;
+  disk_manager_->ReadPage(page_id, page.data_);
+  page_table_[page_id] = frame_id;
+  replacer_->Pin(frame_id);
+  return &page;
+}
+
+Page *BufferPoolManager::FetchChildPage(Page *parent, int slot, page_id_t child_page_id) {
+  if (!cache_child_frames_ || parent == nullptr || slot < 0) {
+    return FetchPage(child_page_id);
+  }
+  lock_guard<recursive_mutex> guard(latch_);
+  auto &hints = child_frames_[FrameOf(parent)];
+  if (static_cast<size_t>(slot) < hints.size()) {
+    frame_id_t frame_id = hints[slot];
+    if (frame_id != INVALID_FRAME_ID && pages_[frame_id].page_id_ == child_page_id) {
+      pages_[frame_id].pin_count_++;
+      replacer_->Pin(frame_id);
+      return &pages_[frame_id];
+    }
+  }
+  Page *child = FetchPage(child_page_id);
+  if (child != nullptr) {
+    if (hints.size() <= static_cast<size_t>(slot)) {
+      hints.resize(slot + 1, INVALID_FRAME_ID);
+    }
+    hints[slot] = FrameOf(child);
+  }
+  return child;
+}
+
+bool BufferPoolManager::UnpinPage(Page *page, bool is_dirty) {
+  lock_guard<recursive_mutex> guard(latch_);
+  if (page == nullptr || page->pin_count_ <= 0) {
+    return false;
+  }
+  page->is_dirty_ = page->is_dirty_ || is_dirty;
+  if (--page->pin_count_ == 0) {
+    replacer_->Unpin(FrameOf(page));
+  }
+  return true;
+}
+
+void BufferPoolManager::ResetChildFrames(frame_id_t frame_id) {
+  if (cache_child_frames_) {
+    child_frames_[frame_id].clear();
+  }
 }
 
 /**
@@ -45,7 +112,24 @@ Page *BufferPoolManager::NewPage(page_id_t &page_id) {
   // 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
   // 3.   Update P's metadata, zero out memory and add P to the page table.
   // 4.   Set the page ID output parameter. Return a pointer to P.
-  return nullptr;
+  lock_guard<recursive_mutex> guard(latch_);
+  frame_id_t frame_id = TryToFindFreePage();
+  if (frame_id == INVALID_FRAME_ID) {
+    return nullptr;
+  }
+  page_id = AllocatePage();
+  if (page_id == INVALID_PAGE_ID) {
+    free_list_.push_back(frame_id);
+    return nullptr;
+  }
+  Page &page = pages_[frame_id];
+  page.ResetMemory();
+  page.page_id_ = page_id;
+  page.pin_count_ = 1;
+  page.is_dirty_ = true;
+  page_table_[page_id] = frame_id;
+  replacer_->Pin(frame_id);
+  return &page;
 }
 
 /**
@@ -57,21 +141,51 @@ bool BufferPoolManager::DeletePage(page_id_t page_id) {
   // 1.   If P does not exist, return true.
   // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
   // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
-  return false;
+  lock_guard<recursive_mutex> guard(latch_);
+  auto it = page_table_.find(page_id);
+  if (it != page_table_.end()) {
+    frame_id_t frame_id = it->second;
+    Page &page = pages_[frame_id];
+    if (page.pin_count_ > 0) {
+      return false;
+    }
+    page_table_.erase(it);
+    replacer_->Pin(frame_id);
+    ResetChildFrames(frame_id);
+    page.ResetMemory();
+    page.page_id_ = INVALID_PAGE_ID;
+    page.is_dirty_ = false;
+    free_list_.push_back(frame_id);
+  }
+  DeallocatePage(page_id);
+  return true;
 }
 
 /**
  * TODO: Student Implement
  */
 bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
-  return false;
+  lock_guard<recursive_mutex> guard(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
+    return false;
+  }
+  return UnpinPage(&pages_[it->second], is_dirty);
 }
 
 /**
  * TODO: Student Implement
  */
 bool BufferPoolManager::FlushPage(page_id_t page_id) {
-  return false;
+  lock_guard<recursive_mutex> guard(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
+    return false;
+  }
+  Page &page = pages_[it->second];
+  disk_manager_->WritePage(page_id, page.data_);
+  page.is_dirty_ = false;
+  return true;
 }
 
 page_id_t BufferPoolManager::AllocatePage() {
@@ -83,6 +197,25 @@ void BufferPoolManager::DeallocatePage(__attribute__((unused)) page_id_t page_id
   disk_manager_->DeAllocatePage(page_id);
 }
 
+frame_id_t BufferPoolManager::TryToFindFreePage() {
+  frame_id_t frame_id = INVALID_FRAME_ID;
+  if (!free_list_.empty()) {
+    frame_id = free_list_.front();
+    free_list_.pop_front();
+  } else if (replacer_->Victim(&frame_id)) {
+    Page &victim = pages_[frame_id];
+    if (victim.is_dirty_) {
+      disk_manager_->WritePage(victim.page_id_, victim.data_);
+    }
+    page_table_.erase(victim.page_id_);
+  } else {
+    return INVALID_FRAME_ID;
+  }
+  // the hints of the frame belong to the page it held before
+  ResetChildFrames(frame_id);
+  return frame_id;
+}
+
 bool BufferPoolManager::IsPageFree(page_id_t page_id) {
   return disk_manager_->IsPageFree(page_id);
 }
@@ -1,6 +1,6 @@
 #include "buffer/lru_replacer.h"
 
-LRUReplacer::LRUReplacer(size_t num_pages){}
+LRUReplacer::LRUReplacer(size_t num_pages) { lru_map_.reserve(num_pages); }
 
 LRUReplacer::~LRUReplacer() = default;
 
@@ -8,26 +8,44 @@ LRUReplacer::~LRUReplacer() = default;
  * TODO: Student Implement
  */
 bool LRUReplacer::Victim(frame_id_t *frame_id) {
-  return false;
+  lock_guard<mutex> guard(latch_);
+  if (lru_list_.empty()) {
+    return false;
+  }
+  *frame_id = lru_list_.back();
+  lru_map_.erase(*frame_id);
+  lru_list_.pop_back();
+  return true;
 }
 
 /**
  * TODO: Student Implement
  */
 void LRUReplacer::Pin(frame_id_t frame_id) {
-
+  lock_guard<mutex> guard(latch_);
+  auto it = lru_map_.find(frame_id);
+  if (it != lru_map_.end()) {
+    lru_list_.erase(it->second);
+    lru_map_.erase(it);
+  }
 }
 
 /**
  * TODO: Student Implement
  */
 void LRUReplacer::Unpin(frame_id_t frame_id) {
-
+  lock_guard<mutex> guard(latch_);
+  if (lru_map_.count(frame_id) != 0) {
+    return;
+  }
+  lru_list_.push_front(frame_id);
+  lru_map_[frame_id] = lru_list_.begin();
 }
 
 /**
  * TODO: Student Implement
  */
 size_t LRUReplacer::Size() {
-  return 0;
-}
\ No newline at end of file
+  lock_guard<mutex> guard(latch_);
+  return lru_list_.size();
+}
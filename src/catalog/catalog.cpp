@@ -55,8 +55,8 @@ CatalogMeta *CatalogMeta::DeserializeFrom(char *buf) {
  * TODO: Student Implement
  */
 uint32_t CatalogMeta::GetSerializedSize() const {
-  ASSERT(false, "Not Implemented yet");
-  return 0;
+  // magic num, table count, index count, then an (id, page id) pair per entry
+  return 4 + 4 + 4 + 8 * (table_meta_pages_.size() + index_meta_pages_.size());
 }
 
 CatalogMeta::CatalogMeta() {}
@@ -67,7 +67,26 @@ CatalogMeta::CatalogMeta() {}
 CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager,
                                LogManager *log_manager, bool init)
     : buffer_pool_manager_(buffer_pool_manager), lock_manager_(lock_manager), log_manager_(log_manager) {
-//    ASSERT(false, "Not Implemented yet");
+  if (init) {
+    catalog_meta_ = CatalogMeta::NewInstance();
+    next_table_id_ = 0;
+    next_index_id_ = 0;
+    FlushCatalogMetaPage();
+    return;
+  }
+  auto meta_page = buffer_pool_manager_->FetchPage(CATALOG_META_PAGE_ID);
+  ASSERT(meta_page != nullptr, "Failed to fetch catalog meta page.");
+  catalog_meta_ = CatalogMeta::DeserializeFrom(meta_page->GetData());
+  buffer_pool_manager_->UnpinPage(CATALOG_META_PAGE_ID, false);
+  next_table_id_ = catalog_meta_->GetNextTableId();
+  next_index_id_ = catalog_meta_->GetNextIndexId();
+  // every table before the indexes, an index is loaded into the table it belongs to
+  for (auto iter : catalog_meta_->table_meta_pages_) {
+    ASSERT(LoadTable(iter.first, iter.second) == DB_SUCCESS, "Failed to load table.");
+  }
+  for (auto iter : catalog_meta_->index_meta_pages_) {
+    ASSERT(LoadIndex(iter.first, iter.second) == DB_SUCCESS, "Failed to load index.");
+  }
 }
 
 CatalogManager::~CatalogManager() {
@@ -85,34 +104,109 @@ CatalogManager::~CatalogManager() {
  * TODO: Student Implement
  */
 dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info) {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  if (table_names_.find(table_name) != table_names_.end()) {
+    return DB_TABLE_ALREADY_EXIST;
+  }
+  page_id_t meta_page_id;
+  auto meta_page = buffer_pool_manager_->NewPage(meta_page_id);
+  if (meta_page == nullptr) {
+    return DB_FAILED;
+  }
+  // the catalog owns its copy of the schema, the caller keeps its own
+  TableSchema *table_schema = Schema::DeepCopySchema(schema);
+  auto table_heap = TableHeap::Create(buffer_pool_manager_, table_schema, txn, log_manager_, lock_manager_);
+  table_id_t table_id = next_table_id_++;
+  auto table_meta = TableMetadata::Create(table_id, table_name, table_heap->GetFirstPageId(), table_schema);
+  table_meta->SerializeTo(meta_page->GetData());
+  buffer_pool_manager_->UnpinPage(meta_page_id, true);
+  table_info = TableInfo::Create();
+  table_info->Init(table_meta, table_heap);
+  table_names_[table_name] = table_id;
+  tables_[table_id] = table_info;
+  catalog_meta_->table_meta_pages_[table_id] = meta_page_id;
+  return FlushCatalogMetaPage();
 }
 
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::GetTable(const string &table_name, TableInfo *&table_info) {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  auto iter = table_names_.find(table_name);
+  if (iter == table_names_.end()) {
+    return DB_TABLE_NOT_EXIST;
+  }
+  return GetTable(iter->second, table_info);
 }
 
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::GetTables(vector<TableInfo *> &tables) const {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  for (auto iter : tables_) {
+    tables.push_back(iter.second);
+  }
+  return DB_SUCCESS;
 }
 
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string &index_name,
-                                    const std::vector<std::string> &index_keys, Txn *txn, IndexInfo *&index_info,
-                                    const string &index_type) {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+                                    const std::vector<std::string> &index_keys, Txn * /*txn*/, IndexInfo *&index_info,
+                                    const string &index_type, const std::vector<std::string> &include_columns,
+                                    bool concurrently) {
+  TableInfo *table_info = nullptr;
+  if (GetTable(table_name, table_info) != DB_SUCCESS) {
+    return DB_TABLE_NOT_EXIST;
+  }
+  auto table_indexes = index_names_.find(table_name);
+  if (table_indexes != index_names_.end() && table_indexes->second.count(index_name) > 0) {
+    return DB_INDEX_ALREADY_EXIST;
+  }
+  std::vector<uint32_t> key_map;
+  std::vector<uint32_t> include_map;
+  uint32_t column_index;
+  for (const auto &column_name : index_keys) {
+    if (table_info->GetSchema()->GetColumnIndex(column_name, column_index) != DB_SUCCESS) {
+      return DB_COLUMN_NAME_NOT_EXIST;
+    }
+    key_map.push_back(column_index);
+  }
+  for (const auto &column_name : include_columns) {
+    if (table_info->GetSchema()->GetColumnIndex(column_name, column_index) != DB_SUCCESS) {
+      return DB_COLUMN_NAME_NOT_EXIST;
+    }
+    include_map.push_back(column_index);
+  }
+  index_id_t index_id = next_index_id_++;
+  auto index_meta = IndexMetadata::Create(index_id, index_name, table_info->GetTableId(), key_map, index_type,
+                                          include_map);
+  index_info = IndexInfo::Create();
+  index_info->Init(index_meta, table_info, buffer_pool_manager_);
+  // an unknown type, or a key too wide for the index
+  if (index_info->GetIndex() == nullptr) {
+    delete index_info;
+    index_info = nullptr;
+    return DB_FAILED;
+  }
+  page_id_t meta_page_id;
+  auto meta_page = buffer_pool_manager_->NewPage(meta_page_id);
+  if (meta_page == nullptr) {
+    index_info->GetIndex()->Destroy();
+    delete index_info;
+    index_info = nullptr;
+    return DB_FAILED;
+  }
+  index_meta->SerializeTo(meta_page->GetData());
+  buffer_pool_manager_->UnpinPage(meta_page_id, true);
+  // capture writes before the index is visible to them, the caller scans the heap afterwards
+  if (concurrently) {
+    index_info->BeginConcurrentBuild();
+  }
+  index_names_[table_name][index_name] = index_id;
+  indexes_[index_id] = index_info;
+  catalog_meta_->index_meta_pages_[index_id] = meta_page_id;
+  return FlushCatalogMetaPage();
 }
 
 /**
@@ -120,62 +214,168 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
  */
 dberr_t CatalogManager::GetIndex(const std::string &table_name, const std::string &index_name,
                                  IndexInfo *&index_info) const {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  auto table_indexes = index_names_.find(table_name);
+  if (table_indexes == index_names_.end()) {
+    return DB_INDEX_NOT_FOUND;
+  }
+  auto iter = table_indexes->second.find(index_name);
+  if (iter == table_indexes->second.end()) {
+    return DB_INDEX_NOT_FOUND;
+  }
+  index_info = indexes_.at(iter->second);
+  return DB_SUCCESS;
 }
 
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::GetTableIndexes(const std::string &table_name, std::vector<IndexInfo *> &indexes) const {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  if (table_names_.find(table_name) == table_names_.end()) {
+    return DB_TABLE_NOT_EXIST;
+  }
+  auto table_indexes = index_names_.find(table_name);
+  if (table_indexes == index_names_.end()) {
+    return DB_SUCCESS;
+  }
+  for (auto iter : table_indexes->second) {
+    indexes.push_back(indexes_.at(iter.second));
+  }
+  return DB_SUCCESS;
 }
 
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::DropTable(const string &table_name) {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  auto iter = table_names_.find(table_name);
+  if (iter == table_names_.end()) {
+    return DB_TABLE_NOT_EXIST;
+  }
+  // the indexes go first, they may still read the heap while they are destroyed
+  std::vector<std::string> index_names;
+  for (auto index : index_names_[table_name]) {
+    index_names.push_back(index.first);
+  }
+  for (const auto &index_name : index_names) {
+    dberr_t result = DropIndex(table_name, index_name);
+    if (result != DB_SUCCESS) {
+      return result;
+    }
+  }
+  index_names_.erase(table_name);
+  return DropTable(iter->second);
+}
+
+dberr_t CatalogManager::DropTable(table_id_t table_id) {
+  auto iter = tables_.find(table_id);
+  if (iter == tables_.end()) {
+    return DB_TABLE_NOT_EXIST;
+  }
+  TableInfo *table_info = iter->second;
+  table_names_.erase(table_info->GetTableName());
+  tables_.erase(iter);
+  table_info->GetTableHeap()->FreeTableHeap();
+  delete table_info;
+  buffer_pool_manager_->DeletePage(catalog_meta_->table_meta_pages_[table_id]);
+  catalog_meta_->table_meta_pages_.erase(table_id);
+  return FlushCatalogMetaPage();
 }
 
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_name) {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  auto table_indexes = index_names_.find(table_name);
+  if (table_indexes == index_names_.end()) {
+    return DB_INDEX_NOT_FOUND;
+  }
+  auto iter = table_indexes->second.find(index_name);
+  if (iter == table_indexes->second.end()) {
+    return DB_INDEX_NOT_FOUND;
+  }
+  index_id_t index_id = iter->second;
+  IndexInfo *index_info = indexes_[index_id];
+  table_indexes->second.erase(iter);
+  indexes_.erase(index_id);
+  index_info->GetIndex()->Destroy();
+  delete index_info;
+  catalog_meta_->DeleteIndexMetaPage(buffer_pool_manager_, index_id);
+  return FlushCatalogMetaPage();
 }
 
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::FlushCatalogMetaPage() const {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  auto meta_page = buffer_pool_manager_->FetchPage(CATALOG_META_PAGE_ID);
+  if (meta_page == nullptr) {
+    return DB_FAILED;
+  }
+  catalog_meta_->SerializeTo(meta_page->GetData());
+  buffer_pool_manager_->UnpinPage(CATALOG_META_PAGE_ID, true);
+  return buffer_pool_manager_->FlushPage(CATALOG_META_PAGE_ID) ? DB_SUCCESS : DB_FAILED;
 }
 
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t page_id) {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  auto meta_page = buffer_pool_manager_->FetchPage(page_id);
+  if (meta_page == nullptr) {
+    return DB_FAILED;
+  }
+  TableMetadata *table_meta = nullptr;
+  TableMetadata::DeserializeFrom(meta_page->GetData(), table_meta);
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  auto table_heap = TableHeap::Create(buffer_pool_manager_, table_meta->GetFirstPageId(), table_meta->GetSchema(),
+                                      log_manager_, lock_manager_);
+  auto table_info = TableInfo::Create();
+  table_info->Init(table_meta, table_heap);
+  table_names_[table_meta->GetTableName()] = table_id;
+  tables_[table_id] = table_info;
+  return DB_SUCCESS;
 }
 
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t page_id) {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  auto meta_page = buffer_pool_manager_->FetchPage(page_id);
+  if (meta_page == nullptr) {
+    return DB_FAILED;
+  }
+  IndexMetadata *index_meta = nullptr;
+  IndexMetadata::DeserializeFrom(meta_page->GetData(), index_meta);
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  TableInfo *table_info = nullptr;
+  if (GetTable(index_meta->GetTableId(), table_info) != DB_SUCCESS) {
+    delete index_meta;
+    return DB_TABLE_NOT_EXIST;
+  }
+  auto index_info = IndexInfo::Create();
+  index_info->Init(index_meta, table_info, buffer_pool_manager_);
+  if (index_info->GetIndex() == nullptr) {
+    delete index_info;
+    return DB_FAILED;
+  }
+  // an in-memory index keeps nothing on disk, it is filled from the heap again
+  if (index_info->IsInMemory() && index_info->GetIndex()->BuildFromHeap(table_info->GetTableHeap(), nullptr) != DB_SUCCESS) {
+    delete index_info;
+    return DB_FAILED;
+  }
+  index_names_[table_info->GetTableName()][index_meta->GetIndexName()] = index_id;
+  indexes_[index_id] = index_info;
+  return DB_SUCCESS;
 }
 
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::GetTable(const table_id_t table_id, TableInfo *&table_info) {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
-}
\ No newline at end of file
+  auto iter = tables_.find(table_id);
+  if (iter == tables_.end()) {
+    return DB_TABLE_NOT_EXIST;
+  }
+  table_info = iter->second;
+  return DB_SUCCESS;
+}
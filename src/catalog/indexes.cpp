@@ -1,12 +1,21 @@
 #include "catalog/indexes.h"
 
+#include <algorithm>
+
 IndexMetadata::IndexMetadata(const index_id_t index_id, const std::string &index_name, const table_id_t table_id,
-                             const std::vector<uint32_t> &key_map)
-    : index_id_(index_id), index_name_(index_name), table_id_(table_id), key_map_(key_map) {}
+                             const std::vector<uint32_t> &key_map, const std::string &index_type,
+                             const std::vector<uint32_t> &include_map)
+    : index_id_(index_id),
+      index_name_(index_name),
+      table_id_(table_id),
+      key_map_(key_map),
+      index_type_(index_type),
+      include_map_(include_map) {}
 
 IndexMetadata *IndexMetadata::Create(const index_id_t index_id, const string &index_name, const table_id_t table_id,
-                                     const vector<uint32_t> &key_map) {
-  return new IndexMetadata(index_id, index_name, table_id, key_map);
+                                     const vector<uint32_t> &key_map, const string &index_type,
+                                     const vector<uint32_t> &include_map) {
+  return new IndexMetadata(index_id, index_name, table_id, key_map, index_type, include_map);
 }
 
 uint32_t IndexMetadata::SerializeTo(char *buf) const {
@@ -35,15 +44,31 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
     MACH_WRITE_UINT32(buf, col_index);
     buf += 4;
   }
+  // index type
+  MACH_WRITE_UINT32(buf, index_type_.length());
+  buf += 4;
+  MACH_WRITE_STRING(buf, index_type_);
+  buf += index_type_.length();
+  // include count
+  MACH_WRITE_UINT32(buf, include_map_.size());
+  buf += 4;
+  // include mapping in table
+  for (auto &col_index : include_map_) {
+    MACH_WRITE_UINT32(buf, col_index);
+    buf += 4;
+  }
   ASSERT(buf - p == ofs, "Unexpected serialize size.");
   return ofs;
 }
 
 /**
  * TODO: Student Implement
+ * NOTE: the index type string (4 bytes length + content) and the include mapping (4 bytes count + 4 bytes per
+ * column) follow the key mapping.
  */
 uint32_t IndexMetadata::GetSerializedSize() const {
-  return 0;
+  return 4 + 4 + MACH_STR_SERIALIZED_SIZE(index_name_) + 4 + 4 + 4 * key_map_.size() +
+         MACH_STR_SERIALIZED_SIZE(index_type_) + 4 + 4 * include_map_.size();
 }
 
 uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
@@ -76,11 +101,145 @@ uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
     buf += 4;
     key_map.push_back(key_index);
   }
+  // index type
+  len = MACH_READ_UINT32(buf);
+  buf += 4;
+  std::string index_type(buf, len);
+  buf += len;
+  // include count
+  uint32_t include_count = MACH_READ_UINT32(buf);
+  buf += 4;
+  // include mapping in table
+  std::vector<uint32_t> include_map;
+  for (uint32_t i = 0; i < include_count; i++) {
+    include_map.push_back(MACH_READ_UINT32(buf));
+    buf += 4;
+  }
   // allocate space for index meta data
-  index_meta = new IndexMetadata(index_id, index_name, table_id, key_map);
+  index_meta = new IndexMetadata(index_id, index_name, table_id, key_map, index_type, include_map);
   return buf - p;
 }
 
+dberr_t IndexInfo::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
+  if (building_.load()) {
+    std::lock_guard<std::mutex> guard(build_latch_);
+    // the build may have finished while this writer waited for the latch
+    if (building_.load()) {
+      side_log_.push_back({true, key, row_id});
+      return DB_SUCCESS;
+    }
+  }
+  return index_->InsertEntry(key, row_id, txn);
+}
+
+dberr_t IndexInfo::RemoveEntry(const Row &key, RowId row_id, Txn *txn) {
+  if (building_.load()) {
+    std::lock_guard<std::mutex> guard(build_latch_);
+    if (building_.load()) {
+      side_log_.push_back({false, key, row_id});
+      return DB_SUCCESS;
+    }
+  }
+  return index_->RemoveEntry(key, row_id, txn);
+}
+
+dberr_t IndexInfo::ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn) {
+  if (!building_.load()) {
+    return index_->ScanKey(key, result, txn);
+  }
+  std::lock_guard<std::mutex> guard(build_latch_);
+  index_->ScanKey(key, result, txn);
+  // replay the logged writes of key in order, a later write of a row overrides an earlier one
+  for (const auto &entry : side_log_) {
+    if (!SameKey(entry.key, key)) {
+      continue;
+    }
+    auto it = std::find(result.begin(), result.end(), entry.row_id);
+    if (entry.insert && it == result.end()) {
+      result.push_back(entry.row_id);
+    } else if (!entry.insert && it != result.end()) {
+      result.erase(it);
+    }
+  }
+  return result.empty() ? DB_KEY_NOT_FOUND : DB_SUCCESS;
+}
+
+bool IndexInfo::SameKey(const Row &a, const Row &b) const {
+  uint32_t key_count = meta_data_->GetIndexColumnCount();
+  if (a.GetFieldCount() < key_count || b.GetFieldCount() < key_count) {
+    return false;
+  }
+  for (uint32_t i = 0; i < key_count; i++) {
+    Field *x = a.GetField(i);
+    Field *y = b.GetField(i);
+    if (x->IsNull() || y->IsNull() || x->CompareEquals(*y) != CmpBool::kTrue) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void IndexInfo::BeginConcurrentBuild() {
+  std::lock_guard<std::mutex> guard(build_latch_);
+  side_log_.clear();
+  building_.store(true);
+}
+
+dberr_t IndexInfo::BuildEntry(const Row &key, RowId row_id, Txn *txn) {
+  if (index_->InsertEntry(key, row_id, txn) == DB_SUCCESS) {
+    return DB_SUCCESS;
+  }
+  std::vector<RowId> result;
+  index_->ScanKey(key, result, txn);
+  for (auto rid : result) {
+    if (rid == row_id) {
+      return DB_SUCCESS;
+    }
+  }
+  return DB_FAILED;
+}
+
+dberr_t IndexInfo::ApplyPending(const std::vector<PendingEntry> &pending, Txn *txn) {
+  for (const auto &entry : pending) {
+    if (entry.insert) {
+      // the heap scan may have added the row already
+      dberr_t result = BuildEntry(entry.key, entry.row_id, txn);
+      if (result != DB_SUCCESS) {
+        return result;
+      }
+    } else {
+      // a row deleted before the scan reached it was never added
+      index_->RemoveEntry(entry.key, entry.row_id, txn);
+    }
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t IndexInfo::FinishConcurrentBuild(Txn *txn) {
+  while (true) {
+    std::vector<PendingEntry> batch;
+    {
+      std::lock_guard<std::mutex> guard(build_latch_);
+      if (side_log_.size() <= FINAL_MERGE_THRESHOLD) {
+        break;
+      }
+      batch.swap(side_log_);
+    }
+    dberr_t result = ApplyPending(batch, txn);
+    if (result != DB_SUCCESS) {
+      return result;
+    }
+  }
+  std::lock_guard<std::mutex> guard(build_latch_);
+  dberr_t result = ApplyPending(side_log_, txn);
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  side_log_.clear();
+  building_.store(false);
+  return DB_SUCCESS;
+}
+
 Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const string &index_type) {
   size_t max_size = 0;
   uint32_t column_cnt = key_schema_->GetColumns().size();
@@ -94,7 +253,7 @@ Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const stri
     max_size += col->GetLength();
   }
 
-  if (index_type == "bptree") {
+  if (index_type == "bptree" || index_type == "btree") {
     if (max_size <= 8)
       max_size = 16;
     else if (max_size <= 24)
@@ -109,8 +268,49 @@ Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const stri
       LOG(ERROR) << "GenericKey size is too large";
       return nullptr;
     }
-  } else {
-    return nullptr;
+    return new BPlusTreeIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager,
+                              meta_data_->GetIndexColumnCount());
+  } else if (index_type == "hash") {
+    if (!meta_data_->include_map_.empty()) {
+      LOG(ERROR) << "Hash index does not support include columns";
+      return nullptr;
+    }
+    // hash keys are stored at their exact size, only the upper bound is shared with the B+ tree
+    if (max_size > 256) {
+      LOG(ERROR) << "GenericKey size is too large";
+      return nullptr;
+    }
+    return new ExtendibleHashIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager);
+  } else if (index_type == "art") {
+    if (!meta_data_->include_map_.empty()) {
+      LOG(ERROR) << "Art index does not support include columns";
+      return nullptr;
+    }
+    return new ArtIndex(meta_data_->index_id_, key_schema_);
+  } else if (index_type == "bitmap") {
+    if (!meta_data_->include_map_.empty() || meta_data_->GetIndexColumnCount() != 1) {
+      LOG(ERROR) << "Bitmap index only supports a single key column";
+      return nullptr;
+    }
+    return new BitmapIndex(meta_data_->index_id_, key_schema_);
+  } else if (index_type == "fulltext") {
+    if (!meta_data_->include_map_.empty() || meta_data_->GetIndexColumnCount() != 1 ||
+        key_schema_->GetColumn(0)->GetType() != TypeId::kTypeChar) {
+      LOG(ERROR) << "Fulltext index only supports a single char key column";
+      return nullptr;
+    }
+    return new FullTextIndex(meta_data_->index_id_, key_schema_, buffer_pool_manager);
+  } else if (index_type == "brin") {
+    if (!meta_data_->include_map_.empty() || meta_data_->GetIndexColumnCount() != 1) {
+      LOG(ERROR) << "Brin index only supports a single key column";
+      return nullptr;
+    }
+    // the bounds of a summary are stored at their exact size
+    if (max_size > 256) {
+      LOG(ERROR) << "GenericKey size is too large";
+      return nullptr;
+    }
+    return new BrinIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager);
   }
-  return new BPlusTreeIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager);
+  return nullptr;
 }
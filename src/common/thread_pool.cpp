@@ -0,0 +1,135 @@
+#include "common/thread_pool.h"
+
+#include <algorithm>
+
+namespace {
+/** The pool and the index of the worker running on this thread, no pool outside of any. */
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local size_t current_worker = 0;
+}  // namespace
+
+ThreadPool::ThreadPool(size_t thread_count) {
+  thread_count = std::max<size_t>(1, thread_count);
+  for (size_t i = 0; i <= thread_count; i++) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+  for (size_t i = 0; i < thread_count; i++) {
+    threads_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> guard(sleep_latch_);
+    stop_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+ThreadPool *ThreadPool::GetInstance() {
+  static ThreadPool pool(std::thread::hardware_concurrency());
+  return &pool;
+}
+
+void ThreadPool::Submit(Task task) {
+  size_t queue = current_pool == this ? current_worker : queues_.size() - 1;
+  // counted before it is queued, so a worker that takes it never sees the count drop below zero
+  {
+    std::lock_guard<std::mutex> guard(sleep_latch_);
+    pending_++;
+  }
+  {
+    std::lock_guard<std::mutex> guard(queues_[queue]->latch_);
+    queues_[queue]->tasks_.push_back(std::move(task));
+  }
+  sleep_cv_.notify_one();
+}
+
+bool ThreadPool::PopTask(size_t self, Task &task) {
+  {
+    WorkQueue &own = *queues_[self];
+    std::lock_guard<std::mutex> guard(own.latch_);
+    if (!own.tasks_.empty()) {
+      task = std::move(own.tasks_.back());
+      own.tasks_.pop_back();
+      return true;
+    }
+  }
+  // the injection queue first, then the other workers starting next to this one
+  for (size_t i = 0; i < queues_.size() - 1; i++) {
+    size_t victim = i == 0 ? queues_.size() - 1 : (self + i) % (queues_.size() - 1);
+    WorkQueue &queue = *queues_[victim];
+    std::lock_guard<std::mutex> guard(queue.latch_);
+    if (!queue.tasks_.empty()) {
+      task = std::move(queue.tasks_.front());
+      queue.tasks_.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::WorkerLoop(size_t self) {
+  current_pool = this;
+  current_worker = self;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(sleep_latch_);
+      sleep_cv_.wait(lock, [this] { return stop_ || pending_ > 0; });
+      if (stop_) {
+        return;
+      }
+    }
+    Task task;
+    if (!PopTask(self, task)) {
+      // another worker took it between the wake up and the pop, or it is counted but not queued yet
+      std::this_thread::yield();
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> guard(sleep_latch_);
+      pending_--;
+    }
+    task();
+  }
+}
+
+void TaskGroup::Submit(ThreadPool::Task task) {
+  auto state = state_;
+  pool_->Submit([state, task = std::move(task)]() {
+    {
+      std::lock_guard<std::mutex> guard(state->latch_);
+      if (state->closed_) {
+        return;
+      }
+      state->running_++;
+    }
+    try {
+      task();
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(state->latch_);
+      if (state->error_ == nullptr) {
+        state->error_ = std::current_exception();
+      }
+    }
+    {
+      std::lock_guard<std::mutex> guard(state->latch_);
+      state->running_--;
+    }
+    state->cv_.notify_all();
+  });
+}
+
+void TaskGroup::Wait() {
+  std::unique_lock<std::mutex> lock(state_->latch_);
+  state_->closed_ = true;
+  state_->cv_.wait(lock, [this] { return state_->running_ == 0; });
+  if (state_->error_ != nullptr) {
+    auto error = state_->error_;
+    state_->error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
@@ -0,0 +1,595 @@
+#include "executor/executors/aggregation_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+#include "common/hash_util.h"
+#include "executor/executors/bitmap_scan_executor.h"
+#include "executor/query_scheduler.h"
+
+AggregationHashTable::AggregationHashTable(std::vector<AggregationType> agg_types, std::vector<TypeId> value_types,
+                                           size_t expected_groups)
+    : agg_types_(std::move(agg_types)), value_types_(std::move(value_types)) {
+  // keep the load factor at or below one half for the expected groups
+  size_t capacity = 16;
+  while (capacity < expected_groups * 2) {
+    capacity <<= 1;
+  }
+  slots_.assign(capacity, Slot{0, 0});
+}
+
+void AggregationHashTable::MakeKey(const std::vector<Field> &group_bys, std::string &key, uint64_t &hash) {
+  key.clear();
+  for (const auto &field : group_bys) {
+    key.push_back(field.IsNull() ? 0 : 1);
+    if (field.IsNull()) {
+      continue;
+    }
+    size_t offset = key.size();
+    key.resize(offset + field.GetSerializedSize());
+    if (field.GetTypeId() == TypeId::kTypeFloat) {
+      Field(TypeId::kTypeFloat, HashUtil::NormalizeFloat(field.GetFloatValue())).SerializeTo(&key[offset]);
+    } else {
+      field.SerializeTo(&key[offset]);
+    }
+  }
+  hash = HashUtil::Murmur3_64(key.data(), key.size());
+}
+
+template <typename MakeGroup>
+size_t AggregationHashTable::FindOrInsert(uint64_t hash, const std::string &key, MakeGroup &&make_group) {
+  size_t mask = slots_.size() - 1;
+  for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+    Slot &slot = slots_[pos];
+    if (slot.head_ == 0) {
+      groups_.push_back(make_group());
+      slot = Slot{hash, static_cast<uint32_t>(groups_.size())};
+      const Group &group = groups_.back();
+      bytes_ += sizeof(Group) + group.key_.size() + group.accumulators_.size() * sizeof(Accumulator);
+      for (const auto &field : group.fields_) {
+        bytes_ += sizeof(Field) + field.GetSerializedSize();
+      }
+      if (groups_.size() * 2 > slots_.size()) {
+        Resize(slots_.size() * 2);
+      }
+      return groups_.size() - 1;
+    }
+    if (slot.hash_ == hash && groups_[slot.head_ - 1].key_ == key) {
+      return slot.head_ - 1;
+    }
+  }
+}
+
+void AggregationHashTable::Resize(size_t capacity) {
+  slots_.assign(capacity, Slot{0, 0});
+  size_t mask = capacity - 1;
+  for (uint32_t i = 0; i < groups_.size(); i++) {
+    size_t pos = groups_[i].hash_ & mask;
+    while (slots_[pos].head_ != 0) {
+      pos = (pos + 1) & mask;
+    }
+    slots_[pos] = Slot{groups_[i].hash_, i + 1};
+  }
+}
+
+void AggregationHashTable::AccumulateBatch(std::vector<Input> &batch) {
+  size_t mask = slots_.size() - 1;
+  for (const auto &input : batch) {
+    __builtin_prefetch(&slots_[input.hash_ & mask]);
+  }
+  for (auto &input : batch) {
+    size_t index = FindOrInsert(input.hash_, input.key_, [this, &input]() {
+      Group group = NewGroup(std::move(input.group_bys_));
+      group.hash_ = input.hash_;
+      group.key_ = std::move(input.key_);
+      return group;
+    });
+    Fold(groups_[index], input.values_);
+  }
+}
+
+void AggregationHashTable::Combine(Group &&partial) {
+  bool inserted = false;
+  size_t index = FindOrInsert(partial.hash_, partial.key_, [&inserted, &partial]() {
+    inserted = true;
+    return std::move(partial);
+  });
+  if (inserted) {
+    return;
+  }
+  Group &group = groups_[index];
+  size_t extreme_offset = group.fields_.size() - agg_types_.size();
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    Accumulator &accumulator = group.accumulators_[i];
+    const Accumulator &other = partial.accumulators_[i];
+    accumulator.count_ += other.count_;
+    accumulator.int_sum_ += other.int_sum_;
+    accumulator.float_sum_ += other.float_sum_;
+    Field &extreme = group.fields_[extreme_offset + i];
+    Field &candidate = partial.fields_[extreme_offset + i];
+    if (candidate.IsNull() || (agg_types_[i] != AggregationType::Min && agg_types_[i] != AggregationType::Max)) {
+      continue;
+    }
+    CmpBool better = agg_types_[i] == AggregationType::Min ? candidate.CompareLessThan(extreme)
+                                                           : candidate.CompareGreaterThan(extreme);
+    if (extreme.IsNull() || better == CmpBool::kTrue) {
+      Swap(extreme, candidate);
+    }
+  }
+}
+
+void AggregationHashTable::Merge(AggregationHashTable &&other) {
+  for (auto &group : other.groups_) {
+    Combine(std::move(group));
+  }
+  other.Clear();
+}
+
+AggregationHashTable::Group AggregationHashTable::NewGroup(std::vector<Field> &&group_bys) const {
+  Group group;
+  group.fields_ = std::move(group_bys);
+  group.fields_.reserve(group.fields_.size() + value_types_.size());
+  for (auto type : value_types_) {
+    group.fields_.emplace_back(type);
+  }
+  group.accumulators_.resize(agg_types_.size());
+  return group;
+}
+
+void AggregationHashTable::Fold(Group &group, const std::vector<Field> &values) const {
+  size_t extreme_offset = group.fields_.size() - agg_types_.size();
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    Accumulator &accumulator = group.accumulators_[i];
+    if (agg_types_[i] == AggregationType::CountStar) {
+      accumulator.count_++;
+      continue;
+    }
+    const Field &value = values[i];
+    if (value.IsNull()) {
+      continue;
+    }
+    accumulator.count_++;
+    switch (agg_types_[i]) {
+      case AggregationType::Sum:
+      case AggregationType::Avg:
+        if (value.GetTypeId() == TypeId::kTypeInt) {
+          accumulator.int_sum_ += value.GetIntValue();
+        } else {
+          accumulator.float_sum_ += value.GetFloatValue();
+        }
+        break;
+      case AggregationType::Min:
+      case AggregationType::Max: {
+        Field &extreme = group.fields_[extreme_offset + i];
+        CmpBool better = agg_types_[i] == AggregationType::Min ? value.CompareLessThan(extreme)
+                                                               : value.CompareGreaterThan(extreme);
+        if (extreme.IsNull() || better == CmpBool::kTrue) {
+          Field copy(value);
+          Swap(extreme, copy);
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+/** @return value as an int, the result columns of count and of an int sum are ints */
+static int32_t ToInt(int64_t value, const char *aggregate) {
+  if (value < std::numeric_limits<int32_t>::min() || value > std::numeric_limits<int32_t>::max()) {
+    throw std::overflow_error(std::string(aggregate) + " " + std::to_string(value) + " does not fit in an int");
+  }
+  return static_cast<int32_t>(value);
+}
+
+std::vector<Field> AggregationHashTable::Finalize(const Group &group) const {
+  size_t extreme_offset = group.fields_.size() - agg_types_.size();
+  std::vector<Field> fields;
+  fields.reserve(group.fields_.size());
+  for (size_t i = 0; i < extreme_offset; i++) {
+    fields.emplace_back(group.fields_[i]);
+  }
+  for (size_t i = 0; i < agg_types_.size(); i++) {
+    const Accumulator &accumulator = group.accumulators_[i];
+    bool is_int = value_types_[i] == TypeId::kTypeInt;
+    switch (agg_types_[i]) {
+      case AggregationType::CountStar:
+      case AggregationType::Count:
+        fields.emplace_back(TypeId::kTypeInt, ToInt(accumulator.count_, "count"));
+        break;
+      case AggregationType::Sum:
+        if (accumulator.count_ == 0) {
+          fields.emplace_back(value_types_[i]);
+        } else if (is_int) {
+          fields.emplace_back(TypeId::kTypeInt, ToInt(accumulator.int_sum_, "sum"));
+        } else {
+          fields.emplace_back(TypeId::kTypeFloat, static_cast<float>(accumulator.float_sum_));
+        }
+        break;
+      case AggregationType::Avg:
+        if (accumulator.count_ == 0) {
+          fields.emplace_back(TypeId::kTypeFloat);
+        } else {
+          double sum = is_int ? static_cast<double>(accumulator.int_sum_) : accumulator.float_sum_;
+          fields.emplace_back(TypeId::kTypeFloat, static_cast<float>(sum / accumulator.count_));
+        }
+        break;
+      case AggregationType::Min:
+      case AggregationType::Max:
+        fields.emplace_back(group.fields_[extreme_offset + i]);
+        break;
+    }
+  }
+  return fields;
+}
+
+void AggregationHashTable::Clear() {
+  groups_.clear();
+  slots_.assign(slots_.size(), Slot{0, 0});
+  bytes_ = 0;
+}
+
+AggregationExecutor::AggregationExecutor(ExecuteContext *exec_ctx, const AggregationPlanNode *plan,
+                                         std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+AggregationExecutor::~AggregationExecutor() { DropPartitions(); }
+
+uint32_t AggregationExecutor::PartitionOf(const AggregationHashTable::Group &group, uint32_t level) {
+  if (level == 0) {
+    return (group.hash_ >> 32) % PARTITION_COUNT;
+  }
+  // groups of one partition agree on the bits above, a split needs a hash independent of them
+  return HashUtil::Murmur3(group.key_.data(), group.key_.size(), REPARTITION_SEED + level) % PARTITION_COUNT;
+}
+
+std::unique_ptr<AggregationHashTable> AggregationExecutor::MakeTable() const {
+  std::vector<TypeId> value_types;
+  for (const auto &aggregate : plan_->GetAggregates()) {
+    value_types.push_back(aggregate == nullptr ? TypeId::kTypeInt : aggregate->GetReturnType());
+  }
+  size_t expected_groups = plan_->GetGroupBys().empty() ? 1 : EXPECTED_GROUPS;
+  return std::make_unique<AggregationHashTable>(plan_->GetAggregateTypes(), std::move(value_types), expected_groups);
+}
+
+std::vector<Field> AggregationExecutor::EvaluateValues(const Row &row) const {
+  std::vector<Field> values;
+  values.reserve(plan_->GetAggregates().size());
+  for (const auto &aggregate : plan_->GetAggregates()) {
+    if (aggregate == nullptr) {
+      values.emplace_back(TypeId::kTypeInt);
+    } else {
+      values.emplace_back(aggregate->Evaluate(&row));
+    }
+  }
+  return values;
+}
+
+AggregationHashTable::Input AggregationExecutor::MakeInput(const Row &row) const {
+  AggregationHashTable::Input input;
+  for (const auto &group_by : plan_->GetGroupBys()) {
+    input.group_bys_.emplace_back(group_by->Evaluate(&row));
+  }
+  AggregationHashTable::MakeKey(input.group_bys_, input.key_, input.hash_);
+  input.values_ = EvaluateValues(row);
+  return input;
+}
+
+void AggregationExecutor::Init() {
+  DropPartitions();
+  spilled_ = false;
+  next_partition_ = 0;
+  group_cursor_ = 0;
+  table_ = MakeTable();
+  std::vector<Column *> columns;
+  auto add_column = [&columns](TypeId type) {
+    auto name = "field" + std::to_string(columns.size());
+    if (type == TypeId::kTypeChar) {
+      columns.push_back(new Column(name, type, PAGE_SIZE, columns.size(), true, false));
+    } else {
+      columns.push_back(new Column(name, type, columns.size(), true, false));
+    }
+  };
+  for (const auto &group_by : plan_->GetGroupBys()) {
+    add_column(group_by->GetReturnType());
+  }
+  for (const auto &aggregate : plan_->GetAggregates()) {
+    add_column(aggregate == nullptr ? TypeId::kTypeInt : aggregate->GetReturnType());
+  }
+  group_schema_ = std::make_unique<Schema>(columns);
+  if (plan_->GetChildPlan()->GetType() == PlanType::Gather) {
+    AggregateParallel(dynamic_cast<const GatherPlanNode *>(plan_->GetChildPlan().get()));
+  } else {
+    AggregateSerial();
+  }
+  if (spilled_) {
+    SpillGroups();
+    for (auto &partition : partitions_) {
+      FlushBuffer(partition);
+    }
+    NextPartition();
+  }
+}
+
+void AggregationExecutor::AggregateSerial() {
+  child_executor_->Init();
+  Row row;
+  RowId rid;
+  // a single group needs no lookup, every row is folded straight into it
+  if (plan_->GetGroupBys().empty()) {
+    auto group = table_->NewGroup({});
+    // count(*) alone over bitmaps that answer the whole predicate is their cardinality, no row is fetched
+    const auto &agg_types = plan_->GetAggregateTypes();
+    auto bitmap_scan = dynamic_cast<BitmapScanExecutor *>(child_executor_.get());
+    uint64_t count = 0;
+    if (bitmap_scan != nullptr &&
+        std::all_of(agg_types.begin(), agg_types.end(),
+                    [](AggregationType type) { return type == AggregationType::CountStar; }) &&
+        bitmap_scan->CountMatches(count)) {
+      for (auto &accumulator : group.accumulators_) {
+        accumulator.count_ = static_cast<int64_t>(count);
+      }
+      table_->GetGroups().push_back(std::move(group));
+      return;
+    }
+    while (child_executor_->Next(&row, &rid)) {
+      table_->Fold(group, EvaluateValues(row));
+    }
+    table_->GetGroups().push_back(std::move(group));
+    return;
+  }
+  std::vector<AggregationHashTable::Input> batch;
+  batch.reserve(BATCH_SIZE);
+  bool exhausted = false;
+  while (!exhausted) {
+    while (batch.size() < BATCH_SIZE && !(exhausted = !child_executor_->Next(&row, &rid))) {
+      batch.push_back(MakeInput(row));
+    }
+    table_->AccumulateBatch(batch);
+    batch.clear();
+    if (table_->GetBytes() > plan_->GetMemoryBudget()) {
+      SpillGroups();
+    }
+  }
+}
+
+void AggregationExecutor::AggregateParallel(const GatherPlanNode *gather) {
+  QueryScheduler scheduler(gather->GetDop());
+  uint32_t workers = scheduler.GetWorkerCount();
+  bool grouped = !plan_->GetGroupBys().empty();
+  std::vector<std::unique_ptr<AggregationHashTable>> locals;
+  std::vector<std::vector<AggregationHashTable::Input>> batches(workers);
+  std::vector<AggregationHashTable::Group> singles;
+  for (uint32_t i = 0; i < workers; i++) {
+    locals.push_back(MakeTable());
+    if (!grouped) {
+      singles.push_back(table_->NewGroup({}));
+    }
+  }
+  uint64_t local_budget = std::max<uint64_t>(1, plan_->GetMemoryBudget() / workers);
+  std::mutex latch;
+  auto accumulate = [&](uint32_t worker) {
+    locals[worker]->AccumulateBatch(batches[worker]);
+    batches[worker].clear();
+    if (locals[worker]->GetBytes() > local_budget) {
+      std::lock_guard<std::mutex> guard(latch);
+      table_->Merge(std::move(*locals[worker]));
+      if (table_->GetBytes() > plan_->GetMemoryBudget()) {
+        SpillGroups();
+      }
+    }
+  };
+  scheduler.RunScanPipeline(
+      exec_ctx_, gather->GetScanPlan(),
+      [&](uint32_t worker, Row &row) {
+        if (!grouped) {
+          table_->Fold(singles[worker], EvaluateValues(row));
+          return;
+        }
+        batches[worker].push_back(MakeInput(row));
+        if (batches[worker].size() >= BATCH_SIZE) {
+          accumulate(worker);
+        }
+      },
+      [&](uint32_t worker) {
+        if (!batches[worker].empty()) {
+          accumulate(worker);
+        }
+      });
+  if (!grouped) {
+    for (auto &group : singles) {
+      table_->Combine(std::move(group));
+    }
+    return;
+  }
+  if (spilled_) {
+    // the groups are on pages already, the rest of them follow the same way
+    for (auto &local : locals) {
+      table_->Merge(std::move(*local));
+      if (table_->GetBytes() > plan_->GetMemoryBudget()) {
+        SpillGroups();
+      }
+    }
+    return;
+  }
+  // every worker routes its own groups by hash, the shared table is one more producer
+  RepartitionExchange<AggregationHashTable::Group> exchange(workers + 1, PARTITION_COUNT);
+  scheduler.Run([&](uint32_t worker) {
+    auto route = [&exchange](uint32_t producer, AggregationHashTable &table) {
+      for (auto &group : table.GetGroups()) {
+        uint32_t partition = (group.hash_ >> 32) % PARTITION_COUNT;
+        exchange.Push(producer, partition, std::move(group));
+      }
+      table.Clear();
+    };
+    route(worker, *locals[worker]);
+    if (worker == 0) {
+      route(workers, *table_);
+    }
+  });
+  // a partition holds every partial group of its keys, so the partitions combine independently
+  std::vector<std::unique_ptr<AggregationHashTable>> partitions(PARTITION_COUNT);
+  std::atomic<uint32_t> next_partition{0};
+  scheduler.Run([&](uint32_t) {
+    for (uint32_t partition = next_partition++; partition < PARTITION_COUNT; partition = next_partition++) {
+      partitions[partition] = MakeTable();
+      for (auto &group : exchange.TakePartition(partition)) {
+        partitions[partition]->Combine(std::move(group));
+      }
+    }
+  });
+  // Next only walks the groups, so they are moved over without building slots for them again
+  auto &groups = table_->GetGroups();
+  for (auto &partition : partitions) {
+    for (auto &group : partition->GetGroups()) {
+      groups.push_back(std::move(group));
+    }
+  }
+}
+
+bool AggregationExecutor::Next(Row *row, RowId * /*rid*/) {
+  while (true) {
+    auto &groups = table_->GetGroups();
+    if (group_cursor_ < groups.size()) {
+      auto values = table_->Finalize(groups[group_cursor_++]);
+      std::vector<Field> fields;
+      fields.reserve(GetOutputSchema()->GetColumnCount());
+      for (auto column : GetOutputSchema()->GetColumns()) {
+        fields.emplace_back(values[column->GetTableInd()]);
+      }
+      *row = Row(fields);
+      return true;
+    }
+    if (!spilled_ || !NextPartition()) {
+      return false;
+    }
+  }
+}
+
+void AggregationExecutor::SpillGroups(uint32_t base, uint32_t level) {
+  spilled_ = true;
+  if (partitions_.size() < base + PARTITION_COUNT) {
+    partitions_.resize(base + PARTITION_COUNT);
+    for (uint32_t i = base; i < partitions_.size(); i++) {
+      partitions_[i].level_ = level;
+    }
+  }
+  for (auto &group : table_->GetGroups()) {
+    Partition &partition = partitions_[base + PartitionOf(group, level)];
+    Row row(group.fields_);
+    uint32_t accumulator_size = group.accumulators_.size() * sizeof(AggregationHashTable::Accumulator);
+    uint32_t size = row.GetSerializedSize(group_schema_.get()) + accumulator_size;
+    if (2 * sizeof(uint32_t) + size > PAGE_SIZE) {
+      throw std::runtime_error("a group of " + std::to_string(size) + " bytes is too large to spill in an aggregation");
+    }
+    if (partition.buffer_ == nullptr) {
+      partition.buffer_ = std::make_unique<char[]>(PAGE_SIZE);
+      partition.buffer_size_ = sizeof(uint32_t);
+    }
+    if (partition.buffer_size_ + sizeof(uint32_t) + size > PAGE_SIZE) {
+      FlushBuffer(partition);
+    }
+    // an entry is [size][group row][accumulators]
+    char *buf = partition.buffer_.get() + partition.buffer_size_;
+    MACH_WRITE_UINT32(buf, size);
+    uint32_t row_size = row.SerializeTo(buf + sizeof(uint32_t), group_schema_.get());
+    memcpy(buf + sizeof(uint32_t) + row_size, group.accumulators_.data(), accumulator_size);
+    partition.buffer_size_ += sizeof(uint32_t) + size;
+    partition.buffer_count_++;
+  }
+  table_->Clear();
+}
+
+void AggregationExecutor::FlushBuffer(Partition &partition) {
+  if (partition.buffer_count_ == 0) {
+    return;
+  }
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  page_id_t page_id;
+  Page *page = bpm->NewPage(page_id);
+  if (page == nullptr) {
+    throw std::runtime_error("no free frame for an aggregation partition page");
+  }
+  MACH_WRITE_UINT32(partition.buffer_.get(), partition.buffer_count_);
+  memcpy(page->GetData(), partition.buffer_.get(), PAGE_SIZE);
+  bpm->UnpinPage(page_id, true);
+  partition.pages_.push_back(page_id);
+  partition.buffer_size_ = sizeof(uint32_t);
+  partition.buffer_count_ = 0;
+}
+
+bool AggregationExecutor::NextPartition() {
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  size_t group_by_count = plan_->GetGroupBys().size();
+  size_t aggregate_count = plan_->GetAggregates().size();
+  while (next_partition_ < partitions_.size()) {
+    uint32_t index = next_partition_++;
+    // splitting the partition appends to partitions_, so nothing refers into it while the pages are read
+    std::vector<page_id_t> pages = std::move(partitions_[index].pages_);
+    partitions_[index].pages_.clear();
+    uint32_t level = partitions_[index].level_;
+    if (pages.empty()) {
+      continue;
+    }
+    table_->Clear();
+    group_cursor_ = 0;
+    // base of the partitions the groups are split into, 0 while they fit in the budget
+    uint32_t split_base = 0;
+    for (auto page_id : pages) {
+      Page *page = bpm->FetchPage(page_id);
+      if (page == nullptr) {
+        throw std::runtime_error("no free frame for an aggregation partition page");
+      }
+      char *buf = page->GetData();
+      uint32_t count = MACH_READ_UINT32(buf);
+      uint32_t offset = sizeof(uint32_t);
+      for (uint32_t i = 0; i < count; i++) {
+        uint32_t size = MACH_READ_UINT32(buf + offset);
+        Row row;
+        uint32_t row_size = row.DeserializeFrom(buf + offset + sizeof(uint32_t), group_schema_.get());
+        AggregationHashTable::Group group;
+        for (uint32_t j = 0; j < row.GetFieldCount(); j++) {
+          group.fields_.emplace_back(*row.GetField(j));
+        }
+        group.accumulators_.resize(aggregate_count);
+        memcpy(group.accumulators_.data(), buf + offset + sizeof(uint32_t) + row_size,
+               aggregate_count * sizeof(AggregationHashTable::Accumulator));
+        std::vector<Field> group_bys(group.fields_.begin(), group.fields_.begin() + group_by_count);
+        AggregationHashTable::MakeKey(group_bys, group.key_, group.hash_);
+        table_->Combine(std::move(group));
+        offset += sizeof(uint32_t) + size;
+      }
+      bpm->UnpinPage(page_id, false);
+      bpm->DeletePage(page_id);
+      if (table_->GetBytes() > plan_->GetMemoryBudget() && level < MAX_REPARTITION_LEVEL) {
+        if (split_base == 0) {
+          split_base = partitions_.size();
+        }
+        SpillGroups(split_base, level + 1);
+      }
+    }
+    if (split_base != 0) {
+      SpillGroups(split_base, level + 1);
+      for (uint32_t i = split_base; i < partitions_.size(); i++) {
+        FlushBuffer(partitions_[i]);
+      }
+      continue;
+    }
+    return true;
+  }
+  table_->Clear();
+  return false;
+}
+
+void AggregationExecutor::DropPartitions() {
+  for (auto &partition : partitions_) {
+    for (auto page_id : partition.pages_) {
+      exec_ctx_->GetBufferPoolManager()->DeletePage(page_id);
+    }
+  }
+  partitions_.clear();
+}
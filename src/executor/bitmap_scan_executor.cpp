@@ -0,0 +1,118 @@
+#include "executor/executors/bitmap_scan_executor.h"
+
+#include "index/bitmap_index.h"
+
+BitmapScanExecutor::BitmapScanExecutor(ExecuteContext *exec_ctx, const BitmapScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+bool BitmapScanExecutor::EvaluateBitmap(const AbstractExpressionRef &predicate, RoaringBitmap &result, bool &exact) {
+  if (predicate->GetType() == ExpressionType::ComparisonExpression) {
+    auto comparison = dynamic_cast<ComparisonExpression *>(predicate.get());
+    if (!comparison->ComparesToConstants()) {
+      return false;
+    }
+    uint32_t col_idx = dynamic_pointer_cast<ColumnValueExpression>(comparison->GetChildAt(0))->GetColIdx();
+    for (auto index : plan_->indexes_) {
+      auto key_column = index->GetIndexKeySchema()->GetColumn(0);
+      if (key_column->GetTableInd() != col_idx) {
+        continue;
+      }
+      std::vector<Field> fields;
+      std::string compare_operator = comparison->GetComparisonType();
+      auto bitmap_index = dynamic_cast<BitmapIndex *>(index->GetIndex());
+      if (compare_operator == "in") {
+        // the union of the bitmaps of every value
+        for (size_t i = 1; i < comparison->GetChildren().size(); i++) {
+          std::vector<Field> value;
+          value.emplace_back(comparison->GetChildAt(i)->Evaluate(nullptr));
+          if (value[0].GetTypeId() != key_column->GetType() || !bitmap_index->Lookup(Row(value), "=", result)) {
+            return false;
+          }
+        }
+        exact = true;
+        return true;
+      }
+      if (compare_operator == "is" || compare_operator == "not") {
+        fields.emplace_back(key_column->GetType());
+      } else {
+        fields.emplace_back(comparison->GetChildAt(1)->Evaluate(nullptr));
+        if (fields[0].GetTypeId() != key_column->GetType()) {
+          return false;
+        }
+      }
+      exact = true;
+      return bitmap_index->Lookup(Row(fields), compare_operator, result);
+    }
+    return false;
+  }
+  if (predicate->GetType() != ExpressionType::LogicExpression) {
+    return false;
+  }
+  bool is_and = dynamic_cast<LogicExpression *>(predicate.get())->logic_type_ == LogicType::And;
+  RoaringBitmap lhs, rhs;
+  bool lhs_exact = false;
+  bool rhs_exact = false;
+  bool has_lhs = EvaluateBitmap(predicate->GetChildAt(0), lhs, lhs_exact);
+  bool has_rhs = EvaluateBitmap(predicate->GetChildAt(1), rhs, rhs_exact);
+  if (is_and) {
+    if (!has_lhs && !has_rhs) {
+      return false;
+    }
+    if (has_lhs && has_rhs) {
+      lhs.IntersectWith(rhs);
+    } else if (has_rhs) {
+      lhs = std::move(rhs);
+    }
+  } else {
+    if (!has_lhs || !has_rhs) {
+      return false;
+    }
+    lhs.UnionWith(rhs);
+  }
+  exact = has_lhs && has_rhs && lhs_exact && rhs_exact;
+  result.UnionWith(lhs);
+  return true;
+}
+
+void BitmapScanExecutor::Init() {
+  exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
+  matches_ = RoaringBitmap();
+  ordinals_.clear();
+  cursor_ = 0;
+  exact_ = false;
+  if (!EvaluateBitmap(plan_->GetPredicate(), matches_, exact_)) {
+    throw std::logic_error("the predicate can not be answered by bitmap indexes");
+  }
+  matches_.ToVector(ordinals_);
+}
+
+bool BitmapScanExecutor::CountMatches(uint64_t &count) const {
+  if (!exact_) {
+    return false;
+  }
+  count = matches_.Cardinality();
+  return true;
+}
+
+bool BitmapScanExecutor::Next(Row *row, RowId *rid) {
+  auto predicate = plan_->GetPredicate();
+  while (cursor_ < ordinals_.size()) {
+    RowId next_rid = BitmapIndex::FromOrdinal(ordinals_[cursor_++]);
+    Row fetched(next_rid);
+    if (!table_info_->GetTableHeap()->GetTuple(&fetched, exec_ctx_->GetTransaction())) {
+      continue;
+    }
+    if (!predicate->Evaluate(&fetched).CompareEquals(Field(kTypeInt, 1))) {
+      continue;
+    }
+    *rid = next_rid;
+    std::vector<Field> fields;
+    for (auto column : plan_->OutputSchema()->GetColumns()) {
+      fields.emplace_back(*fetched.GetField(column->GetTableInd()));
+    }
+    *row = Row(fields);
+    row->SetRowId(next_rid);
+    return true;
+  }
+  return false;
+}
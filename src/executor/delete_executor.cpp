@@ -4,6 +4,8 @@
 
 #include "executor/executors/delete_executor.h"
 
+#include <stdexcept>
+
 DeleteExecutor::DeleteExecutor(ExecuteContext *exec_ctx, const DeletePlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
     : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
@@ -21,9 +23,17 @@ bool DeleteExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
       return false;
     }
     Row key_row;
-    for (auto info : index_info_) {  // 更新索引
-      row->GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), key_row);
-      info->GetIndex()->RemoveEntry(key_row, *rid, txn_);
+    for (size_t i = 0; i < index_info_.size(); i++) {  // 更新索引
+      row->GetKeyFromRow(table_info_->GetSchema(), index_info_[i]->GetIndexKeySchema(), key_row);
+      if (index_info_[i]->RemoveEntry(key_row, *rid, txn_) != DB_SUCCESS) {
+        // put back the entries already removed and keep the row
+        for (size_t j = 0; j < i; j++) {
+          row->GetKeyFromRow(table_info_->GetSchema(), index_info_[j]->GetIndexKeySchema(), key_row);
+          index_info_[j]->InsertEntry(key_row, *rid, txn_);
+        }
+        table_info_->GetTableHeap()->RollbackDelete(*rid, txn_);
+        throw std::runtime_error("failed to remove from index " + index_info_[i]->GetIndexName());
+      }
     }
     return true;
   }
@@ -7,10 +7,19 @@
 #include <chrono>
 
 #include "common/result_writer.h"
+#include "executor/executors/aggregation_executor.h"
+#include "executor/executors/bitmap_scan_executor.h"
 #include "executor/executors/delete_executor.h"
+#include "executor/executors/gather_executor.h"
+#include "executor/executors/hash_join_executor.h"
+#include "executor/executors/index_nested_loop_join_executor.h"
 #include "executor/executors/index_scan_executor.h"
 #include "executor/executors/insert_executor.h"
+#include "executor/executors/limit_executor.h"
+#include "executor/executors/merge_join_executor.h"
 #include "executor/executors/seq_scan_executor.h"
+#include "executor/executors/sort_executor.h"
+#include "executor/executors/topn_executor.h"
 #include "executor/executors/update_executor.h"
 #include "executor/executors/values_executor.h"
 #include "glog/logging.h"
@@ -56,6 +65,54 @@ std::unique_ptr<AbstractExecutor> ExecuteEngine::CreateExecutor(ExecuteContext *
     case PlanType::IndexScan: {
       return std::make_unique<IndexScanExecutor>(exec_ctx, dynamic_cast<const IndexScanPlanNode *>(plan.get()));
     }
+    // Create a new bitmap scan executor
+    case PlanType::BitmapScan: {
+      return std::make_unique<BitmapScanExecutor>(exec_ctx, dynamic_cast<const BitmapScanPlanNode *>(plan.get()));
+    }
+    // Create a new hash join executor
+    case PlanType::HashJoin: {
+      auto join_plan = dynamic_cast<const HashJoinPlanNode *>(plan.get());
+      auto left_executor = CreateExecutor(exec_ctx, join_plan->GetLeftPlan());
+      auto right_executor = CreateExecutor(exec_ctx, join_plan->GetRightPlan());
+      return std::make_unique<HashJoinExecutor>(exec_ctx, join_plan, std::move(left_executor),
+                                                std::move(right_executor));
+    }
+    case PlanType::IndexNestedLoopJoin: {
+      auto join_plan = dynamic_cast<const IndexNestedLoopJoinPlanNode *>(plan.get());
+      auto outer_executor = CreateExecutor(exec_ctx, join_plan->GetOuterPlan());
+      return std::make_unique<IndexNestedLoopJoinExecutor>(exec_ctx, join_plan, std::move(outer_executor));
+    }
+    case PlanType::Aggregation: {
+      auto aggregation_plan = dynamic_cast<const AggregationPlanNode *>(plan.get());
+      auto child_executor = CreateExecutor(exec_ctx, aggregation_plan->GetChildPlan());
+      return std::make_unique<AggregationExecutor>(exec_ctx, aggregation_plan, std::move(child_executor));
+    }
+    case PlanType::MergeJoin: {
+      auto join_plan = dynamic_cast<const MergeJoinPlanNode *>(plan.get());
+      auto left_executor = CreateExecutor(exec_ctx, join_plan->GetLeftPlan());
+      auto right_executor = CreateExecutor(exec_ctx, join_plan->GetRightPlan());
+      return std::make_unique<MergeJoinExecutor>(exec_ctx, join_plan, std::move(left_executor),
+                                                 std::move(right_executor));
+    }
+    case PlanType::Sort: {
+      auto sort_plan = dynamic_cast<const SortPlanNode *>(plan.get());
+      auto child_executor = CreateExecutor(exec_ctx, sort_plan->GetChildPlan());
+      return std::make_unique<SortExecutor>(exec_ctx, sort_plan, std::move(child_executor));
+    }
+    case PlanType::TopN: {
+      auto topn_plan = dynamic_cast<const TopNPlanNode *>(plan.get());
+      auto child_executor = CreateExecutor(exec_ctx, topn_plan->GetChildPlan());
+      return std::make_unique<TopNExecutor>(exec_ctx, topn_plan, std::move(child_executor));
+    }
+    case PlanType::Gather: {
+      auto gather_plan = dynamic_cast<const GatherPlanNode *>(plan.get());
+      return std::make_unique<GatherExecutor>(exec_ctx, gather_plan);
+    }
+    case PlanType::Limit: {
+      auto limit_plan = dynamic_cast<const LimitPlanNode *>(plan.get());
+      auto child_executor = CreateExecutor(exec_ctx, limit_plan->GetChildPlan());
+      return std::make_unique<LimitExecutor>(exec_ctx, limit_plan, std::move(child_executor));
+    }
     // Create a new update executor
     case PlanType::Update: {
       auto update_plan = dynamic_cast<const UpdatePlanNode *>(plan.get());
@@ -83,6 +140,22 @@ std::unique_ptr<AbstractExecutor> ExecuteEngine::CreateExecutor(ExecuteContext *
 
 dberr_t ExecuteEngine::ExecutePlan(const AbstractPlanNodeRef &plan, std::vector<Row> *result_set, Txn *txn,
                                    ExecuteContext *exec_ctx) {
+  auto result = ExecutePlan(
+      plan,
+      [result_set](const Row &row) {
+        if (result_set != nullptr) {
+          result_set->push_back(row);
+        }
+      },
+      txn, exec_ctx);
+  if (result != DB_SUCCESS && result_set != nullptr) {
+    result_set->clear();
+  }
+  return result;
+}
+
+dberr_t ExecuteEngine::ExecutePlan(const AbstractPlanNodeRef &plan, const std::function<void(const Row &)> &sink,
+                                   Txn *txn, ExecuteContext *exec_ctx) {
   // Construct the executor for the abstract plan node
   auto executor = CreateExecutor(exec_ctx, plan);
 
@@ -91,15 +164,10 @@ dberr_t ExecuteEngine::ExecutePlan(const AbstractPlanNodeRef &plan, std::vector<
     RowId rid{};
     Row row{};
     while (executor->Next(&row, &rid)) {
-      if (result_set != nullptr) {
-        result_set->push_back(row);
-      }
+      sink(row);
     }
   } catch (const exception &ex) {
     std::cout << "Error Encountered in Executor Execution: " << ex.what() << std::endl;
-    if (result_set != nullptr) {
-      result_set->clear();
-    }
     return DB_FAILED;
   }
   return DB_SUCCESS;
@@ -112,6 +180,7 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
   auto start_time = std::chrono::system_clock::now();
   unique_ptr<ExecuteContext> context(nullptr);
   if (!current_db_.empty()) context = dbs_[current_db_]->MakeExecuteContext(nullptr);
+  if (context != nullptr) context->SetMaxWorkers(max_workers_);
   switch (ast->type_) {
     case kNodeCreateDB:
       return ExecuteCreateDatabase(ast, context.get());
@@ -148,63 +217,48 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
   }
   // Plan the query.
   Planner planner(context.get());
-  std::vector<Row> result_set{};
   try {
     planner.PlanQuery(ast);
-    // Execute the query.
-    ExecutePlan(planner.plan_, &result_set, nullptr, context.get());
   } catch (const exception &ex) {
     std::cout << "Error Encountered in Planner: " << ex.what() << std::endl;
     return DB_FAILED;
   }
+  // Execute the query, the rows of a select are printed while the executors produce them.
+  bool is_select = ast->type_ == kNodeSelect;
+  size_t row_count = 0;
+  std::unique_ptr<ResultStream> stream;
+  if (is_select) {
+    stream = std::make_unique<ResultStream>(std::cout, planner.plan_->OutputSchema(), result_format_);
+  }
+  dberr_t result;
+  try {
+    result = ExecutePlan(
+        planner.plan_,
+        [&stream, &row_count](const Row &row) {
+          row_count++;
+          if (stream != nullptr) {
+            stream->Push(row);
+          }
+        },
+        nullptr, context.get());
+  } catch (const exception &ex) {
+    std::cout << "Error Encountered in Planner: " << ex.what() << std::endl;
+    if (is_select) {
+      delete planner.plan_->OutputSchema();
+    }
+    return DB_FAILED;
+  }
+  if (stream != nullptr) {
+    stream->Finish();
+  }
   auto stop_time = std::chrono::system_clock::now();
   double duration_time =
       double((std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time)).count());
-  // Return the result set as string.
-  std::stringstream ss;
-  ResultWriter writer(ss);
-
-  if (planner.plan_->GetType() == PlanType::SeqScan || planner.plan_->GetType() == PlanType::IndexScan) {
-    auto schema = planner.plan_->OutputSchema();
-    auto num_of_columns = schema->GetColumnCount();
-    if (!result_set.empty()) {
-      // find the max width for each column
-      vector<int> data_width(num_of_columns, 0);
-      for (const auto &row : result_set) {
-        for (uint32_t i = 0; i < num_of_columns; i++) {
-          data_width[i] = max(data_width[i], int(row.GetField(i)->toString().size()));
-        }
-      }
-      int k = 0;
-      for (const auto &column : schema->GetColumns()) {
-        data_width[k] = max(data_width[k], int(column->GetName().length()));
-        k++;
-      }
-      // Generate header for the result set.
-      writer.Divider(data_width);
-      k = 0;
-      writer.BeginRow();
-      for (const auto &column : schema->GetColumns()) {
-        writer.WriteHeaderCell(column->GetName(), data_width[k++]);
-      }
-      writer.EndRow();
-      writer.Divider(data_width);
-
-      // Transforming result set into strings.
-      for (const auto &row : result_set) {
-        writer.BeginRow();
-        for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
-          writer.WriteCell(row.GetField(i)->toString(), data_width[i]);
-        }
-        writer.EndRow();
-      }
-      writer.Divider(data_width);
-    }
-    writer.EndInformation(result_set.size(), duration_time, true);
-  } else {
-    writer.EndInformation(result_set.size(), duration_time, false);
+  // a failed query may have printed some rows already, but no summary
+  if (result == DB_SUCCESS && (!is_select || result_format_ == ResultFormat::Table)) {
+    ResultWriter writer(std::cout);
+    writer.EndInformation(row_count, duration_time, is_select);
   }
-  std::cout << writer.stream_.rdbuf();
   // todo:: use shared_ptr for schema
   if (ast->type_ == kNodeSelect)
       delete planner.plan_->OutputSchema();
@@ -575,20 +629,29 @@ dberr_t ExecuteEngine::ExecuteCreateIndex(pSyntaxNode ast, ExecuteContext *conte
   vector<string> index_keys;
   pSyntaxNode indexes_list = ast->child_->next_->next_;
   string index_type = "btree";
+  // CONCURRENTLY：扫描堆表时不阻塞写入，写入先记在旁路日志中，扫描结束后合并
+  bool concurrently = ast->val_ != nullptr && strcmp(ast->val_, "concurrently") == 0;
 
   // 得到索引的列名
   for (auto index = indexes_list->child_; index != nullptr; index = index->next_) {
     index_keys.push_back(index->val_);
   }
 
-  // 检查索引的类型
-  if (indexes_list->next_ != nullptr) {
-    index_type = indexes_list->next_->child_->val_;
+  // 检查索引的类型和 include 列
+  vector<string> include_columns;
+  for (auto option = indexes_list->next_; option != nullptr; option = option->next_) {
+    if (option->type_ == kNodeIndexType) {
+      index_type = option->child_->val_;
+    } else if (option->type_ == kNodeIndexInclude) {
+      for (auto column = option->child_; column != nullptr; column = column->next_) {
+        include_columns.push_back(column->val_);
+      }
+    }
   }
 
   //  创建索引
   IndexInfo *index_info;
-  dberr_t result_create_index = context->GetCatalog()->CreateIndex(table_name, index_name, index_keys, context->GetTransaction(), index_info, index_type);
+  dberr_t result_create_index = context->GetCatalog()->CreateIndex(table_name, index_name, index_keys, context->GetTransaction(), index_info, index_type, include_columns, concurrently);
 
   if (result_create_index != DB_SUCCESS) {
     cout << "Create index error" << endl;
@@ -614,11 +677,24 @@ dberr_t ExecuteEngine::ExecuteCreateIndex(pSyntaxNode ast, ExecuteContext *conte
     }
     // 将行插入索引
     Row row_idx(fields);
-    dberr_t result_insert_entry = index_info->GetIndex()->InsertEntry(row_idx, row_id, txn);
+    dberr_t result_insert_entry = concurrently ? index_info->BuildEntry(row_idx, row_id, txn)
+                                               : index_info->GetIndex()->InsertEntry(row_idx, row_id, txn);
     if (result_insert_entry != DB_SUCCESS) {
+      if (concurrently) {
+        // 未完成的索引不能留在catalog中
+        context->GetCatalog()->DropIndex(table_name, index_name);
+      }
       return result_insert_entry;
     }
   }
+  if (concurrently) {
+    // 合并扫描期间的写入，然后索引对查询可见
+    dberr_t result_finish = index_info->FinishConcurrentBuild(txn);
+    if (result_finish != DB_SUCCESS) {
+      context->GetCatalog()->DropIndex(table_name, index_name);
+      return result_finish;
+    }
+  }
   cout<<"index "<<index_name<<" created."<<endl;
   return DB_SUCCESS;
 }
@@ -0,0 +1,167 @@
+#include "executor/executors/gather_executor.h"
+
+#include <algorithm>
+
+GatherExecutor::GatherExecutor(ExecuteContext *exec_ctx, const GatherPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+GatherExecutor::~GatherExecutor() { Stop(); }
+
+void GatherExecutor::Init() {
+  Stop();
+  auto scan_plan = plan_->GetScanPlan();
+  TableInfo *table_info = nullptr;
+  exec_ctx_->GetCatalog()->GetTable(scan_plan->GetTableName(), table_info);
+  QueryScheduler scheduler(plan_->GetDop());
+  // every scan is set up on this thread, the producers only read shared state
+  scans_.clear();
+  for (uint32_t i = 0; i < scheduler.GetWorkerCount(); i++) {
+    scans_.push_back(std::make_unique<SeqScanExecutor>(exec_ctx_, scan_plan));
+    scans_.back()->Init();
+  }
+  source_ = std::make_unique<TableMorselSource>(table_info->GetTableHeap(), exec_ctx_->GetBufferPoolManager());
+  batches_.clear();
+  max_batches_ = std::max<size_t>(1, (scans_.size() - 1) * QUEUED_BATCHES);
+  busy_ = 0;
+  exhausted_ = false;
+  stopped_ = false;
+  error_ = nullptr;
+  batch_.clear();
+  batch_pos_ = 0;
+  producers_ = std::make_unique<TaskGroup>(ThreadPool::GetInstance());
+  for (uint32_t i = 1; i < scans_.size(); i++) {
+    producers_->Submit([this, i]() { Produce(i); });
+  }
+}
+
+bool GatherExecutor::Next(Row *row, RowId *rid) {
+  while (batch_pos_ >= batch_.size()) {
+    std::unique_lock<std::mutex> lock(latch_);
+    if (error_ != nullptr) {
+      std::rethrow_exception(error_);
+    }
+    if (!batches_.empty()) {
+      batch_ = std::move(batches_.front());
+      batches_.pop_front();
+      batch_pos_ = 0;
+      cv_.notify_all();
+      continue;
+    }
+    if (!exhausted_) {
+      // nothing queued, scan a morsel here rather than wait for a producer that may not even have started
+      busy_++;
+      lock.unlock();
+      batch_.clear();
+      batch_pos_ = 0;
+      bool scanned = false;
+      try {
+        scanned = ScanMorsel(scans_[0].get(), [this](Row &scanned_row) {
+          batch_.push_back(std::move(scanned_row));
+          return true;
+        });
+      } catch (...) {
+        lock.lock();
+        busy_--;
+        cv_.notify_all();
+        throw;
+      }
+      lock.lock();
+      busy_--;
+      if (!scanned) {
+        exhausted_ = true;
+      }
+      cv_.notify_all();
+      continue;
+    }
+    if (busy_ == 0) {
+      return false;
+    }
+    cv_.wait(lock);
+  }
+  *row = std::move(batch_[batch_pos_++]);
+  *rid = row->GetRowId();
+  return true;
+}
+
+void GatherExecutor::Produce(uint32_t scan_index) {
+  std::vector<Row> rows;
+  while (true) {
+    {
+      std::lock_guard<std::mutex> guard(latch_);
+      if (stopped_ || exhausted_) {
+        return;
+      }
+      busy_++;
+    }
+    bool scanned = false;
+    bool running = true;
+    try {
+      scanned = ScanMorsel(scans_[scan_index].get(), [this, &rows](Row &row) {
+        rows.push_back(std::move(row));
+        return rows.size() < BATCH_ROWS || Publish(rows);
+      });
+      running = rows.empty() || Publish(rows);
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(latch_);
+      if (error_ == nullptr) {
+        error_ = std::current_exception();
+      }
+      scanned = false;
+      running = false;
+    }
+    std::lock_guard<std::mutex> guard(latch_);
+    busy_--;
+    if (!scanned && error_ == nullptr && !stopped_) {
+      exhausted_ = true;
+    }
+    cv_.notify_all();
+    if (!scanned || !running) {
+      return;
+    }
+  }
+}
+
+bool GatherExecutor::ScanMorsel(SeqScanExecutor *scan, const std::function<bool(Row &)> &emit) {
+  Morsel morsel;
+  if (!source_->NextMorsel(morsel)) {
+    return false;
+  }
+  scan->SetMorsel(morsel);
+  Row row;
+  RowId rid;
+  while (scan->Next(&row, &rid)) {
+    row.SetRowId(rid);
+    if (!emit(row)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool GatherExecutor::Publish(std::vector<Row> &rows) {
+  std::unique_lock<std::mutex> lock(latch_);
+  cv_.wait(lock, [this] { return stopped_ || batches_.size() < max_batches_; });
+  if (stopped_) {
+    return false;
+  }
+  batches_.push_back(std::move(rows));
+  rows.clear();
+  cv_.notify_all();
+  return true;
+}
+
+void GatherExecutor::Stop() {
+  if (producers_ == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> guard(latch_);
+    stopped_ = true;
+  }
+  cv_.notify_all();
+  try {
+    producers_->Wait();
+  } catch (...) {
+  }
+  producers_.reset();
+}
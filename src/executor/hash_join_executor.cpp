@@ -0,0 +1,417 @@
+#include "executor/executors/hash_join_executor.h"
+
+#include <algorithm>
+
+#include "common/hash_util.h"
+
+HashJoinExecutor::HashJoinExecutor(ExecuteContext *exec_ctx, const HashJoinPlanNode *plan,
+                                   std::unique_ptr<AbstractExecutor> &&left_executor,
+                                   std::unique_ptr<AbstractExecutor> &&right_executor)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_executor)),
+      right_executor_(std::move(right_executor)) {}
+
+HashJoinExecutor::~HashJoinExecutor() { DropPartitions(); }
+
+bool HashJoinExecutor::MakeKey(int side, Row &&row, KeyedRow &keyed) const {
+  const auto &keys = side == 0 ? plan_->GetLeftKeys() : plan_->GetRightKeys();
+  keyed.key_.clear();
+  for (const auto &key : keys) {
+    Field field = key->Evaluate(&row);
+    if (field.IsNull()) {
+      return false;
+    }
+    size_t offset = keyed.key_.size();
+    keyed.key_.resize(offset + field.GetSerializedSize());
+    if (field.GetTypeId() == TypeId::kTypeFloat) {
+      Field(TypeId::kTypeFloat, HashUtil::NormalizeFloat(field.GetFloatValue())).SerializeTo(&keyed.key_[offset]);
+    } else {
+      field.SerializeTo(&keyed.key_[offset]);
+    }
+  }
+  keyed.hash_ = HashUtil::Murmur3_64(keyed.key_.data(), keyed.key_.size());
+  keyed.row_ = std::move(row);
+  return true;
+}
+
+uint32_t HashJoinExecutor::PartitionOf(const KeyedRow &keyed, uint32_t level) {
+  if (level == 0) {
+    return (keyed.hash_ >> 32) % PARTITION_COUNT;
+  }
+  // rows of one partition agree on the bits above, a split needs a hash independent of them
+  return HashUtil::Murmur3(keyed.key_.data(), keyed.key_.size(), REPARTITION_SEED + level) % PARTITION_COUNT;
+}
+
+uint64_t HashJoinExecutor::RowBytes(const Row &row) {
+  uint64_t bytes = sizeof(Row);
+  for (uint32_t i = 0; i < row.GetFieldCount(); i++) {
+    bytes += sizeof(Field) + row.GetField(i)->GetSerializedSize();
+  }
+  return bytes;
+}
+
+void HashJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  DropPartitions();
+  slots_.clear();
+  build_rows_.clear();
+  next_.clear();
+  probe_rows_.clear();
+  probe_cursor_ = 0;
+  probe_pages_.clear();
+  probe_page_cursor_ = 0;
+  probe_child_ = nullptr;
+  partitioned_ = false;
+  resident_bytes_ = 0;
+  next_partition_ = 0;
+  output_.clear();
+  output_cursor_ = 0;
+  // read both sides in turns, the side that ends first is the smaller one
+  std::vector<KeyedRow> staged[2];
+  bool exhausted[2] = {false, false};
+  uint64_t staged_bytes = 0;
+  uint64_t budget = plan_->GetMemoryBudget();
+  while (!exhausted[0] && !exhausted[1] && staged_bytes <= budget) {
+    for (int side = 0; side < 2; side++) {
+      Row row;
+      RowId rid;
+      if (!Child(side)->Next(&row, &rid)) {
+        exhausted[side] = true;
+        continue;
+      }
+      KeyedRow keyed;
+      if (MakeKey(side, std::move(row), keyed)) {
+        staged_bytes += RowBytes(keyed.row_);
+        staged[side].push_back(std::move(keyed));
+      }
+    }
+  }
+  if (exhausted[0] || exhausted[1]) {
+    build_side_ = exhausted[1] ? 1 : 0;
+    Build(std::move(staged[build_side_]));
+    probe_rows_ = std::move(staged[1 - build_side_]);
+    probe_child_ = exhausted[1 - build_side_] ? nullptr : Child(1 - build_side_);
+    return;
+  }
+  // neither side fits, partition both of them
+  partitioned_ = true;
+  for (auto &partitions : partitions_) {
+    partitions.resize(PARTITION_COUNT);
+  }
+  for (int side = 0; side < 2; side++) {
+    for (auto &keyed : staged[side]) {
+      AddToPartition(side, std::move(keyed), 0, 0);
+    }
+    staged[side].clear();
+    Row row;
+    RowId rid;
+    while (Child(side)->Next(&row, &rid)) {
+      KeyedRow keyed;
+      if (MakeKey(side, std::move(row), keyed)) {
+        AddToPartition(side, std::move(keyed), 0, 0);
+      }
+    }
+  }
+  for (auto &partitions : partitions_) {
+    for (auto &partition : partitions) {
+      FlushBuffer(partition);
+    }
+  }
+  NextPartition();
+}
+
+void HashJoinExecutor::Build(std::vector<KeyedRow> &&rows) {
+  build_rows_ = std::move(rows);
+  next_.assign(build_rows_.size(), 0);
+  // keep the load factor at or below one half
+  size_t capacity = 16;
+  while (capacity < build_rows_.size() * 2) {
+    capacity <<= 1;
+  }
+  slots_.assign(capacity, Slot{0, 0});
+  size_t mask = capacity - 1;
+  for (uint32_t i = 0; i < build_rows_.size(); i++) {
+    const KeyedRow &keyed = build_rows_[i];
+    for (size_t pos = keyed.hash_ & mask;; pos = (pos + 1) & mask) {
+      Slot &slot = slots_[pos];
+      if (slot.head_ == 0) {
+        slot = Slot{keyed.hash_, i + 1};
+        break;
+      }
+      if (slot.hash_ == keyed.hash_ && build_rows_[slot.head_ - 1].key_ == keyed.key_) {
+        next_[i] = slot.head_;
+        slot.head_ = i + 1;
+        break;
+      }
+    }
+  }
+}
+
+bool HashJoinExecutor::NextProbeRow(KeyedRow &keyed) {
+  while (probe_cursor_ == probe_rows_.size()) {
+    if (probe_page_cursor_ == probe_pages_.size()) {
+      break;
+    }
+    probe_rows_.clear();
+    probe_cursor_ = 0;
+    LoadPage(1 - build_side_, probe_pages_[probe_page_cursor_++], probe_rows_);
+  }
+  if (probe_cursor_ < probe_rows_.size()) {
+    keyed = std::move(probe_rows_[probe_cursor_++]);
+    return true;
+  }
+  Row row;
+  RowId rid;
+  while (probe_child_ != nullptr && probe_child_->Next(&row, &rid)) {
+    if (MakeKey(1 - build_side_, std::move(row), keyed)) {
+      return true;
+    }
+  }
+  probe_child_ = nullptr;
+  return false;
+}
+
+bool HashJoinExecutor::ProbeBatch() {
+  KeyedRow batch[PROBE_BATCH_SIZE];
+  uint32_t count = 0;
+  while (count < PROBE_BATCH_SIZE && NextProbeRow(batch[count])) {
+    count++;
+  }
+  if (count == 0) {
+    return false;
+  }
+  if (slots_.empty()) {
+    return true;
+  }
+  size_t mask = slots_.size() - 1;
+  for (uint32_t i = 0; i < count; i++) {
+    __builtin_prefetch(&slots_[batch[i].hash_ & mask]);
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    const KeyedRow &probe = batch[i];
+    for (size_t pos = probe.hash_ & mask; slots_[pos].head_ != 0; pos = (pos + 1) & mask) {
+      const Slot &slot = slots_[pos];
+      if (slot.hash_ != probe.hash_ || build_rows_[slot.head_ - 1].key_ != probe.key_) {
+        continue;
+      }
+      for (uint32_t head = slot.head_; head != 0; head = next_[head - 1]) {
+        Emit(build_rows_[head - 1].row_, probe.row_);
+      }
+      break;
+    }
+  }
+  return true;
+}
+
+void HashJoinExecutor::Emit(const Row &build_row, const Row &probe_row) {
+  const Row &left = build_side_ == 0 ? build_row : probe_row;
+  const Row &right = build_side_ == 0 ? probe_row : build_row;
+  auto predicate = plan_->GetPredicate();
+  if (predicate != nullptr && !predicate->EvaluateJoin(&left, &right).CompareEquals(Field(kTypeInt, 1))) {
+    return;
+  }
+  uint32_t left_count = left.GetFieldCount();
+  std::vector<Field> fields;
+  fields.reserve(GetOutputSchema()->GetColumnCount());
+  for (auto column : GetOutputSchema()->GetColumns()) {
+    uint32_t idx = column->GetTableInd();
+    fields.emplace_back(idx < left_count ? *left.GetField(idx) : *right.GetField(idx - left_count));
+  }
+  output_.emplace_back(fields);
+}
+
+bool HashJoinExecutor::Next(Row *row, RowId * /*rid*/) {
+  while (true) {
+    if (output_cursor_ < output_.size()) {
+      *row = output_[output_cursor_++];
+      return true;
+    }
+    output_.clear();
+    output_cursor_ = 0;
+    if (!ProbeBatch() && (!partitioned_ || !NextPartition())) {
+      return false;
+    }
+  }
+}
+
+void HashJoinExecutor::AddToPartition(int side, KeyedRow &&keyed, uint32_t base, uint32_t level) {
+  Partition &partition = partitions_[side][base + PartitionOf(keyed, level)];
+  uint64_t bytes = RowBytes(keyed.row_);
+  partition.total_bytes_ += bytes;
+  if (partition.spilled_) {
+    SpillRow(partition, side, keyed.row_);
+    return;
+  }
+  partition.rows_.push_back(std::move(keyed));
+  partition.resident_bytes_ += bytes;
+  resident_bytes_ += bytes;
+  // the highest partitions go to pages first, the lowest ones stay in memory as long as possible, the ones
+  // already joined are empty
+  uint64_t budget = plan_->GetMemoryBudget();
+  for (uint32_t victim = partitions_[0].size(); resident_bytes_ > budget && victim-- > next_partition_;) {
+    Spill(victim);
+  }
+}
+
+void HashJoinExecutor::Spill(uint32_t index) {
+  for (int side = 0; side < 2; side++) {
+    Partition &partition = partitions_[side][index];
+    partition.spilled_ = true;
+    for (const auto &keyed : partition.rows_) {
+      SpillRow(partition, side, keyed.row_);
+    }
+    partition.rows_.clear();
+    partition.rows_.shrink_to_fit();
+    resident_bytes_ -= partition.resident_bytes_;
+    partition.resident_bytes_ = 0;
+  }
+}
+
+void HashJoinExecutor::SpillRow(Partition &partition, int side, const Row &row) {
+  auto schema = const_cast<Schema *>(Child(side)->GetOutputSchema());
+  uint32_t size = row.GetSerializedSize(schema);
+  if (2 * sizeof(uint32_t) + size > PAGE_SIZE) {
+    throw std::runtime_error("a row of " + std::to_string(size) + " bytes is too large to spill in a hash join");
+  }
+  if (partition.buffer_ == nullptr) {
+    partition.buffer_ = std::make_unique<char[]>(PAGE_SIZE);
+    partition.buffer_size_ = sizeof(uint32_t);
+  }
+  if (partition.buffer_size_ + sizeof(uint32_t) + size > PAGE_SIZE) {
+    FlushBuffer(partition);
+  }
+  char *buf = partition.buffer_.get() + partition.buffer_size_;
+  MACH_WRITE_UINT32(buf, size);
+  row.SerializeTo(buf + sizeof(uint32_t), schema);
+  partition.buffer_size_ += sizeof(uint32_t) + size;
+  partition.buffer_count_++;
+}
+
+void HashJoinExecutor::FlushBuffer(Partition &partition) {
+  if (partition.buffer_count_ == 0) {
+    return;
+  }
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  page_id_t page_id;
+  Page *page = bpm->NewPage(page_id);
+  if (page == nullptr) {
+    throw std::runtime_error("no free frame for a hash join partition page");
+  }
+  MACH_WRITE_UINT32(partition.buffer_.get(), partition.buffer_count_);
+  memcpy(page->GetData(), partition.buffer_.get(), PAGE_SIZE);
+  bpm->UnpinPage(page_id, true);
+  partition.pages_.push_back(page_id);
+  partition.buffer_size_ = sizeof(uint32_t);
+  partition.buffer_count_ = 0;
+}
+
+void HashJoinExecutor::LoadPage(int side, page_id_t page_id, std::vector<KeyedRow> &rows) {
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  Page *page = bpm->FetchPage(page_id);
+  if (page == nullptr) {
+    throw std::runtime_error("no free frame for a hash join partition page");
+  }
+  auto schema = const_cast<Schema *>(Child(side)->GetOutputSchema());
+  char *buf = page->GetData();
+  uint32_t count = MACH_READ_UINT32(buf);
+  uint32_t offset = sizeof(uint32_t);
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t size = MACH_READ_UINT32(buf + offset);
+    Row row;
+    row.DeserializeFrom(buf + offset + sizeof(uint32_t), schema);
+    offset += sizeof(uint32_t) + size;
+    KeyedRow keyed;
+    MakeKey(side, std::move(row), keyed);
+    rows.push_back(std::move(keyed));
+  }
+  bpm->UnpinPage(page_id, false);
+  bpm->DeletePage(page_id);
+}
+
+bool HashJoinExecutor::NextPartition() {
+  while (next_partition_ < partitions_[0].size()) {
+    uint32_t index = next_partition_++;
+    Partition &left = partitions_[0][index];
+    Partition &right = partitions_[1][index];
+    if (left.total_bytes_ == 0 || right.total_bytes_ == 0) {
+      continue;
+    }
+    build_side_ = left.total_bytes_ < right.total_bytes_ ? 0 : 1;
+    if (std::min(left.total_bytes_, right.total_bytes_) > plan_->GetMemoryBudget() &&
+        left.level_ < MAX_REPARTITION_LEVEL) {
+      Repartition(index);
+      continue;
+    }
+    Partition &build = partitions_[build_side_][index];
+    Partition &probe = partitions_[1 - build_side_][index];
+    // the rows now belong to the join of this partition, the budget is left to the partitions still waiting
+    resident_bytes_ -= build.resident_bytes_ + probe.resident_bytes_;
+    build.resident_bytes_ = 0;
+    probe.resident_bytes_ = 0;
+    std::vector<KeyedRow> rows = std::move(build.rows_);
+    for (auto page_id : build.pages_) {
+      LoadPage(build_side_, page_id, rows);
+    }
+    build.pages_.clear();
+    Build(std::move(rows));
+    probe_rows_ = std::move(probe.rows_);
+    probe_cursor_ = 0;
+    probe_pages_ = std::move(probe.pages_);
+    probe.pages_.clear();
+    probe_page_cursor_ = 0;
+    return true;
+  }
+  DropPartitions();
+  return false;
+}
+
+void HashJoinExecutor::Repartition(uint32_t index) {
+  uint32_t base = partitions_[0].size();
+  uint32_t level = partitions_[0][index].level_ + 1;
+  for (auto &partitions : partitions_) {
+    partitions.resize(base + PARTITION_COUNT);
+    for (uint32_t i = base; i < partitions.size(); i++) {
+      partitions[i].level_ = level;
+    }
+  }
+  for (int side = 0; side < 2; side++) {
+    std::vector<KeyedRow> rows = std::move(partitions_[side][index].rows_);
+    std::vector<page_id_t> pages = std::move(partitions_[side][index].pages_);
+    resident_bytes_ -= partitions_[side][index].resident_bytes_;
+    partitions_[side][index] = Partition();
+    for (auto &keyed : rows) {
+      AddToPartition(side, std::move(keyed), base, level);
+    }
+    rows.clear();
+    for (auto page_id : pages) {
+      LoadPage(side, page_id, rows);
+      for (auto &keyed : rows) {
+        AddToPartition(side, std::move(keyed), base, level);
+      }
+      rows.clear();
+    }
+  }
+  for (auto &partitions : partitions_) {
+    for (uint32_t i = base; i < partitions.size(); i++) {
+      FlushBuffer(partitions[i]);
+    }
+  }
+}
+
+void HashJoinExecutor::DropPartitions() {
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  for (; probe_page_cursor_ < probe_pages_.size(); probe_page_cursor_++) {
+    bpm->DeletePage(probe_pages_[probe_page_cursor_]);
+  }
+  for (auto &partitions : partitions_) {
+    for (auto &partition : partitions) {
+      for (auto page_id : partition.pages_) {
+        bpm->DeletePage(page_id);
+      }
+    }
+    partitions.clear();
+  }
+  resident_bytes_ = 0;
+}
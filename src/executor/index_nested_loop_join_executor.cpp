@@ -0,0 +1,143 @@
+#include "executor/executors/index_nested_loop_join_executor.h"
+
+#include <algorithm>
+
+IndexNestedLoopJoinExecutor::IndexNestedLoopJoinExecutor(ExecuteContext *exec_ctx,
+                                                         const IndexNestedLoopJoinPlanNode *plan,
+                                                         std::unique_ptr<AbstractExecutor> &&outer_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), outer_executor_(std::move(outer_executor)) {}
+
+void IndexNestedLoopJoinExecutor::Init() {
+  outer_executor_->Init();
+  outer_done_ = false;
+  exec_ctx_->GetCatalog()->GetTable(plan_->GetInnerTableName(), inner_table_);
+  output_.clear();
+  output_cursor_ = 0;
+  entry_positions_.clear();
+  if (plan_->index_only_) {
+    const auto &key_columns = plan_->GetInnerIndex()->GetIndexKeySchema()->GetColumns();
+    for (auto column : inner_table_->GetSchema()->GetColumns()) {
+      auto it = std::find_if(key_columns.begin(), key_columns.end(), [column](const Column *key_column) {
+        return key_column->GetTableInd() == column->GetTableInd();
+      });
+      entry_positions_.push_back(it == key_columns.end() ? -1 : static_cast<int>(it - key_columns.begin()));
+    }
+  }
+}
+
+bool IndexNestedLoopJoinExecutor::Next(Row *row, RowId * /*rid*/) {
+  while (output_cursor_ == output_.size()) {
+    output_.clear();
+    output_cursor_ = 0;
+    if (!JoinBatch()) {
+      return false;
+    }
+  }
+  *row = std::move(output_[output_cursor_++]);
+  return true;
+}
+
+bool IndexNestedLoopJoinExecutor::JoinBatch() {
+  if (outer_done_) {
+    return false;
+  }
+  std::vector<OuterRow> batch;
+  batch.reserve(OUTER_BATCH_SIZE);
+  Row row;
+  RowId rid;
+  while (batch.size() < OUTER_BATCH_SIZE) {
+    if (!outer_executor_->Next(&row, &rid)) {
+      outer_done_ = true;
+      break;
+    }
+    std::vector<Field> fields;
+    bool has_null = false;
+    for (const auto &key : plan_->GetOuterKeys()) {
+      fields.emplace_back(key->Evaluate(&row));
+      has_null = has_null || fields.back().IsNull();
+    }
+    if (!has_null) {
+      batch.push_back(OuterRow{Row(fields), std::move(row)});
+    }
+  }
+  if (batch.empty()) {
+    return !outer_done_;
+  }
+  // equal keys end up next to each other and the probes walk the index in key order
+  auto compare = [](const OuterRow &lhs, const OuterRow &rhs) {
+    for (uint32_t i = 0; i < lhs.key_.GetFieldCount(); i++) {
+      if (lhs.key_.GetField(i)->CompareLessThan(*rhs.key_.GetField(i)) == CmpBool::kTrue) {
+        return true;
+      }
+      if (rhs.key_.GetField(i)->CompareLessThan(*lhs.key_.GetField(i)) == CmpBool::kTrue) {
+        return false;
+      }
+    }
+    return false;
+  };
+  std::stable_sort(batch.begin(), batch.end(), compare);
+  std::vector<Row> inner_rows;
+  for (size_t begin = 0, end; begin < batch.size(); begin = end) {
+    end = begin + 1;
+    while (end < batch.size() && !compare(batch[begin], batch[end])) {
+      end++;
+    }
+    inner_rows.clear();
+    Probe(batch[begin].key_, inner_rows);
+    for (size_t i = begin; i < end; i++) {
+      for (const auto &inner_row : inner_rows) {
+        Emit(batch[i].row_, inner_row);
+      }
+    }
+  }
+  return true;
+}
+
+void IndexNestedLoopJoinExecutor::Probe(const Row &key, std::vector<Row> &inner_rows) {
+  auto txn = exec_ctx_->GetTransaction();
+  auto cursor = plan_->GetInnerIndex()->GetIndex()->Scan(&key, true, &key, true, txn);
+  if (cursor == nullptr) {
+    return;
+  }
+  auto inner_predicate = plan_->GetInnerPredicate();
+  RowId rid;
+  Row entry;
+  while (plan_->index_only_ ? cursor->NextEntry(rid, entry) : cursor->Next(rid)) {
+    Row inner_row(rid);
+    if (plan_->index_only_) {
+      const auto &columns = inner_table_->GetSchema()->GetColumns();
+      std::vector<Field> fields;
+      fields.reserve(columns.size());
+      for (uint32_t i = 0; i < columns.size(); i++) {
+        if (entry_positions_[i] < 0) {
+          fields.emplace_back(columns[i]->GetType());
+        } else {
+          fields.emplace_back(*entry.GetField(entry_positions_[i]));
+        }
+      }
+      inner_row = Row(fields);
+      inner_row.SetRowId(rid);
+    } else if (!inner_table_->GetTableHeap()->GetTuple(&inner_row, txn)) {
+      continue;
+    }
+    if (inner_predicate != nullptr && !inner_predicate->Evaluate(&inner_row).CompareEquals(Field(kTypeInt, 1))) {
+      continue;
+    }
+    inner_rows.push_back(std::move(inner_row));
+  }
+}
+
+void IndexNestedLoopJoinExecutor::Emit(const Row &outer_row, const Row &inner_row) {
+  auto predicate = plan_->GetPredicate();
+  if (predicate != nullptr && !predicate->EvaluateJoin(&outer_row, &inner_row).CompareEquals(Field(kTypeInt, 1))) {
+    return;
+  }
+  uint32_t outer_count = outer_row.GetFieldCount();
+  std::vector<Field> fields;
+  fields.reserve(GetOutputSchema()->GetColumnCount());
+  for (auto column : GetOutputSchema()->GetColumns()) {
+    uint32_t idx = column->GetTableInd();
+    fields.emplace_back(idx < outer_count ? *outer_row.GetField(idx) : *inner_row.GetField(idx - outer_count));
+  }
+  output_.emplace_back(fields);
+}
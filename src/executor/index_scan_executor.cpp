@@ -1,18 +1,128 @@
 #include "executor/executors/index_scan_executor.h"
 
-class RowidCompare {
- public:
-  bool operator()(RowId rid1, RowId rid2) { return rid1.Get() < rid2.Get(); }
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * Comparisons of the predicate that bound a leftmost prefix of an index key:
+ * equalities on the leading key columns and an optional range on the next one.
+ */
+struct ScanRange {
+  IndexInfo *index{nullptr};
+  vector<ComparisonExpression *> points;
+  ComparisonExpression *lower{nullptr};
+  ComparisonExpression *upper{nullptr};
+  ComparisonExpression *not_equal{nullptr};
+  /** a like pattern with a literal prefix, bounds the range [prefix, prefix with its last character incremented) */
+  ComparisonExpression *like{nullptr};
+  /** an in list, one point lookup per value */
+  ComparisonExpression *in_list{nullptr};
 };
 
+/**
+ * Build a search key over the leading key columns from the constant sides of the equalities,
+ * followed by the one of bound if any.
+ * @return nullptr if the key would fix no column at all
+ */
+static std::unique_ptr<Row> MakeKey(const vector<ComparisonExpression *> &points, ComparisonExpression *bound) {
+  vector<Field> fields;
+  for (auto comparison : points) {
+    fields.emplace_back(comparison->GetChildAt(1)->Evaluate(nullptr));
+  }
+  if (bound != nullptr) {
+    fields.emplace_back(bound->GetChildAt(1)->Evaluate(nullptr));
+  }
+  if (fields.empty()) {
+    return nullptr;
+  }
+  return std::make_unique<Row>(fields);
+}
+
+/**
+ * Build a search key from the equalities followed by a char field holding text.
+ */
+static std::unique_ptr<Row> MakeKey(const vector<ComparisonExpression *> &points, const std::string &text) {
+  vector<Field> fields;
+  for (auto comparison : points) {
+    fields.emplace_back(comparison->GetChildAt(1)->Evaluate(nullptr));
+  }
+  fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(text.data()), text.size(), true);
+  return std::make_unique<Row>(fields);
+}
+
+/**
+ * @return the literal prefix of the pattern of a like comparison
+ */
+static std::string LikePrefixOf(ComparisonExpression *comparison) {
+  Field pattern = comparison->GetChildAt(1)->Evaluate(nullptr);
+  if (pattern.IsNull()) {
+    return "";
+  }
+  return ComparisonExpression::LikePrefix(pattern.GetData(), pattern.GetLength());
+}
+
+/**
+ * @return the non null values of an in list in ascending order without duplicates
+ */
+static std::vector<Field> DistinctValuesOf(ComparisonExpression *in_list) {
+  std::vector<Field> values;
+  for (size_t i = 1; i < in_list->GetChildren().size(); i++) {
+    Field value = in_list->GetChildAt(i)->Evaluate(nullptr);
+    if (!value.IsNull()) {
+      values.emplace_back(value);
+    }
+  }
+  std::vector<size_t> order(values.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&values](size_t lhs, size_t rhs) {
+    return values[lhs].CompareLessThan(values[rhs]) == CmpBool::kTrue;
+  });
+  std::vector<Field> distinct;
+  for (size_t i : order) {
+    if (distinct.empty() || distinct.back().CompareEquals(values[i]) != CmpBool::kTrue) {
+      distinct.emplace_back(values[i]);
+    }
+  }
+  return distinct;
+}
+
+static uint32_t ColumnOf(ComparisonExpression *comparison) {
+  return dynamic_pointer_cast<ColumnValueExpression>(comparison->GetChildAt(0))->GetColIdx();
+}
+
+/**
+ * @return true if the constant of lhs is a tighter bound than the one of rhs
+ */
+static bool TighterBound(ComparisonExpression *lhs, ComparisonExpression *rhs, bool lower) {
+  if (rhs == nullptr) {
+    return true;
+  }
+  Field l = lhs->GetChildAt(1)->Evaluate(nullptr);
+  Field r = rhs->GetChildAt(1)->Evaluate(nullptr);
+  if (l.CompareEquals(r) == CmpBool::kTrue) {
+    // an exclusive bound is tighter than an inclusive one on the same key
+    return lhs->GetComparisonType().size() == 1;
+  }
+  return lower ? l.CompareGreaterThan(r) == CmpBool::kTrue : l.CompareLessThan(r) == CmpBool::kTrue;
+}
+
 IndexScanExecutor::IndexScanExecutor(ExecuteContext *exec_ctx, const IndexScanPlanNode *plan)
     : AbstractExecutor(exec_ctx), plan_(plan) {}
 
 void IndexScanExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
-  auto first_row = table_info_->GetTableHeap()->Begin(nullptr);
-  result_ = IndexScan(plan_->GetPredicate());
   is_schema_same_ = SchemaEqual(table_info_->GetSchema(), plan_->OutputSchema());
+  if (plan_->index_only_) {
+    // where each table column sits in the index entry, -1 if the index does not carry it
+    entry_positions_.assign(table_info_->GetSchema()->GetColumnCount(), -1);
+    const auto &index_columns = plan_->indexes_[0]->GetIndexKeySchema()->GetColumns();
+    for (uint32_t i = 0; i < index_columns.size(); i++) {
+      entry_positions_[index_columns[i]->GetTableInd()] = static_cast<int>(i);
+    }
+  }
+  OpenCursors();
 }
 
 bool IndexScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *output_schema) {
@@ -44,65 +154,221 @@ void IndexScanExecutor::TupleTransfer(const Schema *table_schema, const Schema *
   *output_row = Row(dest_row);
 }
 
-vector<RowId> IndexScanExecutor::IndexScan(AbstractExpressionRef predicate) {
-  switch (predicate->GetType()) {
-    case ExpressionType::LogicExpression: {
-      vector<RowId> lhs = IndexScan(predicate->GetChildAt(0));
-      vector<RowId> rhs = IndexScan(predicate->GetChildAt(1));
-      // The function cannot differentiate between the case where the number of rows that
-      // meet the criteria in the indexed column is zero and the case where the column is
-      // not indexed. Writing it this way will ignore the filtering effect brought about
-      // by having zero rows that meet the criteria in the indexed column.
-      if (plan_->need_filter_) {
-        if (lhs.empty()) return rhs;
-        if (rhs.empty()) return lhs;
+void IndexScanExecutor::OpenCursors() {
+  cursors_.clear();
+  cursor_ = 0;
+  vector<ComparisonExpression *> conjuncts;
+  LogicExpression::CollectConjuncts(plan_->GetPredicate(), conjuncts);
+  auto txn = exec_ctx_->GetTransaction();
+  for (auto index : plan_->indexes_) {
+    if (!index->IsFullTextIndex()) {
+      continue;
+    }
+    // the rows holding every token of a match(...) on the indexed column
+    uint32_t key_col = index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
+    for (auto comparison : conjuncts) {
+      if (ColumnOf(comparison) == key_col && comparison->GetComparisonType() == "match") {
+        auto key = MakeKey({comparison}, nullptr);
+        vector<RowId> result;
+        index->GetIndex()->ScanKey(*key, result, txn, "match");
+        cursors_.emplace_back(std::make_unique<MaterializedScanIterator>(std::move(result)));
+        return;
       }
-      sort(lhs.begin(), lhs.end(), RowidCompare());
-      sort(rhs.begin(), rhs.end(), RowidCompare());
-      vector<RowId> result;
-      set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), back_inserter(result), RowidCompare());
-      return result;
-    }
-    case ExpressionType::ComparisonExpression: {
-      std::vector<RowId> ret;
-      std::vector<Field> fields{predicate->GetChildAt(1)->Evaluate(nullptr)};
-      Row key(fields);
-      for (auto index : plan_->indexes_) {
-        uint32_t col_idx = dynamic_pointer_cast<ColumnValueExpression>(predicate->GetChildAt(0))->GetColIdx();
-        if (col_idx == index->GetIndexKeySchema()->GetColumn(0)->GetTableInd()) {
-          index->GetIndex()->ScanKey(key, ret, nullptr,
-                                     dynamic_pointer_cast<ComparisonExpression>(predicate)->GetComparisonType());
+    }
+  }
+  // every equality on a leading key column narrows the scan, then a point lookup on the whole key
+  // beats a bounded range, a like prefix or an in list on the next column, which beats a half open range and "<>"
+  ScanRange best;
+  int best_rank = 0;
+  for (auto index : plan_->indexes_) {
+    if (index->IsFullTextIndex()) {
+      continue;
+    }
+    ScanRange range;
+    range.index = index;
+    auto key_schema = index->GetIndexKeySchema();
+    uint32_t key_count = index->GetKeyColumnCount();
+    for (uint32_t i = 0; i < key_count && range.points.size() == i; i++) {
+      uint32_t key_col = key_schema->GetColumn(i)->GetTableInd();
+      for (auto comparison : conjuncts) {
+        if (ColumnOf(comparison) == key_col && comparison->GetComparisonType() == "=") {
+          range.points.push_back(comparison);
           break;
         }
       }
-      return ret;
     }
-    default:
-      break;
+    bool full_key = range.points.size() == key_count;
+    if (!full_key) {
+      uint32_t key_col = key_schema->GetColumn(range.points.size())->GetTableInd();
+      for (auto comparison : conjuncts) {
+        if (ColumnOf(comparison) != key_col) {
+          continue;
+        }
+        auto compare_operator = comparison->GetComparisonType();
+        if (compare_operator == ">" || compare_operator == ">=") {
+          if (TighterBound(comparison, range.lower, true)) range.lower = comparison;
+        } else if (compare_operator == "<" || compare_operator == "<=") {
+          if (TighterBound(comparison, range.upper, false)) range.upper = comparison;
+        } else if (compare_operator == "<>") {
+          range.not_equal = comparison;
+        } else if (compare_operator == "like" && !LikePrefixOf(comparison).empty()) {
+          range.like = comparison;
+        } else if (compare_operator == "in") {
+          range.in_list = comparison;
+        }
+      }
+    }
+    // an in list on the last key column is a batch of point lookups on the whole key
+    bool in_full_key = range.in_list != nullptr && range.points.size() + 1 == key_count;
+    if (index->IsHashIndex() && !full_key && !in_full_key) {
+      // hash indexes only answer equality probes on the whole key
+      continue;
+    }
+    int rank = static_cast<int>(range.points.size()) * 8;
+    if (full_key || in_full_key) {
+      rank += 4;
+    } else if ((range.lower != nullptr && range.upper != nullptr) || range.like != nullptr ||
+               range.in_list != nullptr) {
+      rank += 3;
+    } else if (range.lower != nullptr || range.upper != nullptr) {
+      rank += 2;
+    } else if (range.not_equal != nullptr) {
+      rank += 1;
+    }
+    // on a tie a hash probe touches fewer pages than a tree descent
+    if (rank > best_rank || (rank == best_rank && rank > 0 && index->IsHashIndex())) {
+      best_rank = rank;
+      best = range;
+    }
+  }
+  if (best.index != nullptr) {
+    Index *index = best.index->GetIndex();
+    if (best.in_list != nullptr) {
+      std::vector<Row> keys;
+      for (auto &value : DistinctValuesOf(best.in_list)) {
+        vector<Field> fields;
+        for (auto comparison : best.points) {
+          fields.emplace_back(comparison->GetChildAt(1)->Evaluate(nullptr));
+        }
+        fields.emplace_back(value);
+        keys.emplace_back(fields);
+      }
+      if (keys.empty()) {
+        // no value can match, keep the scan from falling back to the whole index
+        cursors_.emplace_back(std::make_unique<MaterializedScanIterator>(vector<RowId>{}));
+      } else if (plan_->index_only_) {
+        // covering scans need the entries, which only the range cursors hand out
+        for (const auto &key : keys) {
+          cursors_.emplace_back(index->Scan(&key, true, &key, true, txn));
+        }
+      } else {
+        // the values are distinct, so every row is produced once
+        vector<RowId> result;
+        if (index->ScanKeys(keys, result, txn) != DB_FAILED) {
+          cursors_.emplace_back(std::make_unique<MaterializedScanIterator>(std::move(result)));
+        }
+      }
+    } else if (best.like != nullptr && best.lower == nullptr && best.upper == nullptr) {
+      // every string starting with the prefix sorts before the prefix with its last character incremented,
+      // trailing 0xff characters can not be incremented and are dropped
+      std::string prefix = LikePrefixOf(best.like);
+      std::string limit = prefix;
+      while (!limit.empty() && static_cast<uint8_t>(limit.back()) == 0xff) {
+        limit.pop_back();
+      }
+      auto lower = MakeKey(best.points, prefix);
+      if (limit.empty()) {
+        auto upper = MakeKey(best.points, nullptr);
+        cursors_.emplace_back(index->Scan(lower.get(), true, upper.get(), true, txn));
+      } else {
+        limit.back() = static_cast<char>(static_cast<uint8_t>(limit.back()) + 1);
+        auto upper = MakeKey(best.points, limit);
+        cursors_.emplace_back(index->Scan(lower.get(), true, upper.get(), false, txn));
+      }
+    } else if (best.not_equal != nullptr && best.lower == nullptr && best.upper == nullptr) {
+      // the two ranges around the key, both still within the equality prefix
+      auto prefix = MakeKey(best.points, nullptr);
+      auto key = MakeKey(best.points, best.not_equal);
+      cursors_.emplace_back(index->Scan(prefix.get(), true, key.get(), false, txn));
+      cursors_.emplace_back(index->Scan(key.get(), false, prefix.get(), true, txn));
+    } else if (best.lower != nullptr || best.upper != nullptr) {
+      auto lower = MakeKey(best.points, best.lower);
+      auto upper = MakeKey(best.points, best.upper);
+      cursors_.emplace_back(index->Scan(lower.get(), best.lower == nullptr || best.lower->GetComparisonType() == ">=",
+                                        upper.get(), best.upper == nullptr || best.upper->GetComparisonType() == "<=",
+                                        txn));
+    } else {
+      auto key = MakeKey(best.points, nullptr);
+      cursors_.emplace_back(index->Scan(key.get(), true, key.get(), true, txn));
+    }
+  }
+  // no usable range, walk a whole ordered index instead
+  if (cursors_.empty() || cursors_.front() == nullptr) {
+    cursors_.clear();
+    for (auto index : plan_->indexes_) {
+      if (index->IsHashIndex()) {
+        continue;
+      }
+      // a full-text index can not be walked, it answers nullptr
+      auto cursor = index->GetIndex()->Scan(nullptr, false, nullptr, false, txn);
+      if (cursor != nullptr) {
+        cursors_.emplace_back(std::move(cursor));
+        break;
+      }
+    }
+    if (cursors_.empty()) {
+      throw std::logic_error("no index of " + plan_->GetTableName() + " can be scanned as a whole");
+    }
   }
 }
 
+bool IndexScanExecutor::NextRowId(RowId &rid, Row *entry) {
+  while (cursor_ < cursors_.size()) {
+    if (cursors_[cursor_] != nullptr &&
+        (entry == nullptr ? cursors_[cursor_]->Next(rid) : cursors_[cursor_]->NextEntry(rid, *entry))) {
+      return true;
+    }
+    cursor_++;
+  }
+  return false;
+}
+
+void IndexScanExecutor::RowFromIndexEntry(const Row &entry, Row *row) {
+  const auto &table_columns = table_info_->GetSchema()->GetColumns();
+  std::vector<Field> fields;
+  fields.reserve(table_columns.size());
+  for (uint32_t i = 0; i < table_columns.size(); i++) {
+    if (entry_positions_[i] < 0) {
+      fields.emplace_back(table_columns[i]->GetType());
+    } else {
+      fields.emplace_back(*entry.GetField(entry_positions_[i]));
+    }
+  }
+  *row = Row(fields);
+  row->SetRowId(entry.GetRowId());
+}
+
 bool IndexScanExecutor::Next(Row *row, RowId *rid) {
-  auto predicate = plan_->GetPredicate();
+  auto predicate = plan_->GetCompiledPredicate();
   auto table_schema = table_info_->GetSchema();
-  while (cursor_ < result_.size()) {
-    auto p_row = new Row(result_[cursor_]);
-    table_info_->GetTableHeap()->GetTuple(p_row, nullptr);
-    if (plan_->need_filter_) {
-      if (!predicate->Evaluate(p_row).CompareEquals(Field(kTypeInt, 1))) {
-        cursor_++;
-        delete p_row;
-        continue;
-      }
+  RowId next_rid;
+  Row entry;
+  while (NextRowId(next_rid, plan_->index_only_ ? &entry : nullptr)) {
+    Row fetched(next_rid);
+    if (plan_->index_only_) {
+      RowFromIndexEntry(entry, &fetched);
+    } else {
+      table_info_->GetTableHeap()->GetTuple(&fetched, exec_ctx_->GetTransaction(), plan_->GetNeededColumns());
     }
-    *rid = result_[cursor_];
+    if (predicate != nullptr && !predicate->Matches(&fetched)) {
+      continue;
+    }
+    *rid = next_rid;
     if (!is_schema_same_) {
-      TupleTransfer(table_schema, plan_->OutputSchema(), p_row, row);
+      TupleTransfer(table_schema, plan_->OutputSchema(), &fetched, row);
     } else {
-      *row = *p_row;
+      *row = fetched;
     }
-    delete p_row;
-    cursor_++;
     return true;
   }
   return false;
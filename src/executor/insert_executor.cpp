@@ -4,6 +4,8 @@
 
 #include "executor/executors/insert_executor.h"
 
+#include <stdexcept>
+
 InsertExecutor::InsertExecutor(ExecuteContext *exec_ctx, const InsertPlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
     : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
@@ -15,25 +17,34 @@ void InsertExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->GetTableName(), index_info_);
 }
 
-bool InsertExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
+bool InsertExecutor::Next([[maybe_unused]] Row *row, RowId * /*rid*/) {
     Row insert_row;
     RowId insert_rid;
     if (child_executor_->Next(&insert_row, &insert_rid)) {
         for (auto info: index_info_) {
+            // 并发构建中的索引连同side log一起检查，扫描尚未到达的重复由构建合并时发现
             Row key_row;
             insert_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), key_row);
             std::vector<RowId> result;
             if (!key_row.GetFields().empty() &&
-                info->GetIndex()->ScanKey(key_row, result, exec_ctx_->GetTransaction()) == DB_SUCCESS) {
+                info->ScanKey(key_row, result, exec_ctx_->GetTransaction()) == DB_SUCCESS) {
                 std::cout << "key already exists" << std::endl;
                 return false;
             }
         }
         if (table_info_->GetTableHeap()->InsertTuple(insert_row, exec_ctx_->GetTransaction())) {
             Row key_row;
-            for (auto info: index_info_) {  // 更新索引
-                insert_row.GetKeyFromRow(schema_, info->GetIndexKeySchema(), key_row);
-                info->GetIndex()->InsertEntry(key_row, insert_row.GetRowId(), exec_ctx_->GetTransaction());
+            for (size_t i = 0; i < index_info_.size(); i++) {  // 更新索引
+                insert_row.GetKeyFromRow(schema_, index_info_[i]->GetIndexKeySchema(), key_row);
+                if (index_info_[i]->InsertEntry(key_row, insert_row.GetRowId(), exec_ctx_->GetTransaction()) != DB_SUCCESS) {
+                    // undo the entries already added and the heap insert, the row must not stay half indexed
+                    for (size_t j = 0; j < i; j++) {
+                        insert_row.GetKeyFromRow(schema_, index_info_[j]->GetIndexKeySchema(), key_row);
+                        index_info_[j]->RemoveEntry(key_row, insert_row.GetRowId(), exec_ctx_->GetTransaction());
+                    }
+                    table_info_->GetTableHeap()->ApplyDelete(insert_row.GetRowId(), exec_ctx_->GetTransaction());
+                    throw std::runtime_error("failed to insert into index " + index_info_[i]->GetIndexName());
+                }
             }
             return true;
         }
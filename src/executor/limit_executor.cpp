@@ -0,0 +1,31 @@
+#include "executor/executors/limit_executor.h"
+
+LimitExecutor::LimitExecutor(ExecuteContext *exec_ctx, const LimitPlanNode *plan,
+                             std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void LimitExecutor::Init() {
+  skipped_ = 0;
+  emitted_ = 0;
+  if (plan_->GetLimit() > 0) {
+    child_executor_->Init();
+  }
+}
+
+bool LimitExecutor::Next(Row *row, RowId *rid) {
+  if (emitted_ >= plan_->GetLimit()) {
+    return false;
+  }
+  for (; skipped_ < plan_->GetOffset(); skipped_++) {
+    if (!child_executor_->Next(row, rid)) {
+      emitted_ = plan_->GetLimit();
+      return false;
+    }
+  }
+  if (!child_executor_->Next(row, rid)) {
+    emitted_ = plan_->GetLimit();
+    return false;
+  }
+  emitted_++;
+  return true;
+}
@@ -0,0 +1,95 @@
+#include "executor/executors/merge_join_executor.h"
+
+MergeJoinExecutor::MergeJoinExecutor(ExecuteContext *exec_ctx, const MergeJoinPlanNode *plan,
+                                     std::unique_ptr<AbstractExecutor> &&left_executor,
+                                     std::unique_ptr<AbstractExecutor> &&right_executor)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_executor)),
+      right_executor_(std::move(right_executor)) {}
+
+void MergeJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  group_rows_.clear();
+  group_key_.reset();
+  output_.clear();
+  output_cursor_ = 0;
+  valid_[0] = Advance(0);
+  valid_[1] = Advance(1);
+}
+
+bool MergeJoinExecutor::Next(Row *row, RowId * /*rid*/) {
+  while (output_cursor_ == output_.size()) {
+    output_.clear();
+    output_cursor_ = 0;
+    if (!MergeStep()) {
+      return false;
+    }
+  }
+  *row = std::move(output_[output_cursor_++]);
+  return true;
+}
+
+bool MergeJoinExecutor::Advance(int side) {
+  auto child = side == 0 ? left_executor_.get() : right_executor_.get();
+  const auto &key = side == 0 ? plan_->GetLeftKey() : plan_->GetRightKey();
+  Cursor &cursor = cursors_[side];
+  RowId rid;
+  while (child->Next(&cursor.row_, &rid)) {
+    cursor.key_ = std::make_unique<Field>(key->Evaluate(&cursor.row_));
+    if (!cursor.key_->IsNull()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MergeJoinExecutor::MergeStep() {
+  if (!valid_[0]) {
+    return false;
+  }
+  Cursor &left = cursors_[0];
+  Cursor &right = cursors_[1];
+  // left rows with equal keys follow each other, all of them meet the same right rows
+  if (group_key_ != nullptr && left.key_->CompareEquals(*group_key_) == CmpBool::kTrue) {
+    for (const auto &right_row : group_rows_) {
+      Emit(left.row_, right_row);
+    }
+    valid_[0] = Advance(0);
+    return true;
+  }
+  if (!valid_[1]) {
+    return false;
+  }
+  if (left.key_->CompareLessThan(*right.key_) == CmpBool::kTrue) {
+    valid_[0] = Advance(0);
+    return true;
+  }
+  if (right.key_->CompareLessThan(*left.key_) == CmpBool::kTrue) {
+    valid_[1] = Advance(1);
+    return true;
+  }
+  group_rows_.clear();
+  group_key_ = std::move(right.key_);
+  do {
+    group_rows_.push_back(std::move(right.row_));
+    valid_[1] = Advance(1);
+  } while (valid_[1] && right.key_->CompareEquals(*group_key_) == CmpBool::kTrue);
+  return true;
+}
+
+void MergeJoinExecutor::Emit(const Row &left_row, const Row &right_row) {
+  auto predicate = plan_->GetPredicate();
+  if (predicate != nullptr && !predicate->EvaluateJoin(&left_row, &right_row).CompareEquals(Field(kTypeInt, 1))) {
+    return;
+  }
+  uint32_t left_count = left_row.GetFieldCount();
+  std::vector<Field> fields;
+  fields.reserve(GetOutputSchema()->GetColumnCount());
+  for (auto column : GetOutputSchema()->GetColumns()) {
+    uint32_t idx = column->GetTableInd();
+    fields.emplace_back(idx < left_count ? *left_row.GetField(idx) : *right_row.GetField(idx - left_count));
+  }
+  output_.emplace_back(fields);
+}
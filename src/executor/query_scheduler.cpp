@@ -0,0 +1,90 @@
+#include "executor/query_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "executor/execute_context.h"
+#include "executor/executors/seq_scan_executor.h"
+
+bool TableMorselSource::NextMorsel(Morsel &morsel) {
+  std::lock_guard<std::mutex> guard(latch_);
+  if (next_page_id_ == INVALID_PAGE_ID) {
+    return false;
+  }
+  morsel.after_page_id_ = last_page_id_;
+  morsel.pages_.clear();
+  while (morsel.pages_.size() < MORSEL_PAGES && next_page_id_ != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id_));
+    if (page == nullptr) {
+      throw std::runtime_error("no free frame to cut a table into morsels");
+    }
+    page->RLatch();
+    page_id_t next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(next_page_id_, false);
+    morsel.pages_.push_back(next_page_id_);
+    last_page_id_ = next_page_id_;
+    next_page_id_ = next_page_id;
+  }
+  return true;
+}
+
+QueryScheduler::QueryScheduler(uint32_t max_workers, ThreadPool *pool)
+    : pool_(pool),
+      worker_count_(std::max<uint32_t>(1, std::min<uint32_t>(max_workers, pool->GetThreadCount() + 1))) {}
+
+void QueryScheduler::Run(const std::function<void(uint32_t)> &worker) {
+  // a worker index runs once, on whichever thread claims it first
+  auto claimed = std::make_unique<std::atomic<bool>[]>(worker_count_);
+  TaskGroup group(pool_);
+  for (uint32_t i = 1; i < worker_count_; i++) {
+    group.Submit([&worker, &claimed, i]() {
+      if (!claimed[i].exchange(true)) {
+        worker(i);
+      }
+    });
+  }
+  std::exception_ptr error;
+  try {
+    for (uint32_t i = 0; i < worker_count_; i++) {
+      if (!claimed[i].exchange(true)) {
+        worker(i);
+      }
+    }
+  } catch (...) {
+    error = std::current_exception();
+  }
+  group.Wait();
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+void QueryScheduler::RunScanPipeline(ExecuteContext *exec_ctx, const SeqScanPlanNode *plan,
+                                     const std::function<void(uint32_t, Row &)> &consume,
+                                     const std::function<void(uint32_t)> &finish) {
+  TableInfo *table_info = nullptr;
+  exec_ctx->GetCatalog()->GetTable(plan->GetTableName(), table_info);
+  TableMorselSource source(table_info->GetTableHeap(), exec_ctx->GetBufferPoolManager());
+  // every worker scans with its own executor, set up here so the workers only read shared state
+  std::vector<std::unique_ptr<SeqScanExecutor>> scans;
+  for (uint32_t i = 0; i < worker_count_; i++) {
+    scans.push_back(std::make_unique<SeqScanExecutor>(exec_ctx, plan));
+    scans.back()->Init();
+  }
+  Run([&](uint32_t worker) {
+    Morsel morsel;
+    Row row;
+    RowId rid;
+    while (source.NextMorsel(morsel)) {
+      scans[worker]->SetMorsel(morsel);
+      while (scans[worker]->Next(&row, &rid)) {
+        consume(worker, row);
+      }
+    }
+    if (finish != nullptr) {
+      finish(worker);
+    }
+  });
+}
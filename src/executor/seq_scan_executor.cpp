@@ -44,24 +44,87 @@ void SeqScanExecutor::Init() {
   iterator_ = (table_info_->GetTableHeap()->Begin(exec_ctx_->GetTransaction()));
   schema_ = plan_->OutputSchema();
   is_schema_same_ = SchemaEqual(table_info_->GetSchema(), schema_);
+  morsel_.pages_.clear();
+  // 收集可以用block range index跳过page的条件
+  page_filters_.clear();
+  checked_page_id_ = INVALID_PAGE_ID;
+  std::vector<IndexInfo *> indexes;
+  exec_ctx_->GetCatalog()->GetTableIndexes(plan_->GetTableName(), indexes);
+  std::vector<ComparisonExpression *> conjuncts;
+  LogicExpression::CollectConjuncts(plan_->GetPredicate(), conjuncts);
+  for (auto index : indexes) {
+    // 并发构建中的索引还没有覆盖所有page
+    if (!index->IsBrinIndex() || index->IsBuilding()) {
+      continue;
+    }
+    uint32_t col_idx = index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
+    for (auto comparison : conjuncts) {
+      if (dynamic_pointer_cast<ColumnValueExpression>(comparison->GetChildAt(0))->GetColIdx() == col_idx) {
+        page_filters_.emplace_back(dynamic_cast<BrinIndex *>(index->GetIndex()), comparison);
+      }
+    }
+  }
+}
+
+void SeqScanExecutor::SetMorsel(const Morsel &morsel) {
+  morsel_ = morsel;
+  checked_page_id_ = INVALID_PAGE_ID;
+  auto table_heap = table_info_->GetTableHeap();
+  iterator_ = morsel.after_page_id_ == INVALID_PAGE_ID
+                  ? table_heap->Begin(exec_ctx_->GetTransaction())
+                  : table_heap->BeginAfterPage(morsel.after_page_id_, exec_ctx_->GetTransaction());
+}
+
+bool SeqScanExecutor::PageMayMatch(page_id_t page_id) {
+  for (const auto &filter : page_filters_) {
+    if (filter.second->GetComparisonType() == "in") {
+      // the page may hold a row of the list once it may hold one of the values
+      bool may_match = false;
+      for (size_t i = 1; !may_match && i < filter.second->GetChildren().size(); i++) {
+        Field value = filter.second->GetChildAt(i)->Evaluate(nullptr);
+        may_match = filter.first->PageMayMatch(page_id, "=", value);
+      }
+      if (!may_match) {
+        return false;
+      }
+      continue;
+    }
+    Field value = filter.second->GetChildAt(1)->Evaluate(nullptr);
+    if (!filter.first->PageMayMatch(page_id, filter.second->GetComparisonType(), value)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool SeqScanExecutor::Next(Row *row, RowId *rid) {
-  auto predicate = plan_->GetPredicate();
+  auto predicate = plan_->GetCompiledPredicate();
   auto table_schema = table_info_->GetSchema();
   while (iterator_ != table_info_->GetTableHeap()->End()) {
-    auto p_row = &(*iterator_);
-    if (predicate != nullptr) {
-      if (!predicate->Evaluate(p_row).CompareEquals(Field(kTypeInt, 1))) {
-        iterator_++;
+    // 进入新的page时先检查summary，不可能有匹配的page跳过其中所有tuple（page本身仍要读出才能找到下一页）
+    page_id_t page_id = iterator_.GetRowId().GetPageId();
+    if (!morsel_.pages_.empty() && !morsel_.Contains(page_id)) {
+      return false;
+    }
+    if (!page_filters_.empty() && page_id != checked_page_id_) {
+      checked_page_id_ = page_id;
+      if (!PageMayMatch(page_id)) {
+        iterator_ = table_info_->GetTableHeap()->BeginAfterPage(page_id, exec_ctx_->GetTransaction());
         continue;
       }
     }
-    *rid = iterator_->GetRowId();
+    // 只反序列化查询用到的列，其余列留空
+    Row scanned(iterator_.GetRowId());
+    if (!table_info_->GetTableHeap()->GetTuple(&scanned, exec_ctx_->GetTransaction(), plan_->GetNeededColumns()) ||
+        (predicate != nullptr && !predicate->Matches(&scanned))) {
+      iterator_++;
+      continue;
+    }
+    *rid = scanned.GetRowId();
     if (!is_schema_same_) {
-      TupleTransfer(table_schema, schema_, p_row, row);
+      TupleTransfer(table_schema, schema_, &scanned, row);
     } else {
-      *row = *p_row;
+      *row = std::move(scanned);
     }
     iterator_++;
     return true;
@@ -0,0 +1,301 @@
+#include "executor/executors/sort_executor.h"
+
+#include <algorithm>
+#include <cstring>
+
+SortExecutor::SortExecutor(ExecuteContext *exec_ctx, const SortPlanNode *plan,
+                           std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+SortExecutor::~SortExecutor() { DropRuns(); }
+
+static uint64_t RowBytes(const Row &row) {
+  uint64_t bytes = sizeof(Row);
+  for (uint32_t i = 0; i < row.GetFieldCount(); i++) {
+    bytes += sizeof(Field) + row.GetField(i)->GetSerializedSize();
+  }
+  return bytes;
+}
+
+void SortExecutor::AppendSortKey(const Field &field, bool descending, std::string &key) {
+  size_t begin = key.size();
+  if (field.IsNull()) {
+    key.push_back(0);
+  } else {
+    key.push_back(1);
+    switch (field.GetTypeId()) {
+      case TypeId::kTypeInt: {
+        uint32_t bits = static_cast<uint32_t>(*reinterpret_cast<const int32_t *>(field.GetData())) ^ 0x80000000u;
+        for (int shift = 24; shift >= 0; shift -= 8) {
+          key.push_back(static_cast<char>(bits >> shift));
+        }
+        break;
+      }
+      case TypeId::kTypeFloat: {
+        float value = *reinterpret_cast<const float *>(field.GetData());
+        if (value == 0) {
+          value = 0;
+        }
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        // a negative float orders backwards on its bits, a positive one only needs the sign bit above the negatives
+        bits = (bits & 0x80000000u) != 0 ? ~bits : bits ^ 0x80000000u;
+        for (int shift = 24; shift >= 0; shift -= 8) {
+          key.push_back(static_cast<char>(bits >> shift));
+        }
+        break;
+      }
+      default: {
+        const char *data = field.GetData();
+        for (uint32_t i = 0; i < field.GetLength(); i++) {
+          key.push_back(data[i]);
+          if (data[i] == 0) {
+            key.push_back(static_cast<char>(0xff));
+          }
+        }
+        key.push_back(0);
+        key.push_back(0);
+        break;
+      }
+    }
+  }
+  if (descending) {
+    for (size_t i = begin; i < key.size(); i++) {
+      key[i] = static_cast<char>(~key[i]);
+    }
+  }
+}
+
+void SortExecutor::Init() {
+  child_executor_->Init();
+  DropRuns();
+  project_ = plan_->OutputSchema() != child_executor_->GetOutputSchema();
+  std::vector<SortRow> rows;
+  uint64_t bytes = 0;
+  Row row;
+  RowId rid;
+  while (child_executor_->Next(&row, &rid)) {
+    bytes += RowBytes(row);
+    rows.push_back(MakeSortRow(std::move(row)));
+    if (bytes > plan_->GetMemoryBudget()) {
+      SpillRun(rows);
+      bytes = 0;
+    }
+  }
+  if (!rows.empty()) {
+    std::stable_sort(rows.begin(), rows.end(), [](const SortRow &lhs, const SortRow &rhs) { return lhs.key_ < rhs.key_; });
+    runs_.emplace_back();
+    runs_.back().rows_ = std::move(rows);
+  }
+  // every run being merged holds one page of rows, merge groups of runs until the budget holds them all
+  size_t fan_in = std::max<size_t>(2, plan_->GetMemoryBudget() / PAGE_SIZE);
+  while (runs_.size() > fan_in) {
+    std::vector<Run> merged;
+    for (size_t begin = 0; begin < runs_.size(); begin += fan_in) {
+      merged.push_back(MergeRuns(begin, std::min(runs_.size(), begin + fan_in)));
+    }
+    runs_ = std::move(merged);
+  }
+  for (auto &run : runs_) {
+    Fill(run);
+  }
+  BuildTree(runs_, 0, runs_.size(), tree_);
+}
+
+bool SortExecutor::Next(Row *row, RowId * /*rid*/) {
+  if (tree_.empty()) {
+    return false;
+  }
+  size_t winner = tree_[0];
+  Run &run = runs_[winner];
+  if (run.row_cursor_ == run.rows_.size()) {
+    return false;
+  }
+  Row &next = run.rows_[run.row_cursor_++].row_;
+  if (project_) {
+    std::vector<Field> fields;
+    fields.reserve(GetOutputSchema()->GetColumnCount());
+    for (auto column : GetOutputSchema()->GetColumns()) {
+      fields.emplace_back(*next.GetField(column->GetTableInd()));
+    }
+    *row = Row(fields);
+  } else {
+    *row = std::move(next);
+  }
+  Fill(run);
+  ReplayTree(runs_, 0, runs_.size(), winner, tree_);
+  return true;
+}
+
+SortExecutor::SortRow SortExecutor::MakeSortRow(Row &&row) const {
+  SortRow sort_row;
+  for (const auto &order_by : plan_->GetOrderBy()) {
+    AppendSortKey(order_by.second->Evaluate(&row), order_by.first == OrderByType::Desc, sort_row.key_);
+  }
+  sort_row.row_ = std::move(row);
+  return sort_row;
+}
+
+bool SortExecutor::Beats(const Run &lhs, const Run &rhs) const {
+  if (lhs.row_cursor_ == lhs.rows_.size()) {
+    return false;
+  }
+  if (rhs.row_cursor_ == rhs.rows_.size()) {
+    return true;
+  }
+  return lhs.rows_[lhs.row_cursor_].key_ <= rhs.rows_[rhs.row_cursor_].key_;
+}
+
+void SortExecutor::BuildTree(std::vector<Run> &runs, size_t begin, size_t end, std::vector<size_t> &tree) const {
+  size_t count = end - begin;
+  tree.assign(count, 0);
+  if (count == 0) {
+    return;
+  }
+  // winners[n] is the winner below node n, the leaf of run i sits at count + i
+  std::vector<size_t> winners(2 * count);
+  for (size_t i = 0; i < count; i++) {
+    winners[count + i] = i;
+  }
+  for (size_t node = count - 1; node >= 1; node--) {
+    size_t left = winners[2 * node];
+    size_t right = winners[2 * node + 1];
+    // the earlier run wins a tie, so equal rows keep the order they were read in
+    bool left_wins = left < right ? Beats(runs[begin + left], runs[begin + right])
+                                  : !Beats(runs[begin + right], runs[begin + left]);
+    winners[node] = left_wins ? left : right;
+    tree[node] = left_wins ? right : left;
+  }
+  tree[0] = winners[1 % (2 * count)];
+}
+
+void SortExecutor::ReplayTree(std::vector<Run> &runs, size_t begin, size_t end, size_t index,
+                              std::vector<size_t> &tree) const {
+  size_t count = end - begin;
+  size_t winner = index;
+  for (size_t node = (count + index) / 2; node >= 1; node /= 2) {
+    size_t loser = tree[node];
+    bool loser_wins = loser < winner ? Beats(runs[begin + loser], runs[begin + winner])
+                                     : !Beats(runs[begin + winner], runs[begin + loser]);
+    if (loser_wins) {
+      tree[node] = winner;
+      winner = loser;
+    }
+  }
+  tree[0] = winner;
+}
+
+void SortExecutor::SpillRun(std::vector<SortRow> &rows) {
+  std::stable_sort(rows.begin(), rows.end(), [](const SortRow &lhs, const SortRow &rhs) { return lhs.key_ < rhs.key_; });
+  RunWriter writer;
+  for (const auto &sort_row : rows) {
+    WriteRow(writer, sort_row.row_);
+  }
+  FlushPage(writer);
+  rows.clear();
+  runs_.push_back(std::move(writer.run_));
+  spilled_runs_++;
+}
+
+SortExecutor::Run SortExecutor::MergeRuns(size_t begin, size_t end) {
+  std::vector<size_t> tree;
+  for (size_t i = begin; i < end; i++) {
+    Fill(runs_[i]);
+  }
+  BuildTree(runs_, begin, end, tree);
+  RunWriter writer;
+  while (true) {
+    Run &run = runs_[begin + tree[0]];
+    if (run.row_cursor_ == run.rows_.size()) {
+      break;
+    }
+    WriteRow(writer, run.rows_[run.row_cursor_++].row_);
+    Fill(run);
+    ReplayTree(runs_, begin, end, tree[0], tree);
+  }
+  FlushPage(writer);
+  spilled_runs_++;
+  return std::move(writer.run_);
+}
+
+void SortExecutor::WriteRow(RunWriter &writer, const Row &row) {
+  auto schema = const_cast<Schema *>(child_executor_->GetOutputSchema());
+  uint32_t size = row.GetSerializedSize(schema);
+  if (2 * sizeof(uint32_t) + size > PAGE_SIZE) {
+    throw std::runtime_error("a row of " + std::to_string(size) + " bytes is too large to spill in a sort");
+  }
+  if (writer.buffer_ == nullptr) {
+    writer.buffer_ = std::make_unique<char[]>(PAGE_SIZE);
+    writer.buffer_size_ = sizeof(uint32_t);
+  }
+  if (writer.buffer_size_ + sizeof(uint32_t) + size > PAGE_SIZE) {
+    FlushPage(writer);
+  }
+  // a page holds [row count][size, row]...
+  char *buf = writer.buffer_.get() + writer.buffer_size_;
+  MACH_WRITE_UINT32(buf, size);
+  row.SerializeTo(buf + sizeof(uint32_t), schema);
+  writer.buffer_size_ += sizeof(uint32_t) + size;
+  writer.buffer_count_++;
+}
+
+void SortExecutor::FlushPage(RunWriter &writer) {
+  if (writer.buffer_count_ == 0) {
+    return;
+  }
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  page_id_t page_id;
+  Page *page = bpm->NewPage(page_id);
+  if (page == nullptr) {
+    throw std::runtime_error("no free frame for a sort run page");
+  }
+  MACH_WRITE_UINT32(writer.buffer_.get(), writer.buffer_count_);
+  memcpy(page->GetData(), writer.buffer_.get(), PAGE_SIZE);
+  bpm->UnpinPage(page_id, true);
+  writer.run_.pages_.push_back(page_id);
+  writer.buffer_size_ = sizeof(uint32_t);
+  writer.buffer_count_ = 0;
+}
+
+bool SortExecutor::Fill(Run &run) {
+  if (run.row_cursor_ < run.rows_.size()) {
+    return true;
+  }
+  run.rows_.clear();
+  run.row_cursor_ = 0;
+  if (run.page_cursor_ == run.pages_.size()) {
+    return false;
+  }
+  auto bpm = exec_ctx_->GetBufferPoolManager();
+  page_id_t page_id = run.pages_[run.page_cursor_++];
+  Page *page = bpm->FetchPage(page_id);
+  if (page == nullptr) {
+    throw std::runtime_error("no free frame for a sort run page");
+  }
+  auto schema = const_cast<Schema *>(child_executor_->GetOutputSchema());
+  char *buf = page->GetData();
+  uint32_t count = MACH_READ_UINT32(buf);
+  uint32_t offset = sizeof(uint32_t);
+  run.rows_.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t size = MACH_READ_UINT32(buf + offset);
+    Row row;
+    row.DeserializeFrom(buf + offset + sizeof(uint32_t), schema);
+    offset += sizeof(uint32_t) + size;
+    run.rows_.push_back(MakeSortRow(std::move(row)));
+  }
+  bpm->UnpinPage(page_id, false);
+  bpm->DeletePage(page_id);
+  return true;
+}
+
+void SortExecutor::DropRuns() {
+  for (auto &run : runs_) {
+    for (; run.page_cursor_ < run.pages_.size(); run.page_cursor_++) {
+      exec_ctx_->GetBufferPoolManager()->DeletePage(run.pages_[run.page_cursor_]);
+    }
+  }
+  runs_.clear();
+  tree_.clear();
+  spilled_runs_ = 0;
+}
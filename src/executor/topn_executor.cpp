@@ -0,0 +1,59 @@
+#include "executor/executors/topn_executor.h"
+
+#include <algorithm>
+
+#include "executor/executors/sort_executor.h"
+
+TopNExecutor::TopNExecutor(ExecuteContext *exec_ctx, const TopNPlanNode *plan,
+                           std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void TopNExecutor::Init() {
+  rows_.clear();
+  cursor_ = 0;
+  if (plan_->GetN() == 0) {
+    return;
+  }
+  child_executor_->Init();
+  project_ = plan_->OutputSchema() != child_executor_->GetOutputSchema();
+  rows_.reserve(plan_->GetN());
+  Row row;
+  RowId rid;
+  uint64_t seq = 0;
+  std::string key;
+  while (child_executor_->Next(&row, &rid)) {
+    key.clear();
+    for (const auto &order_by : plan_->GetOrderBy()) {
+      SortExecutor::AppendSortKey(order_by.second->Evaluate(&row), order_by.first == OrderByType::Desc, key);
+    }
+    // a later row with the key of the top sorts after it
+    if (rows_.size() == plan_->GetN()) {
+      if (key >= rows_.front().key_) {
+        continue;
+      }
+      std::pop_heap(rows_.begin(), rows_.end(), Before);
+      rows_.pop_back();
+    }
+    rows_.push_back(HeapRow{key, seq++, std::move(row)});
+    std::push_heap(rows_.begin(), rows_.end(), Before);
+  }
+  std::sort_heap(rows_.begin(), rows_.end(), Before);
+}
+
+bool TopNExecutor::Next(Row *row, RowId * /*rid*/) {
+  if (cursor_ == rows_.size()) {
+    return false;
+  }
+  Row &next = rows_[cursor_++].row_;
+  if (project_) {
+    std::vector<Field> fields;
+    fields.reserve(GetOutputSchema()->GetColumnCount());
+    for (auto column : GetOutputSchema()->GetColumns()) {
+      fields.emplace_back(*next.GetField(column->GetTableInd()));
+    }
+    *row = Row(fields);
+  } else {
+    *row = std::move(next);
+  }
+  return true;
+}
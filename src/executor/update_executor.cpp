@@ -4,6 +4,8 @@
 
 #include "executor/executors/update_executor.h"
 
+#include <stdexcept>
+
 UpdateExecutor::UpdateExecutor(ExecuteContext *exec_ctx, const UpdatePlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
     : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
@@ -15,7 +17,7 @@ void UpdateExecutor::Init() {
   txn_ = exec_ctx_->GetTransaction();
 }
 
-bool UpdateExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
+bool UpdateExecutor::Next([[maybe_unused]] Row *row, RowId * /*rid*/) {
   Row src_row;
   RowId src_rid;
   if (child_executor_->Next(&src_row, &src_rid)) {
@@ -25,11 +27,25 @@ bool UpdateExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
     }
     Row src_key_row;
     Row dest_key_row;
-    for (auto info : index_info_) {  // 更新索引
+    for (size_t i = 0; i < index_info_.size(); i++) {  // 更新索引
+      auto info = index_info_[i];
       src_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), src_key_row);
       dest_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), dest_key_row);
-      info->GetIndex()->RemoveEntry(src_key_row, src_rid, txn_);
-      info->GetIndex()->InsertEntry(dest_key_row, src_rid, txn_);
+      if (info->RemoveEntry(src_key_row, src_rid, txn_) == DB_SUCCESS) {
+        if (info->InsertEntry(dest_key_row, src_rid, txn_) == DB_SUCCESS) {
+          continue;
+        }
+        info->InsertEntry(src_key_row, src_rid, txn_);
+      }
+      // point the indexes already updated back at the old key and restore the old row
+      for (size_t j = 0; j < i; j++) {
+        src_row.GetKeyFromRow(table_info_->GetSchema(), index_info_[j]->GetIndexKeySchema(), src_key_row);
+        dest_row.GetKeyFromRow(table_info_->GetSchema(), index_info_[j]->GetIndexKeySchema(), dest_key_row);
+        index_info_[j]->RemoveEntry(dest_key_row, src_rid, txn_);
+        index_info_[j]->InsertEntry(src_key_row, src_rid, txn_);
+      }
+      table_info_->GetTableHeap()->UpdateTuple(src_row, src_rid, txn_);
+      throw std::runtime_error("failed to update index " + info->GetIndexName());
     }
     return true;
   }
@@ -4,6 +4,7 @@
 #include <list>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "buffer/lru_replacer.h"
 #include "page/disk_file_meta_page.h"
@@ -14,14 +15,35 @@ using namespace std;
 
 class BufferPoolManager {
  public:
-  explicit BufferPoolManager(size_t pool_size, DiskManager *disk_manager);
+  /**
+   * @param cache_child_frames Whether FetchChildPage keeps a frame hint for every child slot it fetched through,
+   * see there
+   */
+  explicit BufferPoolManager(size_t pool_size, DiskManager *disk_manager, bool cache_child_frames = false);
 
   ~BufferPoolManager();
 
   Page *FetchPage(page_id_t page_id);
 
+  /**
+   * Fetch the page a child slot of a resident parent page refers to, e.g. a step down a B+ tree.
+   *
+   * With child frame caching on, every frame has a side table holding, per child slot, the frame its child was
+   * last found in. A hint that still holds child_page_id is pinned without the page_table_ lookup, a stale one
+   * falls back to FetchPage and is refreshed. This is a frame hint cache, not pointer swizzling: the slots of the
+   * page keep their page ids and the side table is read under the global latch_ like any other lookup, so a hit
+   * only saves the hash probe of page_table_, never the latch.
+   * @param parent The pinned parent page
+   * @param slot The index of the child slot within the parent
+   * @param child_page_id The page id stored in the slot
+   */
+  Page *FetchChildPage(Page *parent, int slot, page_id_t child_page_id);
+
   bool UnpinPage(page_id_t page_id, bool is_dirty);
 
+  /** Unpin a page through its frame, without a page table lookup. */
+  bool UnpinPage(Page *page, bool is_dirty);
+
   bool FlushPage(page_id_t page_id);
 
   Page *NewPage(page_id_t &page_id);
@@ -45,6 +67,11 @@ class BufferPoolManager {
 
   frame_id_t TryToFindFreePage();
 
+  inline frame_id_t FrameOf(Page *page) const { return static_cast<frame_id_t>(page - pages_); }
+
+  /** Forget the child frame hints of a frame, called whenever the frame is handed to another page. */
+  void ResetChildFrames(frame_id_t frame_id);
+
  private:
   size_t pool_size_;                                 // number of pages in buffer pool
   Page *pages_;                                      // array of pages
@@ -53,6 +80,8 @@ class BufferPoolManager {
   Replacer *replacer_;                               // to find an unpinned page for replacement
   list<frame_id_t> free_list_;                       // to find a free page for replacement
   recursive_mutex latch_;                            // to protect shared data structure
+  bool cache_child_frames_;                          // whether FetchChildPage keeps child frame hints
+  vector<vector<frame_id_t>> child_frames_;          // per frame, the last known frame of the child of each slot
 };
 
 #endif  // MINISQL_BUFFER_POOL_MANAGER_H
@@ -3,6 +3,7 @@
 
 #include <list>
 #include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -36,7 +37,10 @@ class LRUReplacer : public Replacer {
   size_t Size() override;
 
 private:
-  // add your own private member variables here
+  mutex latch_;
+  /** unpinned frames, the least recently unpinned one at the back */
+  list<frame_id_t> lru_list_;
+  unordered_map<frame_id_t, list<frame_id_t>::iterator> lru_map_;
 };
 
 #endif  // MINISQL_LRU_REPLACER_H
@@ -1,12 +1,20 @@
 #ifndef MINISQL_INDEXES_H
 #define MINISQL_INDEXES_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "catalog/table.h"
 #include "common/macros.h"
 #include "common/rowid.h"
+#include "index/art_index.h"
 #include "index/b_plus_tree_index.h"
+#include "index/bitmap_index.h"
+#include "index/brin_index.h"
+#include "index/extendible_hash_index.h"
+#include "index/fulltext_index.h"
 #include "index/generic_key.h"
 #include "record/schema.h"
 
@@ -15,7 +23,8 @@ class IndexMetadata {
 
  public:
   static IndexMetadata *Create(const index_id_t index_id, const std::string &index_name, const table_id_t table_id,
-                               const std::vector<uint32_t> &key_map);
+                               const std::vector<uint32_t> &key_map, const std::string &index_type = "bptree",
+                               const std::vector<uint32_t> &include_map = {});
 
   uint32_t SerializeTo(char *buf) const;
 
@@ -33,11 +42,16 @@ class IndexMetadata {
 
   inline index_id_t GetIndexId() const { return index_id_; }
 
+  inline std::string GetIndexType() const { return index_type_; }
+
+  inline const std::vector<uint32_t> &GetIncludeMapping() const { return include_map_; }
+
  private:
   IndexMetadata() = delete;
 
   explicit IndexMetadata(const index_id_t index_id, const std::string &index_name, const table_id_t table_id,
-                         const std::vector<uint32_t> &key_map);
+                         const std::vector<uint32_t> &key_map, const std::string &index_type,
+                         const std::vector<uint32_t> &include_map);
 
  private:
   static constexpr uint32_t INDEX_METADATA_MAGIC_NUM = 344528;
@@ -45,6 +59,8 @@ class IndexMetadata {
   std::string index_name_;
   table_id_t table_id_;
   std::vector<uint32_t> key_map_; /** The mapping of index key to tuple key */
+  std::string index_type_;        /** "bptree" (alias "btree"), "hash", "art", "brin", "bitmap" or "fulltext" */
+  std::vector<uint32_t> include_map_; /** The mapping of index payload columns to tuple columns */
 };
 
 /**
@@ -65,26 +81,112 @@ class IndexInfo {
  */
   void Init(IndexMetadata *meta_data, TableInfo *table_info, BufferPoolManager *buffer_pool_manager) {
     // Step1: init index metadata and table info
-    // Step2: mapping index key to key schema
-    // Step3: call CreateIndex to create the index
-    ASSERT(false, "Not Implemented yet.");
+    // Step2: mapping index key to key schema, the include columns follow the key columns
+    // Step3: call CreateIndex with meta_data_->GetIndexType() to create the index
+    meta_data_ = meta_data;
+    std::vector<uint32_t> attrs = meta_data_->GetKeyMapping();
+    for (auto column_index : meta_data_->GetIncludeMapping()) {
+      attrs.push_back(column_index);
+    }
+    key_schema_ = Schema::ShallowCopySchema(table_info->GetSchema(), attrs);
+    index_ = CreateIndex(buffer_pool_manager, meta_data_->GetIndexType());
   }
 
   inline Index *GetIndex() { return index_; }
 
   std::string GetIndexName() { return meta_data_->GetIndexName(); }
 
+  std::string GetIndexType() { return meta_data_->GetIndexType(); }
+
+  /** @return true if the index can only answer equality probes */
+  bool IsHashIndex() { return meta_data_->GetIndexType() == "hash"; }
+
+  /** @return true if the index is a B+ tree, the only kind whose entries can answer index-only scans */
+  bool IsBPlusTreeIndex() { return meta_data_->GetIndexType() == "bptree" || meta_data_->GetIndexType() == "btree"; }
+
+  /** @return true if the index only summarizes page ranges, it can skip pages of a sequential scan but not locate rows */
+  bool IsBrinIndex() { return meta_data_->GetIndexType() == "brin"; }
+
+  /** @return true if the index keeps nothing on disk and must be rebuilt from the table heap when loaded */
+  bool IsInMemory() { return meta_data_->GetIndexType() == "art" || IsBitmapIndex(); }
+
+  /** @return true if the index maps the tokens of a char column to its rows, it only answers match(...) */
+  bool IsFullTextIndex() { return meta_data_->GetIndexType() == "fulltext"; }
+
+  /** @return true if the index maps each distinct key to a bitmap of its rows */
+  bool IsBitmapIndex() { return meta_data_->GetIndexType() == "bitmap"; }
+
+  /** @return the number of leading key schema columns that order the index, the rest are include columns */
+  uint32_t GetKeyColumnCount() { return meta_data_->GetIndexColumnCount(); }
+
   IndexSchema *GetIndexKeySchema() { return key_schema_; }
 
+  /**
+   * Maintain the index for a write to its table. While the index is built concurrently the change is only
+   * recorded in the side log, FinishConcurrentBuild replays it once the heap scan is done.
+   */
+  dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn);
+
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Txn *txn);
+
+  /**
+   * Look up the rows of key, including writes still waiting in the side log. While the index is built the
+   * result only covers the rows scanned or written so far, a key it misses may still be found by the build.
+   * @return DB_SUCCESS if any row holds key
+   */
+  dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn);
+
+  /**
+   * @return true while the index is built concurrently, it is then incomplete: queries must not read it and
+   * writers go through InsertEntry and RemoveEntry of the IndexInfo
+   */
+  bool IsBuilding() const { return building_.load(); }
+
+  /** Start capturing writes in the side log, call it before the heap scan of a concurrent build. */
+  void BeginConcurrentBuild();
+
+  /**
+   * Add one row found by the heap scan of a concurrent build. A row a writer already added is skipped.
+   * @return DB_FAILED if another row holds the key of a unique index
+   */
+  dberr_t BuildEntry(const Row &key, RowId row_id, Txn *txn);
+
+  /**
+   * Replay the side log and make the index visible. The log is drained in batches while writers keep
+   * appending to it, only the last short batch is applied under the latch together with the flip.
+   * @return DB_FAILED if a logged insert holds the key of another row, the index then stays building and
+   * the caller must drop it
+   */
+  dberr_t FinishConcurrentBuild(Txn *txn);
+
  private:
   explicit IndexInfo() : meta_data_{nullptr}, index_{nullptr}, key_schema_{nullptr} {}
 
   Index *CreateIndex(BufferPoolManager *buffer_pool_manager, const string &index_type);
 
+  /** A write captured during a concurrent build. */
+  struct PendingEntry {
+    bool insert;
+    Row key;
+    RowId row_id;
+  };
+
+  /** @return the first failure of a logged insert, a logged delete of a row the scan never saw is a no-op */
+  dberr_t ApplyPending(const std::vector<PendingEntry> &pending, Txn *txn);
+
+  /** @return true if the leading key columns of a and b are equal */
+  bool SameKey(const Row &a, const Row &b) const;
+
+  /** once the side log is this short, it is applied while writers wait */
+  static constexpr size_t FINAL_MERGE_THRESHOLD = 64;
+
  private:
   IndexMetadata *meta_data_;
   Index *index_;
   IndexSchema *key_schema_;
+  std::atomic<bool> building_{false};
+  std::mutex build_latch_;
+  std::vector<PendingEntry> side_log_;
 };
 
 #endif  // MINISQL_INDEXES_H
@@ -0,0 +1,94 @@
+#ifndef MINISQL_HASH_UTIL_H
+#define MINISQL_HASH_UTIL_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Hash functions whose output only depends on the input bytes, never on the standard library, the compiler or the
+ * build, so hash values may be stored on disk and compared across binaries.
+ */
+class HashUtil {
+ public:
+  /**
+   * MurmurHash3 x86_32 by Austin Appleby. Blocks are read byte by byte in little endian order, so the result is
+   * the same on every platform.
+   */
+  static uint32_t Murmur3(const void *data, size_t len, uint32_t seed = 0) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    const uint32_t c1 = 0xcc9e2d51;
+    const uint32_t c2 = 0x1b873593;
+    uint32_t h = seed;
+    size_t block_count = len / 4;
+    for (size_t i = 0; i < block_count; i++) {
+      const uint8_t *block = bytes + i * 4;
+      uint32_t k = static_cast<uint32_t>(block[0]) | static_cast<uint32_t>(block[1]) << 8 |
+                   static_cast<uint32_t>(block[2]) << 16 | static_cast<uint32_t>(block[3]) << 24;
+      k *= c1;
+      k = Rotl(k, 15);
+      k *= c2;
+      h ^= k;
+      h = Rotl(h, 13);
+      h = h * 5 + 0xe6546b64;
+    }
+    const uint8_t *tail = bytes + block_count * 4;
+    uint32_t k = 0;
+    switch (len & 3) {
+      case 3:
+        k ^= static_cast<uint32_t>(tail[2]) << 16;
+        [[fallthrough]];
+      case 2:
+        k ^= static_cast<uint32_t>(tail[1]) << 8;
+        [[fallthrough]];
+      case 1:
+        k ^= tail[0];
+        k *= c1;
+        k = Rotl(k, 15);
+        k *= c2;
+        h ^= k;
+        break;
+      default:
+        break;
+    }
+    h ^= static_cast<uint32_t>(len);
+    return FinalMix(h);
+  }
+
+  /** @return two independent 32 bit Murmur3 hashes of data, seeded differently, in one 64 bit value */
+  static uint64_t Murmur3_64(const void *data, size_t len) {
+    return static_cast<uint64_t>(Murmur3(data, len, SEED_HIGH)) << 32 | Murmur3(data, len, SEED_LOW);
+  }
+
+  /**
+   * @return value with every representation of the same number made identical: -0.0 becomes 0.0 and every NaN the
+   * same quiet NaN, so floats equal as values also have equal bytes
+   */
+  static float NormalizeFloat(float value) {
+    if (value == 0) {
+      return 0;
+    }
+    if (std::isnan(value)) {
+      return std::numeric_limits<float>::quiet_NaN();
+    }
+    return value;
+  }
+
+ private:
+  static constexpr uint32_t SEED_HIGH = 0x9747b28c;
+  static constexpr uint32_t SEED_LOW = 0x5bd1e995;
+
+  static uint32_t Rotl(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+
+  static uint32_t FinalMix(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+  }
+};
+
+#endif  // MINISQL_HASH_UTIL_H
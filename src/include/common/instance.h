@@ -14,7 +14,9 @@
 
 class DBStorageEngine {
  public:
-  explicit DBStorageEngine(std::string db_name, bool init = true, uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE);
+  /** @param cache_child_frames Whether the buffer pool keeps frame hints for the child slots of index pages */
+  explicit DBStorageEngine(std::string db_name, bool init = true, uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE,
+                           bool cache_child_frames = false);
 
   ~DBStorageEngine();
 
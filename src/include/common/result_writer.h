@@ -5,11 +5,16 @@
 #ifndef MINISQL_RESULTWRITER_H
 #define MINISQL_RESULTWRITER_H
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "record/field.h"
+#include "record/row.h"
+#include "record/schema.h"
+
 class ResultWriter {
  public:
   explicit ResultWriter(std::ostream &stream, bool disable_header = false, const char *separator = "|")
@@ -30,7 +35,7 @@ class ResultWriter {
     stream_ << "\n";
   }
   void BeginRow() { stream_ << "|"; }
-  void EndRow() { stream_ << std::endl; }
+  void EndRow() { stream_ << "\n"; }
   void EndInformation(size_t result_size, double time, bool is_scan) {
     if (is_scan) {
       if (!result_size)
@@ -47,4 +52,141 @@ class ResultWriter {
   std::string separator_;
 };
 
+/** How the rows of a select are printed. */
+enum class ResultFormat {
+  /** a table with column widths fitted to the first rows */
+  Table,
+  /** a header line and one line per row, the cells separated by tabs */
+  Tsv,
+};
+
+/**
+ * ResultStream prints the rows of a select as they are produced, so printing takes constant memory and the first
+ * rows show up before the query ends.
+ *
+ * A table fits its column widths to the first SAMPLE_ROWS rows, which are held back until then; a shorter result
+ * is printed exactly as a fully buffered one, a later cell wider than its column just stretches its line. A TSV
+ * cell escapes backslashes, tabs and line breaks, a null is written as \N.
+ */
+class ResultStream {
+ public:
+  ResultStream(std::ostream &stream, const Schema *schema, ResultFormat format)
+      : writer_(stream), schema_(schema), format_(format) {
+    if (format_ == ResultFormat::Tsv) {
+      const auto &columns = schema_->GetColumns();
+      for (size_t i = 0; i < columns.size(); i++) {
+        writer_.stream_ << (i == 0 ? "" : "\t") << columns[i]->GetName();
+      }
+      writer_.stream_ << "\n";
+    }
+  }
+
+  void Push(const Row &row) {
+    row_count_++;
+    if (format_ == ResultFormat::Tsv) {
+      WriteTsvRow(row);
+    } else if (!widths_.empty()) {
+      WriteTableRow(row);
+    } else {
+      sample_.push_back(row);
+      if (sample_.size() == SAMPLE_ROWS) {
+        FlushSample();
+      }
+    }
+  }
+
+  /** Print the rows still held back and close the table. */
+  void Finish() {
+    if (format_ == ResultFormat::Tsv) {
+      writer_.stream_.flush();
+      return;
+    }
+    if (widths_.empty() && !sample_.empty()) {
+      FlushSample();
+    }
+    if (!widths_.empty()) {
+      writer_.Divider(widths_);
+    }
+    writer_.stream_.flush();
+  }
+
+  size_t GetRowCount() const { return row_count_; }
+
+  /** Rows the column widths of a table are fitted to */
+  static constexpr size_t SAMPLE_ROWS = 1024;
+
+ private:
+  void FlushSample() {
+    const auto &columns = schema_->GetColumns();
+    widths_.assign(columns.size(), 0);
+    for (size_t i = 0; i < columns.size(); i++) {
+      widths_[i] = static_cast<int>(columns[i]->GetName().length());
+    }
+    for (const auto &row : sample_) {
+      for (size_t i = 0; i < columns.size(); i++) {
+        widths_[i] = std::max(widths_[i], static_cast<int>(row.GetField(i)->toString().size()));
+      }
+    }
+    writer_.Divider(widths_);
+    writer_.BeginRow();
+    for (size_t i = 0; i < columns.size(); i++) {
+      writer_.WriteHeaderCell(columns[i]->GetName(), widths_[i]);
+    }
+    writer_.EndRow();
+    writer_.Divider(widths_);
+    for (const auto &row : sample_) {
+      WriteTableRow(row);
+    }
+    sample_.clear();
+    sample_.shrink_to_fit();
+  }
+
+  void WriteTableRow(const Row &row) {
+    writer_.BeginRow();
+    for (size_t i = 0; i < widths_.size(); i++) {
+      writer_.WriteCell(row.GetField(i)->toString(), widths_[i]);
+    }
+    writer_.EndRow();
+  }
+
+  void WriteTsvRow(const Row &row) {
+    for (uint32_t i = 0; i < row.GetFieldCount(); i++) {
+      if (i > 0) {
+        writer_.stream_ << '\t';
+      }
+      Field *field = row.GetField(i);
+      if (field->IsNull()) {
+        writer_.stream_ << "\\N";
+        continue;
+      }
+      for (char ch : field->toString()) {
+        switch (ch) {
+          case '\\':
+            writer_.stream_ << "\\\\";
+            break;
+          case '\t':
+            writer_.stream_ << "\\t";
+            break;
+          case '\n':
+            writer_.stream_ << "\\n";
+            break;
+          case '\r':
+            writer_.stream_ << "\\r";
+            break;
+          default:
+            writer_.stream_ << ch;
+        }
+      }
+    }
+    writer_.stream_ << '\n';
+  }
+
+  ResultWriter writer_;
+  const Schema *schema_;
+  ResultFormat format_;
+  std::vector<Row> sample_;
+  std::vector<int> widths_;
+  size_t row_count_{0};
+};
+
 #endif  // MINISQL_RESULTWRITER_H
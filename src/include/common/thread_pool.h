@@ -0,0 +1,102 @@
+#ifndef MINISQL_THREAD_POOL_H
+#define MINISQL_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/macros.h"
+
+/**
+ * ThreadPool runs tasks on a fixed set of worker threads with work stealing.
+ *
+ * Every worker owns a deque: a task submitted from a worker goes to the back of its own deque and the worker takes
+ * its next task from the back, so the most recent and cache-warm work runs first. A task submitted from outside
+ * the pool goes to the shared injection queue. An idle worker looks at its own deque, then the injection queue,
+ * then steals from the front of the other deques, the oldest and usually largest pieces of work.
+ */
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  /** @param thread_count The number of worker threads, at least one */
+  explicit ThreadPool(size_t thread_count);
+
+  ~ThreadPool();
+
+  DISALLOW_COPY_AND_MOVE(ThreadPool);
+
+  /** @return the pool shared by all queries, with one worker per hardware thread */
+  static ThreadPool *GetInstance();
+
+  void Submit(Task task);
+
+  size_t GetThreadCount() const { return threads_.size(); }
+
+ private:
+  /** The deque of one worker, or the injection queue. */
+  struct WorkQueue {
+    std::mutex latch_;
+    std::deque<Task> tasks_;
+  };
+
+  /** Take a task from the own deque, the injection queue or another worker, in that order. */
+  bool PopTask(size_t self, Task &task);
+
+  void WorkerLoop(size_t self);
+
+  /** queues_[i] belongs to worker i, the last one is the injection queue */
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> threads_;
+  /** tasks submitted but not taken yet, the workers sleep while it is zero */
+  std::atomic<size_t> pending_{0};
+  std::mutex sleep_latch_;
+  std::condition_variable sleep_cv_;
+  bool stop_{false};
+};
+
+/**
+ * TaskGroup submits related tasks to a ThreadPool and waits for them.
+ *
+ * Wait closes the group: a task that has not started yet is skipped when a worker picks it up, so waiting never
+ * depends on free workers, only on the tasks already running. The first exception thrown by a task is rethrown by
+ * Wait. The state a task touches must therefore outlive only the tasks that started before Wait returned.
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool *pool) : pool_(pool), state_(std::make_shared<State>()) {}
+
+  ~TaskGroup() {
+    try {
+      Wait();
+    } catch (...) {
+    }
+  }
+
+  DISALLOW_COPY_AND_MOVE(TaskGroup);
+
+  void Submit(ThreadPool::Task task);
+
+  /** Skip the tasks not started yet, wait for the running ones and rethrow the first exception of any of them. */
+  void Wait();
+
+ private:
+  struct State {
+    std::mutex latch_;
+    std::condition_variable cv_;
+    size_t running_{0};
+    bool closed_{false};
+    std::exception_ptr error_;
+  };
+
+  ThreadPool *pool_;
+  std::shared_ptr<State> state_;
+};
+
+#endif  // MINISQL_THREAD_POOL_H
@@ -34,6 +34,11 @@ class ExecuteContext {
   /** @return the buffer pool manager */
   BufferPoolManager *GetBufferPoolManager() { return bpm_; }
 
+  /** @return the number of threads a query may run on, 1 runs every plan serially */
+  uint32_t GetMaxWorkers() const { return max_workers_; }
+
+  void SetMaxWorkers(uint32_t max_workers) { max_workers_ = max_workers == 0 ? 1 : max_workers; }
+
  private:
   /** The recovery context associated with this executor context */
   Txn *transaction_;
@@ -41,6 +46,8 @@ class ExecuteContext {
   CatalogManager *catalog_;
   /** The buffer pool manager associated with this executor context */
   BufferPoolManager *bpm_;
+  /** The degree of parallelism of the query */
+  uint32_t max_workers_{1};
 };
 
 #endif  // MINISQL_EXECUTE_CONTEXT_H
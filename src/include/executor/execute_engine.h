@@ -1,12 +1,16 @@
 #ifndef MINISQL_EXECUTE_ENGINE_H
 #define MINISQL_EXECUTE_ENGINE_H
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #include "common/dberr.h"
 #include "common/instance.h"
+#include "common/result_writer.h"
 #include "concurrency/txn.h"
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
@@ -38,8 +42,22 @@ class ExecuteEngine {
   dberr_t ExecutePlan(const AbstractPlanNodeRef &plan, std::vector<Row> *result_set, Txn *txn,
                       ExecuteContext *exec_ctx);
 
+  /**
+   * Execute a plan and hand every row to sink as soon as the root executor produces it.
+   */
+  dberr_t ExecutePlan(const AbstractPlanNodeRef &plan, const std::function<void(const Row &)> &sink, Txn *txn,
+                      ExecuteContext *exec_ctx);
+
+  void SetResultFormat(ResultFormat format) { result_format_ = format; }
+
+  /** Set the degree of parallelism of the queries, 1 runs them serially. */
+  void SetMaxWorkers(uint32_t max_workers) { max_workers_ = max_workers == 0 ? 1 : max_workers; }
+
   void ExecuteInformation(dberr_t result);
 
+  /** @return the database chosen by the last use statement, null before any */
+  DBStorageEngine *GetCurrentDatabase() { return current_db_.empty() ? nullptr : dbs_[current_db_]; }
+
  private:
   static std::unique_ptr<AbstractExecutor> CreateExecutor(ExecuteContext *exec_ctx, const AbstractPlanNodeRef &plan);
 
@@ -76,6 +94,8 @@ class ExecuteEngine {
  private:
   std::unordered_map<std::string, DBStorageEngine *> dbs_; /** all opened databases */
   std::string current_db_;                                 /** current database */
+  ResultFormat result_format_{ResultFormat::Table};        /** how the rows of a select are printed */
+  uint32_t max_workers_{std::max(1U, std::thread::hardware_concurrency())}; /** the degree of parallelism */
 };
 
 #endif  // MINISQL_EXECUTE_ENGINE_H
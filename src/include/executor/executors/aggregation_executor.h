@@ -0,0 +1,217 @@
+#ifndef MINISQL_AGGREGATION_EXECUTOR_H
+#define MINISQL_AGGREGATION_EXECUTOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/aggregation_plan.h"
+#include "executor/plans/gather_plan.h"
+
+/**
+ * AggregationHashTable maps group keys to the partial aggregates of their groups.
+ *
+ * The groups live in one vector, the table is open addressing with linear probing over slots of (hash, group) and
+ * is sized for the expected number of groups up front, it only doubles once it is half full. Input rows are folded
+ * in batches, the slots of a whole batch are prefetched before any of them is looked up. Two tables over the same
+ * aggregates merge group by group, so partial tables built on separate inputs, one per thread or one per spilled
+ * batch, combine into the final groups.
+ */
+class AggregationHashTable {
+ public:
+  /** The running state of one aggregate of a group. */
+  struct Accumulator {
+    /** non null arguments, every row for count(*) */
+    int64_t count_{0};
+    int64_t int_sum_{0};
+    double float_sum_{0};
+  };
+
+  /** A group: its group by values followed by the min or max of every aggregate, and its accumulators. */
+  struct Group {
+    uint64_t hash_{0};
+    std::string key_;
+    std::vector<Field> fields_;
+    std::vector<Accumulator> accumulators_;
+  };
+
+  /** A row to fold into its group, values_ holds the argument of every aggregate. */
+  struct Input {
+    uint64_t hash_{0};
+    std::string key_;
+    std::vector<Field> group_bys_;
+    std::vector<Field> values_;
+  };
+
+  /**
+   * @param agg_types The function of every aggregate
+   * @param value_types The type of the argument of every aggregate
+   * @param expected_groups The number of groups the slots are sized for
+   */
+  AggregationHashTable(std::vector<AggregationType> agg_types, std::vector<TypeId> value_types,
+                       size_t expected_groups);
+
+  /** Fold a batch of rows into their groups, creating the groups not seen yet. */
+  void AccumulateBatch(std::vector<Input> &batch);
+
+  /** Merge a partial group into the group with its key. */
+  void Combine(Group &&partial);
+
+  /** Merge every group of other into this table, other is left empty. */
+  void Merge(AggregationHashTable &&other);
+
+  /** @return a group for the given group by values with every aggregate empty */
+  Group NewGroup(std::vector<Field> &&group_bys) const;
+
+  /** Fold the aggregate arguments of one row into group. */
+  void Fold(Group &group, const std::vector<Field> &values) const;
+
+  /**
+   * @return the group by values followed by the final value of every aggregate
+   * @throw std::overflow_error if a count or an int sum does not fit in an int
+   */
+  std::vector<Field> Finalize(const Group &group) const;
+
+  std::vector<Group> &GetGroups() { return groups_; }
+
+  /** @return the approximate bytes taken by the groups */
+  uint64_t GetBytes() const { return bytes_; }
+
+  void Clear();
+
+  /** Build a key from group by values, a null is a value of its own. */
+  static void MakeKey(const std::vector<Field> &group_bys, std::string &key, uint64_t &hash);
+
+ private:
+  /** A slot of the table, head_ is one past the index of the group, 0 marks an empty slot. */
+  struct Slot {
+    uint64_t hash_;
+    uint32_t head_;
+  };
+
+  /** @return the index of the group of key, a new group built by make_group if there is none */
+  template <typename MakeGroup>
+  size_t FindOrInsert(uint64_t hash, const std::string &key, MakeGroup &&make_group);
+
+  void Resize(size_t capacity);
+
+  std::vector<AggregationType> agg_types_;
+  std::vector<TypeId> value_types_;
+  std::vector<Slot> slots_;
+  std::vector<Group> groups_;
+  uint64_t bytes_{0};
+};
+
+/**
+ * AggregationExecutor computes the aggregates of its child per group through an AggregationHashTable.
+ *
+ * Without group by expressions there is only one group and the rows are folded straight into it, and a bare count(*)
+ * over a bitmap scan whose bitmaps answer the whole predicate is read off their cardinality. Once the groups
+ * exceed the memory budget, they are written to temporary pages as partial groups, split into partitions by hash,
+ * and the table starts over. At the end the partial groups of every partition are merged back one partition at
+ * a time, so a partition only has to hold its own share of the groups. A partition whose groups still exceed the
+ * budget is split again with another hash seed, up to MAX_REPARTITION_LEVEL times.
+ *
+ * Over a gather the scan runs on several workers, each folding its rows into a table of its own. The local tables
+ * are then repartitioned by hash and every partition is combined by one worker, so no table is ever shared. A local
+ * table over its share of the budget is merged into the shared table under a latch, which spills as above.
+ */
+class AggregationExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new AggregationExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The aggregation plan to be executed
+   * @param child_executor The executor producing the rows to aggregate
+   */
+  AggregationExecutor(ExecuteContext *exec_ctx, const AggregationPlanNode *plan,
+                      std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  ~AggregationExecutor() override;
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+  /** @return true if the last Init had to write partial groups to pages */
+  bool IsSpilled() const { return spilled_; }
+
+  /** @return true if the partial groups of a partition had to be split again */
+  bool IsRepartitioned() const { return partitions_.size() > PARTITION_COUNT; }
+
+  /** Input rows folded together */
+  static constexpr uint32_t BATCH_SIZE = 64;
+
+  /** Groups the table is sized for before it grows */
+  static constexpr uint32_t EXPECTED_GROUPS = 1024;
+
+  /** Partitions of the spilled partial groups */
+  static constexpr uint32_t PARTITION_COUNT = 16;
+
+  /** How many times the groups of one partition are split again at most */
+  static constexpr uint32_t MAX_REPARTITION_LEVEL = 3;
+
+ private:
+  /** The partial groups of one partition written to pages, the last ones are buffered in a page image. */
+  struct Partition {
+    std::vector<page_id_t> pages_;
+    std::unique_ptr<char[]> buffer_;
+    uint32_t buffer_size_{0};
+    uint32_t buffer_count_{0};
+    /** how many times the groups of this partition were split, 0 for the partitions of Init */
+    uint32_t level_{0};
+  };
+
+  /** @return the partition among the PARTITION_COUNT ones of level that group belongs to */
+  static uint32_t PartitionOf(const AggregationHashTable::Group &group, uint32_t level);
+
+  std::unique_ptr<AggregationHashTable> MakeTable() const;
+
+  /** @return the argument of every aggregate for row */
+  std::vector<Field> EvaluateValues(const Row &row) const;
+
+  /** @return row as an input of its group */
+  AggregationHashTable::Input MakeInput(const Row &row) const;
+
+  /** Aggregate the rows of the child executor on this thread. */
+  void AggregateSerial();
+
+  /** Aggregate the rows of the scan under gather on the workers of the query. */
+  void AggregateParallel(const GatherPlanNode *gather);
+
+  /**
+   * Write every group of table_ to the page of its partition and empty the table.
+   * @param base The index of the first partition of level
+   */
+  void SpillGroups(uint32_t base = 0, uint32_t level = 0);
+
+  void FlushBuffer(Partition &partition);
+
+  /**
+   * Merge the partial groups of the next partition into table_, a partition over the budget is split into new
+   * partitions instead. @return false if there is none left
+   */
+  bool NextPartition();
+
+  void DropPartitions();
+
+  /** seed of the partition hash of the levels above 0, independent of the seeds of HashUtil::Murmur3_64 */
+  static constexpr uint32_t REPARTITION_SEED = 0x2545f491;
+
+  const AggregationPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  std::unique_ptr<AggregationHashTable> table_;
+  /** The group by and min or max fields of a group, to write it to pages */
+  std::unique_ptr<Schema> group_schema_;
+
+  bool spilled_{false};
+  std::vector<Partition> partitions_;
+  uint32_t next_partition_{0};
+  size_t group_cursor_{0};
+};
+
+#endif  // MINISQL_AGGREGATION_EXECUTOR_H
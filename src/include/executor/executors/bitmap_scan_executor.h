@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/bitmap_scan_plan.h"
+#include "index/roaring_bitmap.h"
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/logic_expression.h"
+
+/**
+ * The BitmapScanExecutor turns the predicate into a bitmap of row ordinals:
+ * a comparison on a bitmap indexed column is the union of the bitmaps of the
+ * matching keys, "and" intersects and "or" unites the bitmaps of its children.
+ * An "and" child no bitmap index can answer is left out, which only widens
+ * the candidates, so the whole predicate is evaluated on every fetched row.
+ * Rows are fetched in ordinal order, which is page order.
+ */
+class BitmapScanExecutor : public AbstractExecutor {
+ public:
+  BitmapScanExecutor(ExecuteContext *exec_ctx, const BitmapScanPlanNode *plan);
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+  /**
+   * Count the matching rows from the bitmap cardinalities alone, must be called after Init.
+   * @return false if the bitmaps only bound the matches and the rows have to be fetched
+   */
+  bool CountMatches(uint64_t &count) const;
+
+ private:
+  /**
+   * @param[out] result The ordinals of the rows that may satisfy predicate
+   * @param[out] exact Whether result holds exactly the rows satisfying predicate
+   * @return false if no bitmap index can narrow down predicate
+   */
+  bool EvaluateBitmap(const AbstractExpressionRef &predicate, RoaringBitmap &result, bool &exact);
+
+  const BitmapScanPlanNode *plan_;
+  TableInfo *table_info_{};
+  RoaringBitmap matches_;
+  bool exact_{false};
+  std::vector<uint32_t> ordinals_;
+  size_t cursor_{0};
+};
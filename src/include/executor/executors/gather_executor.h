@@ -0,0 +1,84 @@
+#ifndef MINISQL_GATHER_EXECUTOR_H
+#define MINISQL_GATHER_EXECUTOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/thread_pool.h"
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "executor/plans/gather_plan.h"
+#include "executor/query_scheduler.h"
+
+/**
+ * GatherExecutor runs a sequential scan on the shared thread pool and hands out its rows one at a time.
+ *
+ * Producer tasks pull morsels of the table, scan them with their own SeqScanExecutor and queue the rows in batches.
+ * The queue is bounded, a producer waits while it is full, so a slow consumer keeps the memory used small. When the
+ * queue is empty the consumer scans the next morsel itself instead of waiting, so the scan finishes even if no pool
+ * thread is free. Destroying or re-initializing the executor stops the producers and waits for the running ones.
+ */
+class GatherExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new GatherExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The gather plan to be executed
+   */
+  GatherExecutor(ExecuteContext *exec_ctx, const GatherPlanNode *plan);
+
+  ~GatherExecutor() override;
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+  /** Rows per batch handed from a producer to the consumer */
+  static constexpr size_t BATCH_ROWS = 256;
+  /** Batches queued per producer before the producers wait */
+  static constexpr size_t QUEUED_BATCHES = 4;
+
+ private:
+  /** The task of producer scan_index, runs until the table is exhausted or the executor stops. */
+  void Produce(uint32_t scan_index);
+
+  /**
+   * Scan the next morsel with scan on the calling thread, handing its rows to emit.
+   * @return false if no morsel is left or emit returned false
+   */
+  bool ScanMorsel(SeqScanExecutor *scan, const std::function<bool(Row &)> &emit);
+
+  /** Queue a full batch of a producer, false if the executor stopped while waiting for room. */
+  bool Publish(std::vector<Row> &rows);
+
+  /** Stop the producers and wait for the running ones. */
+  void Stop();
+
+  const GatherPlanNode *plan_;
+  /** scans_[0] belongs to the consumer, the others to one producer each */
+  std::vector<std::unique_ptr<SeqScanExecutor>> scans_;
+  std::unique_ptr<TableMorselSource> source_;
+  std::unique_ptr<TaskGroup> producers_;
+  std::mutex latch_;
+  std::condition_variable cv_;
+  std::deque<std::vector<Row>> batches_;
+  size_t max_batches_{0};
+  /** threads scanning a morsel right now */
+  uint32_t busy_{0};
+  bool exhausted_{false};
+  bool stopped_{false};
+  std::exception_ptr error_;
+  /** the batch the consumer is handing out */
+  std::vector<Row> batch_;
+  size_t batch_pos_{0};
+};
+
+#endif  // MINISQL_GATHER_EXECUTOR_H
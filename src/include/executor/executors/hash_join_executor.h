@@ -0,0 +1,174 @@
+#ifndef MINISQL_HASH_JOIN_EXECUTOR_H
+#define MINISQL_HASH_JOIN_EXECUTOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/hash_join_plan.h"
+
+/**
+ * HashJoinExecutor joins its children on equal keys.
+ *
+ * Both children are read in turns until one of them ends, that one is the smaller input and becomes the build
+ * side, the rows read of the other side are probed first and the rest of it is streamed. A row whose key has a
+ * null never matches and is dropped.
+ *
+ * Once the rows read exceed the memory budget before either side ended, both sides are split into partitions by
+ * the hash of their keys (grace hash join). A partition stays in memory until the partitions together exceed the
+ * budget, then the highest ones are written to temporary pages, so the first partitions are usually joined without
+ * any I/O (hybrid hash join). Every partition builds on whichever of its two sides is smaller. A partition whose
+ * smaller side still exceeds the budget is split again with another hash seed, up to MAX_REPARTITION_LEVEL times,
+ * deeper ones only hold rows of too few keys to split and are built in memory. A spilled row must fit in a page.
+ *
+ * The hash table uses open addressing with linear probing over slots of (hash, first row), rows with equal keys are
+ * chained behind the first. Probe rows are looked up in batches, the slots of a whole batch are prefetched before
+ * any of them is compared.
+ */
+class HashJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new HashJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The hash join plan to be executed
+   * @param left_executor The executor producing the left rows
+   * @param right_executor The executor producing the right rows
+   */
+  HashJoinExecutor(ExecuteContext *exec_ctx, const HashJoinPlanNode *plan,
+                   std::unique_ptr<AbstractExecutor> &&left_executor,
+                   std::unique_ptr<AbstractExecutor> &&right_executor);
+
+  ~HashJoinExecutor() override;
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+  /** @return true if the last Init had to partition its inputs */
+  bool IsPartitioned() const { return partitioned_; }
+
+  /** @return true if a partition had to be split again */
+  bool IsRepartitioned() const { return partitions_[0].size() > PARTITION_COUNT; }
+
+  /** Probe rows looked up together */
+  static constexpr uint32_t PROBE_BATCH_SIZE = 64;
+
+  /** Partitions per side in the grace mode */
+  static constexpr uint32_t PARTITION_COUNT = 16;
+
+  /** How many times the rows of one partition are split again at most */
+  static constexpr uint32_t MAX_REPARTITION_LEVEL = 3;
+
+ private:
+  /** A row with its normalized join key. */
+  struct KeyedRow {
+    uint64_t hash_{0};
+    std::string key_;
+    Row row_;
+  };
+
+  /**
+   * The rows of one side that fall into one partition, the last rows are buffered in a page image until
+   * the page is full.
+   */
+  struct Partition {
+    std::vector<KeyedRow> rows_;
+    std::vector<page_id_t> pages_;
+    std::unique_ptr<char[]> buffer_;
+    uint32_t buffer_size_{0};
+    uint32_t buffer_count_{0};
+    uint64_t resident_bytes_{0};
+    uint64_t total_bytes_{0};
+    bool spilled_{false};
+    /** how many times the rows of this partition were split, 0 for the partitions of Init */
+    uint32_t level_{0};
+  };
+
+  /** A slot of the hash table, head_ is one past the index of the first build row, 0 marks an empty slot. */
+  struct Slot {
+    uint64_t hash_;
+    uint32_t head_;
+  };
+
+  /**
+   * Evaluate the keys of a side on row and serialize them, floats are normalized so 0 and -0 are equal.
+   * @return false if a key is null
+   */
+  bool MakeKey(int side, Row &&row, KeyedRow &keyed) const;
+
+  /** @return the partition among the PARTITION_COUNT ones of level that keyed belongs to */
+  static uint32_t PartitionOf(const KeyedRow &keyed, uint32_t level);
+
+  static uint64_t RowBytes(const Row &row);
+
+  /** Build the hash table over rows. */
+  void Build(std::vector<KeyedRow> &&rows);
+
+  /** @return the next probe row, taken from probe_rows_, then probe_pages_, then probe_child_ */
+  bool NextProbeRow(KeyedRow &keyed);
+
+  /** Look up the next batch of probe rows and queue the joined rows. */
+  bool ProbeBatch();
+
+  void Emit(const Row &build_row, const Row &probe_row);
+
+  /**
+   * Add a row to the partitions of its side, spilling partitions while the resident rows exceed the budget.
+   * @param base The index of the first partition of level
+   */
+  void AddToPartition(int side, KeyedRow &&keyed, uint32_t base, uint32_t level);
+
+  /** Write the resident rows of both sides of partition index to pages. */
+  void Spill(uint32_t index);
+
+  /** @throw std::runtime_error if the row does not fit in a page */
+  void SpillRow(Partition &partition, int side, const Row &row);
+
+  void FlushBuffer(Partition &partition);
+
+  /** Read back the rows of a partition page, the page is deleted afterwards. */
+  void LoadPage(int side, page_id_t page_id, std::vector<KeyedRow> &rows);
+
+  /** Build and set up the probe for the next partition. */
+  bool NextPartition();
+
+  /** Split both sides of partition index into PARTITION_COUNT new partitions of the next level. */
+  void Repartition(uint32_t index);
+
+  void DropPartitions();
+
+  /** seed of the partition hash of the levels above 0, independent of the seeds of HashUtil::Murmur3_64 */
+  static constexpr uint32_t REPARTITION_SEED = 0x2545f491;
+
+  AbstractExecutor *Child(int side) const { return side == 0 ? left_executor_.get() : right_executor_.get(); }
+
+  const HashJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  std::vector<Slot> slots_;
+  std::vector<KeyedRow> build_rows_;
+  /** one past the index of the next build row with the same key, 0 ends the chain */
+  std::vector<uint32_t> next_;
+  int build_side_{1};
+
+  std::vector<KeyedRow> probe_rows_;
+  size_t probe_cursor_{0};
+  std::vector<page_id_t> probe_pages_;
+  size_t probe_page_cursor_{0};
+  AbstractExecutor *probe_child_{nullptr};
+
+  bool partitioned_{false};
+  std::vector<Partition> partitions_[2];
+  uint64_t resident_bytes_{0};
+  uint32_t next_partition_{0};
+
+  std::vector<Row> output_;
+  size_t output_cursor_{0};
+};
+
+#endif  // MINISQL_HASH_JOIN_EXECUTOR_H
@@ -0,0 +1,65 @@
+#ifndef MINISQL_INDEX_NESTED_LOOP_JOIN_EXECUTOR_H
+#define MINISQL_INDEX_NESTED_LOOP_JOIN_EXECUTOR_H
+
+#include <memory>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/index_nested_loop_join_plan.h"
+
+/**
+ * IndexNestedLoopJoinExecutor probes the index of the inner table with the keys of the outer rows.
+ *
+ * Outer rows are read in batches and sorted by key, so outer rows with equal keys share one probe and
+ * consecutive probes descend into neighbouring leaves. The inner rows found for a key are fetched from the
+ * table heap, or rebuilt from the index entries for index-only plans, and filtered once before they are
+ * joined with every outer row of the key. An outer key with a null never matches.
+ */
+class IndexNestedLoopJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new IndexNestedLoopJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The index nested loop join plan to be executed
+   * @param outer_executor The executor producing the outer rows
+   */
+  IndexNestedLoopJoinExecutor(ExecuteContext *exec_ctx, const IndexNestedLoopJoinPlanNode *plan,
+                              std::unique_ptr<AbstractExecutor> &&outer_executor);
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+  /** Outer rows sorted and probed together */
+  static constexpr uint32_t OUTER_BATCH_SIZE = 256;
+
+ private:
+  /** An outer row with the fields of its probe key. */
+  struct OuterRow {
+    Row key_;
+    Row row_;
+  };
+
+  /** Read the next batch of outer rows and join it, @return false once the outer side is exhausted */
+  bool JoinBatch();
+
+  /** Collect the inner rows of key that pass the inner predicate. */
+  void Probe(const Row &key, std::vector<Row> &inner_rows);
+
+  void Emit(const Row &outer_row, const Row &inner_row);
+
+  const IndexNestedLoopJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> outer_executor_;
+  /** the outer executor returned false, it is not asked again */
+  bool outer_done_{false};
+  TableInfo *inner_table_{nullptr};
+  /** Position of every inner table column in the index entry for index-only plans. */
+  std::vector<int> entry_positions_;
+  std::vector<Row> output_;
+  size_t output_cursor_{0};
+};
+
+#endif  // MINISQL_INDEX_NESTED_LOOP_JOIN_EXECUTOR_H
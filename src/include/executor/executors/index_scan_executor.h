@@ -7,9 +7,16 @@
 #include "executor/plans/index_scan_plan.h"
 #include "planner/expressions/column_value_expression.h"
 #include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/logic_expression.h"
 
 /**
  * The IndexScanExecutor executor can over a table.
+ *
+ * The conjuncts of the predicate that bound a leftmost prefix of an index key,
+ * equalities on the leading columns plus a range on the next one, drive the
+ * scan: that key range is opened as a cursor and row ids are pulled lazily,
+ * the whole predicate is evaluated on every fetched row. Index-only plans rebuild the row from the index entry
+ * and never touch the table heap.
  */
 class IndexScanExecutor : public AbstractExecutor {
  public:
@@ -39,12 +46,25 @@ class IndexScanExecutor : public AbstractExecutor {
   void TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row, Row *output_row);
 
  private:
-  vector<RowId> IndexScan(AbstractExpressionRef predicate);
+  /** Choose the driving index range and open the cursors over it. */
+  void OpenCursors();
+
+  /**
+   * @param[out] entry The index entry of the row id, only filled when not nullptr
+   * @return false once every cursor is exhausted
+   */
+  bool NextRowId(RowId &rid, Row *entry);
+
+  /** Spread the fields of a covering index entry over a table row, columns missing from the index are null. */
+  void RowFromIndexEntry(const Row &entry, Row *row);
 
   /** The sequential scan plan node to be executed */
   const IndexScanPlanNode *plan_;
   TableInfo *table_info_{};
-  vector<RowId> result_;
+  /** Cursors over the driving index, "<>" scans the two ranges around the key. */
+  vector<IndexScanIteratorRef> cursors_;
   size_t cursor_ = 0;
+  /** Position of every table column in the index entry for index-only scans, -1 if absent. */
+  vector<int> entry_positions_;
   bool is_schema_same_;
 };
\ No newline at end of file
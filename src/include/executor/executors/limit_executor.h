@@ -0,0 +1,40 @@
+#ifndef MINISQL_LIMIT_EXECUTOR_H
+#define MINISQL_LIMIT_EXECUTOR_H
+
+#include <memory>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/limit_plan.h"
+
+/**
+ * LimitExecutor passes on the rows of its child after the offset until the limit is reached.
+ *
+ * The child is never asked for a row past the last one output, so a pipeline below it stops as soon as the limit
+ * is reached. A limit of zero does not even initialize the child.
+ */
+class LimitExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new LimitExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The limit plan to be executed
+   * @param child_executor The executor producing the rows
+   */
+  LimitExecutor(ExecuteContext *exec_ctx, const LimitPlanNode *plan,
+                std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+ private:
+  const LimitPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  uint32_t skipped_{0};
+  uint32_t emitted_{0};
+};
+
+#endif  // MINISQL_LIMIT_EXECUTOR_H
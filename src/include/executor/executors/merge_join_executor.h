@@ -0,0 +1,66 @@
+#ifndef MINISQL_MERGE_JOIN_EXECUTOR_H
+#define MINISQL_MERGE_JOIN_EXECUTOR_H
+
+#include <memory>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/merge_join_plan.h"
+
+/**
+ * MergeJoinExecutor joins two children ordered by their join keys in one pass over both of them.
+ *
+ * Only the right rows of the current key are kept, every left row with that key is joined with all of them,
+ * so the memory used is bounded by the longest run of equal right keys. A row whose key is null never matches
+ * and is skipped.
+ */
+class MergeJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new MergeJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The merge join plan to be executed
+   * @param left_executor The executor producing the left rows in key order
+   * @param right_executor The executor producing the right rows in key order
+   */
+  MergeJoinExecutor(ExecuteContext *exec_ctx, const MergeJoinPlanNode *plan,
+                    std::unique_ptr<AbstractExecutor> &&left_executor,
+                    std::unique_ptr<AbstractExecutor> &&right_executor);
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+ private:
+  /** The current row of one side and its key. */
+  struct Cursor {
+    Row row_;
+    std::unique_ptr<Field> key_;
+  };
+
+  /** Move a side to its next row with a non null key, @return false once the side is exhausted */
+  bool Advance(int side);
+
+  /** Take one step of the merge, queueing the rows it joins, @return false once the join is done */
+  bool MergeStep();
+
+  void Emit(const Row &left_row, const Row &right_row);
+
+  const MergeJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  Cursor cursors_[2];
+  bool valid_[2] = {false, false};
+  /** The right rows whose key is group_key_ */
+  std::vector<Row> group_rows_;
+  std::unique_ptr<Field> group_key_;
+
+  std::vector<Row> output_;
+  size_t output_cursor_{0};
+};
+
+#endif  // MINISQL_MERGE_JOIN_EXECUTOR_H
@@ -10,9 +10,16 @@
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/seq_scan_plan.h"
+#include "executor/query_scheduler.h"
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/logic_expression.h"
 
 /**
  * The SeqScanExecutor executor executes a sequential table scan.
+ *
+ * A scan can also be restricted to one morsel of pages after Init, so several executors over the same plan scan
+ * one table in parallel.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -34,6 +41,9 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   bool Next(Row *row, RowId *rid) override;
 
+  /** Restart the scan at the first page of morsel, Next stops at the end of it. */
+  void SetMorsel(const Morsel &morsel);
+
   /** @return The output schema for the sequential scan */
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
@@ -42,12 +52,21 @@ class SeqScanExecutor : public AbstractExecutor {
   void TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row, Row *output_row);
 
  private:
+  /** @return false if a block range index proves no row of the page satisfies the predicate */
+  bool PageMayMatch(page_id_t page_id);
+
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
   TableInfo *table_info_{};
   TableIterator iterator_;
   const Schema *schema_{};
   bool is_schema_same_;
+  /** comparisons of the predicate that must all hold, each paired with a block range index on its column */
+  std::vector<std::pair<BrinIndex *, ComparisonExpression *>> page_filters_;
+  /** the last page checked against page_filters_ */
+  page_id_t checked_page_id_{INVALID_PAGE_ID};
+  /** the pages Next is restricted to, none if empty */
+  Morsel morsel_;
 };
 
 #endif  // MINISQL_SEQ_SCAN_EXECUTOR_H
@@ -0,0 +1,114 @@
+#ifndef MINISQL_SORT_EXECUTOR_H
+#define MINISQL_SORT_EXECUTOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/sort_plan.h"
+
+/**
+ * SortExecutor orders the rows of its child with an external merge sort.
+ *
+ * Every row gets a normalized sort key, a byte string whose memcmp order is the order of the sort keys with their
+ * directions, so sorting and merging compare plain bytes instead of fields. Rows are collected until they exceed
+ * the memory budget, then sorted and written to temporary pages as a run. The rows left at the end are sorted in
+ * memory and become the last run, so an input that fits the budget is never written.
+ *
+ * The runs are merged through a loser tree, a written run is read back one page at a time and its pages are
+ * deleted once read. When there are more runs than pages in the budget, groups of them are first merged into
+ * longer runs, so the final merge never holds more pages than the budget allows.
+ */
+class SortExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new SortExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The sort plan to be executed
+   * @param child_executor The executor producing the rows to sort
+   */
+  SortExecutor(ExecuteContext *exec_ctx, const SortPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  ~SortExecutor() override;
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+  /** @return the number of runs the last Init wrote to pages, the runs of intermediate merges included */
+  size_t GetSpilledRunCount() const { return spilled_runs_; }
+
+  /**
+   * Append the normalized form of field to key, descending fields have every byte inverted.
+   * A null sorts before every value, integers and floats are written big endian with their sign bit flipped,
+   * strings escape their zero bytes and end with two zero bytes, so a prefix sorts first.
+   */
+  static void AppendSortKey(const Field &field, bool descending, std::string &key);
+
+ private:
+  /** A row with its normalized sort key. */
+  struct SortRow {
+    std::string key_;
+    Row row_;
+  };
+
+  /** A sorted run, the rows of its current page and the pages still to read. */
+  struct Run {
+    std::vector<SortRow> rows_;
+    size_t row_cursor_{0};
+    std::vector<page_id_t> pages_;
+    size_t page_cursor_{0};
+  };
+
+  /** A run being written, the last rows are buffered in a page image. */
+  struct RunWriter {
+    Run run_;
+    std::unique_ptr<char[]> buffer_;
+    uint32_t buffer_size_{0};
+    uint32_t buffer_count_{0};
+  };
+
+  SortRow MakeSortRow(Row &&row) const;
+
+  /** Sort rows and write them to pages as a new run. */
+  void SpillRun(std::vector<SortRow> &rows);
+
+  void WriteRow(RunWriter &writer, const Row &row);
+
+  void FlushPage(RunWriter &writer);
+
+  /** Load the next page of run when its rows are used up, @return false once the run is exhausted */
+  bool Fill(Run &run);
+
+  /** Merge runs [begin, end) into one run written to pages. */
+  Run MergeRuns(size_t begin, size_t end);
+
+  /** @return true if the current row of run lhs comes first, an exhausted run comes last, a tie goes to lhs */
+  bool Beats(const Run &lhs, const Run &rhs) const;
+
+  /**
+   * Build a loser tree over runs, tree[0] holds the winner and tree[n] the loser of the match at node n, the
+   * leaf of run begin + i sits at position end - begin + i.
+   */
+  void BuildTree(std::vector<Run> &runs, size_t begin, size_t end, std::vector<size_t> &tree) const;
+
+  /** Replay the matches from the leaf of run index up to the root after its current row changed. */
+  void ReplayTree(std::vector<Run> &runs, size_t begin, size_t end, size_t index, std::vector<size_t> &tree) const;
+
+  void DropRuns();
+
+  const SortPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  /** Whether the output schema picks columns of the child row by their table index */
+  bool project_{false};
+  std::vector<Run> runs_;
+  /** The loser tree of the final merge over runs_ */
+  std::vector<size_t> tree_;
+  size_t spilled_runs_{0};
+};
+
+#endif  // MINISQL_SORT_EXECUTOR_H
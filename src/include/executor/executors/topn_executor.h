@@ -0,0 +1,56 @@
+#ifndef MINISQL_TOPN_EXECUTOR_H
+#define MINISQL_TOPN_EXECUTOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/topn_plan.h"
+
+/**
+ * TopNExecutor keeps the first n rows of its child in a bounded heap.
+ *
+ * Rows are compared by the normalized sort keys of the SortExecutor, with their arrival number breaking ties. The
+ * heap is a max heap of at most n rows, a row that does not sort before its top is dropped right away, so the
+ * memory used depends on n alone and the child is read once without ever being written to pages.
+ */
+class TopNExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new TopNExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The top-n plan to be executed
+   * @param child_executor The executor producing the rows
+   */
+  TopNExecutor(ExecuteContext *exec_ctx, const TopNPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child_executor);
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+ private:
+  /** A row with its normalized sort key and its arrival number. */
+  struct HeapRow {
+    std::string key_;
+    uint64_t seq_;
+    Row row_;
+  };
+
+  static bool Before(const HeapRow &lhs, const HeapRow &rhs) {
+    return lhs.key_ < rhs.key_ || (lhs.key_ == rhs.key_ && lhs.seq_ < rhs.seq_);
+  }
+
+  const TopNPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  /** Whether the output schema picks columns of the child row by their table index */
+  bool project_{false};
+  /** The heap while reading the child, the rows in output order afterwards */
+  std::vector<HeapRow> rows_;
+  size_t cursor_{0};
+};
+
+#endif  // MINISQL_TOPN_EXECUTOR_H
@@ -15,6 +15,7 @@
 enum class PlanType {
   SeqScan,
   IndexScan,
+  BitmapScan,
   Insert,
   Update,
   Delete,
@@ -23,6 +24,12 @@ enum class PlanType {
   Limit,
   Distinct,
   NestedLoopJoin,
+  HashJoin,
+  IndexNestedLoopJoin,
+  MergeJoin,
+  Sort,
+  TopN,
+  Gather,
 };
 
 class AbstractPlanNode;
@@ -0,0 +1,66 @@
+#ifndef MINISQL_AGGREGATION_PLAN_H
+#define MINISQL_AGGREGATION_PLAN_H
+
+#include <utility>
+#include <vector>
+
+#include "abstract_plan.h"
+#include "common/config.h"
+#include "planner/expressions/abstract_expression.h"
+
+/** The aggregate functions of a select list. */
+enum class AggregationType { CountStar, Count, Sum, Avg, Min, Max };
+
+/**
+ * AggregationPlanNode groups the rows of its child by the group by expressions and computes the aggregates of
+ * every group. Without group by expressions the whole input is one group, which yields one row even for no input.
+ * The output schema refers to the group by values followed by the aggregate values, the table index of an output
+ * column is its index in that row.
+ */
+class AggregationPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new AggregationPlanNode instance.
+   * @param output The output schema of the aggregation
+   * @param child The plan producing the rows to aggregate
+   * @param group_bys The group by expressions, evaluated on a child row
+   * @param aggregates The arguments of the aggregates, evaluated on a child row, null for count(*)
+   * @param agg_types The function of every aggregate
+   * @param memory_budget The bytes the groups may take before partial groups are written to pages
+   */
+  AggregationPlanNode(const Schema *output, AbstractPlanNodeRef child, std::vector<AbstractExpressionRef> group_bys,
+                      std::vector<AbstractExpressionRef> aggregates, std::vector<AggregationType> agg_types,
+                      uint32_t memory_budget = DEFAULT_MEMORY_BUDGET)
+      : AbstractPlanNode(output, {std::move(child)}),
+        group_bys_(std::move(group_bys)),
+        aggregates_(std::move(aggregates)),
+        agg_types_(std::move(agg_types)),
+        memory_budget_(memory_budget) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::Aggregation; }
+
+  /** @return The plan producing the rows to aggregate */
+  AbstractPlanNodeRef GetChildPlan() const { return GetChildAt(0); }
+
+  const std::vector<AbstractExpressionRef> &GetGroupBys() const { return group_bys_; }
+
+  const std::vector<AbstractExpressionRef> &GetAggregates() const { return aggregates_; }
+
+  const std::vector<AggregationType> &GetAggregateTypes() const { return agg_types_; }
+
+  uint32_t GetMemoryBudget() const { return memory_budget_; }
+
+  /** 64 pages worth of groups */
+  static constexpr uint32_t DEFAULT_MEMORY_BUDGET = 64 * PAGE_SIZE;
+
+  std::vector<AbstractExpressionRef> group_bys_;
+
+  std::vector<AbstractExpressionRef> aggregates_;
+
+  std::vector<AggregationType> agg_types_;
+
+  uint32_t memory_budget_;
+};
+
+#endif  // MINISQL_AGGREGATION_PLAN_H
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "abstract_plan.h"
+#include "catalog/catalog.h"
+#include "planner/expressions/abstract_expression.h"
+
+/**
+ * BitmapScanPlanNode answers a predicate of "and"s and "or"s over columns
+ * with bitmap indexes by combining the bitmaps of the comparisons.
+ */
+class BitmapScanPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new bitmap scan plan node.
+   * @param output the output format of this scan plan node
+   * @param table_name The identifier of table to be scanned
+   * @param indexes The single column bitmap indexes of the table
+   */
+  BitmapScanPlanNode(const Schema *output, std::string table_name, std::vector<IndexInfo *> indexes,
+                     AbstractExpressionRef filter_predicate)
+      : AbstractPlanNode(output, {}),
+        table_name_(std::move(table_name)),
+        indexes_(std::move(indexes)),
+        filter_predicate_(std::move(filter_predicate)) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::BitmapScan; }
+
+  /** @return The identifier of the table that should be scanned */
+  std::string GetTableName() const { return table_name_; }
+
+  AbstractExpressionRef GetPredicate() const { return filter_predicate_; }
+
+  /** The table name */
+  std::string table_name_;
+
+  /** The bitmap indexes */
+  std::vector<IndexInfo *> indexes_;
+
+  /** The predicate, it is evaluated again on every fetched row */
+  AbstractExpressionRef filter_predicate_;
+};
@@ -0,0 +1,33 @@
+#ifndef MINISQL_GATHER_PLAN_H
+#define MINISQL_GATHER_PLAN_H
+
+#include "abstract_plan.h"
+#include "executor/plans/seq_scan_plan.h"
+
+/**
+ * GatherPlanNode runs its sequential scan on several threads at once and collects their rows into one stream.
+ * The rows come out in no particular order, so it is only planned below operators that do not depend on it.
+ */
+class GatherPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new GatherPlanNode instance.
+   * @param output The output schema, the one of the scan
+   * @param child The sequential scan run in parallel
+   * @param dop The maximum number of threads scanning at once
+   */
+  GatherPlanNode(const Schema *output, AbstractPlanNodeRef child, uint32_t dop)
+      : AbstractPlanNode(output, {std::move(child)}), dop_(dop) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::Gather; }
+
+  /** @return The sequential scan run in parallel */
+  const SeqScanPlanNode *GetScanPlan() const { return dynamic_cast<const SeqScanPlanNode *>(GetChildAt(0).get()); }
+
+  uint32_t GetDop() const { return dop_; }
+
+  uint32_t dop_;
+};
+
+#endif  // MINISQL_GATHER_PLAN_H
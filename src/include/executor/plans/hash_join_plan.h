@@ -0,0 +1,66 @@
+#ifndef MINISQL_HASH_JOIN_PLAN_H
+#define MINISQL_HASH_JOIN_PLAN_H
+
+#include <utility>
+#include <vector>
+
+#include "abstract_plan.h"
+#include "common/config.h"
+#include "planner/expressions/abstract_expression.h"
+
+/**
+ * HashJoinPlanNode joins the rows of its two children on equal keys.
+ * The output schema refers to the left row followed by the right row, the table index
+ * of an output column is its index in that concatenated row.
+ */
+class HashJoinPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new HashJoinPlanNode instance.
+   * @param output The output schema of the join
+   * @param left The plan producing the left rows
+   * @param right The plan producing the right rows
+   * @param left_keys The join keys, evaluated on a left row
+   * @param right_keys The join keys, evaluated on a right row, paired with left_keys by position
+   * @param predicate The remaining join condition, evaluated with EvaluateJoin(left, right), may be null
+   * @param memory_budget The bytes of rows the build side may keep in memory before partitions spill to pages
+   */
+  HashJoinPlanNode(const Schema *output, AbstractPlanNodeRef left, AbstractPlanNodeRef right,
+                   std::vector<AbstractExpressionRef> left_keys, std::vector<AbstractExpressionRef> right_keys,
+                   AbstractExpressionRef predicate = nullptr, uint32_t memory_budget = DEFAULT_MEMORY_BUDGET)
+      : AbstractPlanNode(output, {std::move(left), std::move(right)}),
+        left_keys_(std::move(left_keys)),
+        right_keys_(std::move(right_keys)),
+        predicate_(std::move(predicate)),
+        memory_budget_(memory_budget) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::HashJoin; }
+
+  /** @return The plan producing the left rows */
+  AbstractPlanNodeRef GetLeftPlan() const { return GetChildAt(0); }
+
+  /** @return The plan producing the right rows */
+  AbstractPlanNodeRef GetRightPlan() const { return GetChildAt(1); }
+
+  const std::vector<AbstractExpressionRef> &GetLeftKeys() const { return left_keys_; }
+
+  const std::vector<AbstractExpressionRef> &GetRightKeys() const { return right_keys_; }
+
+  AbstractExpressionRef GetPredicate() const { return predicate_; }
+
+  uint32_t GetMemoryBudget() const { return memory_budget_; }
+
+  /** 64 pages worth of rows */
+  static constexpr uint32_t DEFAULT_MEMORY_BUDGET = 64 * PAGE_SIZE;
+
+  std::vector<AbstractExpressionRef> left_keys_;
+
+  std::vector<AbstractExpressionRef> right_keys_;
+
+  AbstractExpressionRef predicate_;
+
+  uint32_t memory_budget_;
+};
+
+#endif  // MINISQL_HASH_JOIN_PLAN_H
@@ -0,0 +1,71 @@
+#ifndef MINISQL_INDEX_NESTED_LOOP_JOIN_PLAN_H
+#define MINISQL_INDEX_NESTED_LOOP_JOIN_PLAN_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_plan.h"
+#include "catalog/catalog.h"
+#include "planner/expressions/abstract_expression.h"
+
+/**
+ * IndexNestedLoopJoinPlanNode joins the rows of its child, the outer side, with the rows of a table found
+ * through a B+ tree index on the inner table. The output schema refers to the outer row followed by the whole
+ * inner row, like the one of HashJoinPlanNode.
+ */
+class IndexNestedLoopJoinPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new IndexNestedLoopJoinPlanNode instance.
+   * @param output The output schema of the join
+   * @param outer The plan producing the outer rows
+   * @param inner_table_name The table probed for every outer row
+   * @param inner_index The B+ tree index of the inner table that is probed
+   * @param outer_keys Evaluated on an outer row, one per leading column of the index key
+   * @param inner_predicate The filter on the inner table alone, evaluated on an inner row, may be null
+   * @param predicate The remaining join condition, evaluated with EvaluateJoin(outer, inner), may be null
+   * @param index_only Whether the index entries hold every inner column, so the table heap is never read
+   */
+  IndexNestedLoopJoinPlanNode(const Schema *output, AbstractPlanNodeRef outer, std::string inner_table_name,
+                              IndexInfo *inner_index, std::vector<AbstractExpressionRef> outer_keys,
+                              AbstractExpressionRef inner_predicate, AbstractExpressionRef predicate,
+                              bool index_only = false)
+      : AbstractPlanNode(output, {std::move(outer)}),
+        inner_table_name_(std::move(inner_table_name)),
+        inner_index_(inner_index),
+        outer_keys_(std::move(outer_keys)),
+        inner_predicate_(std::move(inner_predicate)),
+        predicate_(std::move(predicate)),
+        index_only_(index_only) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::IndexNestedLoopJoin; }
+
+  /** @return The plan producing the outer rows */
+  AbstractPlanNodeRef GetOuterPlan() const { return GetChildAt(0); }
+
+  std::string GetInnerTableName() const { return inner_table_name_; }
+
+  IndexInfo *GetInnerIndex() const { return inner_index_; }
+
+  const std::vector<AbstractExpressionRef> &GetOuterKeys() const { return outer_keys_; }
+
+  AbstractExpressionRef GetInnerPredicate() const { return inner_predicate_; }
+
+  AbstractExpressionRef GetPredicate() const { return predicate_; }
+
+  std::string inner_table_name_;
+
+  IndexInfo *inner_index_;
+
+  std::vector<AbstractExpressionRef> outer_keys_;
+
+  AbstractExpressionRef inner_predicate_;
+
+  AbstractExpressionRef predicate_;
+
+  bool index_only_ = false;
+};
+
+#endif  // MINISQL_INDEX_NESTED_LOOP_JOIN_PLAN_H
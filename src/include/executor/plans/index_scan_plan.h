@@ -6,6 +6,7 @@
 #include "abstract_plan.h"
 #include "catalog/catalog.h"
 #include "planner/expressions/abstract_expression.h"
+#include "planner/expressions/compiled_predicate.h"
 
 /**
  * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
@@ -16,14 +17,17 @@ class IndexScanPlanNode : public AbstractPlanNode {
    * Creates a new index scan plan node.
    * @param output the output format of this scan plan node
    * @param table_name The identifier of table to be scanned
+   * @param index_only Whether the single index in indexes covers every column the query reads
    */
   IndexScanPlanNode(const Schema *output, std::string table_name, std::vector<IndexInfo *> indexes, bool need_filter,
-                    AbstractExpressionRef filter_predicate = nullptr)
+                    AbstractExpressionRef filter_predicate = nullptr, bool index_only = false)
       : AbstractPlanNode(output, {}),
         table_name_(std::move(table_name)),
         indexes_(std::move(indexes)),
         need_filter_(need_filter),
-        filter_predicate_(std::move(filter_predicate)) {}
+        filter_predicate_(std::move(filter_predicate)),
+        compiled_predicate_(CompiledPredicate::Compile(filter_predicate_)),
+        index_only_(index_only) {}
 
   /** @return The type of the plan node */
   PlanType GetType() const override { return PlanType::IndexScan; }
@@ -33,6 +37,12 @@ class IndexScanPlanNode : public AbstractPlanNode {
 
   AbstractExpressionRef GetPredicate() const { return filter_predicate_; }
 
+  /** @return the predicate compiled into typed kernels, null if there is no predicate */
+  const CompiledPredicate *GetCompiledPredicate() const { return compiled_predicate_.get(); }
+
+  /** @return the columns of the table the query reads, null if it reads all of them */
+  const std::vector<bool> *GetNeededColumns() const { return needed_columns_.empty() ? nullptr : &needed_columns_; }
+
   /** The table name */
   std::string table_name_;
 
@@ -44,4 +54,13 @@ class IndexScanPlanNode : public AbstractPlanNode {
 
   /** The predicate to filter in IndexScan.*/
   AbstractExpressionRef filter_predicate_;
+
+  /** The predicate evaluated per row, compiled once with the plan. */
+  std::shared_ptr<const CompiledPredicate> compiled_predicate_;
+
+  /** The columns decoded from the table, by table index, the others are left null; all of them if empty. */
+  std::vector<bool> needed_columns_;
+
+  /** Rows are built from the index entries, the table heap is never read. */
+  bool index_only_ = false;
 };
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef MINISQL_LIMIT_PLAN_H
+#define MINISQL_LIMIT_PLAN_H
+
+#include "abstract_plan.h"
+
+/**
+ * LimitPlanNode skips the first offset rows of its child and outputs at most limit of the rows after them.
+ */
+class LimitPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new LimitPlanNode instance.
+   * @param output The output schema, the one of the child
+   * @param child The plan producing the rows
+   * @param limit The maximum number of rows to output
+   * @param offset The number of rows skipped before the first output row
+   */
+  LimitPlanNode(const Schema *output, AbstractPlanNodeRef child, uint32_t limit, uint32_t offset = 0)
+      : AbstractPlanNode(output, {std::move(child)}), limit_(limit), offset_(offset) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::Limit; }
+
+  /** @return The plan producing the rows */
+  AbstractPlanNodeRef GetChildPlan() const { return GetChildAt(0); }
+
+  uint32_t GetLimit() const { return limit_; }
+
+  uint32_t GetOffset() const { return offset_; }
+
+  uint32_t limit_;
+
+  uint32_t offset_;
+};
+
+#endif  // MINISQL_LIMIT_PLAN_H
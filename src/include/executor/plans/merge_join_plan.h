@@ -0,0 +1,56 @@
+#ifndef MINISQL_MERGE_JOIN_PLAN_H
+#define MINISQL_MERGE_JOIN_PLAN_H
+
+#include <utility>
+#include <vector>
+
+#include "abstract_plan.h"
+#include "planner/expressions/abstract_expression.h"
+
+/**
+ * MergeJoinPlanNode joins two children that both produce their rows in ascending order of the join key.
+ * The output schema refers to the left row followed by the right row, like the one of HashJoinPlanNode,
+ * and the output keeps the order of the left child.
+ */
+class MergeJoinPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new MergeJoinPlanNode instance.
+   * @param output The output schema of the join
+   * @param left The plan producing the left rows ordered by left_key
+   * @param right The plan producing the right rows ordered by right_key
+   * @param left_key The join key, evaluated on a left row
+   * @param right_key The join key, evaluated on a right row
+   * @param predicate The remaining join condition, evaluated with EvaluateJoin(left, right), may be null
+   */
+  MergeJoinPlanNode(const Schema *output, AbstractPlanNodeRef left, AbstractPlanNodeRef right,
+                    AbstractExpressionRef left_key, AbstractExpressionRef right_key,
+                    AbstractExpressionRef predicate = nullptr)
+      : AbstractPlanNode(output, {std::move(left), std::move(right)}),
+        left_key_(std::move(left_key)),
+        right_key_(std::move(right_key)),
+        predicate_(std::move(predicate)) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::MergeJoin; }
+
+  /** @return The plan producing the left rows */
+  AbstractPlanNodeRef GetLeftPlan() const { return GetChildAt(0); }
+
+  /** @return The plan producing the right rows */
+  AbstractPlanNodeRef GetRightPlan() const { return GetChildAt(1); }
+
+  AbstractExpressionRef GetLeftKey() const { return left_key_; }
+
+  AbstractExpressionRef GetRightKey() const { return right_key_; }
+
+  AbstractExpressionRef GetPredicate() const { return predicate_; }
+
+  AbstractExpressionRef left_key_;
+
+  AbstractExpressionRef right_key_;
+
+  AbstractExpressionRef predicate_;
+};
+
+#endif  // MINISQL_MERGE_JOIN_PLAN_H
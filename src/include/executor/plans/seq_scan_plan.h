@@ -8,6 +8,7 @@
 #include "abstract_plan.h"
 #include "catalog/catalog.h"
 #include "planner/expressions/abstract_expression.h"
+#include "planner/expressions/compiled_predicate.h"
 
 class SeqScanPlanNode : public AbstractPlanNode {
  public:
@@ -19,7 +20,8 @@ class SeqScanPlanNode : public AbstractPlanNode {
   SeqScanPlanNode(const Schema *output, std::string table_name, AbstractExpressionRef filter_predicate = nullptr)
       : AbstractPlanNode(output, {}),
         table_name_(std::move(table_name)),
-        filter_predicate_(std::move(filter_predicate)) {}
+        filter_predicate_(std::move(filter_predicate)),
+        compiled_predicate_(CompiledPredicate::Compile(filter_predicate_)) {}
 
   /** @return The type of the plan node */
   PlanType GetType() const override { return PlanType::SeqScan; }
@@ -29,11 +31,23 @@ class SeqScanPlanNode : public AbstractPlanNode {
 
   AbstractExpressionRef GetPredicate() const { return filter_predicate_; }
 
+  /** @return the predicate compiled into typed kernels, null if there is no predicate */
+  const CompiledPredicate *GetCompiledPredicate() const { return compiled_predicate_.get(); }
+
+  /** @return the columns of the table the query reads, null if it reads all of them */
+  const std::vector<bool> *GetNeededColumns() const { return needed_columns_.empty() ? nullptr : &needed_columns_; }
+
   /** The table name */
   std::string table_name_;
 
   /** The predicate to filter in SeqScan.*/
   AbstractExpressionRef filter_predicate_;
+
+  /** The predicate evaluated per row, compiled once with the plan. */
+  std::shared_ptr<const CompiledPredicate> compiled_predicate_;
+
+  /** The columns decoded from the table, by table index, the others are left null; all of them if empty. */
+  std::vector<bool> needed_columns_;
 };
 
 #endif  // MINISQL_SEQ_SCAN_PLAN_H
@@ -0,0 +1,50 @@
+#ifndef MINISQL_SORT_PLAN_H
+#define MINISQL_SORT_PLAN_H
+
+#include <utility>
+#include <vector>
+
+#include "abstract_plan.h"
+#include "common/config.h"
+#include "planner/expressions/abstract_expression.h"
+
+/** The direction of a sort key. */
+enum class OrderByType { Asc, Desc };
+
+/**
+ * SortPlanNode outputs the rows of its child ordered by a list of keys, the first key deciding first.
+ * A null sorts before every value in ascending order and after every value in descending order.
+ */
+class SortPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new SortPlanNode instance.
+   * @param output The output schema, either the one of the child or columns picking child fields by table index
+   * @param child The plan producing the rows to sort
+   * @param order_bys The sort keys with their direction, evaluated on a child row
+   * @param memory_budget The bytes of rows sorted in memory before a sorted run is written to pages
+   */
+  SortPlanNode(const Schema *output, AbstractPlanNodeRef child,
+               std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys,
+               uint32_t memory_budget = DEFAULT_MEMORY_BUDGET)
+      : AbstractPlanNode(output, {std::move(child)}), order_bys_(std::move(order_bys)), memory_budget_(memory_budget) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::Sort; }
+
+  /** @return The plan producing the rows to sort */
+  AbstractPlanNodeRef GetChildPlan() const { return GetChildAt(0); }
+
+  const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &GetOrderBy() const { return order_bys_; }
+
+  uint32_t GetMemoryBudget() const { return memory_budget_; }
+
+  /** 64 pages worth of rows */
+  static constexpr uint32_t DEFAULT_MEMORY_BUDGET = 64 * PAGE_SIZE;
+
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys_;
+
+  uint32_t memory_budget_;
+};
+
+#endif  // MINISQL_SORT_PLAN_H
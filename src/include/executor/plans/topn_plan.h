@@ -0,0 +1,43 @@
+#ifndef MINISQL_TOPN_PLAN_H
+#define MINISQL_TOPN_PLAN_H
+
+#include <utility>
+#include <vector>
+
+#include "abstract_plan.h"
+#include "executor/plans/sort_plan.h"
+#include "planner/expressions/abstract_expression.h"
+
+/**
+ * TopNPlanNode outputs the first n rows of its child in the order of the sort keys, the rows a SortPlanNode with
+ * the same keys would output first. Rows with equal keys keep the order they were read in.
+ */
+class TopNPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new TopNPlanNode instance.
+   * @param output The output schema, either the one of the child or columns picking child fields by table index
+   * @param child The plan producing the rows
+   * @param order_bys The sort keys with their direction, evaluated on a child row
+   * @param n The number of rows to output
+   */
+  TopNPlanNode(const Schema *output, AbstractPlanNodeRef child,
+               std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys, uint32_t n)
+      : AbstractPlanNode(output, {std::move(child)}), order_bys_(std::move(order_bys)), n_(n) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::TopN; }
+
+  /** @return The plan producing the rows */
+  AbstractPlanNodeRef GetChildPlan() const { return GetChildAt(0); }
+
+  const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &GetOrderBy() const { return order_bys_; }
+
+  uint32_t GetN() const { return n_; }
+
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys_;
+
+  uint32_t n_;
+};
+
+#endif  // MINISQL_TOPN_PLAN_H
@@ -0,0 +1,128 @@
+#ifndef MINISQL_QUERY_SCHEDULER_H
+#define MINISQL_QUERY_SCHEDULER_H
+
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/thread_pool.h"
+#include "record/row.h"
+#include "storage/table_heap.h"
+
+class ExecuteContext;
+class SeqScanPlanNode;
+
+/** A run of consecutive pages of a table heap, the unit of work handed to one worker at a time. */
+struct Morsel {
+  /** The page before the first one, INVALID_PAGE_ID if the morsel starts the heap */
+  page_id_t after_page_id_{INVALID_PAGE_ID};
+  std::vector<page_id_t> pages_;
+
+  bool Contains(page_id_t page_id) const {
+    for (auto page : pages_) {
+      if (page == page_id) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/**
+ * TableMorselSource cuts a table heap into morsels while the workers ask for them, following the page chain
+ * under a latch, so any number of workers can share it.
+ */
+class TableMorselSource {
+ public:
+  TableMorselSource(TableHeap *table_heap, BufferPoolManager *buffer_pool_manager)
+      : buffer_pool_manager_(buffer_pool_manager), next_page_id_(table_heap->GetFirstPageId()) {}
+
+  /** @return false once every page was handed out */
+  bool NextMorsel(Morsel &morsel);
+
+  /** Pages per morsel */
+  static constexpr uint32_t MORSEL_PAGES = 16;
+
+ private:
+  std::mutex latch_;
+  BufferPoolManager *buffer_pool_manager_;
+  page_id_t last_page_id_{INVALID_PAGE_ID};
+  page_id_t next_page_id_;
+};
+
+/**
+ * QueryScheduler runs the pipelines of one query on the shared ThreadPool with at most the degree of parallelism
+ * of the query.
+ *
+ * A pipeline is a function run once by every worker, the workers pull morsels from a shared source until it is
+ * exhausted, so a fast worker simply takes more of them. The calling thread is always worker 0, the others are
+ * pool tasks; a worker the pool has not started by the time the calling thread is done is run by the calling thread
+ * itself, so a query makes progress even when every pool thread is busy. In a scan pipeline such a late worker only
+ * finds the source exhausted.
+ */
+class QueryScheduler {
+ public:
+  /**
+   * @param max_workers The degree of parallelism of the query
+   * @param pool The pool running the workers besides the calling thread
+   */
+  explicit QueryScheduler(uint32_t max_workers, ThreadPool *pool = ThreadPool::GetInstance());
+
+  /** @return the number of workers a pipeline runs on, worker indexes are below it */
+  uint32_t GetWorkerCount() const { return worker_count_; }
+
+  /** Run worker(index) once for every index and wait for all of them, the first exception is rethrown. */
+  void Run(const std::function<void(uint32_t)> &worker);
+
+  /**
+   * Run the scan of plan on every worker, morsel by morsel: the rows passing its predicate are projected to its
+   * output schema and handed to consume on the worker that read them.
+   * @param finish Called by every worker once the table is exhausted, may be empty
+   */
+  void RunScanPipeline(ExecuteContext *exec_ctx, const SeqScanPlanNode *plan,
+                       const std::function<void(uint32_t, Row &)> &consume,
+                       const std::function<void(uint32_t)> &finish = nullptr);
+
+ private:
+  ThreadPool *pool_;
+  uint32_t worker_count_;
+};
+
+/**
+ * RepartitionExchange routes the items of several producers into partitions without any latch: every producer
+ * fills its own buffer per partition, a partition is collected from all of them once the producers are done.
+ */
+template <typename T>
+class RepartitionExchange {
+ public:
+  RepartitionExchange(uint32_t producer_count, uint32_t partition_count)
+      : buffers_(producer_count, std::vector<std::vector<T>>(partition_count)) {}
+
+  /** Called by one producer at a time for its own index. */
+  void Push(uint32_t producer, uint32_t partition, T &&item) { buffers_[producer][partition].push_back(std::move(item)); }
+
+  /** @return the items of partition from every producer, in producer order */
+  std::vector<T> TakePartition(uint32_t partition) {
+    std::vector<T> items;
+    for (auto &producer : buffers_) {
+      auto &buffer = producer[partition];
+      if (items.empty()) {
+        items = std::move(buffer);
+      } else {
+        items.insert(items.end(), std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()));
+      }
+      buffer.clear();
+    }
+    return items;
+  }
+
+  uint32_t GetPartitionCount() const { return buffers_.empty() ? 0 : buffers_.front().size(); }
+
+ private:
+  /** buffers_[producer][partition] */
+  std::vector<std::vector<std::vector<T>>> buffers_;
+};
+
+#endif  // MINISQL_QUERY_SCHEDULER_H
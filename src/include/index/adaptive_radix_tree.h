@@ -0,0 +1,82 @@
+#ifndef MINISQL_ADAPTIVE_RADIX_TREE_H
+#define MINISQL_ADAPTIVE_RADIX_TREE_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/rowid.h"
+#include "common/rwlatch.h"
+
+#define ART_MAX_STORED_PREFIX 8
+
+struct ArtNode;
+
+/**
+ * In-memory Adaptive Radix Tree (Leis et al.) over binary comparable keys.
+ *
+ * (1) Inner nodes adapt their fan-out: Node4, Node16, Node48 and Node256
+ * (2) Paths are compressed, a node keeps the bytes all of its keys share; only
+ *     the first ART_MAX_STORED_PREFIX of them are stored, longer prefixes are
+ *     skipped optimistically and checked against the full key in the leaf
+ * (3) Only support unique keys, and no key may be a prefix of another key
+ * (4) Point lookups use optimistic lock coupling: every inner node carries a
+ *     version that writers bump, a reader validates the version of a node
+ *     after reading its child pointer and restarts from the root on conflict.
+ *     Writers are serialized by a latch, range scans hold it in read mode.
+ *     Replaced nodes are freed once no optimistic reader is in flight.
+ */
+class AdaptiveRadixTree {
+ public:
+  AdaptiveRadixTree() = default;
+
+  ~AdaptiveRadixTree();
+
+  DISALLOW_COPY(AdaptiveRadixTree);
+
+  /** @return false if the key already exists */
+  bool Insert(const std::string &key, const RowId &value);
+
+  /** @return false if the key does not exist */
+  bool Remove(const std::string &key);
+
+  bool Lookup(const std::string &key, RowId &value) const;
+
+  /**
+   * Collect the values of the keys between lower and upper in key order, a nullptr bound leaves that side open.
+   * A bound is compared with the leading bytes of a key only, a key that starts with the bound equals it.
+   */
+  void Range(const std::string *lower, bool lower_inclusive, const std::string *upper, bool upper_inclusive,
+             std::vector<RowId> &result) const;
+
+  size_t Size() const { return size_.load(); }
+
+  /** Drop every key. */
+  void Clear();
+
+ private:
+  bool InsertAt(std::atomic<ArtNode *> &slot, ArtNode *parent, ArtNode *leaf, size_t depth);
+
+  bool RemoveAt(std::atomic<ArtNode *> &slot, ArtNode *parent, const std::string &key, size_t depth);
+
+  /** Publish node in slot, the parent is write locked around the store so that optimistic readers notice. */
+  void ReplaceChild(std::atomic<ArtNode *> &slot, ArtNode *parent, ArtNode *node);
+
+  /** Hand a node that was unlinked from the tree over to deferred reclamation. */
+  void Retire(ArtNode *node);
+
+  void ReclaimRetired();
+
+  bool Walk(const ArtNode *node, size_t depth, bool lower_tight, bool upper_tight, const std::string *lower,
+            bool lower_inclusive, const std::string *upper, bool upper_inclusive, std::vector<RowId> &result) const;
+
+  std::atomic<ArtNode *> root_{nullptr};
+  std::atomic<size_t> size_{0};
+  /** number of optimistic point lookups in flight, retired nodes are only freed while it is 0 */
+  mutable std::atomic<uint32_t> active_readers_{0};
+  std::vector<ArtNode *> retired_;
+  mutable ReaderWriterLatch latch_;
+};
+
+#endif  // MINISQL_ADAPTIVE_RADIX_TREE_H
@@ -0,0 +1,45 @@
+#ifndef MINISQL_ART_INDEX_H
+#define MINISQL_ART_INDEX_H
+
+#include <string>
+
+#include "index/adaptive_radix_tree.h"
+#include "index/index.h"
+
+/**
+ * In-memory index created by "create index ... using art" for small, hot
+ * tables. Lookups never go through the buffer pool. Nothing is written to
+ * disk: the tree starts empty whenever the table is opened and is filled from
+ * the table heap by BuildFromHeap.
+ *
+ * Keys are encoded into bytes whose order matches the order of the fields,
+ * column after column, so a row holding only the leading key columns encodes
+ * to a prefix of the full keys and bounds a range.
+ */
+class ArtIndex : public Index {
+ public:
+  ArtIndex(index_id_t index_id, IndexSchema *key_schema);
+
+  dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, std::string compare_operator = "=") override;
+
+  IndexScanIteratorRef Scan(const Row *lower, bool lower_inclusive, const Row *upper, bool upper_inclusive,
+                            Txn *txn) override;
+
+  dberr_t Destroy() override;
+
+  /**
+   * Append the binary comparable encoding of the fields of key, each field is a null flag byte followed by
+   * big endian ints, order preserving float bits or escaped chars ended by 0x00.
+   */
+  static void EncodeKey(const Row &key, std::string &bytes);
+
+ protected:
+  // container
+  AdaptiveRadixTree container_;
+};
+
+#endif  // MINISQL_ART_INDEX_H
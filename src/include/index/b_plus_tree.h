@@ -35,12 +35,15 @@ class BPlusTree {
   // Insert a key-value pair into this B+ tree.
   bool Insert(GenericKey *key, const RowId &value, Txn *transaction = nullptr);
 
-  // Remove a key and its value from this B+ tree.
-  void Remove(const GenericKey *key, Txn *transaction = nullptr);
+  // Remove a key and its value from this B+ tree, returns false if the key is not in it.
+  bool Remove(const GenericKey *key, Txn *transaction = nullptr);
 
   // return the value associated with a given key
   bool GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction = nullptr);
 
+  // return the values associated with the given keys, which must be sorted and distinct
+  bool GetValues(const std::vector<GenericKey *> &keys, std::vector<RowId> &result, Txn *transaction = nullptr);
+
   IndexIterator Begin();
 
   IndexIterator Begin(const GenericKey *key);
@@ -1,13 +1,69 @@
 #ifndef MINISQL_B_PLUS_TREE_INDEX_H
 #define MINISQL_B_PLUS_TREE_INDEX_H
 
+#include <memory>
+
 #include "index/b_plus_tree.h"
+#include "index/bloom_filter.h"
 #include "index/generic_key.h"
 #include "index/index.h"
 
+/**
+ * Cursor over a key range of a B+ tree, it walks the leaf chain through an
+ * IndexIterator and stops at the first key past the upper bound. A bound may
+ * only fix a leftmost prefix of the key columns, then only that prefix is
+ * compared against the entries.
+ */
+class BPlusTreeIndexScanIterator : public IndexScanIterator {
+ public:
+  /**
+   * The bound keys are owned by the cursor, a nullptr bound leaves that side open.
+   * @param lower_columns The number of leading key columns fixed by the lower bound
+   * @param upper_columns The number of leading key columns fixed by the upper bound
+   */
+  BPlusTreeIndexScanIterator(BPlusTree &container, const KeyManager &processor, IndexSchema *key_schema,
+                             GenericKey *lower, uint32_t lower_columns, bool lower_inclusive, GenericKey *upper,
+                             uint32_t upper_columns, bool upper_inclusive);
+
+  ~BPlusTreeIndexScanIterator() override;
+
+  bool Next(RowId &rid) override;
+
+  bool NextEntry(RowId &rid, Row &key) override;
+
+ private:
+  /**
+   * Produce the entry under the cursor and move past it.
+   * @param copy_key Whether to copy the entry key into current_
+   * @return false once out of range
+   */
+  bool Advance(RowId &rid, bool copy_key);
+
+  const KeyManager &processor_;
+  IndexSchema *key_schema_;
+  GenericKey *lower_;
+  uint32_t lower_columns_;
+  bool lower_inclusive_;
+  GenericKey *upper_;
+  uint32_t upper_columns_;
+  bool upper_inclusive_;
+  IndexIterator iter_;
+  IndexIterator end_;
+  GenericKey *current_;
+  bool exhausted_{false};
+};
+
 class BPlusTreeIndex : public Index {
  public:
-  BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size, BufferPoolManager *buffer_pool_manager);
+  /**
+   * @param key_column_count The number of leading key schema columns the tree is ordered by, the remaining
+   * columns are INCLUDE payload. 0 means every column is a key column.
+   * @param use_filter Whether to keep a Bloom filter over the keys, equality probes on keys it has never seen
+   * then return without descending the tree. The filter lives in memory only, opening a non-empty index
+   * rebuilds it with one walk over every leaf, i.e. one page read per leaf.
+   */
+  BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size, BufferPoolManager *buffer_pool_manager,
+                 uint32_t key_column_count = 0, bool use_filter = true);
 
   dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn) override;
 
@@ -15,6 +71,12 @@ class BPlusTreeIndex : public Index {
 
   dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, string compare_operator = "=") override;
 
+  /** Sort the whole keys the filter lets through and look them up in one pass over the tree. */
+  dberr_t ScanKeys(const std::vector<Row> &keys, std::vector<RowId> &result, Txn *txn) override;
+
+  IndexScanIteratorRef Scan(const Row *lower, bool lower_inclusive, const Row *upper, bool upper_inclusive,
+                            Txn *txn) override;
+
   dberr_t Destroy() override;
 
   IndexIterator GetBeginIterator();
@@ -24,10 +86,21 @@ class BPlusTreeIndex : public Index {
   IndexIterator GetEndIterator();
 
  protected:
+  /**
+   * Serialize a search key, keys carrying only a leftmost prefix of the columns are padded with nulls,
+   * which sort first, so the padded key is where the prefix starts in the tree.
+   */
+  void SerializeSearchKey(GenericKey *index_key, const Row &key);
+
+  /** Size the filter for twice the current number of keys and add every key of the tree. */
+  void RebuildFilter();
+
   // comparator for key
   KeyManager processor_;
   // container
   BPlusTree container_;
+  // filter for negative point lookups, nullptr if disabled
+  std::unique_ptr<CountingBloomFilter> filter_;
 };
 
 #endif  // MINISQL_B_PLUS_TREE_INDEX_H
@@ -0,0 +1,64 @@
+#ifndef MINISQL_BITMAP_INDEX_H
+#define MINISQL_BITMAP_INDEX_H
+
+#include <map>
+#include <string>
+
+#include "common/rwlatch.h"
+#include "index/index.h"
+#include "index/roaring_bitmap.h"
+
+/**
+ * Number of low bits of a row ordinal that hold the slot number, a table page
+ * holds fewer than 2^BITMAP_SLOT_BITS tuples.
+ */
+#define BITMAP_SLOT_BITS 10
+
+/**
+ * In-memory index created by "create index ... using bitmap" for columns with
+ * a handful of distinct values. Every distinct key owns a RoaringBitmap of the
+ * ordinals of its rows, an ordinal packs the page id and the slot number of a
+ * row id into 32 bits. Like ArtIndex it keeps nothing on disk and is filled
+ * from the table heap by BuildFromHeap.
+ *
+ * Keys are kept in the order of their ArtIndex::EncodeKey encoding, so a range
+ * comparison is the union of the bitmaps of a run of keys.
+ */
+class BitmapIndex : public Index {
+ public:
+  BitmapIndex(index_id_t index_id, IndexSchema *key_schema);
+
+  dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, std::string compare_operator = "=") override;
+
+  dberr_t Destroy() override;
+
+  /**
+   * Collect the ordinals of the rows whose key satisfies the comparison, rows with a null key only satisfy "is".
+   * @param compare_operator One of "=", "<>", "<", "<=", ">", ">=", "is" (is null) and "not" (is not null)
+   * @param[out] result The ordinals, see ToOrdinal
+   * @return false if the compare operator is not supported
+   */
+  bool Lookup(const Row &key, const std::string &compare_operator, RoaringBitmap &result);
+
+  /** @return the number of distinct keys */
+  size_t GetKeyCount();
+
+  static uint32_t ToOrdinal(const RowId &rid) {
+    return static_cast<uint32_t>(rid.GetPageId()) << BITMAP_SLOT_BITS | rid.GetSlotNum();
+  }
+
+  static RowId FromOrdinal(uint32_t ordinal) {
+    return RowId(static_cast<page_id_t>(ordinal >> BITMAP_SLOT_BITS), ordinal & ((1u << BITMAP_SLOT_BITS) - 1));
+  }
+
+ private:
+  // encoded key -> ordinals of its rows
+  std::map<std::string, RoaringBitmap> bitmaps_;
+  ReaderWriterLatch latch_;
+};
+
+#endif  // MINISQL_BITMAP_INDEX_H
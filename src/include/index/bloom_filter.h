@@ -0,0 +1,68 @@
+#ifndef MINISQL_BLOOM_FILTER_H
+#define MINISQL_BLOOM_FILTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "common/rwlatch.h"
+#include "record/row.h"
+
+/**
+ * In-memory counting Bloom filter over index keys.
+ *
+ * Every slot is an 8 bit counter instead of a bit, so keys can be removed again
+ * when their index entry is deleted. A counter that reached its maximum sticks
+ * there, it may only cause false positives, never false negatives.
+ * MayContain never misses a key that was added and not removed, a negative
+ * answer lets a point lookup skip the index descent.
+ *
+ * Only the leading key_column_count fields of a key are hashed, include
+ * columns carried after them do not change the hash. Float fields are
+ * normalized first, so -0.0 probes the counters of 0.0.
+ *
+ * The filter is shared by every writer and reader of its index, a latch
+ * guards the counters.
+ */
+class CountingBloomFilter {
+ public:
+  /**
+   * @param key_column_count The number of leading fields of a key that identify it
+   * @param expected_keys The number of keys the filter is sized for
+   */
+  explicit CountingBloomFilter(uint32_t key_column_count, uint32_t expected_keys = DEFAULT_EXPECTED_KEYS);
+
+  void Add(const Row &key);
+
+  void Remove(const Row &key);
+
+  /** @return false if the key was certainly never added */
+  bool MayContain(const Row &key) const;
+
+  /** Drop every key and resize the filter for expected_keys keys. */
+  void Reset(uint32_t expected_keys);
+
+  /** @return true once more keys were added than the filter was sized for */
+  bool IsOverloaded() const;
+
+  uint32_t GetKeyCount() const;
+
+  uint32_t GetExpectedKeys() const;
+
+  static constexpr uint32_t DEFAULT_EXPECTED_KEYS = 1024;
+
+ private:
+  /** 10 counters per key with 7 probes keep false positives around 1% */
+  static constexpr uint32_t COUNTERS_PER_KEY = 10;
+  static constexpr uint32_t PROBE_COUNT = 7;
+
+  /** @return a hash of the key fields that does not depend on the build */
+  uint64_t Hash(const Row &key) const;
+
+  mutable ReaderWriterLatch latch_;
+  uint32_t key_column_count_;
+  uint32_t expected_keys_;
+  uint32_t key_count_{0};
+  std::vector<uint8_t> counters_;
+};
+
+#endif  // MINISQL_BLOOM_FILTER_H
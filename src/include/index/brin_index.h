@@ -0,0 +1,90 @@
+#ifndef MINISQL_BRIN_INDEX_H
+#define MINISQL_BRIN_INDEX_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "buffer/buffer_pool_manager.h"
+#include "index/generic_key.h"
+#include "index/index.h"
+#include "page/brin_page.h"
+
+#define BRIN_PAGES_PER_RANGE 16
+
+/**
+ * Block range index created by "create index ... using brin" on one column.
+ *
+ * Instead of an entry per row it keeps a summary per run of
+ * BRIN_PAGES_PER_RANGE table pages: the number of indexed rows, how many of
+ * them are null, and the smallest and largest value. Summaries only widen,
+ * deleting a row leaves them as they are, so they stay conservative. A range
+ * without a summary may match anything. A sequential scan asks PageMayMatch
+ * when it enters a page and skips the rows of pages whose summary rules the
+ * predicate out, which pays off on columns that follow the insert order such
+ * as timestamps or increasing ids. The table heap is a linked list of pages,
+ * so the scan still fetches a skipped page to find the next one; what it saves
+ * is decoding and testing the rows, not the page reads.
+ *
+ * Summaries live in a chain of BrinPage, the first page id is registered in
+ * the index roots page. They are cached in memory when the index is opened.
+ */
+class BrinIndex : public Index {
+ public:
+  BrinIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size, BufferPoolManager *buffer_pool_manager);
+
+  /** Widen the summary of the page range holding row_id. */
+  dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  /** Summaries are never narrowed, nothing to do. */
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  /** A block range index can not locate rows, always DB_FAILED. */
+  dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, std::string compare_operator = "=") override;
+
+  /** A block range index can not locate rows, always nullptr. */
+  IndexScanIteratorRef Scan(const Row *lower, bool lower_inclusive, const Row *upper, bool upper_inclusive,
+                            Txn *txn) override;
+
+  dberr_t Destroy() override;
+
+  /**
+   * @param page_id A page of the indexed table
+   * @param compare_operator One of "=", "<>", "<", "<=", ">", ">=", "is" (is null) and "not" (is not null)
+   * @param value The constant the column is compared with, ignored by "is" and "not"
+   * @return false only if the page range holding page_id has a summary and none of its rows can satisfy the
+   * comparison
+   */
+  bool PageMayMatch(page_id_t page_id, const std::string &compare_operator, const Field &value);
+
+  static uint32_t RangeOf(page_id_t page_id) { return static_cast<uint32_t>(page_id) / BRIN_PAGES_PER_RANGE; }
+
+ private:
+  struct Summary {
+    page_id_t page_id;
+    int slot;
+    uint32_t row_count{0};
+    uint32_t null_count{0};
+    /** order preserving encodings of the bounds, see ArtIndex::EncodeKey */
+    std::string min;
+    std::string max;
+  };
+
+  /** Read every summary of the chain into summaries_. */
+  void LoadSummaries();
+
+  /** Append an empty summary for range_id to the chain, extending it by a page if the tail is full. */
+  Summary *AppendSummary(uint32_t range_id);
+
+  /** Write the counters of summary back, and its bounds too if key is not nullptr. */
+  void PersistSummary(const Summary &summary, const Row *key, bool min_changed, bool max_changed);
+
+  BufferPoolManager *buffer_pool_manager_;
+  KeyManager processor_;
+  page_id_t first_page_id_{INVALID_PAGE_ID};
+  page_id_t last_page_id_{INVALID_PAGE_ID};
+  std::unordered_map<uint32_t, Summary> summaries_;
+  std::mutex latch_;
+};
+
+#endif  // MINISQL_BRIN_INDEX_H
@@ -0,0 +1,38 @@
+#ifndef MINISQL_EXTENDIBLE_HASH_INDEX_H
+#define MINISQL_EXTENDIBLE_HASH_INDEX_H
+
+#include "index/extendible_hash_table.h"
+#include "index/generic_key.h"
+#include "index/index.h"
+
+/**
+ * Hash index created by "create index ... using hash". It only answers
+ * equality probes, ScanKey fails with any other compare operator so callers
+ * can fall back to a B+ tree index or a sequential scan.
+ *
+ * Float key fields are normalized before serialization, the table hashes and
+ * compares key bytes and -0.0 has to find 0.0.
+ */
+class ExtendibleHashIndex : public Index {
+ public:
+  ExtendibleHashIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size,
+                      BufferPoolManager *buffer_pool_manager);
+
+  dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, string compare_operator = "=") override;
+
+  dberr_t Destroy() override;
+
+ protected:
+  GenericKey *MakeKey(const Row &key) const;
+
+  // comparator for key
+  KeyManager processor_;
+  // container
+  ExtendibleHashTable container_;
+};
+
+#endif  // MINISQL_EXTENDIBLE_HASH_INDEX_H
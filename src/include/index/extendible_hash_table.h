@@ -0,0 +1,94 @@
+#ifndef MINISQL_EXTENDIBLE_HASH_TABLE_H
+#define MINISQL_EXTENDIBLE_HASH_TABLE_H
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/rwlatch.h"
+#include "concurrency/txn.h"
+#include "index/generic_key.h"
+#include "page/hash_table_bucket_page.h"
+#include "page/hash_table_directory_page.h"
+#include "page/hash_table_header_page.h"
+
+/**
+ * Disk based extendible hash table used by the hash index.
+ *
+ * The directory has two levels: the high bits of a key's hash select a
+ * directory page in the header page, the low bits a bucket in that directory.
+ * The header page id is kept in the index roots page, the same way the B+ tree
+ * keeps its root page id, so an index can be reopened after restart.
+ * (1) We only support unique key
+ * (2) Full buckets are split, doubling their directory when necessary, and get
+ *     overflow buckets once the directory reached its maximum depth, which
+ *     with the default depths takes hundreds of thousands of buckets
+ * (3) Empty buckets are merged with their split image and the directory shrinks
+ * (4) Only equality lookups are supported, a probe reads the header, one
+ *     directory and one bucket page; the header and the directories are few
+ *     and stay in the buffer pool, so a probe reads one bucket page from disk
+ * (5) Keys are hashed and compared as bytes, the caller serializes keys equal
+ *     as values to the same bytes (see ExtendibleHashIndex)
+ */
+class ExtendibleHashTable {
+ public:
+  /**
+   * @param bucket_max_size Pairs per bucket, 0 for as many as fit in a page
+   * @param header_max_depth Hash bits selecting a directory page
+   * @param directory_max_depth Hash bits a directory page may use to select a bucket
+   */
+  explicit ExtendibleHashTable(index_id_t index_id, BufferPoolManager *buffer_pool_manager,
+                               const KeyManager &comparator, int bucket_max_size = 0,
+                               uint32_t header_max_depth = HTABLE_HEADER_MAX_DEPTH,
+                               uint32_t directory_max_depth = DIRECTORY_MAX_DEPTH);
+
+  // Returns true if this hash table has no keys and values.
+  bool IsEmpty();
+
+  // Insert a key-value pair into this hash table.
+  bool Insert(GenericKey *key, const RowId &value, Txn *transaction = nullptr);
+
+  // Remove a key and its value from this hash table.
+  void Remove(const GenericKey *key, Txn *transaction = nullptr);
+
+  // return the value associated with a given key
+  bool GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction = nullptr);
+
+  // destroy the hash table, all pages are given back to the buffer pool
+  void Destroy();
+
+  // the largest global depth of the directory pages
+  uint32_t GetGlobalDepth();
+
+ private:
+  uint32_t Hash(const GenericKey *key) const;
+
+  HashTableHeaderPage *FetchHeaderPage();
+
+  HashTableDirectoryPage *FetchDirectoryPage(page_id_t directory_page_id);
+
+  HashTableBucketPage *FetchBucketPage(page_id_t bucket_page_id);
+
+  void StartNewTable();
+
+  page_id_t NewDirectory(HashTableHeaderPage *header_page, uint32_t directory_idx);
+
+  bool SplitBucket(HashTableDirectoryPage *dir_page, uint32_t bucket_idx);
+
+  bool AppendOverflowBucket(page_id_t last_page_id, GenericKey *key, const RowId &value);
+
+  void Merge(HashTableDirectoryPage *dir_page, uint32_t bucket_idx);
+
+  void UpdateHeaderPageId(int insert_record = 0);
+
+  // member variable
+  index_id_t index_id_;
+  page_id_t header_page_id_{INVALID_PAGE_ID};
+  BufferPoolManager *buffer_pool_manager_;
+  KeyManager processor_;
+  int bucket_max_size_;
+  uint32_t header_max_depth_;
+  uint32_t directory_max_depth_;
+  ReaderWriterLatch table_latch_;
+};
+
+#endif  // MINISQL_EXTENDIBLE_HASH_TABLE_H
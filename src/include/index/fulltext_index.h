@@ -0,0 +1,85 @@
+#ifndef MINISQL_FULLTEXT_INDEX_H
+#define MINISQL_FULLTEXT_INDEX_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "buffer/buffer_pool_manager.h"
+#include "index/index.h"
+#include "page/fulltext_page.h"
+
+/**
+ * Inverted index created by "create index ... using fulltext" on one char
+ * column. The value of the column is split by TokenizeText and the row id is
+ * added to the posting list of every token, a chain of PostingPage holding
+ * the row ids in ascending order with delta and varint compression. The
+ * lexicon, a chain of LexiconPage registered in the index roots page, maps
+ * every token to its posting list and is cached in memory.
+ *
+ * It answers the predicate match(column, "a b") through ScanKey with the
+ * compare operator "match": the rows holding every token of the query.
+ */
+class FullTextIndex : public Index {
+ public:
+  FullTextIndex(index_id_t index_id, IndexSchema *key_schema, BufferPoolManager *buffer_pool_manager);
+
+  dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  /**
+   * @param key A single char field holding the query
+   * @param compare_operator Only "match" is supported
+   */
+  dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, std::string compare_operator = "=") override;
+
+  /**
+   * The index holds tokens rather than column values and can not answer a range of them, match(...) goes
+   * through ScanKey instead.
+   * @return nullptr, which the callers of Index::Scan take as "can not answer"
+   */
+  IndexScanIteratorRef Scan(const Row *lower, bool lower_inclusive, const Row *upper, bool upper_inclusive,
+                            Txn *txn) override;
+
+  dberr_t Destroy() override;
+
+  /**
+   * Keep the values of lhs that are also in rhs, both ascending. Every value of lhs is searched in rhs with
+   * a galloping search from where the previous one was found, so a short list intersects a long one in
+   * time logarithmic in the gaps between its matches.
+   */
+  static void IntersectPostings(std::vector<uint64_t> &lhs, const std::vector<uint64_t> &rhs);
+
+ private:
+  struct Term {
+    page_id_t first_page_id;
+    /** INVALID_PAGE_ID until the chain was walked */
+    page_id_t last_page_id;
+  };
+
+  void LoadLexicon();
+
+  /** Register the first posting page of a new token in the lexicon. */
+  bool AppendLexicon(const std::string &token, page_id_t posting_page_id);
+
+  bool ReadPostings(const Term &term, std::vector<uint64_t> &values);
+
+  /** Replace the content of the posting list of term with values, reusing its pages. */
+  bool WritePostings(Term &term, const std::vector<uint64_t> &values);
+
+  bool AddPosting(const std::string &token, uint64_t value);
+
+  bool RemovePosting(const std::string &token, uint64_t value);
+
+  /** @return the tokens of the single char field of key */
+  static std::vector<std::string> Tokens(const Row &key);
+
+  BufferPoolManager *buffer_pool_manager_;
+  page_id_t lexicon_page_id_{INVALID_PAGE_ID};
+  page_id_t lexicon_last_page_id_{INVALID_PAGE_ID};
+  std::unordered_map<std::string, Term> lexicon_;
+  std::mutex latch_;
+};
+
+#endif  // MINISQL_FULLTEXT_INDEX_H
@@ -3,6 +3,7 @@
 
 #include <cstring>
 
+#include "index/key_search.h"
 #include "record/field.h"
 #include "record/row.h"
 
@@ -31,10 +32,15 @@ class KeyManager {
     ASSERT(ofs <= (uint32_t)key_size_, "Index key size exceed max key size.");
   }
 
-  // compare
+  // compare, only the leading compare_column_count_ columns take part, the rest is payload
   [[nodiscard]] inline int CompareKeys(const GenericKey *lhs, const GenericKey *rhs) const {
+    return CompareKeys(lhs, rhs, compare_column_count_);
+  }
+
+  // compare the leading column_count columns only, nulls sort before every value so that a key padded
+  // with nulls is the smallest key of its prefix
+  [[nodiscard]] inline int CompareKeys(const GenericKey *lhs, const GenericKey *rhs, uint32_t column_count) const {
     //    ASSERT(malloc_usable_size((void *)&lhs) == malloc_usable_size((void *)&rhs), "key size not match.");
-    uint32_t column_count = key_schema_->GetColumnCount();
     Row lhs_key(INVALID_ROWID);
     Row rhs_key(INVALID_ROWID);
     DeserializeToKey(lhs, lhs_key, key_schema_);
@@ -44,6 +50,13 @@ class KeyManager {
       Field *lhs_value = lhs_key.GetField(i);
       Field *rhs_value = rhs_key.GetField(i);
 
+      if (lhs_value->IsNull() || rhs_value->IsNull()) {
+        if (lhs_value->IsNull() != rhs_value->IsNull()) {
+          return lhs_value->IsNull() ? -1 : 1;
+        }
+        continue;
+      }
+
       if (lhs_value->CompareLessThan(*rhs_value) == CmpBool::kTrue) {
         return -1;
       }
@@ -56,19 +69,70 @@ class KeyManager {
     return 0;
   }
 
+  /**
+   * Find the first of the keys in [begin, end) laid out every stride bytes from base that is not less than key.
+   * Keys ordered by a single int or float column are searched on their normalized value, the others through
+   * CompareKeys.
+   */
+  [[nodiscard]] inline int LowerBound(const char *base, size_t stride, int begin, int end,
+                                      const GenericKey *key) const {
+    const char *probe = reinterpret_cast<const char *>(key);
+    switch (fixed_type_) {
+      case TypeId::kTypeInt:
+        return FixedKeyLowerBound<int32_t>(base, stride, null_byte_, value_offset_, begin, end,
+                                           NormalizeFixedKey<int32_t>(probe, null_byte_, value_offset_));
+      case TypeId::kTypeFloat:
+        return FixedKeyLowerBound<float>(base, stride, null_byte_, value_offset_, begin, end,
+                                         NormalizeFixedKey<float>(probe, null_byte_, value_offset_));
+      default:
+        break;
+    }
+    while (begin < end) {
+      int mid = begin + (end - begin) / 2;
+      if (CompareKeys(reinterpret_cast<const GenericKey *>(base + mid * stride), key) < 0) {
+        begin = mid + 1;
+      } else {
+        end = mid;
+      }
+    }
+    return begin;
+  }
+
   inline int GetKeySize() const { return key_size_; }
 
+  inline uint32_t GetCompareColumnCount() const { return compare_column_count_; }
+
   KeyManager(const KeyManager &other) {
     this->key_schema_ = other.key_schema_;
     this->key_size_ = other.key_size_;
+    this->compare_column_count_ = other.compare_column_count_;
+    this->fixed_type_ = other.fixed_type_;
+    this->null_byte_ = other.null_byte_;
+    this->value_offset_ = other.value_offset_;
   }
 
-  // constructor
-  KeyManager(Schema *key_schema, size_t key_size) : key_size_(key_size), key_schema_(key_schema) {}
+  // constructor, a compare_column_count of 0 compares every column of the key schema
+  KeyManager(Schema *key_schema, size_t key_size, uint32_t compare_column_count = 0)
+      : key_size_(key_size),
+        key_schema_(key_schema),
+        compare_column_count_(compare_column_count == 0 ? key_schema->GetColumnCount() : compare_column_count) {
+    // a serialized key starts with | Field Nums | Null bitmap |, the first column follows right after
+    TypeId first_type = key_schema->GetColumn(0)->GetType();
+    if (compare_column_count_ == 1 && (first_type == TypeId::kTypeInt || first_type == TypeId::kTypeFloat)) {
+      fixed_type_ = first_type;
+      null_byte_ = sizeof(size_t);
+      value_offset_ = null_byte_ + (key_schema->GetColumnCount() + 7) / 8;
+    }
+  }
 
  private:
   int key_size_;
   Schema *key_schema_;
+  uint32_t compare_column_count_;
+  /** type of the single fixed width key column searched by the kernels of key_search.h, kTypeInvalid if none */
+  TypeId fixed_type_{TypeId::kTypeInvalid};
+  size_t null_byte_{0};
+  size_t value_offset_{0};
 };
 
 #endif  // MINISQL_GENERIC_KEY_H
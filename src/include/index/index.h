@@ -2,11 +2,62 @@
 #define MINISQL_INDEX_H
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "common/dberr.h"
 #include "concurrency/txn.h"
 #include "record/row.h"
 
+/**
+ * Cursor over the row ids of an index key range, returned by Index::Scan.
+ * Row ids are produced lazily, one per call to Next.
+ */
+class IndexScanIterator {
+ public:
+  virtual ~IndexScanIterator() = default;
+
+  /**
+   * Move to the next matching entry.
+   * @param[out] rid The row id of the entry
+   * @return false once the range is exhausted
+   */
+  virtual bool Next(RowId &rid) = 0;
+
+  /**
+   * Like Next, and also hand out the index entry itself so covering scans can
+   * skip the table heap. Only cursors of ordered indexes support it.
+   * @param[out] key The index key, with the fields of the index key schema
+   * @return false once the range is exhausted or if keys are not available
+   */
+  virtual bool NextEntry(RowId &/*rid*/, Row &/*key*/) { return false; }
+};
+
+using IndexScanIteratorRef = std::unique_ptr<IndexScanIterator>;
+
+class TableHeap;
+
+/**
+ * Cursor over row ids that were collected up front.
+ */
+class MaterializedScanIterator : public IndexScanIterator {
+ public:
+  explicit MaterializedScanIterator(std::vector<RowId> result) : result_(std::move(result)) {}
+
+  bool Next(RowId &rid) override {
+    if (cursor_ >= result_.size()) {
+      return false;
+    }
+    rid = result_[cursor_++];
+    return true;
+  }
+
+ private:
+  std::vector<RowId> result_;
+  size_t cursor_{0};
+};
+
 class Index {
  public:
   explicit Index(index_id_t index_id, IndexSchema *key_schema) : index_id_(index_id), key_schema_(key_schema) {}
@@ -17,11 +68,44 @@ class Index {
 
   virtual dberr_t RemoveEntry(const Row &key, RowId row_id, Txn *txn) = 0;
 
-  virtual dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, string compare_operator = "=") = 0;
+  virtual dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, std::string compare_operator = "=") = 0;
+
+  /**
+   * Equality probes for several keys at once, e.g. for col in (...), keys that are not in the index are skipped.
+   * The default implementation calls ScanKey once per key, ordered indexes override it to probe the keys in
+   * order and share the descent between neighbouring keys.
+   * @return DB_FAILED if the index can not answer equality probes
+   */
+  virtual dberr_t ScanKeys(const std::vector<Row> &keys, std::vector<RowId> &result, Txn *txn);
+
+  /**
+   * Open a cursor over the keys between lower and upper. A nullptr bound leaves
+   * that side of the range open; bounds with equal key values ask for a point
+   * lookup, see IsPointRange. A bound may carry only a leftmost prefix of the key
+   * columns, ordered indexes then bound the range by that prefix alone, e.g. the
+   * same one column row as both inclusive bounds of an index on (a, b) yields
+   * every entry with that a. The default implementation materializes the range
+   * through ScanKey, ordered indexes override it to walk their pages lazily.
+   * @return nullptr if the index can not answer this kind of range
+   */
+  virtual IndexScanIteratorRef Scan(const Row *lower, bool lower_inclusive, const Row *upper, bool upper_inclusive,
+                                    Txn *txn);
 
   virtual dberr_t Destroy() = 0;
 
+  /**
+   * Insert every row of the table heap, the key columns are picked through their table index.
+   * In-memory indexes are filled this way when their table is opened.
+   */
+  dberr_t BuildFromHeap(TableHeap *table_heap, Txn *txn);
+
  protected:
+  /**
+   * Whether lower and upper bound a single key, i.e. both are set, carry the same
+   * number of fields and every field compares equal. A null field never matches.
+   */
+  static bool IsPointRange(const Row *lower, const Row *upper);
+
   index_id_t index_id_;
   IndexSchema *key_schema_;
 };
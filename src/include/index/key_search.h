@@ -0,0 +1,78 @@
+#ifndef MINISQL_KEY_SEARCH_H
+#define MINISQL_KEY_SEARCH_H
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Search kernels for B+ tree pages whose keys are ordered by a single fixed
+ * width column.
+ *
+ * Such a key is reduced to a 64 bit normalized value: the high word tells a
+ * null (0) from a value (1) so nulls sort first, the low word holds the
+ * column value with its bits rearranged so unsigned order matches the order
+ * of the type. A probe is normalized once, after that each step of the search
+ * reads one 4 byte slot of the page instead of deserializing two rows.
+ */
+template <typename T>
+struct FixedKeyTraits;
+
+template <>
+struct FixedKeyTraits<int32_t> {
+  static inline uint32_t OrderBits(const char *value) {
+    int32_t v;
+    memcpy(&v, value, sizeof(v));
+    return static_cast<uint32_t>(v) ^ 0x80000000u;
+  }
+};
+
+template <>
+struct FixedKeyTraits<float> {
+  static inline uint32_t OrderBits(const char *value) {
+    uint32_t bits;
+    memcpy(&bits, value, sizeof(bits));
+    if (bits == 0x80000000u) {
+      // -0.0 equals 0.0
+      bits = 0;
+    }
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+  }
+};
+
+/**
+ * @param null_byte Offset of the null bitmap byte that holds the flag of the key column
+ * @param value_offset Offset of the serialized column value
+ */
+template <typename T>
+inline uint64_t NormalizeFixedKey(const char *key, size_t null_byte, size_t value_offset) {
+  if ((key[null_byte] & 0x80) == 0) {
+    return 0;
+  }
+  return (uint64_t{1} << 32) | FixedKeyTraits<T>::OrderBits(key + value_offset);
+}
+
+/**
+ * Find the first key in [begin, end) that is not less than probe, keys are laid out every stride bytes from base.
+ * The range is halved without branching on the comparison until it fits a few cache lines, then the
+ * remaining keys less than the probe are counted in one pass.
+ */
+template <typename T>
+inline int FixedKeyLowerBound(const char *base, size_t stride, size_t null_byte, size_t value_offset, int begin,
+                              int end, uint64_t probe) {
+  static constexpr int LINEAR_SEARCH_THRESHOLD = 16;
+  const char *first = base + static_cast<size_t>(begin) * stride;
+  int len = end - begin;
+  while (len > LINEAR_SEARCH_THRESHOLD) {
+    int half = len / 2;
+    bool less = NormalizeFixedKey<T>(first + half * stride, null_byte, value_offset) < probe;
+    first += less ? (len - half) * stride : 0;
+    len = half;
+  }
+  int count = 0;
+  for (int i = 0; i < len; i++) {
+    count += NormalizeFixedKey<T>(first + i * stride, null_byte, value_offset) < probe;
+  }
+  return static_cast<int>((first - base) / stride) + count;
+}
+
+#endif  // MINISQL_KEY_SEARCH_H
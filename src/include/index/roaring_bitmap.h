@@ -0,0 +1,70 @@
+#ifndef MINISQL_ROARING_BITMAP_H
+#define MINISQL_ROARING_BITMAP_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Compressed bitmap over 32 bit values in the layout of Roaring (Lemire et al.).
+ *
+ * Values are grouped by their high 16 bits into containers. A container with
+ * at most ARRAY_CONTAINER_MAX_SIZE values keeps their low 16 bits in a sorted
+ * array, a denser one switches to a plain 2^16 bit bitmap. Intersections and
+ * unions work container by container and pick the kernel by the kinds of the
+ * two operands, so sparse and dense sets both stay cheap.
+ */
+class RoaringBitmap {
+ public:
+  static constexpr uint32_t ARRAY_CONTAINER_MAX_SIZE = 4096;
+
+  /** @return false if value was already in the set */
+  bool Add(uint32_t value);
+
+  /** @return false if value was not in the set */
+  bool Remove(uint32_t value);
+
+  bool Contains(uint32_t value) const;
+
+  /** @return the number of values in the set, without visiting them */
+  uint64_t Cardinality() const;
+
+  bool IsEmpty() const { return containers_.empty(); }
+
+  /** Keep only the values that are also in other. */
+  void IntersectWith(const RoaringBitmap &other);
+
+  /** Add every value of other. */
+  void UnionWith(const RoaringBitmap &other);
+
+  /** Append the values in ascending order. */
+  void ToVector(std::vector<uint32_t> &values) const;
+
+ private:
+  struct Container {
+    uint16_t key;
+    uint32_t cardinality{0};
+    /** sorted low bits while the container is an array */
+    std::vector<uint16_t> array;
+    /** 1024 words once the container is a bitmap */
+    std::vector<uint64_t> words;
+
+    bool IsBitmap() const { return !words.empty(); }
+
+    void ToBitmap();
+
+    void ToArray();
+  };
+
+  static void Intersect(Container &lhs, const Container &rhs);
+
+  static void Union(Container &lhs, const Container &rhs);
+
+  /** @return the first container whose key is not less than key */
+  std::vector<Container>::iterator LowerBound(uint16_t key);
+
+  std::vector<Container>::const_iterator LowerBound(uint16_t key) const;
+
+  std::vector<Container> containers_;
+};
+
+#endif  // MINISQL_ROARING_BITMAP_H
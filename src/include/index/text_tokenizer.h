@@ -0,0 +1,34 @@
+#ifndef MINISQL_TEXT_TOKENIZER_H
+#define MINISQL_TEXT_TOKENIZER_H
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+/** Longer tokens are cut to this many bytes. */
+#define MAX_TOKEN_LENGTH 32
+
+/**
+ * Split text into tokens for full text search: every maximal run of ASCII
+ * letters and digits is a token, letters are lower cased. The tokens are
+ * sorted and each appears once.
+ */
+inline void TokenizeText(const char *text, size_t length, std::vector<std::string> &tokens) {
+  std::string token;
+  for (size_t i = 0; i <= length; i++) {
+    auto c = i < length ? static_cast<unsigned char>(text[i]) : '\0';
+    if (std::isalnum(c)) {
+      if (token.size() < MAX_TOKEN_LENGTH) {
+        token.push_back(static_cast<char>(std::tolower(c)));
+      }
+    } else if (!token.empty()) {
+      tokens.push_back(std::move(token));
+      token.clear();
+    }
+  }
+  std::sort(tokens.begin(), tokens.end());
+  tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+}
+
+#endif  // MINISQL_TEXT_TOKENIZER_H
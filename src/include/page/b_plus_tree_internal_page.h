@@ -44,6 +44,9 @@ class BPlusTreeInternalPage : public BPlusTreePage {
 
   page_id_t Lookup(const GenericKey *key, const KeyManager &KP);
 
+  /** @return the index of the child Lookup would descend into */
+  int LookupIndex(const GenericKey *key, const KeyManager &KP);
+
   void PopulateNewRoot(const page_id_t &old_value, GenericKey *new_key, const page_id_t &new_value);
 
   int InsertNodeAfter(const page_id_t &old_value, GenericKey *new_key, const page_id_t &new_value);
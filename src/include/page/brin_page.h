@@ -0,0 +1,89 @@
+#ifndef MINISQL_BRIN_PAGE_H
+#define MINISQL_BRIN_PAGE_H
+
+#include <cstring>
+
+#include "common/config.h"
+#include "index/generic_key.h"
+
+#define BRIN_PAGE_HEADER_SIZE 16
+
+/**
+ * brin_page.h
+ *
+ * Summary page of a block range index. Every entry summarizes one run of table
+ * pages: how many rows were indexed there, how many of them are null, and the
+ * smallest and largest key. The min and max keys are only meaningful while
+ * RowCount > NullCount. Pages are chained through NextPageId, entries are never
+ * moved once appended.
+ *
+ * Summary page format:
+ *  ----------------------------------------------------------------------
+ * | HEADER | SUMMARY(1) | SUMMARY(2) | ... | SUMMARY(n)
+ *  ----------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 16 bytes in total):
+ *  ------------------------------------------------------------------
+ * | KeySize (4) | CurrentSize (4) | MaxSize (4) | NextPageId (4) |
+ *  ------------------------------------------------------------------
+ *
+ *  Summary format:
+ *  --------------------------------------------------------------------------
+ * | RangeId (4) | RowCount (4) | NullCount (4) | MinKey (KeySize) | MaxKey (KeySize) |
+ *  --------------------------------------------------------------------------
+ */
+class BrinPage {
+ public:
+  void Init(int key_size);
+
+  int GetKeySize() const { return key_size_; }
+
+  int GetSize() const { return size_; }
+
+  bool IsFull() const { return size_ >= max_size_; }
+
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  uint32_t RangeIdAt(int index) { return ReadUint32(index, 0); }
+
+  uint32_t RowCountAt(int index) { return ReadUint32(index, 1); }
+
+  uint32_t NullCountAt(int index) { return ReadUint32(index, 2); }
+
+  void SetCountsAt(int index, uint32_t row_count, uint32_t null_count);
+
+  GenericKey *MinKeyAt(int index);
+
+  GenericKey *MaxKeyAt(int index);
+
+  /**
+   * Append an empty summary, the caller must make sure the page is not full.
+   * @return the index of the new summary
+   */
+  int Append(uint32_t range_id);
+
+ private:
+  static constexpr int ENTRY_HEADER_SIZE = 3 * sizeof(uint32_t);
+
+  char *EntryPtrAt(int index) { return data_ + index * EntrySize(); }
+
+  int EntrySize() const { return ENTRY_HEADER_SIZE + 2 * key_size_; }
+
+  uint32_t ReadUint32(int index, int field) {
+    uint32_t value;
+    memcpy(&value, EntryPtrAt(index) + field * sizeof(uint32_t), sizeof(uint32_t));
+    return value;
+  }
+
+  int key_size_;
+  int size_;
+  int max_size_;
+  page_id_t next_page_id_;
+  char data_[PAGE_SIZE - BRIN_PAGE_HEADER_SIZE];
+};
+
+static_assert(sizeof(BrinPage) == PAGE_SIZE, "Brin page size mismatch.");
+
+#endif  // MINISQL_BRIN_PAGE_H
@@ -0,0 +1,108 @@
+#ifndef MINISQL_FULLTEXT_PAGE_H
+#define MINISQL_FULLTEXT_PAGE_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+
+#define POSTING_PAGE_HEADER_SIZE 24
+#define LEXICON_PAGE_HEADER_SIZE 8
+
+/**
+ * fulltext_page.h
+ *
+ * Page of the posting list of one token in a full text index. The values are
+ * ascending row ids (RowId::Get), the first value of a page is stored as is,
+ * every following one as the difference to its predecessor. Each number is a
+ * varint: 7 bits per byte, low bits first, the high bit set on all but the
+ * last byte. Rows inserted in heap order only ever append to the last page.
+ *
+ *  Header format (size in byte, 24 bytes in total):
+ *  ---------------------------------------------------------------------------
+ * | NextPageId (4) | Size (4) | Count (4) | Reserved (4) | LastValue (8) |
+ *  ---------------------------------------------------------------------------
+ */
+class PostingPage {
+ public:
+  void Init() {
+    next_page_id_ = INVALID_PAGE_ID;
+    size_ = 0;
+    count_ = 0;
+    reserved_ = 0;
+    last_value_ = 0;
+  }
+
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  uint32_t GetCount() const { return count_; }
+
+  uint64_t GetLastValue() const { return last_value_; }
+
+  /**
+   * Append a value greater than every value on the page.
+   * @return false if the page has no room left
+   */
+  bool Append(uint64_t value);
+
+  /** Append every value of the page to values. */
+  void Decode(std::vector<uint64_t> &values) const;
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t size_;
+  uint32_t count_;
+  uint32_t reserved_;
+  uint64_t last_value_;
+  char data_[PAGE_SIZE - POSTING_PAGE_HEADER_SIZE];
+};
+
+/**
+ * Page of the lexicon of a full text index, which maps every token to the
+ * first page of its posting list. Records are appended and never removed.
+ *
+ *  Header format (size in byte, 8 bytes in total):
+ *  ------------------------------
+ * | NextPageId (4) | Size (4) |
+ *  ------------------------------
+ *
+ *  Record format:
+ *  ---------------------------------------------------------
+ * | TokenLength (1) | Token (TokenLength) | PostingPageId (4) |
+ *  ---------------------------------------------------------
+ */
+class LexiconPage {
+ public:
+  void Init() {
+    next_page_id_ = INVALID_PAGE_ID;
+    size_ = 0;
+  }
+
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  /**
+   * @return false if the page has no room left, tokens are at most 255 bytes long
+   */
+  bool Append(const std::string &token, page_id_t posting_page_id);
+
+  /**
+   * Read the record at offset.
+   * @return the offset of the next record, or -1 past the last record
+   */
+  int ReadAt(int offset, std::string &token, page_id_t &posting_page_id) const;
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t size_;
+  char data_[PAGE_SIZE - LEXICON_PAGE_HEADER_SIZE];
+};
+
+static_assert(sizeof(PostingPage) == PAGE_SIZE, "Posting page size mismatch.");
+static_assert(sizeof(LexiconPage) == PAGE_SIZE, "Lexicon page size mismatch.");
+
+#endif  // MINISQL_FULLTEXT_PAGE_H
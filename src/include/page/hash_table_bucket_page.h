@@ -0,0 +1,88 @@
+#ifndef MINISQL_HASH_TABLE_BUCKET_PAGE_H
+#define MINISQL_HASH_TABLE_BUCKET_PAGE_H
+
+#include <cstring>
+
+#include "common/config.h"
+#include "common/rowid.h"
+#include "index/generic_key.h"
+
+#define HASH_BUCKET_PAGE_HEADER_SIZE 16
+
+/**
+ * hash_table_bucket_page.h
+ *
+ * Bucket page of an extendible hash index. Pairs are kept unordered, a probe
+ * scans the bucket and compares serialized keys byte by byte, which is enough
+ * for equality since KeyManager zero-fills every key before serializing it.
+ * Only support unique key. Once the directory reaches its maximum depth a
+ * full bucket can no longer split, further pairs go to a chain of overflow
+ * buckets linked through NextPageId.
+ *
+ * Bucket page format:
+ *  ----------------------------------------------------------------------
+ * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
+ *  ----------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 16 bytes in total):
+ *  ------------------------------------------------------------------
+ * | KeySize (4) | CurrentSize (4) | MaxSize (4) | NextPageId (4) |
+ *  ------------------------------------------------------------------
+ */
+class HashTableBucketPage {
+ public:
+  /**
+   * Init method after creating a new bucket page, max size defaults to as many
+   * pairs as fit in the page.
+   */
+  void Init(int key_size, int max_size = 0);
+
+  int GetKeySize() const { return key_size_; }
+
+  int GetSize() const { return size_; }
+
+  int GetMaxSize() const { return max_size_; }
+
+  bool IsFull() const { return size_ >= max_size_; }
+
+  bool IsEmpty() const { return size_ == 0; }
+
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  GenericKey *KeyAt(int index);
+
+  RowId ValueAt(int index) const;
+
+  /** @return the index of key in this bucket, -1 if not found */
+  int KeyIndex(const GenericKey *key);
+
+  bool Lookup(const GenericKey *key, RowId &value);
+
+  /**
+   * Append a pair, the caller must make sure the bucket is not full.
+   * @return false if the key already exists
+   */
+  bool Insert(const GenericKey *key, const RowId &value);
+
+  /** Remove the pair at index by moving the last pair into its slot. */
+  void RemoveAt(int index);
+
+  bool Remove(const GenericKey *key);
+
+ private:
+  char *PairPtrAt(int index) { return data_ + index * PairSize(); }
+
+  int PairSize() const { return key_size_ + static_cast<int>(sizeof(RowId)); }
+
+  int key_size_;
+  int size_;
+  int max_size_;
+  page_id_t next_page_id_;
+  char data_[PAGE_SIZE - HASH_BUCKET_PAGE_HEADER_SIZE];
+};
+
+static_assert(sizeof(HashTableBucketPage) == PAGE_SIZE, "Hash bucket page size mismatch.");
+
+#endif  // MINISQL_HASH_TABLE_BUCKET_PAGE_H
@@ -0,0 +1,85 @@
+#ifndef MINISQL_HASH_TABLE_DIRECTORY_PAGE_H
+#define MINISQL_HASH_TABLE_DIRECTORY_PAGE_H
+
+#include <cstdint>
+
+#include "common/config.h"
+
+#define DIRECTORY_MAX_DEPTH 9
+#define DIRECTORY_ARRAY_SIZE (1 << DIRECTORY_MAX_DEPTH)
+
+/**
+ * hash_table_directory_page.h
+ *
+ * Directory page of an extendible hash index, the second level of its
+ * directory below the header page. The low GlobalDepth bits of a key's hash
+ * select a directory slot, and every slot points to a bucket page. Several
+ * slots share one bucket when the bucket's local depth is smaller than the
+ * global depth.
+ *
+ * Directory page format (size in byte):
+ *  ----------------------------------------------------------------------------------------------------
+ * | PageId (4) | MaxDepth (4) | GlobalDepth (4) | LocalDepths (512) | BucketPageIds (2048) | (free) |
+ *  ----------------------------------------------------------------------------------------------------
+ */
+class HashTableDirectoryPage {
+ public:
+  /**
+   * Init method after creating a new directory page, the directory starts with
+   * a single slot of global depth 0.
+   * @param max_depth The global depth the directory may grow to, at most DIRECTORY_MAX_DEPTH
+   */
+  void Init(page_id_t page_id, uint32_t max_depth = DIRECTORY_MAX_DEPTH);
+
+  page_id_t GetPageId() const { return page_id_; }
+
+  uint32_t GetMaxDepth() const { return max_depth_; }
+
+  uint32_t GetGlobalDepth() const { return global_depth_; }
+
+  /** @return mask of global_depth 1's, used to map a hash to a directory index */
+  uint32_t GetGlobalDepthMask() const { return (1U << global_depth_) - 1; }
+
+  /** @return the current number of directory slots */
+  uint32_t Size() const { return 1U << global_depth_; }
+
+  /**
+   * Double the directory, the new upper half mirrors the lower half so every
+   * bucket keeps being reachable from the same hash values.
+   * @return false if the directory has reached its maximum depth
+   */
+  bool IncrGlobalDepth();
+
+  void DecrGlobalDepth();
+
+  /** @return true if every local depth is smaller than the global depth */
+  bool CanShrink() const;
+
+  page_id_t GetBucketPageId(uint32_t bucket_idx) const { return bucket_page_ids_[bucket_idx]; }
+
+  void SetBucketPageId(uint32_t bucket_idx, page_id_t bucket_page_id) { bucket_page_ids_[bucket_idx] = bucket_page_id; }
+
+  uint32_t GetLocalDepth(uint32_t bucket_idx) const { return local_depths_[bucket_idx]; }
+
+  void SetLocalDepth(uint32_t bucket_idx, uint8_t local_depth) { local_depths_[bucket_idx] = local_depth; }
+
+  /** @return mask of local_depth 1's for the bucket at bucket_idx */
+  uint32_t GetLocalDepthMask(uint32_t bucket_idx) const { return (1U << local_depths_[bucket_idx]) - 1; }
+
+  /**
+   * The split image of a slot differs from it only in the highest bit covered
+   * by the slot's local depth.
+   */
+  uint32_t GetSplitImageIndex(uint32_t bucket_idx) const;
+
+ private:
+  page_id_t page_id_;
+  uint32_t max_depth_;
+  uint32_t global_depth_;
+  uint8_t local_depths_[DIRECTORY_ARRAY_SIZE];
+  page_id_t bucket_page_ids_[DIRECTORY_ARRAY_SIZE];
+};
+
+static_assert(sizeof(HashTableDirectoryPage) <= PAGE_SIZE, "Hash directory does not fit in a page.");
+
+#endif  // MINISQL_HASH_TABLE_DIRECTORY_PAGE_H
@@ -0,0 +1,60 @@
+#ifndef MINISQL_HASH_TABLE_HEADER_PAGE_H
+#define MINISQL_HASH_TABLE_HEADER_PAGE_H
+
+#include <cstdint>
+
+#include "common/config.h"
+
+#define HTABLE_HEADER_MAX_DEPTH 9
+#define HTABLE_HEADER_ARRAY_SIZE (1 << HTABLE_HEADER_MAX_DEPTH)
+
+/**
+ * hash_table_header_page.h
+ *
+ * Header page of an extendible hash index, the first level of its directory.
+ * The high MaxDepth bits of a key's hash select a directory page, the
+ * directory page then uses the low bits of the same hash. Directory pages are
+ * created on the first insert that reaches them, so a small table only has
+ * one.
+ *
+ * Header page format (size in byte):
+ *  ------------------------------------------------------------------
+ * | PageId (4) | MaxDepth (4) | DirectoryPageIds (2048) | (free) |
+ *  ------------------------------------------------------------------
+ */
+class HashTableHeaderPage {
+ public:
+  /**
+   * Init method after creating a new header page, every slot starts without
+   * a directory.
+   * @param max_depth The number of high hash bits selecting a directory, at most HTABLE_HEADER_MAX_DEPTH
+   */
+  void Init(page_id_t page_id, uint32_t max_depth = HTABLE_HEADER_MAX_DEPTH);
+
+  page_id_t GetPageId() const { return page_id_; }
+
+  uint32_t GetMaxDepth() const { return max_depth_; }
+
+  /** @return the number of directory slots */
+  uint32_t Size() const { return 1U << max_depth_; }
+
+  /** @return the slot of the directory a hash belongs to */
+  uint32_t HashToDirectoryIndex(uint32_t hash) const {
+    return max_depth_ == 0 ? 0 : hash >> (sizeof(uint32_t) * 8 - max_depth_);
+  }
+
+  page_id_t GetDirectoryPageId(uint32_t directory_idx) const { return directory_page_ids_[directory_idx]; }
+
+  void SetDirectoryPageId(uint32_t directory_idx, page_id_t directory_page_id) {
+    directory_page_ids_[directory_idx] = directory_page_id;
+  }
+
+ private:
+  page_id_t page_id_;
+  uint32_t max_depth_;
+  page_id_t directory_page_ids_[HTABLE_HEADER_ARRAY_SIZE];
+};
+
+static_assert(sizeof(HashTableHeaderPage) <= PAGE_SIZE, "Hash header does not fit in a page.");
+
+#endif  // MINISQL_HASH_TABLE_HEADER_PAGE_H
@@ -56,7 +56,9 @@ class TablePage : public Page {
 
   void RollbackDelete(const RowId &rid, Txn *txn, LogManager *log_manager);
 
-  bool GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_manager);
+  /** @param needed_columns The columns to deserialize, every column if null */
+  bool GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_manager,
+                const std::vector<bool> *needed_columns = nullptr);
 
   bool GetFirstTupleRid(RowId *first_rid);
 
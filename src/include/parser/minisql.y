@@ -7,6 +7,8 @@
   int yyerror(char* error);
 %}
 
+%define api.header.include {"parser/minisql_yacc.h"}
+
 %union {
 	pSyntaxNode syntax_node;
 }
@@ -17,14 +19,17 @@
 %token <syntax_node> ON FROM WHERE INTO SET VALUES PRIMARY KEY UNIQUE
 %token <syntax_node> CHAR INT FLOAT AND OR NOT IS FLAGNULL
 %token <syntax_node> IDENTIFIER STRING NUMBER EQ NE LE GE
+%token <syntax_node> INCLUDE MATCH LIKE IN BY CONCURRENTLY JOIN GROUP ORDER ASC DESC LIMIT OFFSET
 
 %type <syntax_node> start sql
 %type <syntax_node> sql_create_database sql_drop_database sql_show_databases sql_use_database
 %type <syntax_node> sql_show_tables sql_create_table sql_drop_table
 %type <syntax_node> column_definition_list column_definition column_type column_list
-%type <syntax_node> sql_create_index sql_drop_index sql_show_indexes
+%type <syntax_node> sql_create_index sql_drop_index sql_show_indexes index_include index_using
 %type <syntax_node> sql_trx_begin sql_trx_commit sql_trx_rollback
-%type <syntax_node> sql_select select_columns column_values column_value operator
+%type <syntax_node> sql_select select_columns select_column_list select_column column_ref from_tables join_tables
+%type <syntax_node> select_where select_group_by select_order_by select_limit order_list order_item column_ref_list
+%type <syntax_node> column_values column_value operator
 %type <syntax_node> connector where_conditions where_condition
 %type <syntax_node> sql_insert sql_delete sql_update update_values update_value
 %type <syntax_node> sql_quit sql_exec_file
@@ -161,24 +166,53 @@ sql_drop_table:
   ;
 
 sql_create_index:
-  CREATE INDEX IDENTIFIER ON IDENTIFIER '(' column_list ')' {
+  CREATE INDEX IDENTIFIER ON IDENTIFIER '(' column_list ')' index_include index_using {
     $$ = CreateSyntaxNode(kNodeCreateIndex, NULL);
     SyntaxNodeAddChildren($$, $3);
     SyntaxNodeAddChildren($$, $5);
     pSyntaxNode index_keys_node = CreateSyntaxNode(kNodeColumnList, "index keys");
     SyntaxNodeAddChildren(index_keys_node, $7);
     SyntaxNodeAddChildren($$, index_keys_node);
+    if ($10 != NULL) {
+      SyntaxNodeAddChildren($$, $10);
+    }
+    if ($9 != NULL) {
+      SyntaxNodeAddChildren($$, $9);
+    }
+  }
+  | CREATE INDEX CONCURRENTLY IDENTIFIER ON IDENTIFIER '(' column_list ')' index_include index_using {
+    $$ = CreateSyntaxNode(kNodeCreateIndex, "concurrently");
+    SyntaxNodeAddChildren($$, $4);
+    SyntaxNodeAddChildren($$, $6);
+    pSyntaxNode index_keys_node = CreateSyntaxNode(kNodeColumnList, "index keys");
+    SyntaxNodeAddChildren(index_keys_node, $8);
+    SyntaxNodeAddChildren($$, index_keys_node);
+    if ($11 != NULL) {
+      SyntaxNodeAddChildren($$, $11);
+    }
+    if ($10 != NULL) {
+      SyntaxNodeAddChildren($$, $10);
+    }
   }
-  | CREATE INDEX IDENTIFIER ON IDENTIFIER '(' column_list ')' USING IDENTIFIER {
-      $$ = CreateSyntaxNode(kNodeCreateIndex, NULL);
-      SyntaxNodeAddChildren($$, $3);
-      SyntaxNodeAddChildren($$, $5);
-      pSyntaxNode index_keys_node = CreateSyntaxNode(kNodeColumnList, "index keys");
-      SyntaxNodeAddChildren(index_keys_node, $7);
-      SyntaxNodeAddChildren($$, index_keys_node);
-      pSyntaxNode index_type_node = CreateSyntaxNode(kNodeIndexType, "index type");
-      SyntaxNodeAddChildren(index_type_node, $10);
-      SyntaxNodeAddChildren($$, index_type_node);
+  ;
+
+index_include:
+  /* empty */ {
+    $$ = NULL;
+  }
+  | INCLUDE '(' column_list ')' {
+    $$ = CreateSyntaxNode(kNodeIndexInclude, "include columns");
+    SyntaxNodeAddChildren($$, $3);
+  }
+  ;
+
+index_using:
+  /* empty */ {
+    $$ = NULL;
+  }
+  | USING IDENTIFIER {
+    $$ = CreateSyntaxNode(kNodeIndexType, "index type");
+    SyntaxNodeAddChildren($$, $2);
   }
   ;
 
@@ -196,17 +230,127 @@ sql_show_indexes:
   ;
 
 sql_select:
-  SELECT select_columns FROM IDENTIFIER {
+  SELECT select_columns FROM from_tables select_where select_group_by select_order_by select_limit {
     $$ = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren($$, $2);
     SyntaxNodeAddChildren($$, $4);
+    if ($5 != NULL) {
+      SyntaxNodeAddChildren($$, $5);
+    }
+    if ($6 != NULL) {
+      SyntaxNodeAddChildren($$, $6);
+    }
+    if ($7 != NULL) {
+      SyntaxNodeAddChildren($$, $7);
+    }
+    if ($8 != NULL) {
+      SyntaxNodeAddChildren($$, $8);
+    }
   }
-  | SELECT select_columns FROM IDENTIFIER WHERE where_conditions {
-    $$ = CreateSyntaxNode(kNodeSelect, NULL);
+  ;
+
+select_where:
+  /* empty */ {
+    $$ = NULL;
+  }
+  | WHERE where_conditions {
+    $$ = CreateSyntaxNode(kNodeConditions, NULL);
+    SyntaxNodeAddChildren($$, $2);
+  }
+  ;
+
+select_group_by:
+  /* empty */ {
+    $$ = NULL;
+  }
+  | GROUP BY column_ref_list {
+    $$ = CreateSyntaxNode(kNodeGroupBy, NULL);
+    SyntaxNodeAddChildren($$, $3);
+  }
+  ;
+
+select_order_by:
+  /* empty */ {
+    $$ = NULL;
+  }
+  | ORDER BY order_list {
+    $$ = CreateSyntaxNode(kNodeOrderBy, NULL);
+    SyntaxNodeAddChildren($$, $3);
+  }
+  ;
+
+select_limit:
+  /* empty */ {
+    $$ = NULL;
+  }
+  | LIMIT NUMBER {
+    $$ = CreateSyntaxNode(kNodeLimit, NULL);
+    SyntaxNodeAddChildren($$, $2);
+  }
+  | LIMIT NUMBER OFFSET NUMBER {
+    $$ = CreateSyntaxNode(kNodeLimit, NULL);
     SyntaxNodeAddChildren($$, $2);
     SyntaxNodeAddChildren($$, $4);
+  }
+  ;
+
+order_list:
+  order_item ',' order_list {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+  }
+  | order_item {
+    $$ = $1;
+  }
+  ;
+
+order_item:
+  column_ref {
+    $$ = CreateSyntaxNode(kNodeOrderItem, "asc");
+    SyntaxNodeAddChildren($$, $1);
+  }
+  | column_ref ASC {
+    $$ = CreateSyntaxNode(kNodeOrderItem, "asc");
+    SyntaxNodeAddChildren($$, $1);
+  }
+  | column_ref DESC {
+    $$ = CreateSyntaxNode(kNodeOrderItem, "desc");
+    SyntaxNodeAddChildren($$, $1);
+  }
+  ;
+
+from_tables:
+  IDENTIFIER {
+    $$ = $1;
+  }
+  | join_tables {
+    $$ = $1;
+  }
+  ;
+
+join_tables:
+  IDENTIFIER ',' IDENTIFIER {
+    $$ = CreateSyntaxNode(kNodeJoin, "inner");
+    SyntaxNodeAddChildren($$, $1);
+    SyntaxNodeAddChildren($$, $3);
+  }
+  | IDENTIFIER JOIN IDENTIFIER ON where_conditions {
+    $$ = CreateSyntaxNode(kNodeJoin, "inner");
+    SyntaxNodeAddChildren($$, $1);
+    SyntaxNodeAddChildren($$, $3);
     pSyntaxNode condition_node = CreateSyntaxNode(kNodeConditions, NULL);
-    SyntaxNodeAddChildren(condition_node, $6);
+    SyntaxNodeAddChildren(condition_node, $5);
+    SyntaxNodeAddChildren($$, condition_node);
+  }
+  | join_tables ',' IDENTIFIER {
+    $$ = $1;
+    SyntaxNodeAddChildren($$, $3);
+  }
+  | join_tables JOIN IDENTIFIER ON where_conditions {
+    $$ = $1;
+    SyntaxNodeAddChildren($$, $3);
+    pSyntaxNode condition_node = CreateSyntaxNode(kNodeConditions, NULL);
+    SyntaxNodeAddChildren(condition_node, $5);
     SyntaxNodeAddChildren($$, condition_node);
   }
   ;
@@ -215,12 +359,58 @@ select_columns:
   '*' {
     $$ = CreateSyntaxNode(kNodeAllColumns, NULL);
   }
-  | column_list {
+  | select_column_list {
     $$ = CreateSyntaxNode(kNodeColumnList, "select columns");
     SyntaxNodeAddChildren($$, $1);
   }
   ;
 
+select_column_list:
+  select_column ',' select_column_list {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+  }
+  | select_column {
+    $$ = $1;
+  }
+  ;
+
+select_column:
+  column_ref {
+    $$ = $1;
+  }
+  | IDENTIFIER '(' column_ref ')' {
+    $$ = CreateSyntaxNode(kNodeFunction, $1->val_);
+    SyntaxNodeAddChildren($$, $3);
+  }
+  | IDENTIFIER '(' '*' ')' {
+    $$ = CreateSyntaxNode(kNodeFunction, $1->val_);
+    SyntaxNodeAddChildren($$, CreateSyntaxNode(kNodeAllColumns, NULL));
+  }
+  ;
+
+column_ref_list:
+  column_ref ',' column_ref_list {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+  }
+  | column_ref {
+    $$ = $1;
+  }
+  ;
+
+column_ref:
+  IDENTIFIER {
+    $$ = $1;
+  }
+  | IDENTIFIER '.' IDENTIFIER {
+    char *name = (char *)malloc(strlen($1->val_) + strlen($3->val_) + 2);
+    sprintf(name, "%s.%s", $1->val_, $3->val_);
+    $$ = CreateSyntaxNode(kNodeIdentifier, name);
+    free(name);
+  }
+  ;
+
 where_conditions:
   where_conditions connector where_condition  {
     $$ = $2;
@@ -242,11 +432,26 @@ connector:
   ;
 
 where_condition:
-  IDENTIFIER operator column_value {
+  column_ref operator column_value {
+    $$ = $2;
+    SyntaxNodeAddChildren($$, $1);
+    SyntaxNodeAddChildren($$, $3);
+  }
+  | column_ref operator column_ref {
     $$ = $2;
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $3);
   }
+  | MATCH '(' IDENTIFIER ',' STRING ')' {
+    $$ = CreateSyntaxNode(kNodeCompareOperator, "match");
+    SyntaxNodeAddChildren($$, $3);
+    SyntaxNodeAddChildren($$, $5);
+  }
+  | column_ref IN '(' column_values ')' {
+    $$ = CreateSyntaxNode(kNodeCompareOperator, "in");
+    SyntaxNodeAddChildren($$, $1);
+    SyntaxNodeAddChildren($$, $4);
+  }
   ;
 
 column_value:
@@ -286,6 +491,9 @@ operator:
   | NOT {
     $$ = CreateSyntaxNode(kNodeCompareOperator, "not");
   }
+  | LIKE {
+    $$ = CreateSyntaxNode(kNodeCompareOperator, "like");
+  }
   ;
 
 sql_insert:
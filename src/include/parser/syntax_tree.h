@@ -29,7 +29,7 @@ typedef enum {
   kNodeSelect,               /** select command */
   kNodeConditions,           /** where conditions */
   kNodeConnector,            /** operators 'AND' and 'OR' */
-  kNodeCompareOperator,      /** operators '=', '<>', '<=', '>=', '<', '>', is, not */
+  kNodeCompareOperator,      /** operators '=', '<>', '<=', '>=', '<', '>', is, not, match, like, in */
   kNodeColumnType,           /** column types: int, char, float */
   kNodeColumnDefinition,     /** column definition, contains column identifier and column type and UNIQUE constraint */
   kNodeColumnDefinitionList, /** contains several column definitions */
@@ -43,7 +43,14 @@ typedef enum {
   kNodeIndexType,            /** type of index */
   kNodeTrxBegin,             /** begin recovery command */
   kNodeTrxCommit,            /** commit recovery command */
-  kNodeTrxRollback           /** rollback recovery command */
+  kNodeTrxRollback,          /** rollback recovery command */
+  kNodeIndexInclude,         /** payload columns stored in the index, create index ... include (...) */
+  kNodeJoin,                 /** tables joined in select, contains the tables and the conditions of their ON clauses */
+  kNodeFunction,             /** aggregate function call in select, eg: count(*), sum(column) */
+  kNodeGroupBy,              /** group by clause, contains the grouping columns */
+  kNodeOrderBy,              /** order by clause, contains the order items */
+  kNodeOrderItem,            /** order by key, val is "asc" or "desc", contains the column */
+  kNodeLimit                 /** limit clause, contains the row count and the optional offset */
 } SyntaxNodeType;
 
 /**
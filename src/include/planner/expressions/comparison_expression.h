@@ -5,9 +5,13 @@
 #ifndef MINISQL_COMPARISON_EXPRESSION_H
 #define MINISQL_COMPARISON_EXPRESSION_H
 
+#include <algorithm>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "abstract_expression.h"
+#include "index/text_tokenizer.h"
 #include "record/schema.h"
 
 /**
@@ -16,25 +20,89 @@
 class ComparisonExpression : public AbstractExpression {
  public:
   /** Creates a new comparison expression representing (left comp_type right). */
-  ComparisonExpression(AbstractExpressionRef left, AbstractExpressionRef right, string comp_type)
+  ComparisonExpression(AbstractExpressionRef left, AbstractExpressionRef right, std::string comp_type)
       : AbstractExpression({std::move(left), std::move(right)}, TypeId::kTypeInt, ExpressionType::ComparisonExpression),
         comp_type_{std::move(comp_type)} {}
 
+  /** Creates a comparison of the first child against all the others, e.g. (id in (1, 2, 3)). */
+  ComparisonExpression(std::vector<AbstractExpressionRef> children, std::string comp_type)
+      : AbstractExpression(std::move(children), TypeId::kTypeInt, ExpressionType::ComparisonExpression),
+        comp_type_{std::move(comp_type)} {}
+
   /** e.g. evaluate the result of id = 1 */
   Field Evaluate(const Row *row) const override {
     Field lhs = GetChildAt(0)->Evaluate(row);
+    if (comp_type_ == "in") {
+      return Field(kTypeInt,
+                   PerformIn(lhs, [row](const AbstractExpressionRef &child) { return child->Evaluate(row); }));
+    }
     Field rhs = GetChildAt(1)->Evaluate(row);
     return Field(kTypeInt, PerformComparison(lhs, rhs));
   }
 
   Field EvaluateJoin(const Row *left_row, const Row *right_row) const override {
     Field lhs = GetChildAt(0)->EvaluateJoin(left_row, right_row);
+    if (comp_type_ == "in") {
+      return Field(kTypeInt, PerformIn(lhs, [left_row, right_row](const AbstractExpressionRef &child) {
+                     return child->EvaluateJoin(left_row, right_row);
+                   }));
+    }
     Field rhs = GetChildAt(1)->EvaluateJoin(left_row, right_row);
     return Field(kTypeInt, PerformComparison(lhs, rhs));
   }
 
   std::string GetComparisonType() { return comp_type_; }
 
+  /**
+   * @return true if the column is compared against constants only, a comparison of two columns, e.g. a.x = b.y,
+   * can not bound an index or a page range
+   */
+  bool ComparesToConstants() const {
+    const auto &children = GetChildren();
+    return std::all_of(children.begin() + 1, children.end(), [](const AbstractExpressionRef &child) {
+      return child->GetType() == ExpressionType::ConstantExpression;
+    });
+  }
+
+  /**
+   * Match text against a like pattern, '%' matches any run of characters and '_' any single one.
+   * The pattern is walked once, on a mismatch only the part after the last '%' is retried one
+   * character further, so no state machine has to be built per row.
+   */
+  static bool LikeMatch(const char *text, size_t text_length, const char *pattern, size_t pattern_length) {
+    size_t t = 0;
+    size_t p = 0;
+    size_t star = std::string::npos;
+    size_t star_text = 0;
+    while (t < text_length) {
+      if (p < pattern_length && (pattern[p] == '_' || (pattern[p] != '%' && pattern[p] == text[t]))) {
+        t++;
+        p++;
+      } else if (p < pattern_length && pattern[p] == '%') {
+        star = p++;
+        star_text = t;
+      } else if (star != std::string::npos) {
+        p = star + 1;
+        t = ++star_text;
+      } else {
+        return false;
+      }
+    }
+    while (p < pattern_length && pattern[p] == '%') {
+      p++;
+    }
+    return p == pattern_length;
+  }
+
+  /** @return the characters of a like pattern before its first wildcard */
+  static std::string LikePrefix(const char *pattern, size_t pattern_length) {
+    size_t length = 0;
+    while (length < pattern_length && pattern[length] != '%' && pattern[length] != '_' && pattern[length] != '\0') {
+      length++;
+    }
+    return std::string(pattern, length);
+  }
+
  private:
   CmpBool PerformComparison(const Field &lhs, const Field &rhs) const {
     if (comp_type_ == "=")
@@ -53,10 +121,64 @@ class ComparisonExpression : public AbstractExpression {
       return GetCmpBool(lhs.IsNull());
     else if (comp_type_ == "not")
       return GetCmpBool(!lhs.IsNull());
+    else if (comp_type_ == "match")
+      return PerformMatch(lhs, rhs);
+    else if (comp_type_ == "like")
+      return PerformLike(lhs, rhs);
     else
       throw std::logic_error("Unsupported comparison type");
   }
 
+  /** @return true if lhs equals one of the values, null if it equals none but a value or lhs itself is null */
+  template <typename EvaluateChild>
+  CmpBool PerformIn(const Field &lhs, EvaluateChild evaluate) const {
+    if (lhs.IsNull()) {
+      return CmpBool::kNull;
+    }
+    CmpBool result = CmpBool::kFalse;
+    for (size_t i = 1; i < GetChildren().size(); i++) {
+      CmpBool equal = lhs.CompareEquals(evaluate(GetChildAt(i)));
+      if (equal == CmpBool::kTrue) {
+        return CmpBool::kTrue;
+      }
+      if (equal == CmpBool::kNull) {
+        result = CmpBool::kNull;
+      }
+    }
+    return result;
+  }
+
+  /** @return true if the text of lhs holds every token of the query in rhs, a query without tokens matches nothing */
+  CmpBool PerformMatch(const Field &lhs, const Field &rhs) const {
+    if (lhs.IsNull() || rhs.IsNull()) {
+      return CmpBool::kNull;
+    }
+    std::vector<std::string> text_tokens;
+    std::vector<std::string> query_tokens;
+    TokenizeText(lhs.GetData(), lhs.GetLength(), text_tokens);
+    TokenizeText(rhs.GetData(), rhs.GetLength(), query_tokens);
+    if (query_tokens.empty()) {
+      return CmpBool::kFalse;
+    }
+    return GetCmpBool(std::includes(text_tokens.begin(), text_tokens.end(), query_tokens.begin(), query_tokens.end()));
+  }
+
+  CmpBool PerformLike(const Field &lhs, const Field &rhs) const {
+    if (lhs.IsNull() || rhs.IsNull()) {
+      return CmpBool::kNull;
+    }
+    return GetCmpBool(LikeMatch(lhs.GetData(), TextLength(lhs), rhs.GetData(), TextLength(rhs)));
+  }
+
+  /** @return the length of a char field without the padding zeros */
+  static size_t TextLength(const Field &field) {
+    size_t length = field.GetLength();
+    while (length > 0 && field.GetData()[length - 1] == '\0') {
+      length--;
+    }
+    return length;
+  }
+
   std::string comp_type_;
 };
 
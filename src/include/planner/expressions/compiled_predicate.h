@@ -0,0 +1,104 @@
+#ifndef MINISQL_COMPILED_PREDICATE_H
+#define MINISQL_COMPILED_PREDICATE_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "planner/expressions/abstract_expression.h"
+
+/**
+ * CompiledPredicate is a filter expression lowered into a flat program of typed kernels.
+ *
+ * Comparing a column with a constant or another column of the same type, "in" lists of constants and null tests
+ * each become one kernel instantiated for the value type and the operator, which reads the field value directly:
+ * no Field is built, no Type is looked up and no operator string is compared per row. "and" and "or" become
+ * jumps over the right side once the left one decides the result. Anything else, e.g. "like", "match" or a type
+ * mismatch, stays a leaf that calls Evaluate of its expression, so every predicate compiles and matches exactly
+ * the rows the expression tree evaluates to true for.
+ *
+ * A compiled predicate is immutable and can be shared by the threads scanning one table.
+ */
+class CompiledPredicate {
+ public:
+  /** @return expr compiled, null if expr is null */
+  static std::shared_ptr<const CompiledPredicate> Compile(const AbstractExpressionRef &expr);
+
+  /** @return the three-valued result of the predicate on row */
+  CmpBool Evaluate(const Row *row) const;
+
+  /** @return true if row satisfies the predicate */
+  bool Matches(const Row *row) const { return Evaluate(row) == CmpBool::kTrue; }
+
+  /** @return the leaves left to Evaluate of their expression */
+  size_t GetInterpretedCount() const;
+
+  enum class CmpOp { Eq, Ne, Lt, Le, Gt, Ge };
+
+ private:
+  enum class OpCode { Leaf, AndJump, OrJump, And, Or };
+
+  struct Instruction;
+  using Kernel = CmpBool (*)(const Instruction &, const Row *);
+
+  struct Instruction {
+    OpCode code_{OpCode::Leaf};
+    Kernel kernel_{nullptr};
+    /** the jump target of AndJump and OrJump */
+    size_t target_{0};
+    uint32_t lhs_column_{0};
+    uint32_t rhs_column_{0};
+    /** the constant of a comparison, decoded for the type of the kernel */
+    int32_t int_{0};
+    float float_{0};
+    std::string chars_;
+    /** the constants of an in list, sorted and without nulls */
+    std::vector<int32_t> ints_;
+    std::vector<float> floats_;
+    std::vector<std::string> strings_;
+    bool has_null_{false};
+    /** the expression of an interpreted leaf */
+    AbstractExpressionRef expr_;
+  };
+
+  void Emit(const AbstractExpressionRef &expr);
+
+  /** @return false if comparison is not covered by a typed kernel */
+  bool EmitComparison(const AbstractExpressionRef &comparison);
+
+  template <typename T>
+  static T Read(const Field &field);
+
+  template <typename T>
+  static T Constant(const Instruction &instruction);
+
+  template <typename T>
+  static const std::vector<T> &Constants(const Instruction &instruction);
+
+  template <typename T, CmpOp op>
+  static CmpBool ColumnConstantKernel(const Instruction &instruction, const Row *row);
+
+  template <typename T, CmpOp op>
+  static CmpBool ColumnColumnKernel(const Instruction &instruction, const Row *row);
+
+  template <typename T>
+  static CmpBool InKernel(const Instruction &instruction, const Row *row);
+
+  template <bool is_null>
+  static CmpBool NullKernel(const Instruction &instruction, const Row *row);
+
+  static CmpBool InterpretKernel(const Instruction &instruction, const Row *row);
+
+  template <typename T>
+  static Kernel ColumnConstantKernelFor(CmpOp op);
+
+  template <typename T>
+  static Kernel ColumnColumnKernelFor(CmpOp op);
+
+  std::vector<Instruction> program_;
+  /** the deepest the value stack gets */
+  size_t max_depth_{0};
+};
+
+#endif  // MINISQL_COMPILED_PREDICATE_H
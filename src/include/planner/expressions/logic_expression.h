@@ -5,7 +5,10 @@
 #ifndef MINISQL_LOGIC_EXPRESSION_H
 #define MINISQL_LOGIC_EXPRESSION_H
 
+#include <vector>
+
 #include "abstract_expression.h"
+#include "comparison_expression.h"
 
 /** ArithmeticType represents the type of logic operation that we want to perform. */
 enum class LogicType { And, Or };
@@ -46,6 +49,27 @@ class LogicExpression : public AbstractExpression {
       throw std::logic_error("Unsupported logic type.");
   }
 
+  /**
+   * Collect the comparisons of predicate against constants that must all hold, the children of an "or" and
+   * comparisons of two columns are left out.
+   */
+  static void CollectConjuncts(const AbstractExpressionRef &predicate, std::vector<ComparisonExpression *> &conjuncts) {
+    if (predicate == nullptr) {
+      return;
+    }
+    if (predicate->GetType() == ExpressionType::ComparisonExpression) {
+      auto comparison = dynamic_cast<ComparisonExpression *>(predicate.get());
+      if (comparison->ComparesToConstants()) {
+        conjuncts.push_back(comparison);
+      }
+    } else if (predicate->GetType() == ExpressionType::LogicExpression &&
+               dynamic_cast<LogicExpression *>(predicate.get())->logic_type_ == LogicType::And) {
+      for (const auto &child : predicate->GetChildren()) {
+        CollectConjuncts(child, conjuncts);
+      }
+    }
+  }
+
   LogicType logic_type_;
 
  private:
@@ -5,12 +5,25 @@
 #ifndef MINISQL_PLANNER_H
 #define MINISQL_PLANNER_H
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "common/instance.h"
 #include "executor/plans/abstract_plan.h"
+#include "executor/plans/aggregation_plan.h"
+#include "executor/plans/bitmap_scan_plan.h"
 #include "executor/plans/delete_plan.h"
+#include "executor/plans/gather_plan.h"
+#include "executor/plans/hash_join_plan.h"
+#include "executor/plans/index_nested_loop_join_plan.h"
 #include "executor/plans/index_scan_plan.h"
 #include "executor/plans/insert_plan.h"
+#include "executor/plans/limit_plan.h"
+#include "executor/plans/merge_join_plan.h"
 #include "executor/plans/seq_scan_plan.h"
+#include "executor/plans/sort_plan.h"
+#include "executor/plans/topn_plan.h"
 #include "executor/plans/update_plan.h"
 #include "executor/plans/values_plan.h"
 #include "planner/statement/abstract_statement.h"
@@ -34,6 +47,69 @@ class Planner {
 
   AbstractPlanNodeRef PlanSelect(std::shared_ptr<SelectStatement> statement);
 
+  /**
+   * Order the rows of child by order_bys and apply the LIMIT of the select, a small limit keeps only the first rows
+   * in a TopNPlanNode instead of sorting them all.
+   * @param out_schema The output schema, the one of child or columns picked from it by table index
+   */
+  AbstractPlanNodeRef PlanOrderBy(std::shared_ptr<SelectStatement> statement, AbstractPlanNodeRef child,
+                                  const Schema *out_schema,
+                                  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys);
+
+  /** Record the columns of every table of the select that any part of it reads into needed_columns_. */
+  void CollectNeededColumns(std::shared_ptr<SelectStatement> statement, bool aggregation);
+
+  /**
+   * @param filter_columns The columns the predicate of the scan reads
+   * @return the columns a scan of table_name has to decode, empty if it needs all of them or the statement is not
+   * a select
+   */
+  std::vector<bool> GetNeededColumns(const std::string &table_name, const std::vector<uint32_t> &filter_columns) const;
+
+  /**
+   * Run a sequential scan on the workers of the query under a GatherPlanNode. Only for a consumer that does not
+   * depend on the order of its input, such as an aggregation or a sort.
+   */
+  AbstractPlanNodeRef Parallelize(AbstractPlanNodeRef plan);
+
+  /** Put a LimitPlanNode on top of child if the select has a LIMIT. */
+  AbstractPlanNodeRef PlanLimit(std::shared_ptr<SelectStatement> statement, AbstractPlanNodeRef child);
+
+  /**
+   * Find a B+ tree index of the single table of a select whose key starts with the ORDER BY keys and walk it, the
+   * rows come out in order and the scan stops at the limit.
+   * @return the index scan, null if no index has the order
+   */
+  AbstractPlanNodeRef PlanOrderedIndexScan(std::shared_ptr<SelectStatement> statement, const Schema *out_schema);
+
+  /**
+   * Join the tables of a select with more than one table in FROM.
+   * @param join_schema The output schema of the last join, null to keep every column of every table
+   */
+  AbstractPlanNodeRef PlanJoin(std::shared_ptr<SelectStatement> statement, const Schema *join_schema);
+
+  /**
+   * Choose the access path of a single table.
+   * @param filter_columns The columns the predicate reads
+   * @param has_or Whether the predicate has an "or"
+   */
+  AbstractPlanNodeRef PlanScan(const std::string &table_name, const Schema *out_schema,
+                               const AbstractExpressionRef &where, const std::vector<uint32_t> &filter_columns,
+                               bool has_or);
+
+  /**
+   * Find the B+ tree index of a joined table whose longest leftmost key prefix is matched by equalities.
+   * @param offset The position of the first column of the table in the joined row
+   * @param equalities Pairs of (outer column, column of the table) that must be equal
+   * @param index The index found, left untouched if there is none
+   * @param key_equalities The equalities matching the key prefix, in key order
+   */
+  void FindJoinIndex(
+      const std::string &table_name, uint32_t offset,
+      const std::vector<std::pair<std::shared_ptr<ColumnValueExpression>, std::shared_ptr<ColumnValueExpression>>>
+          &equalities,
+      IndexInfo *&index, std::vector<size_t> &key_equalities);
+
   AbstractPlanNodeRef PlanInsert(std::shared_ptr<InsertStatement> statement);
 
   AbstractPlanNodeRef PlanDelete(std::shared_ptr<DeleteStatement> statement);
@@ -45,6 +121,12 @@ class Planner {
 
   Schema *MakeOutputSchema(const std::vector<std::pair<std::string, AbstractExpressionRef>> &exprs);
 
+  /** The columns of each table the select being planned reads, by table name */
+  std::unordered_map<std::string, std::vector<bool>> needed_columns_;
+
+  /** Output schemas of the plan nodes below the root, they live as long as the planner */
+  std::vector<std::unique_ptr<Schema>> intermediate_schemas_;
+
   /** Catalog will be used during the planning process. SHOULD ONLY BE USED IN
    * CODE PATH OF `PlanQuery`.
    */
@@ -52,6 +134,9 @@ class Planner {
 
   /** The maximum size allowed for VARCHAR columns */
   static constexpr const uint32_t MAX_VARCHAR_SIZE = 128;
+
+  /** The largest LIMIT plus OFFSET kept in the heap of a TopNPlanNode, a larger one sorts all rows */
+  static constexpr const uint32_t MAX_TOP_N_ROWS = 4096;
 };
 
 #endif  // MINISQL_PLANNER_H
@@ -37,15 +37,23 @@ class AbstractStatement {
   /**
    * Make a column value expression.
    * @param table_name The name of the table
-   * @param col The ptr to the SyntaxNode of the column
+   * @param col The ptr to the SyntaxNode of the column, either "column" or "table.column"
    * @return A owning pointer to the ColumnValueExpression
    */
-  AbstractExpressionRef MakeColumnValueExpression(const std::string &table_name, pSyntaxNode col) {
+  virtual AbstractExpressionRef MakeColumnValueExpression(const std::string &table_name, pSyntaxNode col) {
     TableInfo *info = nullptr;
     context_->GetCatalog()->GetTable(table_name, info);
     auto schema = info->GetSchema();
+    std::string column_name = col->val_;
+    auto dot = column_name.find('.');
+    if (dot != std::string::npos) {
+      if (column_name.substr(0, dot) != table_name) {
+        throw std::logic_error("the column does not exist in table");
+      }
+      column_name = column_name.substr(dot + 1);
+    }
     uint32_t index;
-    if (schema->GetColumnIndex(col->val_, index) != DB_SUCCESS) {
+    if (schema->GetColumnIndex(column_name, index) != DB_SUCCESS) {
       throw std::logic_error("the column does not exist in table");
     }
     auto col_type = schema->GetColumn(index)->GetType();
@@ -112,13 +120,31 @@ class AbstractStatement {
         pSyntaxNode col = ast->child_;
         pSyntaxNode value = ast->child_->next_;
         auto col_expr = MakeColumnValueExpression(table_name, col);
+        AddColumnInCondition(col_expr, column_in_condition);
+        if (value->type_ == kNodeIdentifier) {
+          // a comparison of two columns, e.g. the join condition a.x = b.y
+          auto rhs_expr = MakeColumnValueExpression(table_name, value);
+          if (!strcmp(ast->val_, "is") || !strcmp(ast->val_, "not") || !strcmp(ast->val_, "like")) {
+            throw std::logic_error("the operator can not compare two columns");
+          }
+          if (rhs_expr->GetReturnType() != col_expr->GetReturnType()) {
+            throw std::logic_error("the columns compared are of different types");
+          }
+          AddColumnInCondition(rhs_expr, column_in_condition);
+          return MakeComparisonExpression(col_expr, rhs_expr, ast->val_);
+        }
+        if (!strcmp(ast->val_, "like") && col_expr->GetReturnType() != TypeId::kTypeChar) {
+          // the pattern and the prefix range scans read the column as text
+          throw std::logic_error("like only applies to char columns");
+        }
         auto const_expr = MakeConstantValueExpression(col_expr->GetReturnType(), value);
-        if (column_in_condition) {
-          uint32_t index = dynamic_pointer_cast<ColumnValueExpression>(col_expr)->GetColIdx();
-          if (std::find(column_in_condition->begin(), column_in_condition->end(), index) ==
-              column_in_condition->end()) {
-            column_in_condition->emplace_back(index);
+        if (!strcmp(ast->val_, "in")) {
+          // the column followed by one constant per value of the list
+          std::vector<AbstractExpressionRef> children{col_expr, const_expr};
+          for (pSyntaxNode next = value->next_; next != nullptr; next = next->next_) {
+            children.push_back(MakeConstantValueExpression(col_expr->GetReturnType(), next));
           }
+          return std::make_shared<ComparisonExpression>(std::move(children), ast->val_);
         }
         return MakeComparisonExpression(col_expr, const_expr, ast->val_);
       }
@@ -127,6 +153,17 @@ class AbstractStatement {
     }
   }
 
+  /** Record the column of col_expr in column_in_condition, if it is not there yet. */
+  static void AddColumnInCondition(const AbstractExpressionRef &col_expr, vector<uint32_t> *column_in_condition) {
+    if (column_in_condition == nullptr) {
+      return;
+    }
+    uint32_t index = dynamic_pointer_cast<ColumnValueExpression>(col_expr)->GetColIdx();
+    if (std::find(column_in_condition->begin(), column_in_condition->end(), index) == column_in_condition->end()) {
+      column_in_condition->emplace_back(index);
+    }
+  }
+
   /**
    * Allocate a comparison expression and return it to the caller.
    * @param lhs The abstract expression for the left-hand side of the comparison
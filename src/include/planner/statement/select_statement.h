@@ -6,6 +6,8 @@
 #define MINISQL_SELECT_STATEMENT_H
 
 #include "abstract_statement.h"
+#include "executor/plans/aggregation_plan.h"
+#include "executor/plans/sort_plan.h"
 
 class SelectStatement : public AbstractStatement {
  public:
@@ -17,13 +19,21 @@ class SelectStatement : public AbstractStatement {
       return;
     switch (ast->type_) {
       case kNodeIdentifier: {
-        TableInfo *info = nullptr;
-        if (context_->GetCatalog()->GetTable(ast->val_, info) != DB_SUCCESS) {
-          std::stringstream error_info;
-          error_info << "the table " << ast->val_ << " is not exist.";
-          throw std::logic_error(error_info.str());
+        AddTable(ast->val_);
+        break;
+      }
+      case kNodeJoin: {
+        // the tables come first, every ON clause only refers to the tables before it
+        for (pSyntaxNode child = ast->child_; child != nullptr; child = child->next_) {
+          if (child->type_ == kNodeIdentifier) {
+            AddTable(child->val_);
+          }
+        }
+        for (pSyntaxNode child = ast->child_; child != nullptr; child = child->next_) {
+          if (child->type_ == kNodeConditions) {
+            AddCondition(MakePredicate(child->child_, table_name_, &column_in_condition_, &has_or));
+          }
         }
-        table_name_ = ast->val_;
         break;
       }
       case kNodeAllColumns:
@@ -33,7 +43,28 @@ class SelectStatement : public AbstractStatement {
         return;
       }
       case kNodeConditions: {
-        where_ = MakePredicate(ast->child_, table_name_, &column_in_condition_, &has_or);
+        AddCondition(MakePredicate(ast->child_, table_name_, &column_in_condition_, &has_or));
+        break;
+      }
+      case kNodeGroupBy: {
+        for (pSyntaxNode child = ast->child_; child != nullptr; child = child->next_) {
+          group_by_.push_back(MakeColumnValueExpression(table_name_, child));
+        }
+        break;
+      }
+      case kNodeOrderBy: {
+        for (pSyntaxNode child = ast->child_; child != nullptr; child = child->next_) {
+          auto direction = strcmp(child->val_, "desc") == 0 ? OrderByType::Desc : OrderByType::Asc;
+          order_by_.emplace_back(direction, MakeColumnValueExpression(table_name_, child->child_));
+        }
+        break;
+      }
+      case kNodeLimit: {
+        has_limit_ = true;
+        limit_ = ParseRowCount(ast->child_->val_);
+        if (ast->child_->next_ != nullptr) {
+          offset_ = ParseRowCount(ast->child_->next_->val_);
+        }
         break;
       }
       default:
@@ -43,31 +74,76 @@ class SelectStatement : public AbstractStatement {
   };
 
   void MakeColumnList(pSyntaxNode ast) {
-    TableInfo *info = nullptr;
-    context_->GetCatalog()->GetTable(table_name_, info);
-    auto schema = info->GetSchema();
     if (!ast) {
-      auto columns = schema->GetColumns();
-      for (auto column : columns) {
-        auto expr = std::make_shared<ColumnValueExpression>(0, column->GetTableInd(), column->GetType());
-        column_list_.emplace_back(make_pair(column->GetName(), expr));
+      if (!group_by_.empty()) {
+        throw std::logic_error("select * can not be grouped");
+      }
+      for (size_t i = 0; i < table_names_.size(); i++) {
+        TableInfo *info = nullptr;
+        context_->GetCatalog()->GetTable(table_names_[i], info);
+        for (auto column : info->GetSchema()->GetColumns()) {
+          auto expr = std::make_shared<ColumnValueExpression>(0, table_offsets_[i] + column->GetTableInd(),
+                                                              column->GetType());
+          column_list_.emplace_back(make_pair(column->GetName(), expr));
+        }
       }
+    } else if (!group_by_.empty() || IsAggregation(ast)) {
+      MakeAggregationList(ast);
     } else {
       while (ast) {
-        uint32_t index;
-        if (schema->GetColumnIndex(ast->val_, index) != DB_SUCCESS) {
-          throw std::logic_error("the column does not exist in table");
-        }
-        auto expr = std::make_shared<ColumnValueExpression>(0, index, schema->GetColumn(index)->GetType());
-        column_list_.emplace_back(make_pair(ast->val_, expr));
+        column_list_.emplace_back(make_pair(ast->val_, MakeColumnValueExpression(table_name_, ast)));
         ast = ast->next_;
       }
     }
   }
 
-  /** Bound FROM clause. */
+  /**
+   * Bind a column of any table in FROM, "table.column" names the table, a bare column name must be unique among
+   * them. The column index is the one in the row of all FROM tables concatenated in order.
+   */
+  AbstractExpressionRef MakeColumnValueExpression(const std::string &table_name, pSyntaxNode col) override {
+    if (table_names_.size() <= 1) {
+      return AbstractStatement::MakeColumnValueExpression(table_name, col);
+    }
+    std::string column_name = col->val_;
+    std::string qualifier;
+    auto dot = column_name.find('.');
+    if (dot != std::string::npos) {
+      qualifier = column_name.substr(0, dot);
+      column_name = column_name.substr(dot + 1);
+    }
+    AbstractExpressionRef result = nullptr;
+    for (size_t i = 0; i < table_names_.size(); i++) {
+      if (!qualifier.empty() && qualifier != table_names_[i]) {
+        continue;
+      }
+      TableInfo *info = nullptr;
+      context_->GetCatalog()->GetTable(table_names_[i], info);
+      uint32_t index;
+      if (info->GetSchema()->GetColumnIndex(column_name, index) != DB_SUCCESS) {
+        continue;
+      }
+      if (result != nullptr) {
+        throw std::logic_error("the column " + column_name + " is ambiguous");
+      }
+      result = std::make_shared<ColumnValueExpression>(0, table_offsets_[i] + index,
+                                                       info->GetSchema()->GetColumn(index)->GetType());
+    }
+    if (result == nullptr) {
+      throw std::logic_error("the column does not exist in table");
+    }
+    return result;
+  }
+
+  /** Bound FROM clause, the first table. */
   std::string table_name_;
 
+  /** All tables of the FROM clause in order, a join for more than one. */
+  std::vector<std::string> table_names_;
+
+  /** Index of the first column of every FROM table in the concatenated row. */
+  std::vector<uint32_t> table_offsets_;
+
   /** Bound SELECT list. */
   std::vector<std::pair<std::string, AbstractExpressionRef>> column_list_;
 
@@ -77,9 +153,28 @@ class SelectStatement : public AbstractStatement {
   /** Has or in where clause */
   bool has_or = false;
 
-  /** Bound WHERE clause. */
+  /** Bound WHERE clause, the conditions of the ON clauses are and-ed into it. */
   AbstractExpressionRef where_ = nullptr;
 
+  /** Bound GROUP BY clause. */
+  std::vector<AbstractExpressionRef> group_by_;
+
+  /**
+   * The arguments of the aggregates in the select list, null for count(*). With an aggregation the select list
+   * refers to the row of the group by values followed by the aggregate values.
+   */
+  std::vector<AbstractExpressionRef> aggregates_;
+
+  std::vector<AggregationType> agg_types_;
+
+  /** Bound ORDER BY clause, the keys refer to the row of all FROM tables like the WHERE clause. */
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_by_;
+
+  /** Bound LIMIT clause, offset_ rows are skipped before at most limit_ rows are returned. */
+  bool has_limit_ = false;
+  uint32_t limit_ = 0;
+  uint32_t offset_ = 0;
+
   std::string ToString() const override {
     std::stringstream sstream;
     sstream << "Select {{\\n  table={" << table_name_ << "},\\n  columns={";
@@ -89,6 +184,106 @@ class SelectStatement : public AbstractStatement {
     sstream << "},\\n where={" << where_->GetReturnType() << "}\\n}";
     return sstream.str();
   };
+
+ private:
+  void AddTable(const char *table_name) {
+    TableInfo *info = nullptr;
+    if (context_->GetCatalog()->GetTable(table_name, info) != DB_SUCCESS) {
+      std::stringstream error_info;
+      error_info << "the table " << table_name << " is not exist.";
+      throw std::logic_error(error_info.str());
+    }
+    if (std::find(table_names_.begin(), table_names_.end(), table_name) != table_names_.end()) {
+      throw std::logic_error("a table can only appear once in FROM");
+    }
+    uint32_t offset = 0;
+    if (!table_names_.empty()) {
+      TableInfo *last = nullptr;
+      context_->GetCatalog()->GetTable(table_names_.back(), last);
+      offset = table_offsets_.back() + last->GetSchema()->GetColumnCount();
+    } else {
+      table_name_ = table_name;
+    }
+    table_names_.emplace_back(table_name);
+    table_offsets_.push_back(offset);
+  }
+
+  static uint32_t ParseRowCount(const char *text) {
+    char *end = nullptr;
+    errno = 0;
+    long long count = strtoll(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || count < 0 || count > UINT32_MAX) {
+      throw std::logic_error(std::string("the row count ") + text + " is not valid");
+    }
+    return static_cast<uint32_t>(count);
+  }
+
+  static bool IsAggregation(pSyntaxNode ast) {
+    for (; ast != nullptr; ast = ast->next_) {
+      if (ast->type_ == kNodeFunction) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** Bind a select list over groups, a plain column has to be one of the group by columns. */
+  void MakeAggregationList(pSyntaxNode ast) {
+    static const std::vector<std::pair<std::string, AggregationType>> functions = {
+        {"count", AggregationType::Count}, {"sum", AggregationType::Sum}, {"avg", AggregationType::Avg},
+        {"min", AggregationType::Min},     {"max", AggregationType::Max}};
+    for (; ast != nullptr; ast = ast->next_) {
+      if (ast->type_ != kNodeFunction) {
+        auto column = dynamic_pointer_cast<ColumnValueExpression>(MakeColumnValueExpression(table_name_, ast));
+        auto it = std::find_if(group_by_.begin(), group_by_.end(), [&column](const AbstractExpressionRef &group_by) {
+          return dynamic_pointer_cast<ColumnValueExpression>(group_by)->GetColIdx() == column->GetColIdx();
+        });
+        if (it == group_by_.end()) {
+          throw std::logic_error(std::string("the column ") + ast->val_ + " must appear in group by");
+        }
+        column_list_.emplace_back(ast->val_, std::make_shared<ColumnValueExpression>(0, it - group_by_.begin(),
+                                                                                      column->GetReturnType()));
+        continue;
+      }
+      std::string function = ast->val_;
+      auto it = std::find_if(functions.begin(), functions.end(),
+                             [&function](const auto &entry) { return entry.first == function; });
+      if (it == functions.end()) {
+        throw std::logic_error("the function " + function + " is not supported");
+      }
+      AggregationType agg_type = it->second;
+      AbstractExpressionRef argument = nullptr;
+      std::string name;
+      TypeId type = TypeId::kTypeInt;
+      if (ast->child_->type_ == kNodeAllColumns) {
+        if (agg_type != AggregationType::Count) {
+          throw std::logic_error("only count takes *");
+        }
+        agg_type = AggregationType::CountStar;
+        name = function + "(*)";
+      } else {
+        argument = MakeColumnValueExpression(table_name_, ast->child_);
+        name = function + "(" + ast->child_->val_ + ")";
+        if ((agg_type == AggregationType::Sum || agg_type == AggregationType::Avg) &&
+            argument->GetReturnType() == TypeId::kTypeChar) {
+          throw std::logic_error("the function " + function + " needs a number");
+        }
+        if (agg_type == AggregationType::Avg) {
+          type = TypeId::kTypeFloat;
+        } else if (agg_type != AggregationType::Count) {
+          type = argument->GetReturnType();
+        }
+      }
+      uint32_t index = group_by_.size() + aggregates_.size();
+      column_list_.emplace_back(name, std::make_shared<ColumnValueExpression>(0, index, type));
+      aggregates_.push_back(argument);
+      agg_types_.push_back(agg_type);
+    }
+  }
+
+  void AddCondition(const AbstractExpressionRef &condition) {
+    where_ = where_ == nullptr ? condition : MakeLogicExpression(where_, condition, LogicType::And);
+  }
 };
 
 #endif  // MINISQL_SELECT_STATEMENT_H
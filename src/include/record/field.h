@@ -95,6 +95,15 @@ class Field {
 
   inline const char *GetData() const { return Type::GetInstance(type_id_)->GetData(*this); }
 
+  /** Unchecked reads of the value without going through Type, for callers that resolved the type up front. */
+  inline int32_t GetIntValue() const { return value_.integer_; }
+
+  inline float GetFloatValue() const { return value_.float_; }
+
+  inline const char *GetCharData() const { return value_.chars_; }
+
+  inline uint32_t GetCharLength() const { return len_; }
+
   // 返回得到的是我们放进buf的字段的长度
   inline uint32_t SerializeTo(char *buf) const { return Type::GetInstance(type_id_)->SerializeTo(*this, buf); }
 
@@ -66,6 +66,11 @@ class Row {
     }
   }
 
+  /**
+   * Row move function, takes over the fields of other
+   */
+  Row(Row &&other) noexcept : rid_(other.rid_), fields_(std::move(other.fields_)) { other.fields_.clear(); }
+
   /**
    * Assign operator, deep copy
    */
@@ -78,6 +83,19 @@ class Row {
     return *this;
   }
 
+  /**
+   * Move assign operator, takes over the fields of other
+   */
+  Row &operator=(Row &&other) noexcept {
+    if (this != &other) {
+      destroy();
+      rid_ = other.rid_;
+      fields_ = std::move(other.fields_);
+      other.fields_.clear();
+    }
+    return *this;
+  }
+
   /**
    * Note: Make sure that bytes write to buf is equal to GetSerializedSize()
    */
@@ -85,6 +103,14 @@ class Row {
 
   uint32_t DeserializeFrom(char *buf, Schema *schema);
 
+  /**
+   * Deserialize only the columns the caller reads. A column i with needed_columns[i] unset, or past its end, becomes
+   * a null placeholder of its type and its value is skipped in buf without being copied, so the row keeps the
+   * positions of the schema.
+   * @return the bytes of the whole serialized row, as DeserializeFrom
+   */
+  uint32_t DeserializeColumns(char *buf, Schema *schema, const std::vector<bool> &needed_columns);
+
   /**
    * For empty row, return 0
    * For non-empty row with null fields, eg: |null|null|null|, return header size only
@@ -82,6 +82,8 @@ class TypeInt : public Type {
 
   virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const override;
 
+  virtual const char *GetData(const Field &val) const override;
+
   virtual CmpBool CompareEquals(const Field &left, const Field &right) const override;
 
   virtual CmpBool CompareNotEquals(const Field &left, const Field &right) const override;
@@ -132,6 +134,8 @@ class TypeFloat : public Type {
 
   virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const override;
 
+  virtual const char *GetData(const Field &val) const override;
+
   virtual CmpBool CompareEquals(const Field &left, const Field &right) const override;
 
   virtual CmpBool CompareNotEquals(const Field &left, const Field &right) const override;
@@ -92,6 +92,9 @@ class DiskManager {
    */
   page_id_t MapPageId(page_id_t logical_page_id);
 
+  /** @return the physical page id of the bitmap page of an extent */
+  static page_id_t BitmapPhysicalPageId(uint32_t extent_id) { return 1 + extent_id * (BITMAP_SIZE + 1); }
+
  private:
   // stream to write db file
   std::fstream db_io_;
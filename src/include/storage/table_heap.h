@@ -67,9 +67,10 @@ class TableHeap {
    * Read a tuple from the table.
    * @param[in/out] row Output variable for the tuple, row id of the tuple is wrapped in row
    * @param[in] txn recovery performing the read
+   * @param[in] needed_columns The columns to deserialize, the others are left null; every column if null
    * @return true if the read was successful (i.e. the tuple exists)
    */
-  bool GetTuple(Row *row, Txn *txn);
+  bool GetTuple(Row *row, Txn *txn, const std::vector<bool> *needed_columns = nullptr);
 
   void FreeTableHeap() {
     auto next_page_id = first_page_id_;
@@ -103,6 +104,13 @@ class TableHeap {
    */
   TableIterator End();
 
+  /**
+   * Pages are only linked through their next page id, so this reads every page after page_id until one holds a
+   * tuple, there is no way to jump over a run of pages without reading them.
+   * @return an iterator at the first tuple stored on a page after page_id, or End() if there is none
+   */
+  TableIterator BeginAfterPage(page_id_t page_id, Txn *txn);
+
   /**
    * @return the id of the first page of this table
    */
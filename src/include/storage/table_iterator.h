@@ -30,6 +30,9 @@ public:
 
   TableIterator operator++(int);
 
+  /** @return the row id under the iterator, without reading the tuple */
+  RowId GetRowId() const { return rid_; }
+
 private:
   // add your own private member variables here
   TableHeap *table_heap_;
@@ -0,0 +1,717 @@
+#include "index/adaptive_radix_tree.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+enum class ArtNodeType : uint8_t { kLeaf, kNode4, kNode16, kNode48, kNode256 };
+
+/**
+ * Header shared by leaves and inner nodes.
+ *
+ * Version format: | counter (62) | obsolete (1) | locked (1) |
+ * A writer sets the locked bit while it modifies the node and bumps the counter
+ * when it is done, a node unlinked from the tree is marked obsolete for good.
+ */
+struct ArtNode {
+  explicit ArtNode(ArtNodeType type) : type_(type) {}
+
+  bool IsLeaf() const { return type_ == ArtNodeType::kLeaf; }
+
+  /** @return false if the node is obsolete and the reader has to restart */
+  bool ReadLock(uint64_t &version) const {
+    version = version_.load(std::memory_order_acquire);
+    while (version & 1) {
+      std::this_thread::yield();
+      version = version_.load(std::memory_order_acquire);
+    }
+    return (version & 2) == 0;
+  }
+
+  /** @return false if a writer touched the node since ReadLock */
+  bool Validate(uint64_t version) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version_.load(std::memory_order_relaxed) == version;
+  }
+
+  // writers are serialized by the tree latch, so plain increments are enough
+  void WriteLock() {
+    version_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  void WriteUnlock() { version_.fetch_add(3, std::memory_order_release); }
+
+  void WriteUnlockObsolete() { version_.fetch_add(1, std::memory_order_release); }
+
+  ArtNodeType type_;
+  uint16_t count_{0};
+  uint32_t prefix_len_{0};
+  uint8_t prefix_[ART_MAX_STORED_PREFIX]{};
+  std::atomic<uint64_t> version_{0};
+};
+
+/** Leaves hold the full key and are never modified once linked. */
+struct ArtLeaf : public ArtNode {
+  ArtLeaf(std::string key, const RowId &value) : ArtNode(ArtNodeType::kLeaf), key_(std::move(key)), value_(value) {}
+
+  std::string key_;
+  RowId value_;
+};
+
+struct ArtNode4 : public ArtNode {
+  ArtNode4() : ArtNode(ArtNodeType::kNode4) {}
+
+  uint8_t keys_[4]{};
+  std::atomic<ArtNode *> children_[4]{};
+};
+
+struct ArtNode16 : public ArtNode {
+  ArtNode16() : ArtNode(ArtNodeType::kNode16) {}
+
+  uint8_t keys_[16]{};
+  std::atomic<ArtNode *> children_[16]{};
+};
+
+struct ArtNode48 : public ArtNode {
+  static constexpr uint8_t EMPTY = 0xFF;
+
+  ArtNode48() : ArtNode(ArtNodeType::kNode48) { memset(child_index_, EMPTY, sizeof(child_index_)); }
+
+  uint8_t child_index_[256];
+  std::atomic<ArtNode *> children_[48]{};
+};
+
+struct ArtNode256 : public ArtNode {
+  ArtNode256() : ArtNode(ArtNodeType::kNode256) {}
+
+  std::atomic<ArtNode *> children_[256]{};
+};
+
+/*****************************************************************************
+ * NODE HELPERS
+ *****************************************************************************/
+static void DeleteNode(ArtNode *node) {
+  switch (node->type_) {
+    case ArtNodeType::kLeaf:
+      delete static_cast<ArtLeaf *>(node);
+      break;
+    case ArtNodeType::kNode4:
+      delete static_cast<ArtNode4 *>(node);
+      break;
+    case ArtNodeType::kNode16:
+      delete static_cast<ArtNode16 *>(node);
+      break;
+    case ArtNodeType::kNode48:
+      delete static_cast<ArtNode48 *>(node);
+      break;
+    case ArtNodeType::kNode256:
+      delete static_cast<ArtNode256 *>(node);
+      break;
+  }
+}
+
+/**
+ * Call visit(byte, child) for every child in byte order, until it returns false.
+ */
+template <typename Visitor>
+static bool ForEachChild(const ArtNode *node, Visitor &&visit) {
+  switch (node->type_) {
+    case ArtNodeType::kNode4: {
+      auto n = static_cast<const ArtNode4 *>(node);
+      for (int i = 0; i < n->count_; i++) {
+        if (!visit(n->keys_[i], n->children_[i].load(std::memory_order_relaxed))) return false;
+      }
+      break;
+    }
+    case ArtNodeType::kNode16: {
+      auto n = static_cast<const ArtNode16 *>(node);
+      for (int i = 0; i < n->count_; i++) {
+        if (!visit(n->keys_[i], n->children_[i].load(std::memory_order_relaxed))) return false;
+      }
+      break;
+    }
+    case ArtNodeType::kNode48: {
+      auto n = static_cast<const ArtNode48 *>(node);
+      for (int byte = 0; byte < 256; byte++) {
+        if (n->child_index_[byte] == ArtNode48::EMPTY) continue;
+        if (!visit(static_cast<uint8_t>(byte), n->children_[n->child_index_[byte]].load(std::memory_order_relaxed))) {
+          return false;
+        }
+      }
+      break;
+    }
+    case ArtNodeType::kNode256: {
+      auto n = static_cast<const ArtNode256 *>(node);
+      for (int byte = 0; byte < 256; byte++) {
+        ArtNode *child = n->children_[byte].load(std::memory_order_relaxed);
+        if (child != nullptr && !visit(static_cast<uint8_t>(byte), child)) return false;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return true;
+}
+
+/**
+ * @return the slot of the child for byte, nullptr if there is none. Optimistic readers may call it while a
+ * writer modifies the node, so every index is kept in bounds and the caller validates the node afterwards.
+ */
+static std::atomic<ArtNode *> *FindChild(ArtNode *node, uint8_t byte) {
+  switch (node->type_) {
+    case ArtNodeType::kNode4: {
+      auto n = static_cast<ArtNode4 *>(node);
+      int count = std::min<int>(n->count_, 4);
+      for (int i = 0; i < count; i++) {
+        if (n->keys_[i] == byte) return &n->children_[i];
+      }
+      return nullptr;
+    }
+    case ArtNodeType::kNode16: {
+      auto n = static_cast<ArtNode16 *>(node);
+      int count = std::min<int>(n->count_, 16);
+#ifdef __SSE2__
+      __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i *>(n->keys_)));
+      unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(cmp)) & ((1u << count) - 1);
+      return mask != 0 ? &n->children_[__builtin_ctz(mask)] : nullptr;
+#else
+      for (int i = 0; i < count; i++) {
+        if (n->keys_[i] == byte) return &n->children_[i];
+      }
+      return nullptr;
+#endif
+    }
+    case ArtNodeType::kNode48: {
+      auto n = static_cast<ArtNode48 *>(node);
+      uint8_t index = n->child_index_[byte];
+      return index < 48 ? &n->children_[index] : nullptr;
+    }
+    case ArtNodeType::kNode256: {
+      auto n = static_cast<ArtNode256 *>(node);
+      return n->children_[byte].load(std::memory_order_relaxed) != nullptr ? &n->children_[byte] : nullptr;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+static bool IsFull(const ArtNode *node) {
+  switch (node->type_) {
+    case ArtNodeType::kNode4:
+      return node->count_ == 4;
+    case ArtNodeType::kNode16:
+      return node->count_ == 16;
+    case ArtNodeType::kNode48:
+      return node->count_ == 48;
+    default:
+      return false;
+  }
+}
+
+/** Thresholds leave some room so that a node does not flip between two sizes. */
+static bool IsUnderfull(const ArtNode *node) {
+  switch (node->type_) {
+    case ArtNodeType::kNode16:
+      return node->count_ <= 3;
+    case ArtNodeType::kNode48:
+      return node->count_ <= 12;
+    case ArtNodeType::kNode256:
+      return node->count_ <= 37;
+    default:
+      return false;
+  }
+}
+
+template <typename SortedNode>
+static void AddSortedChild(SortedNode *node, uint8_t byte, ArtNode *child) {
+  int pos = 0;
+  while (pos < node->count_ && node->keys_[pos] < byte) pos++;
+  for (int i = node->count_; i > pos; i--) {
+    node->keys_[i] = node->keys_[i - 1];
+    node->children_[i].store(node->children_[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  node->keys_[pos] = byte;
+  node->children_[pos].store(child, std::memory_order_release);
+  node->count_++;
+}
+
+template <typename SortedNode>
+static void RemoveSortedChild(SortedNode *node, uint8_t byte) {
+  int pos = 0;
+  while (pos < node->count_ && node->keys_[pos] != byte) pos++;
+  for (int i = pos; i + 1 < node->count_; i++) {
+    node->keys_[i] = node->keys_[i + 1];
+    node->children_[i].store(node->children_[i + 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  node->count_--;
+  node->children_[node->count_].store(nullptr, std::memory_order_relaxed);
+}
+
+/** The caller makes sure the node is not full. */
+static void AddChild(ArtNode *node, uint8_t byte, ArtNode *child) {
+  switch (node->type_) {
+    case ArtNodeType::kNode4:
+      AddSortedChild(static_cast<ArtNode4 *>(node), byte, child);
+      break;
+    case ArtNodeType::kNode16:
+      AddSortedChild(static_cast<ArtNode16 *>(node), byte, child);
+      break;
+    case ArtNodeType::kNode48: {
+      auto n = static_cast<ArtNode48 *>(node);
+      uint8_t pos = 0;
+      while (n->children_[pos].load(std::memory_order_relaxed) != nullptr) pos++;
+      n->children_[pos].store(child, std::memory_order_release);
+      n->child_index_[byte] = pos;
+      n->count_++;
+      break;
+    }
+    case ArtNodeType::kNode256:
+      static_cast<ArtNode256 *>(node)->children_[byte].store(child, std::memory_order_release);
+      node->count_++;
+      break;
+    default:
+      break;
+  }
+}
+
+static void RemoveChild(ArtNode *node, uint8_t byte) {
+  switch (node->type_) {
+    case ArtNodeType::kNode4:
+      RemoveSortedChild(static_cast<ArtNode4 *>(node), byte);
+      break;
+    case ArtNodeType::kNode16:
+      RemoveSortedChild(static_cast<ArtNode16 *>(node), byte);
+      break;
+    case ArtNodeType::kNode48: {
+      auto n = static_cast<ArtNode48 *>(node);
+      n->children_[n->child_index_[byte]].store(nullptr, std::memory_order_relaxed);
+      n->child_index_[byte] = ArtNode48::EMPTY;
+      n->count_--;
+      break;
+    }
+    case ArtNodeType::kNode256:
+      static_cast<ArtNode256 *>(node)->children_[byte].store(nullptr, std::memory_order_relaxed);
+      node->count_--;
+      break;
+    default:
+      break;
+  }
+}
+
+static void CopyHeader(const ArtNode *from, ArtNode *to) {
+  to->prefix_len_ = from->prefix_len_;
+  memcpy(to->prefix_, from->prefix_, ART_MAX_STORED_PREFIX);
+}
+
+/** @return a copy of node with the next larger fan-out */
+static ArtNode *Grow(const ArtNode *node) {
+  ArtNode *bigger;
+  switch (node->type_) {
+    case ArtNodeType::kNode4:
+      bigger = new ArtNode16();
+      break;
+    case ArtNodeType::kNode16:
+      bigger = new ArtNode48();
+      break;
+    default:
+      bigger = new ArtNode256();
+      break;
+  }
+  CopyHeader(node, bigger);
+  ForEachChild(node, [bigger](uint8_t byte, ArtNode *child) {
+    AddChild(bigger, byte, child);
+    return true;
+  });
+  return bigger;
+}
+
+/** @return a copy of node with the next smaller fan-out */
+static ArtNode *Shrink(const ArtNode *node) {
+  ArtNode *smaller;
+  switch (node->type_) {
+    case ArtNodeType::kNode16:
+      smaller = new ArtNode4();
+      break;
+    case ArtNodeType::kNode48:
+      smaller = new ArtNode16();
+      break;
+    default:
+      smaller = new ArtNode48();
+      break;
+  }
+  CopyHeader(node, smaller);
+  ForEachChild(node, [smaller](uint8_t byte, ArtNode *child) {
+    AddChild(smaller, byte, child);
+    return true;
+  });
+  return smaller;
+}
+
+static const ArtLeaf *MinLeaf(const ArtNode *node) {
+  while (!node->IsLeaf()) {
+    const ArtNode *first = nullptr;
+    ForEachChild(node, [&first](uint8_t, ArtNode *child) {
+      first = child;
+      return false;
+    });
+    node = first;
+  }
+  return static_cast<const ArtLeaf *>(node);
+}
+
+/** Set the compressed path of node to len bytes of key starting at start. */
+static void SetPrefix(ArtNode *node, const std::string &key, size_t start, uint32_t len) {
+  node->prefix_len_ = len;
+  memcpy(node->prefix_, key.data() + start, std::min<uint32_t>(len, ART_MAX_STORED_PREFIX));
+}
+
+/**
+ * @return the number of leading bytes of the compressed path of node that match key at depth, bytes past the
+ * stored ones are read from a leaf below the node
+ */
+static uint32_t PrefixMismatch(const ArtNode *node, const std::string &key, size_t depth) {
+  const std::string *full = node->prefix_len_ > ART_MAX_STORED_PREFIX ? &MinLeaf(node)->key_ : nullptr;
+  for (uint32_t i = 0; i < node->prefix_len_; i++) {
+    uint8_t byte = i < ART_MAX_STORED_PREFIX ? node->prefix_[i] : static_cast<uint8_t>((*full)[depth + i]);
+    if (depth + i >= key.size() || static_cast<uint8_t>(key[depth + i]) != byte) {
+      return i;
+    }
+  }
+  return node->prefix_len_;
+}
+
+/** Compare the leading bytes of key with bound, a key that starts with the bound equals it. */
+static int CompareToBound(const std::string &key, const std::string &bound) {
+  return key.compare(0, bound.size(), bound);
+}
+
+/*****************************************************************************
+ * TREE
+ *****************************************************************************/
+AdaptiveRadixTree::~AdaptiveRadixTree() {
+  Clear();
+  ReclaimRetired();
+}
+
+void AdaptiveRadixTree::Clear() {
+  latch_.WLock();
+  ArtNode *root = root_.exchange(nullptr);
+  std::vector<ArtNode *> stack;
+  if (root != nullptr) {
+    stack.push_back(root);
+  }
+  while (!stack.empty()) {
+    ArtNode *node = stack.back();
+    stack.pop_back();
+    ForEachChild(node, [&stack](uint8_t, ArtNode *child) {
+      stack.push_back(child);
+      return true;
+    });
+    Retire(node);
+  }
+  size_ = 0;
+  ReclaimRetired();
+  latch_.WUnlock();
+}
+
+bool AdaptiveRadixTree::Lookup(const std::string &key, RowId &value) const {
+  active_readers_.fetch_add(1);
+  bool found = false;
+  bool restart;
+  do {
+    restart = false;
+    found = false;
+    ArtNode *node = root_.load();
+    size_t depth = 0;
+    while (node != nullptr) {
+      if (node->IsLeaf()) {
+        // leaves never change, a match is a hit even if the path changed meanwhile
+        auto leaf = static_cast<ArtLeaf *>(node);
+        found = leaf->key_ == key;
+        if (found) {
+          value = leaf->value_;
+        }
+        break;
+      }
+      uint64_t version;
+      if (!node->ReadLock(version)) {
+        restart = true;
+        break;
+      }
+      // bytes past the stored prefix are skipped, the leaf compares the whole key
+      uint32_t prefix_len = node->prefix_len_;
+      bool match = depth + prefix_len < key.size();
+      for (uint32_t i = 0; match && i < std::min<uint32_t>(prefix_len, ART_MAX_STORED_PREFIX); i++) {
+        match = node->prefix_[i] == static_cast<uint8_t>(key[depth + i]);
+      }
+      ArtNode *next = nullptr;
+      if (match) {
+        depth += prefix_len;
+        auto slot = FindChild(node, static_cast<uint8_t>(key[depth]));
+        next = slot == nullptr ? nullptr : slot->load(std::memory_order_acquire);
+      }
+      if (!node->Validate(version)) {
+        restart = true;
+        break;
+      }
+      node = next;
+      depth++;
+    }
+  } while (restart);
+  active_readers_.fetch_sub(1);
+  return found;
+}
+
+bool AdaptiveRadixTree::Insert(const std::string &key, const RowId &value) {
+  latch_.WLock();
+  auto leaf = new ArtLeaf(key, value);
+  bool inserted = InsertAt(root_, nullptr, leaf, 0);
+  if (inserted) {
+    size_++;
+  } else {
+    delete leaf;
+  }
+  ReclaimRetired();
+  latch_.WUnlock();
+  return inserted;
+}
+
+bool AdaptiveRadixTree::InsertAt(std::atomic<ArtNode *> &slot, ArtNode *parent, ArtNode *leaf, size_t depth) {
+  ArtNode *node = slot.load(std::memory_order_relaxed);
+  const std::string &key = static_cast<ArtLeaf *>(leaf)->key_;
+  if (node == nullptr) {
+    ReplaceChild(slot, parent, leaf);
+    return true;
+  }
+  if (node->IsLeaf()) {
+    const std::string &existing = static_cast<ArtLeaf *>(node)->key_;
+    if (existing == key) {
+      return false;
+    }
+    // both keys go below a new Node4 that keeps the bytes they share
+    size_t common = depth;
+    while (common < key.size() && common < existing.size() && key[common] == existing[common]) {
+      common++;
+    }
+    ASSERT(common < key.size() && common < existing.size(), "Art keys must not be prefixes of each other.");
+    auto inner = new ArtNode4();
+    SetPrefix(inner, key, depth, common - depth);
+    AddChild(inner, static_cast<uint8_t>(existing[common]), node);
+    AddChild(inner, static_cast<uint8_t>(key[common]), leaf);
+    ReplaceChild(slot, parent, inner);
+    return true;
+  }
+  uint32_t mismatch = PrefixMismatch(node, key, depth);
+  if (mismatch < node->prefix_len_) {
+    // the key leaves the compressed path, split the path at the first differing byte
+    ASSERT(depth + mismatch < key.size(), "Art keys must not be prefixes of each other.");
+    const std::string full = MinLeaf(node)->key_;
+    auto inner = new ArtNode4();
+    SetPrefix(inner, full, depth, mismatch);
+    AddChild(inner, static_cast<uint8_t>(full[depth + mismatch]), node);
+    AddChild(inner, static_cast<uint8_t>(key[depth + mismatch]), leaf);
+    // keep node locked until its path is shortened, readers arriving through inner wait for it
+    node->WriteLock();
+    ReplaceChild(slot, parent, inner);
+    SetPrefix(node, full, depth + mismatch + 1, node->prefix_len_ - mismatch - 1);
+    node->WriteUnlock();
+    return true;
+  }
+  depth += node->prefix_len_;
+  ASSERT(depth < key.size(), "Art keys must not be prefixes of each other.");
+  auto byte = static_cast<uint8_t>(key[depth]);
+  auto child = FindChild(node, byte);
+  if (child != nullptr) {
+    return InsertAt(*child, node, leaf, depth + 1);
+  }
+  if (IsFull(node)) {
+    ArtNode *bigger = Grow(node);
+    AddChild(bigger, byte, leaf);
+    ReplaceChild(slot, parent, bigger);
+    Retire(node);
+  } else {
+    node->WriteLock();
+    AddChild(node, byte, leaf);
+    node->WriteUnlock();
+  }
+  return true;
+}
+
+bool AdaptiveRadixTree::Remove(const std::string &key) {
+  latch_.WLock();
+  bool removed = RemoveAt(root_, nullptr, key, 0);
+  if (removed) {
+    size_--;
+  }
+  ReclaimRetired();
+  latch_.WUnlock();
+  return removed;
+}
+
+bool AdaptiveRadixTree::RemoveAt(std::atomic<ArtNode *> &slot, ArtNode *parent, const std::string &key,
+                                 size_t depth) {
+  ArtNode *node = slot.load(std::memory_order_relaxed);
+  if (node == nullptr) {
+    return false;
+  }
+  if (node->IsLeaf()) {
+    // only a leaf at the root is reached here, the others are removed by their parent
+    if (static_cast<ArtLeaf *>(node)->key_ != key) {
+      return false;
+    }
+    ReplaceChild(slot, parent, nullptr);
+    Retire(node);
+    return true;
+  }
+  if (PrefixMismatch(node, key, depth) < node->prefix_len_) {
+    return false;
+  }
+  size_t child_depth = depth + node->prefix_len_;
+  if (child_depth >= key.size()) {
+    return false;
+  }
+  auto byte = static_cast<uint8_t>(key[child_depth]);
+  auto child_slot = FindChild(node, byte);
+  if (child_slot == nullptr) {
+    return false;
+  }
+  ArtNode *child = child_slot->load(std::memory_order_relaxed);
+  if (!child->IsLeaf()) {
+    return RemoveAt(*child_slot, node, key, child_depth + 1);
+  }
+  if (static_cast<ArtLeaf *>(child)->key_ != key) {
+    return false;
+  }
+  node->WriteLock();
+  RemoveChild(node, byte);
+  if (node->type_ == ArtNodeType::kNode4 && node->count_ == 1) {
+    // a single child takes the place of node, its path absorbs the path of node and the byte between them
+    auto n = static_cast<ArtNode4 *>(node);
+    ArtNode *only = n->children_[0].load(std::memory_order_relaxed);
+    if (!only->IsLeaf()) {
+      only->WriteLock();
+      const std::string &full = MinLeaf(only)->key_;
+      SetPrefix(only, full, depth, node->prefix_len_ + 1 + only->prefix_len_);
+      ReplaceChild(slot, parent, only);
+      only->WriteUnlock();
+    } else {
+      ReplaceChild(slot, parent, only);
+    }
+    node->WriteUnlockObsolete();
+    Retire(node);
+  } else {
+    node->WriteUnlock();
+    if (IsUnderfull(node)) {
+      ReplaceChild(slot, parent, Shrink(node));
+      Retire(node);
+    }
+  }
+  Retire(child);
+  return true;
+}
+
+void AdaptiveRadixTree::ReplaceChild(std::atomic<ArtNode *> &slot, ArtNode *parent, ArtNode *node) {
+  if (parent != nullptr) {
+    parent->WriteLock();
+  }
+  slot.store(node);
+  if (parent != nullptr) {
+    parent->WriteUnlock();
+  }
+}
+
+void AdaptiveRadixTree::Retire(ArtNode *node) {
+  if (!node->IsLeaf() && (node->version_.load(std::memory_order_relaxed) & 2) == 0) {
+    node->WriteLock();
+    node->WriteUnlockObsolete();
+  }
+  retired_.push_back(node);
+}
+
+void AdaptiveRadixTree::ReclaimRetired() {
+  // a reader that entered after the nodes were unlinked can not reach them any more
+  if (retired_.empty() || active_readers_.load() != 0) {
+    return;
+  }
+  for (auto node : retired_) {
+    DeleteNode(node);
+  }
+  retired_.clear();
+}
+
+void AdaptiveRadixTree::Range(const std::string *lower, bool lower_inclusive, const std::string *upper,
+                              bool upper_inclusive, std::vector<RowId> &result) const {
+  latch_.RLock();
+  ArtNode *root = root_.load();
+  if (root != nullptr) {
+    Walk(root, 0, lower != nullptr, upper != nullptr, lower, lower_inclusive, upper, upper_inclusive, result);
+  }
+  latch_.RUnlock();
+}
+
+/**
+ * In-order walk of the subtree of node. lower_tight (upper_tight) tells that the bytes above depth equal the
+ * leading bytes of the lower (upper) bound, only then the bound can prune a child.
+ * @return false once a key past the upper bound was seen
+ */
+bool AdaptiveRadixTree::Walk(const ArtNode *node, size_t depth, bool lower_tight, bool upper_tight,
+                             const std::string *lower, bool lower_inclusive, const std::string *upper,
+                             bool upper_inclusive, std::vector<RowId> &result) const {
+  if (node->IsLeaf()) {
+    auto leaf = static_cast<const ArtLeaf *>(node);
+    if (lower != nullptr) {
+      int cmp = CompareToBound(leaf->key_, *lower);
+      if (cmp < 0 || (cmp == 0 && !lower_inclusive)) {
+        return true;
+      }
+    }
+    if (upper != nullptr) {
+      int cmp = CompareToBound(leaf->key_, *upper);
+      if (cmp > 0 || (cmp == 0 && !upper_inclusive)) {
+        return false;
+      }
+    }
+    result.push_back(leaf->value_);
+    return true;
+  }
+  if ((lower_tight || upper_tight) && node->prefix_len_ > 0) {
+    const std::string &full = MinLeaf(node)->key_;
+    for (size_t pos = depth; pos < depth + node->prefix_len_; pos++) {
+      auto byte = static_cast<uint8_t>(full[pos]);
+      if (lower_tight && pos < lower->size()) {
+        auto bound = static_cast<uint8_t>((*lower)[pos]);
+        if (byte < bound) return true;
+        lower_tight = byte == bound;
+      }
+      if (upper_tight && pos < upper->size()) {
+        auto bound = static_cast<uint8_t>((*upper)[pos]);
+        if (byte > bound) return false;
+        upper_tight = byte == bound;
+      }
+    }
+  }
+  size_t pos = depth + node->prefix_len_;
+  return ForEachChild(node, [&](uint8_t byte, ArtNode *child) {
+    bool child_lower_tight = lower_tight;
+    bool child_upper_tight = upper_tight;
+    if (lower_tight && pos < lower->size()) {
+      auto bound = static_cast<uint8_t>((*lower)[pos]);
+      if (byte < bound) return true;
+      child_lower_tight = byte == bound;
+    }
+    if (upper_tight && pos < upper->size()) {
+      auto bound = static_cast<uint8_t>((*upper)[pos]);
+      if (byte > bound) return false;
+      child_upper_tight = byte == bound;
+    }
+    return Walk(child, pos + 1, child_lower_tight, child_upper_tight, lower, lower_inclusive, upper, upper_inclusive,
+                result);
+  });
+}
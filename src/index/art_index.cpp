@@ -0,0 +1,114 @@
+#include "index/art_index.h"
+
+#include "index/key_search.h"
+
+ArtIndex::ArtIndex(index_id_t index_id, IndexSchema *key_schema) : Index(index_id, key_schema) {}
+
+void ArtIndex::EncodeKey(const Row &key, std::string &bytes) {
+  for (uint32_t i = 0; i < key.GetFieldCount(); i++) {
+    Field *field = key.GetField(i);
+    if (field->IsNull()) {
+      bytes.push_back('\0');
+      continue;
+    }
+    bytes.push_back('\1');
+    switch (field->GetTypeId()) {
+      case TypeId::kTypeInt:
+      case TypeId::kTypeFloat: {
+        char value[4];
+        field->SerializeTo(value);
+        uint32_t bits = field->GetTypeId() == TypeId::kTypeInt ? FixedKeyTraits<int32_t>::OrderBits(value)
+                                                               : FixedKeyTraits<float>::OrderBits(value);
+        for (int shift = 24; shift >= 0; shift -= 8) {
+          bytes.push_back(static_cast<char>(bits >> shift));
+        }
+        break;
+      }
+      default: {
+        // 0x00 ends the string, so 0x00 and 0x01 inside it are escaped behind 0x01
+        const char *data = field->GetData();
+        for (uint32_t j = 0; j < field->GetLength(); j++) {
+          auto c = static_cast<uint8_t>(data[j]);
+          if (c <= 1) {
+            bytes.push_back('\1');
+            bytes.push_back(static_cast<char>(c + 1));
+          } else {
+            bytes.push_back(static_cast<char>(c));
+          }
+        }
+        bytes.push_back('\0');
+        break;
+      }
+    }
+  }
+}
+
+dberr_t ArtIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
+  std::string bytes;
+  EncodeKey(key, bytes);
+  return container_.Insert(bytes, row_id) ? DB_SUCCESS : DB_FAILED;
+}
+
+dberr_t ArtIndex::RemoveEntry(const Row &key, RowId row_id, Txn *txn) {
+  std::string bytes;
+  EncodeKey(key, bytes);
+  container_.Remove(bytes);
+  return DB_SUCCESS;
+}
+
+dberr_t ArtIndex::ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, std::string compare_operator) {
+  std::string bytes;
+  EncodeKey(key, bytes);
+  if (compare_operator == "=" && key.GetFieldCount() == key_schema_->GetColumnCount()) {
+    RowId rid;
+    if (container_.Lookup(bytes, rid)) {
+      result.emplace_back(rid);
+    }
+  } else if (compare_operator == "=") {
+    container_.Range(&bytes, true, &bytes, true, result);
+  } else if (compare_operator == "<>") {
+    container_.Range(nullptr, false, &bytes, false, result);
+    container_.Range(&bytes, false, nullptr, false, result);
+  } else if (compare_operator == ">") {
+    container_.Range(&bytes, false, nullptr, false, result);
+  } else if (compare_operator == ">=") {
+    container_.Range(&bytes, true, nullptr, false, result);
+  } else if (compare_operator == "<") {
+    container_.Range(nullptr, false, &bytes, false, result);
+  } else if (compare_operator == "<=") {
+    container_.Range(nullptr, false, &bytes, true, result);
+  } else {
+    return DB_FAILED;
+  }
+  if (!result.empty())
+    return DB_SUCCESS;
+  else
+    return DB_KEY_NOT_FOUND;
+}
+
+IndexScanIteratorRef ArtIndex::Scan(const Row *lower, bool lower_inclusive, const Row *upper, bool upper_inclusive,
+                                    Txn *txn) {
+  std::vector<RowId> result;
+  if (IsPointRange(lower, upper)) {
+    if (lower_inclusive && upper_inclusive) {
+      ScanKey(*lower, result, txn, "=");
+    }
+    return std::make_unique<MaterializedScanIterator>(std::move(result));
+  }
+  std::string lower_bytes;
+  std::string upper_bytes;
+  if (lower != nullptr) {
+    EncodeKey(*lower, lower_bytes);
+  }
+  if (upper != nullptr) {
+    EncodeKey(*upper, upper_bytes);
+  }
+  container_.Range(lower == nullptr ? nullptr : &lower_bytes, lower_inclusive,
+                   upper == nullptr ? nullptr : &upper_bytes, upper_inclusive, result);
+  return std::make_unique<MaterializedScanIterator>(std::move(result));
+}
+
+dberr_t ArtIndex::Destroy() {
+  container_.Clear();
+  return DB_SUCCESS;
+}
@@ -39,6 +39,62 @@ bool BPlusTree::IsEmpty() const {
  */
 bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction) { return false; }
 
+/*
+ * Point query for a batch of keys in ascending order
+ * The pages from the root to the last leaf stay pinned together with the
+ * first key past each of their subtrees. The next key climbs only up to the
+ * deepest page whose subtree still holds it and descends from there, so keys
+ * on the same leaf share the whole path and keys on neighbouring leaves only
+ * re-read their common parent.
+ * @return : true means at least one key exists
+ */
+bool BPlusTree::GetValues(const std::vector<GenericKey *> &keys, std::vector<RowId> &result, Txn *transaction) {
+  if (keys.empty() || IsEmpty()) {
+    return false;
+  }
+  struct PathEntry {
+    Page *page;
+    // the first key past the subtree of the page, nullptr if it is the rightmost one
+    const GenericKey *upper;
+  };
+  std::vector<PathEntry> path;
+  bool found = false;
+  for (const GenericKey *key : keys) {
+    while (!path.empty() && path.back().upper != nullptr && processor_.CompareKeys(key, path.back().upper) >= 0) {
+      buffer_pool_manager_->UnpinPage(path.back().page, false);
+      path.pop_back();
+    }
+    if (path.empty()) {
+      Page *root = buffer_pool_manager_->FetchPage(root_page_id_);
+      if (root == nullptr) {
+        return found;
+      }
+      path.push_back({root, nullptr});
+    }
+    auto *node = reinterpret_cast<BPlusTreePage *>(path.back().page->GetData());
+    while (!node->IsLeafPage()) {
+      auto *internal = reinterpret_cast<InternalPage *>(node);
+      int index = internal->LookupIndex(key, processor_);
+      const GenericKey *upper = index + 1 < internal->GetSize() ? internal->KeyAt(index + 1) : path.back().upper;
+      Page *child = buffer_pool_manager_->FetchChildPage(path.back().page, index, internal->ValueAt(index));
+      if (child == nullptr) {
+        break;
+      }
+      path.push_back({child, upper});
+      node = reinterpret_cast<BPlusTreePage *>(child->GetData());
+    }
+    RowId value;
+    if (node->IsLeafPage() && reinterpret_cast<LeafPage *>(node)->Lookup(key, value, processor_)) {
+      result.push_back(value);
+      found = true;
+    }
+  }
+  for (auto &entry : path) {
+    buffer_pool_manager_->UnpinPage(entry.page, false);
+  }
+  return found;
+}
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
@@ -99,8 +155,9 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
  * If not, User needs to first find the right leaf page as deletion target, then
  * delete entry from leaf page. Remember to deal with redistribute or merge if
  * necessary.
+ * @return: false if the key was not found
  */
-void BPlusTree::Remove(const GenericKey *key, Txn *transaction) {}
+bool BPlusTree::Remove(const GenericKey *key, Txn *transaction) { return false; }
 
 /* todo
  * User needs to first find the sibling of input page. If sibling's size + input
@@ -199,6 +256,8 @@ IndexIterator BPlusTree::End() {
  * Find leaf page containing particular key, if leftMost flag == true, find
  * the left most leaf page
  * Note: the leaf page is pinned, you need to unpin it after use.
+ * Note: step down with FetchChildPage(parent, index, child page id), so that a
+ * buffer pool caching child frames can skip its page table lookup.
  */
 Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool leftMost) {
   return nullptr;
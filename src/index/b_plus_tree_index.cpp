@@ -1,12 +1,21 @@
 #include "index/b_plus_tree_index.h"
 
+#include <algorithm>
+
 #include "index/generic_key.h"
 #include "utils/tree_file_mgr.h"
 BPlusTreeIndex::BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size,
-                               BufferPoolManager *buffer_pool_manager)
+                               BufferPoolManager *buffer_pool_manager, uint32_t key_column_count, bool use_filter)
     : Index(index_id, key_schema),
-      processor_(key_schema_, key_size),
-      container_(index_id, buffer_pool_manager, processor_) {}
+      processor_(key_schema_, key_size, key_column_count),
+      container_(index_id, buffer_pool_manager, processor_) {
+  if (use_filter) {
+    filter_ = std::make_unique<CountingBloomFilter>(processor_.GetCompareColumnCount());
+    if (!container_.IsEmpty()) {
+      RebuildFilter();
+    }
+  }
+}
 
 dberr_t BPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
   // ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
@@ -23,63 +32,159 @@ dberr_t BPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
   if (!status) {
     return DB_FAILED;
   }
+  if (filter_ != nullptr) {
+    filter_->Add(key);
+    if (filter_->IsOverloaded()) {
+      RebuildFilter();
+    }
+  }
   return DB_SUCCESS;
 }
 
-dberr_t BPlusTreeIndex::RemoveEntry(const Row &key, RowId row_id, Txn *txn) {
+dberr_t BPlusTreeIndex::RemoveEntry(const Row &key, RowId /*row_id*/, Txn *txn) {
+  if (filter_ != nullptr && !filter_->MayContain(key)) {
+    return DB_SUCCESS;
+  }
   GenericKey *index_key = processor_.InitKey();
   processor_.SerializeFromKey(index_key, key, key_schema_);
 
-  container_.Remove(index_key, txn);
+  bool removed = container_.Remove(index_key, txn);
   free(index_key);
+  // only a key that was really in the tree may give its counters back
+  if (removed && filter_ != nullptr) {
+    filter_->Remove(key);
+  }
   return DB_SUCCESS;
 }
 
 dberr_t BPlusTreeIndex::ScanKey(const Row &key, vector<RowId> &result, Txn *txn, string compare_operator) {
-  GenericKey *index_key = processor_.InitKey();
-  processor_.SerializeFromKey(index_key, key, key_schema_);
-  auto end_iter = GetEndIterator();
-  if (compare_operator == "=") {
-    container_.GetValue(index_key, result, txn);
-  } else if (compare_operator == ">") {
-    auto iter = GetBeginIterator(index_key);
-    if (container_.GetValue(index_key, result, txn)) ++iter;
-    result.clear();
-    for (; iter != end_iter; ++iter) {
-      result.emplace_back((*iter).second);
-    }
-  } else if (compare_operator == ">=") {
-    for (auto iter = GetBeginIterator(index_key); iter != end_iter; ++iter) {
-      result.emplace_back((*iter).second);
-    }
-  } else if (compare_operator == "<") {
-    auto stop_iter = GetBeginIterator(index_key);
-    for (auto iter = GetBeginIterator(); iter != stop_iter; ++iter) {
-      result.emplace_back((*iter).second);
+  if (compare_operator == "=" && key.GetFieldCount() < processor_.GetCompareColumnCount()) {
+    // a leftmost prefix matches a range of entries
+    IndexScanIteratorRef cursor = Scan(&key, true, &key, true, txn);
+    for (RowId rid; cursor->Next(rid);) {
+      result.emplace_back(rid);
     }
-  } else if (compare_operator == "<=") {
-    auto stop_iter = GetBeginIterator(index_key);
-    for (auto iter = GetBeginIterator(); iter != stop_iter; ++iter) {
-      result.emplace_back((*iter).second);
+  } else if (compare_operator == "=") {
+    if (filter_ != nullptr && !filter_->MayContain(key)) {
+      return DB_KEY_NOT_FOUND;
     }
+    GenericKey *index_key = processor_.InitKey();
+    SerializeSearchKey(index_key, key);
     container_.GetValue(index_key, result, txn);
+    free(index_key);
   } else if (compare_operator == "<>") {
-    for (auto iter = GetBeginIterator(); iter != end_iter; ++iter) {
-      result.emplace_back((*iter).second);
+    // two ranges around the key instead of the whole index minus one entry
+    IndexScanIteratorRef below = Scan(nullptr, false, &key, false, txn);
+    IndexScanIteratorRef above = Scan(&key, false, nullptr, false, txn);
+    for (auto cursor : {below.get(), above.get()}) {
+      for (RowId rid; cursor->Next(rid);) {
+        result.emplace_back(rid);
+      }
+    }
+  } else {
+    IndexScanIteratorRef cursor;
+    if (compare_operator == ">") {
+      cursor = Scan(&key, false, nullptr, false, txn);
+    } else if (compare_operator == ">=") {
+      cursor = Scan(&key, true, nullptr, false, txn);
+    } else if (compare_operator == "<") {
+      cursor = Scan(nullptr, false, &key, false, txn);
+    } else if (compare_operator == "<=") {
+      cursor = Scan(nullptr, false, &key, true, txn);
+    } else {
+      return DB_FAILED;
+    }
+    for (RowId rid; cursor->Next(rid);) {
+      result.emplace_back(rid);
     }
-    vector<RowId> temp;
-    if (container_.GetValue(index_key, temp, txn))
-      result.erase(find(result.begin(), result.end(), temp[0]));
   }
-  free(index_key);
   if (!result.empty())
     return DB_SUCCESS;
   else
     return DB_KEY_NOT_FOUND;
 }
 
+dberr_t BPlusTreeIndex::ScanKeys(const std::vector<Row> &keys, std::vector<RowId> &result, Txn *txn) {
+  std::vector<GenericKey *> index_keys;
+  for (const auto &key : keys) {
+    if (key.GetFieldCount() < processor_.GetCompareColumnCount()) {
+      // a leftmost prefix matches a range of entries
+      ScanKey(key, result, txn, "=");
+      continue;
+    }
+    if (filter_ != nullptr && !filter_->MayContain(key)) {
+      continue;
+    }
+    GenericKey *index_key = processor_.InitKey();
+    SerializeSearchKey(index_key, key);
+    index_keys.push_back(index_key);
+  }
+  auto less = [this](const GenericKey *lhs, const GenericKey *rhs) { return processor_.CompareKeys(lhs, rhs) < 0; };
+  std::sort(index_keys.begin(), index_keys.end(), less);
+  std::vector<GenericKey *> distinct_keys;
+  for (auto index_key : index_keys) {
+    if (distinct_keys.empty() || less(distinct_keys.back(), index_key)) {
+      distinct_keys.push_back(index_key);
+    }
+  }
+  container_.GetValues(distinct_keys, result, txn);
+  for (auto index_key : index_keys) {
+    free(index_key);
+  }
+  return DB_SUCCESS;
+}
+
+IndexScanIteratorRef BPlusTreeIndex::Scan(const Row *lower, bool lower_inclusive, const Row *upper,
+                                          bool upper_inclusive, Txn * /*txn*/) {
+  GenericKey *lower_key = nullptr;
+  GenericKey *upper_key = nullptr;
+  uint32_t lower_columns = 0;
+  uint32_t upper_columns = 0;
+  if (lower != nullptr) {
+    lower_key = processor_.InitKey();
+    SerializeSearchKey(lower_key, *lower);
+    lower_columns = std::min(static_cast<uint32_t>(lower->GetFieldCount()), processor_.GetCompareColumnCount());
+  }
+  if (upper != nullptr) {
+    upper_key = processor_.InitKey();
+    SerializeSearchKey(upper_key, *upper);
+    upper_columns = std::min(static_cast<uint32_t>(upper->GetFieldCount()), processor_.GetCompareColumnCount());
+  }
+  return std::make_unique<BPlusTreeIndexScanIterator>(container_, processor_, key_schema_, lower_key, lower_columns,
+                                                      lower_inclusive, upper_key, upper_columns, upper_inclusive);
+}
+
+void BPlusTreeIndex::SerializeSearchKey(GenericKey *index_key, const Row &key) {
+  if (key.GetFieldCount() == key_schema_->GetColumnCount()) {
+    processor_.SerializeFromKey(index_key, key, key_schema_);
+    return;
+  }
+  std::vector<Field> fields;
+  for (uint32_t i = 0; i < key_schema_->GetColumnCount(); i++) {
+    if (i < key.GetFieldCount()) {
+      fields.emplace_back(*key.GetField(i));
+    } else {
+      fields.emplace_back(key_schema_->GetColumn(i)->GetType());
+    }
+  }
+  Row padded(fields);
+  processor_.SerializeFromKey(index_key, padded, key_schema_);
+}
+
+void BPlusTreeIndex::RebuildFilter() {
+  filter_->Reset(std::max(CountingBloomFilter::DEFAULT_EXPECTED_KEYS, filter_->GetKeyCount() * 2));
+  for (auto iter = container_.Begin(); iter != container_.End(); ++iter) {
+    Row key(INVALID_ROWID);
+    processor_.DeserializeToKey((*iter).first, key, key_schema_);
+    filter_->Add(key);
+  }
+}
+
 dberr_t BPlusTreeIndex::Destroy() {
   container_.Destroy();
+  if (filter_ != nullptr) {
+    filter_->Reset(CountingBloomFilter::DEFAULT_EXPECTED_KEYS);
+  }
   return DB_SUCCESS;
 }
 
@@ -93,4 +198,63 @@ IndexIterator BPlusTreeIndex::GetBeginIterator(GenericKey *key) {
 
 IndexIterator BPlusTreeIndex::GetEndIterator() {
   return container_.End();
-}
\ No newline at end of file
+}
+
+BPlusTreeIndexScanIterator::BPlusTreeIndexScanIterator(BPlusTree &container, const KeyManager &processor,
+                                                       IndexSchema *key_schema, GenericKey *lower,
+                                                       uint32_t lower_columns, bool lower_inclusive, GenericKey *upper,
+                                                       uint32_t upper_columns, bool upper_inclusive)
+    : processor_(processor),
+      key_schema_(key_schema),
+      lower_(lower),
+      lower_columns_(lower_columns),
+      lower_inclusive_(lower_inclusive),
+      upper_(upper),
+      upper_columns_(upper_columns),
+      upper_inclusive_(upper_inclusive),
+      iter_(lower == nullptr ? container.Begin() : container.Begin(lower)),
+      end_(container.End()),
+      current_(processor.InitKey()) {}
+
+BPlusTreeIndexScanIterator::~BPlusTreeIndexScanIterator() {
+  free(lower_);
+  free(upper_);
+  free(current_);
+}
+
+bool BPlusTreeIndexScanIterator::Next(RowId &rid) { return Advance(rid, false); }
+
+bool BPlusTreeIndexScanIterator::NextEntry(RowId &rid, Row &key) {
+  if (!Advance(rid, true)) {
+    return false;
+  }
+  key = Row(rid);
+  processor_.DeserializeToKey(current_, key, key_schema_);
+  return true;
+}
+
+bool BPlusTreeIndexScanIterator::Advance(RowId &rid, bool copy_key) {
+  while (!exhausted_ && iter_ != end_) {
+    auto item = *iter_;
+    // Begin(lower) stops at the first key >= lower, skip the equal ones for an exclusive bound
+    if (lower_ != nullptr && !lower_inclusive_ && processor_.CompareKeys(item.first, lower_, lower_columns_) == 0) {
+      ++iter_;
+      continue;
+    }
+    if (upper_ != nullptr) {
+      int cmp = processor_.CompareKeys(item.first, upper_, upper_columns_);
+      if (cmp > 0 || (cmp == 0 && !upper_inclusive_)) {
+        exhausted_ = true;
+        break;
+      }
+    }
+    rid = item.second;
+    // the key points into the current leaf, which may be unpinned once the iterator moves on
+    if (copy_key) {
+      memcpy(current_, item.first, processor_.GetKeySize());
+    }
+    ++iter_;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,105 @@
+#include "index/bitmap_index.h"
+
+#include "index/art_index.h"
+
+BitmapIndex::BitmapIndex(index_id_t index_id, IndexSchema *key_schema) : Index(index_id, key_schema) {}
+
+dberr_t BitmapIndex::InsertEntry(const Row &key, RowId row_id, Txn * /*txn*/) {
+  if (row_id.GetSlotNum() >= (1u << BITMAP_SLOT_BITS) ||
+      row_id.GetPageId() >= (1 << (32 - BITMAP_SLOT_BITS)) || row_id.GetPageId() < 0) {
+    return DB_FAILED;
+  }
+  std::string bytes;
+  ArtIndex::EncodeKey(key, bytes);
+  latch_.WLock();
+  bool inserted = bitmaps_[bytes].Add(ToOrdinal(row_id));
+  latch_.WUnlock();
+  return inserted ? DB_SUCCESS : DB_FAILED;
+}
+
+dberr_t BitmapIndex::RemoveEntry(const Row &key, RowId row_id, Txn * /*txn*/) {
+  std::string bytes;
+  ArtIndex::EncodeKey(key, bytes);
+  latch_.WLock();
+  auto iter = bitmaps_.find(bytes);
+  if (iter != bitmaps_.end() && iter->second.Remove(ToOrdinal(row_id)) && iter->second.IsEmpty()) {
+    bitmaps_.erase(iter);
+  }
+  latch_.WUnlock();
+  return DB_SUCCESS;
+}
+
+/*
+ * A null field encodes to a single 0x00 and any value starts with 0x01, so
+ * every null key sorts before every key holding a value.
+ */
+bool BitmapIndex::Lookup(const Row &key, const std::string &compare_operator, RoaringBitmap &result) {
+  std::string bytes;
+  ArtIndex::EncodeKey(key, bytes);
+  bool null_key = key.GetFieldCount() > 0 && key.GetField(0)->IsNull();
+  latch_.RLock();
+  auto values_begin = bitmaps_.upper_bound(std::string(1, '\0'));
+  auto first = bitmaps_.end();
+  auto last = bitmaps_.end();
+  bool supported = true;
+  if (compare_operator == "is") {
+    first = bitmaps_.begin();
+    last = values_begin;
+  } else if (compare_operator == "not") {
+    first = values_begin;
+  } else if (null_key) {
+    // comparing with null is never true
+  } else if (compare_operator == "=") {
+    first = bitmaps_.lower_bound(bytes);
+    last = bitmaps_.upper_bound(bytes);
+  } else if (compare_operator == "<>") {
+    first = values_begin;
+  } else if (compare_operator == "<") {
+    first = values_begin;
+    last = bitmaps_.lower_bound(bytes);
+  } else if (compare_operator == "<=") {
+    first = values_begin;
+    last = bitmaps_.upper_bound(bytes);
+  } else if (compare_operator == ">") {
+    first = bitmaps_.upper_bound(bytes);
+  } else if (compare_operator == ">=") {
+    first = bitmaps_.lower_bound(bytes);
+  } else {
+    supported = false;
+  }
+  for (auto iter = first; supported && iter != last; ++iter) {
+    if (compare_operator == "<>" && iter->first == bytes) {
+      continue;
+    }
+    result.UnionWith(iter->second);
+  }
+  latch_.RUnlock();
+  return supported;
+}
+
+dberr_t BitmapIndex::ScanKey(const Row &key, std::vector<RowId> &result, Txn * /*txn*/, std::string compare_operator) {
+  RoaringBitmap bitmap;
+  if (!Lookup(key, compare_operator, bitmap)) {
+    return DB_FAILED;
+  }
+  std::vector<uint32_t> ordinals;
+  bitmap.ToVector(ordinals);
+  for (uint32_t ordinal : ordinals) {
+    result.emplace_back(FromOrdinal(ordinal));
+  }
+  return ordinals.empty() ? DB_KEY_NOT_FOUND : DB_SUCCESS;
+}
+
+size_t BitmapIndex::GetKeyCount() {
+  latch_.RLock();
+  size_t count = bitmaps_.size();
+  latch_.RUnlock();
+  return count;
+}
+
+dberr_t BitmapIndex::Destroy() {
+  latch_.WLock();
+  bitmaps_.clear();
+  latch_.WUnlock();
+  return DB_SUCCESS;
+}
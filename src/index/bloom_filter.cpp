@@ -0,0 +1,112 @@
+#include "index/bloom_filter.h"
+
+#include <algorithm>
+#include <string>
+
+#include "common/hash_util.h"
+
+CountingBloomFilter::CountingBloomFilter(uint32_t key_column_count, uint32_t expected_keys)
+    : key_column_count_(key_column_count) {
+  Reset(expected_keys);
+}
+
+void CountingBloomFilter::Reset(uint32_t expected_keys) {
+  latch_.WLock();
+  expected_keys_ = expected_keys == 0 ? DEFAULT_EXPECTED_KEYS : expected_keys;
+  key_count_ = 0;
+  counters_.assign(static_cast<size_t>(expected_keys_) * COUNTERS_PER_KEY, 0);
+  latch_.WUnlock();
+}
+
+bool CountingBloomFilter::IsOverloaded() const {
+  latch_.RLock();
+  bool overloaded = key_count_ > expected_keys_;
+  latch_.RUnlock();
+  return overloaded;
+}
+
+uint32_t CountingBloomFilter::GetKeyCount() const {
+  latch_.RLock();
+  uint32_t key_count = key_count_;
+  latch_.RUnlock();
+  return key_count;
+}
+
+uint32_t CountingBloomFilter::GetExpectedKeys() const {
+  latch_.RLock();
+  uint32_t expected_keys = expected_keys_;
+  latch_.RUnlock();
+  return expected_keys;
+}
+
+/*
+ * Hash the serialized key fields, a null field only contributes a marker byte.
+ * A float is serialized after normalization, equal values then hash the same.
+ * The two halves of the hash drive the probe sequence (double hashing).
+ */
+uint64_t CountingBloomFilter::Hash(const Row &key) const {
+  std::string bytes;
+  uint32_t column_count = std::min(key_column_count_, static_cast<uint32_t>(key.GetFieldCount()));
+  for (uint32_t i = 0; i < column_count; i++) {
+    Field *field = key.GetField(i);
+    if (field->IsNull()) {
+      bytes.push_back('\0');
+      continue;
+    }
+    bytes.push_back('\1');
+    size_t offset = bytes.size();
+    bytes.resize(offset + field->GetSerializedSize());
+    if (field->GetTypeId() == TypeId::kTypeFloat) {
+      Field(TypeId::kTypeFloat, HashUtil::NormalizeFloat(field->GetFloatValue())).SerializeTo(&bytes[offset]);
+    } else {
+      field->SerializeTo(&bytes[offset]);
+    }
+  }
+  return HashUtil::Murmur3_64(bytes.data(), bytes.size());
+}
+
+void CountingBloomFilter::Add(const Row &key) {
+  uint64_t hash = Hash(key);
+  uint32_t h1 = static_cast<uint32_t>(hash);
+  uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+  latch_.WLock();
+  for (uint32_t i = 0; i < PROBE_COUNT; i++) {
+    uint8_t &counter = counters_[(h1 + i * h2) % counters_.size()];
+    if (counter != UINT8_MAX) {
+      counter++;
+    }
+  }
+  key_count_++;
+  latch_.WUnlock();
+}
+
+void CountingBloomFilter::Remove(const Row &key) {
+  uint64_t hash = Hash(key);
+  uint32_t h1 = static_cast<uint32_t>(hash);
+  uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+  latch_.WLock();
+  for (uint32_t i = 0; i < PROBE_COUNT; i++) {
+    uint8_t &counter = counters_[(h1 + i * h2) % counters_.size()];
+    // a saturated counter lost track of how many keys share it
+    if (counter != 0 && counter != UINT8_MAX) {
+      counter--;
+    }
+  }
+  if (key_count_ > 0) {
+    key_count_--;
+  }
+  latch_.WUnlock();
+}
+
+bool CountingBloomFilter::MayContain(const Row &key) const {
+  uint64_t hash = Hash(key);
+  uint32_t h1 = static_cast<uint32_t>(hash);
+  uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+  bool may_contain = true;
+  latch_.RLock();
+  for (uint32_t i = 0; i < PROBE_COUNT && may_contain; i++) {
+    may_contain = counters_[(h1 + i * h2) % counters_.size()] != 0;
+  }
+  latch_.RUnlock();
+  return may_contain;
+}
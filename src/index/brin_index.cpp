@@ -0,0 +1,205 @@
+#include "index/brin_index.h"
+
+#include "index/art_index.h"
+#include "page/index_roots_page.h"
+
+BrinIndex::BrinIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size,
+                     BufferPoolManager *buffer_pool_manager)
+    : Index(index_id, key_schema), buffer_pool_manager_(buffer_pool_manager), processor_(key_schema_, key_size) {
+  auto roots_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  if (roots_page == nullptr) {
+    return;
+  }
+  auto roots = reinterpret_cast<IndexRootsPage *>(roots_page->GetData());
+  if (!roots->GetRootId(index_id_, &first_page_id_)) {
+    first_page_id_ = INVALID_PAGE_ID;
+  }
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
+  LoadSummaries();
+}
+
+void BrinIndex::LoadSummaries() {
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      break;
+    }
+    auto brin_page = reinterpret_cast<BrinPage *>(page->GetData());
+    for (int i = 0; i < brin_page->GetSize(); i++) {
+      Summary &summary = summaries_[brin_page->RangeIdAt(i)];
+      summary.page_id = page_id;
+      summary.slot = i;
+      summary.row_count = brin_page->RowCountAt(i);
+      summary.null_count = brin_page->NullCountAt(i);
+      if (summary.row_count > summary.null_count) {
+        Row min(INVALID_ROWID);
+        Row max(INVALID_ROWID);
+        processor_.DeserializeToKey(brin_page->MinKeyAt(i), min, key_schema_);
+        processor_.DeserializeToKey(brin_page->MaxKeyAt(i), max, key_schema_);
+        ArtIndex::EncodeKey(min, summary.min);
+        ArtIndex::EncodeKey(max, summary.max);
+      }
+    }
+    last_page_id_ = page_id;
+    page_id_t next_page_id = brin_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+BrinIndex::Summary *BrinIndex::AppendSummary(uint32_t range_id) {
+  Page *page = last_page_id_ == INVALID_PAGE_ID ? nullptr : buffer_pool_manager_->FetchPage(last_page_id_);
+  auto brin_page = page == nullptr ? nullptr : reinterpret_cast<BrinPage *>(page->GetData());
+  if (brin_page == nullptr || brin_page->IsFull()) {
+    page_id_t new_page_id;
+    auto new_page = buffer_pool_manager_->NewPage(new_page_id);
+    if (new_page == nullptr) {
+      if (page != nullptr) {
+        buffer_pool_manager_->UnpinPage(last_page_id_, false);
+      }
+      return nullptr;
+    }
+    auto new_brin_page = reinterpret_cast<BrinPage *>(new_page->GetData());
+    new_brin_page->Init(processor_.GetKeySize());
+    if (brin_page != nullptr) {
+      brin_page->SetNextPageId(new_page_id);
+      buffer_pool_manager_->UnpinPage(last_page_id_, true);
+    } else {
+      first_page_id_ = new_page_id;
+      auto roots_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+      if (roots_page != nullptr) {
+        reinterpret_cast<IndexRootsPage *>(roots_page->GetData())->Insert(index_id_, first_page_id_);
+        buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+      }
+    }
+    last_page_id_ = new_page_id;
+    brin_page = new_brin_page;
+  }
+  Summary &summary = summaries_[range_id];
+  summary.page_id = last_page_id_;
+  summary.slot = brin_page->Append(range_id);
+  buffer_pool_manager_->UnpinPage(last_page_id_, true);
+  return &summary;
+}
+
+void BrinIndex::PersistSummary(const Summary &summary, const Row *key, bool min_changed, bool max_changed) {
+  auto page = buffer_pool_manager_->FetchPage(summary.page_id);
+  if (page == nullptr) {
+    return;
+  }
+  auto brin_page = reinterpret_cast<BrinPage *>(page->GetData());
+  brin_page->SetCountsAt(summary.slot, summary.row_count, summary.null_count);
+  if (min_changed) {
+    processor_.SerializeFromKey(brin_page->MinKeyAt(summary.slot), *key, key_schema_);
+  }
+  if (max_changed) {
+    processor_.SerializeFromKey(brin_page->MaxKeyAt(summary.slot), *key, key_schema_);
+  }
+  buffer_pool_manager_->UnpinPage(summary.page_id, true);
+}
+
+dberr_t BrinIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
+  std::lock_guard<std::mutex> guard(latch_);
+  uint32_t range_id = RangeOf(row_id.GetPageId());
+  auto iter = summaries_.find(range_id);
+  Summary *summary = iter == summaries_.end() ? AppendSummary(range_id) : &iter->second;
+  if (summary == nullptr) {
+    return DB_FAILED;
+  }
+  bool min_changed = false;
+  bool max_changed = false;
+  if (key.GetField(0)->IsNull()) {
+    summary->null_count++;
+  } else {
+    std::string bytes;
+    ArtIndex::EncodeKey(key, bytes);
+    bool first_value = summary->row_count == summary->null_count;
+    if (first_value || bytes < summary->min) {
+      summary->min = bytes;
+      min_changed = true;
+    }
+    if (first_value || bytes > summary->max) {
+      summary->max = std::move(bytes);
+      max_changed = true;
+    }
+  }
+  summary->row_count++;
+  PersistSummary(*summary, &key, min_changed, max_changed);
+  return DB_SUCCESS;
+}
+
+dberr_t BrinIndex::RemoveEntry(const Row &key, RowId row_id, Txn *txn) { return DB_SUCCESS; }
+
+dberr_t BrinIndex::ScanKey(const Row &key, vector<RowId> &result, Txn *txn, string compare_operator) {
+  return DB_FAILED;
+}
+
+IndexScanIteratorRef BrinIndex::Scan(const Row *lower, bool lower_inclusive, const Row *upper, bool upper_inclusive,
+                                     Txn *txn) {
+  return nullptr;
+}
+
+bool BrinIndex::PageMayMatch(page_id_t page_id, const std::string &compare_operator, const Field &value) {
+  std::lock_guard<std::mutex> guard(latch_);
+  auto iter = summaries_.find(RangeOf(page_id));
+  if (iter == summaries_.end()) {
+    // nothing is known about the range, e.g. its rows predate the index
+    return true;
+  }
+  const Summary &summary = iter->second;
+  uint32_t value_count = summary.row_count - summary.null_count;
+  if (compare_operator == "is") {
+    return summary.null_count > 0;
+  }
+  if (compare_operator == "not") {
+    return value_count > 0;
+  }
+  if (value_count == 0) {
+    return false;
+  }
+  if (value.IsNull() || value.GetTypeId() != key_schema_->GetColumn(0)->GetType()) {
+    return true;
+  }
+  std::vector<Field> fields;
+  fields.emplace_back(value);
+  std::string bytes;
+  ArtIndex::EncodeKey(Row(fields), bytes);
+  if (compare_operator == "=") {
+    return summary.min <= bytes && bytes <= summary.max;
+  } else if (compare_operator == "<>") {
+    return summary.min != bytes || summary.max != bytes;
+  } else if (compare_operator == "<") {
+    return summary.min < bytes;
+  } else if (compare_operator == "<=") {
+    return summary.min <= bytes;
+  } else if (compare_operator == ">") {
+    return summary.max > bytes;
+  } else if (compare_operator == ">=") {
+    return summary.max >= bytes;
+  }
+  return true;
+}
+
+dberr_t BrinIndex::Destroy() {
+  std::lock_guard<std::mutex> guard(latch_);
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      break;
+    }
+    page_id_t next_page_id = reinterpret_cast<BrinPage *>(page->GetData())->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    page_id = next_page_id;
+  }
+  if (first_page_id_ != INVALID_PAGE_ID) {
+    auto roots_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+    if (roots_page != nullptr) {
+      reinterpret_cast<IndexRootsPage *>(roots_page->GetData())->Delete(index_id_);
+      buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+    }
+  }
+  first_page_id_ = last_page_id_ = INVALID_PAGE_ID;
+  summaries_.clear();
+  return DB_SUCCESS;
+}
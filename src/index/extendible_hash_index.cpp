@@ -0,0 +1,74 @@
+#include "index/extendible_hash_index.h"
+
+#include "common/hash_util.h"
+
+ExtendibleHashIndex::ExtendibleHashIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size,
+                                         BufferPoolManager *buffer_pool_manager)
+    : Index(index_id, key_schema),
+      processor_(key_schema_, key_size),
+      container_(index_id, buffer_pool_manager, processor_) {}
+
+/*
+ * Serialize key with its float fields normalized, the returned key is freed
+ * by the caller.
+ */
+GenericKey *ExtendibleHashIndex::MakeKey(const Row &key) const {
+  GenericKey *index_key = processor_.InitKey();
+  bool has_float = false;
+  for (uint32_t i = 0; i < key.GetFieldCount(); i++) {
+    has_float = has_float || (key.GetField(i)->GetTypeId() == TypeId::kTypeFloat && !key.GetField(i)->IsNull());
+  }
+  if (!has_float) {
+    processor_.SerializeFromKey(index_key, key, key_schema_);
+    return index_key;
+  }
+  std::vector<Field> fields;
+  for (uint32_t i = 0; i < key.GetFieldCount(); i++) {
+    Field *field = key.GetField(i);
+    if (field->GetTypeId() == TypeId::kTypeFloat && !field->IsNull()) {
+      fields.emplace_back(TypeId::kTypeFloat, HashUtil::NormalizeFloat(field->GetFloatValue()));
+    } else {
+      fields.emplace_back(*field);
+    }
+  }
+  processor_.SerializeFromKey(index_key, Row(fields), key_schema_);
+  return index_key;
+}
+
+dberr_t ExtendibleHashIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
+  GenericKey *index_key = MakeKey(key);
+
+  bool status = container_.Insert(index_key, row_id, txn);
+  free(index_key);
+
+  if (!status) {
+    return DB_FAILED;
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t ExtendibleHashIndex::RemoveEntry(const Row &key, RowId row_id, Txn *txn) {
+  GenericKey *index_key = MakeKey(key);
+
+  container_.Remove(index_key, txn);
+  free(index_key);
+  return DB_SUCCESS;
+}
+
+dberr_t ExtendibleHashIndex::ScanKey(const Row &key, vector<RowId> &result, Txn *txn, string compare_operator) {
+  if (compare_operator != "=") {
+    return DB_FAILED;
+  }
+  GenericKey *index_key = MakeKey(key);
+  bool found = container_.GetValue(index_key, result, txn);
+  free(index_key);
+  if (found)
+    return DB_SUCCESS;
+  else
+    return DB_KEY_NOT_FOUND;
+}
+
+dberr_t ExtendibleHashIndex::Destroy() {
+  container_.Destroy();
+  return DB_SUCCESS;
+}
@@ -0,0 +1,540 @@
+#include "index/extendible_hash_table.h"
+
+#include <algorithm>
+#include <set>
+
+#include "common/hash_util.h"
+#include "glog/logging.h"
+#include "page/index_roots_page.h"
+
+ExtendibleHashTable::ExtendibleHashTable(index_id_t index_id, BufferPoolManager *buffer_pool_manager,
+                                         const KeyManager &comparator, int bucket_max_size,
+                                         uint32_t header_max_depth, uint32_t directory_max_depth)
+    : index_id_(index_id),
+      buffer_pool_manager_(buffer_pool_manager),
+      processor_(comparator),
+      bucket_max_size_(bucket_max_size),
+      header_max_depth_(header_max_depth),
+      directory_max_depth_(directory_max_depth) {
+  auto roots_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  if (roots_page == nullptr) {
+    return;
+  }
+  auto roots = reinterpret_cast<IndexRootsPage *>(roots_page->GetData());
+  if (!roots->GetRootId(index_id_, &header_page_id_)) {
+    header_page_id_ = INVALID_PAGE_ID;
+  }
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
+}
+
+/*
+ * Keys are zero filled before serialization, so equal keys always hash to the
+ * same value. The placement of keys is stored on disk, so the hash must not
+ * change between builds: Murmur3 instead of std::hash.
+ */
+uint32_t ExtendibleHashTable::Hash(const GenericKey *key) const {
+  return HashUtil::Murmur3(key, processor_.GetKeySize());
+}
+
+HashTableHeaderPage *ExtendibleHashTable::FetchHeaderPage() {
+  auto page = buffer_pool_manager_->FetchPage(header_page_id_);
+  if (page == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+}
+
+HashTableDirectoryPage *ExtendibleHashTable::FetchDirectoryPage(page_id_t directory_page_id) {
+  auto page = buffer_pool_manager_->FetchPage(directory_page_id);
+  if (page == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<HashTableDirectoryPage *>(page->GetData());
+}
+
+HashTableBucketPage *ExtendibleHashTable::FetchBucketPage(page_id_t bucket_page_id) {
+  auto page = buffer_pool_manager_->FetchPage(bucket_page_id);
+  if (page == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<HashTableBucketPage *>(page->GetData());
+}
+
+bool ExtendibleHashTable::IsEmpty() {
+  table_latch_.RLock();
+  bool empty = true;
+  auto header_page = header_page_id_ == INVALID_PAGE_ID ? nullptr : FetchHeaderPage();
+  if (header_page != nullptr) {
+    for (uint32_t d = 0; d < header_page->Size() && empty; d++) {
+      page_id_t dir_page_id = header_page->GetDirectoryPageId(d);
+      auto dir_page = dir_page_id == INVALID_PAGE_ID ? nullptr : FetchDirectoryPage(dir_page_id);
+      if (dir_page == nullptr) {
+        continue;
+      }
+      std::set<page_id_t> visited;
+      for (uint32_t i = 0; i < dir_page->Size() && empty; i++) {
+        page_id_t bucket_page_id = dir_page->GetBucketPageId(i);
+        if (!visited.insert(bucket_page_id).second) {
+          continue;
+        }
+        for (page_id_t page_id = bucket_page_id; page_id != INVALID_PAGE_ID && empty;) {
+          auto bucket = FetchBucketPage(page_id);
+          if (bucket == nullptr) {
+            break;
+          }
+          empty = bucket->IsEmpty();
+          page_id_t next_page_id = bucket->GetNextPageId();
+          buffer_pool_manager_->UnpinPage(page_id, false);
+          page_id = next_page_id;
+        }
+      }
+      buffer_pool_manager_->UnpinPage(dir_page_id, false);
+    }
+    buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  }
+  table_latch_.RUnlock();
+  return empty;
+}
+
+uint32_t ExtendibleHashTable::GetGlobalDepth() {
+  table_latch_.RLock();
+  uint32_t global_depth = 0;
+  auto header_page = header_page_id_ == INVALID_PAGE_ID ? nullptr : FetchHeaderPage();
+  if (header_page != nullptr) {
+    for (uint32_t d = 0; d < header_page->Size(); d++) {
+      page_id_t dir_page_id = header_page->GetDirectoryPageId(d);
+      auto dir_page = dir_page_id == INVALID_PAGE_ID ? nullptr : FetchDirectoryPage(dir_page_id);
+      if (dir_page != nullptr) {
+        global_depth = std::max(global_depth, dir_page->GetGlobalDepth());
+        buffer_pool_manager_->UnpinPage(dir_page_id, false);
+      }
+    }
+    buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  }
+  table_latch_.RUnlock();
+  return global_depth;
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+/*
+ * Return the only value that associated with input key
+ * @return : true means key exists
+ */
+bool ExtendibleHashTable::GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction) {
+  table_latch_.RLock();
+  bool found = false;
+  uint32_t hash = Hash(key);
+  page_id_t dir_page_id = INVALID_PAGE_ID;
+  auto header_page = header_page_id_ == INVALID_PAGE_ID ? nullptr : FetchHeaderPage();
+  if (header_page != nullptr) {
+    dir_page_id = header_page->GetDirectoryPageId(header_page->HashToDirectoryIndex(hash));
+    buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  }
+  auto dir_page = dir_page_id == INVALID_PAGE_ID ? nullptr : FetchDirectoryPage(dir_page_id);
+  if (dir_page != nullptr) {
+    page_id_t page_id = dir_page->GetBucketPageId(hash & dir_page->GetGlobalDepthMask());
+    while (page_id != INVALID_PAGE_ID && !found) {
+      auto bucket = FetchBucketPage(page_id);
+      if (bucket == nullptr) {
+        break;
+      }
+      RowId value;
+      found = bucket->Lookup(key, value);
+      if (found) {
+        result.push_back(value);
+      }
+      page_id_t next_page_id = bucket->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      page_id = next_page_id;
+    }
+    buffer_pool_manager_->UnpinPage(dir_page_id, false);
+  }
+  table_latch_.RUnlock();
+  return found;
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+/*
+ * Insert constant key & value pair into the hash table, creating the directory
+ * it belongs to on first use and splitting the target bucket until the pair
+ * fits. A bucket that can not split any more gets an overflow bucket appended
+ * to its chain.
+ * @return: since we only support unique key, if user try to insert duplicate
+ * keys return false, otherwise return true.
+ */
+bool ExtendibleHashTable::Insert(GenericKey *key, const RowId &value, Txn *transaction) {
+  table_latch_.WLock();
+  if (header_page_id_ == INVALID_PAGE_ID) {
+    StartNewTable();
+  }
+  uint32_t hash = Hash(key);
+  page_id_t dir_page_id = INVALID_PAGE_ID;
+  auto header_page = header_page_id_ == INVALID_PAGE_ID ? nullptr : FetchHeaderPage();
+  if (header_page != nullptr) {
+    uint32_t directory_idx = header_page->HashToDirectoryIndex(hash);
+    dir_page_id = header_page->GetDirectoryPageId(directory_idx);
+    bool header_dirty = false;
+    if (dir_page_id == INVALID_PAGE_ID) {
+      dir_page_id = NewDirectory(header_page, directory_idx);
+      header_dirty = dir_page_id != INVALID_PAGE_ID;
+    }
+    buffer_pool_manager_->UnpinPage(header_page_id_, header_dirty);
+  }
+  auto dir_page = dir_page_id == INVALID_PAGE_ID ? nullptr : FetchDirectoryPage(dir_page_id);
+  if (dir_page == nullptr) {
+    table_latch_.WUnlock();
+    return false;
+  }
+  bool inserted = false;
+  bool dir_dirty = false;
+  while (true) {
+    uint32_t bucket_idx = hash & dir_page->GetGlobalDepthMask();
+    // walk the bucket chain, looking for the key and for a bucket with room left
+    page_id_t page_id = dir_page->GetBucketPageId(bucket_idx);
+    page_id_t free_page_id = INVALID_PAGE_ID;
+    page_id_t last_page_id = INVALID_PAGE_ID;
+    bool duplicate = false;
+    while (page_id != INVALID_PAGE_ID) {
+      auto bucket = FetchBucketPage(page_id);
+      if (bucket == nullptr) {
+        break;
+      }
+      duplicate = bucket->KeyIndex(key) != -1;
+      if (free_page_id == INVALID_PAGE_ID && !bucket->IsFull()) {
+        free_page_id = page_id;
+      }
+      page_id_t next_page_id = bucket->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      last_page_id = page_id;
+      page_id = duplicate ? INVALID_PAGE_ID : next_page_id;
+    }
+    if (duplicate || last_page_id == INVALID_PAGE_ID) {
+      break;
+    }
+    if (free_page_id != INVALID_PAGE_ID) {
+      auto bucket = FetchBucketPage(free_page_id);
+      inserted = bucket->Insert(key, value);
+      buffer_pool_manager_->UnpinPage(free_page_id, true);
+      break;
+    }
+    if (SplitBucket(dir_page, bucket_idx)) {
+      dir_dirty = true;
+      continue;
+    }
+    inserted = AppendOverflowBucket(last_page_id, key, value);
+    break;
+  }
+  buffer_pool_manager_->UnpinPage(dir_page_id, dir_dirty);
+  table_latch_.WUnlock();
+  return inserted;
+}
+
+/*
+ * Create the header page, without any directory yet, and record the header
+ * page id in the index roots page.
+ */
+void ExtendibleHashTable::StartNewTable() {
+  page_id_t header_page_id;
+  auto page = buffer_pool_manager_->NewPage(header_page_id);
+  if (page == nullptr) {
+    LOG(ERROR) << "Out of memory when creating hash header." << std::endl;
+    return;
+  }
+  auto header_page = reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+  header_page->Init(header_page_id, header_max_depth_);
+  buffer_pool_manager_->UnpinPage(header_page_id, true);
+  header_page_id_ = header_page_id;
+  UpdateHeaderPageId(1);
+}
+
+/*
+ * Create the directory page of a header slot together with its first bucket.
+ * @return: the new directory page id, INVALID_PAGE_ID if out of memory
+ */
+page_id_t ExtendibleHashTable::NewDirectory(HashTableHeaderPage *header_page, uint32_t directory_idx) {
+  page_id_t dir_page_id;
+  auto page = buffer_pool_manager_->NewPage(dir_page_id);
+  if (page == nullptr) {
+    LOG(ERROR) << "Out of memory when creating hash directory." << std::endl;
+    return INVALID_PAGE_ID;
+  }
+  page_id_t bucket_page_id;
+  auto bucket_page = buffer_pool_manager_->NewPage(bucket_page_id);
+  if (bucket_page == nullptr) {
+    buffer_pool_manager_->UnpinPage(dir_page_id, false);
+    buffer_pool_manager_->DeletePage(dir_page_id);
+    LOG(ERROR) << "Out of memory when creating hash bucket." << std::endl;
+    return INVALID_PAGE_ID;
+  }
+  auto dir_page = reinterpret_cast<HashTableDirectoryPage *>(page->GetData());
+  dir_page->Init(dir_page_id, directory_max_depth_);
+  dir_page->SetBucketPageId(0, bucket_page_id);
+  auto bucket = reinterpret_cast<HashTableBucketPage *>(bucket_page->GetData());
+  bucket->Init(processor_.GetKeySize(), bucket_max_size_);
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  buffer_pool_manager_->UnpinPage(dir_page_id, true);
+  header_page->SetDirectoryPageId(directory_idx, dir_page_id);
+  return dir_page_id;
+}
+
+/*
+ * Split the bucket referenced by bucket_idx into itself and a new bucket,
+ * doubling the directory first if the bucket is already at global depth.
+ * Pairs whose hash has the new local depth bit set move to the new bucket.
+ * @return: false if the directory is at its maximum depth or no page could be allocated
+ */
+bool ExtendibleHashTable::SplitBucket(HashTableDirectoryPage *dir_page, uint32_t bucket_idx) {
+  uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+  bool grow = local_depth == dir_page->GetGlobalDepth();
+  if (grow && dir_page->GetGlobalDepth() >= dir_page->GetMaxDepth()) {
+    return false;
+  }
+  // take both pages before the directory is touched, so a failure leaves it unchanged
+  page_id_t old_page_id = dir_page->GetBucketPageId(bucket_idx);
+  page_id_t new_page_id;
+  auto new_page = buffer_pool_manager_->NewPage(new_page_id);
+  if (new_page == nullptr) {
+    return false;
+  }
+  auto old_bucket = FetchBucketPage(old_page_id);
+  if (old_bucket == nullptr) {
+    buffer_pool_manager_->UnpinPage(new_page_id, false);
+    buffer_pool_manager_->DeletePage(new_page_id);
+    return false;
+  }
+  if (grow) {
+    dir_page->IncrGlobalDepth();
+  }
+  auto new_bucket = reinterpret_cast<HashTableBucketPage *>(new_page->GetData());
+  new_bucket->Init(processor_.GetKeySize(), bucket_max_size_);
+
+  uint32_t high_bit = 1U << local_depth;
+  for (uint32_t i = 0; i < dir_page->Size(); i++) {
+    if (dir_page->GetBucketPageId(i) == old_page_id) {
+      dir_page->SetLocalDepth(i, local_depth + 1);
+      if (i & high_bit) {
+        dir_page->SetBucketPageId(i, new_page_id);
+      }
+    }
+  }
+  // walk backwards so that RemoveAt only moves pairs that were already examined
+  for (int i = old_bucket->GetSize() - 1; i >= 0; i--) {
+    GenericKey *key = old_bucket->KeyAt(i);
+    if (Hash(key) & high_bit) {
+      new_bucket->Insert(key, old_bucket->ValueAt(i));
+      old_bucket->RemoveAt(i);
+    }
+  }
+  buffer_pool_manager_->UnpinPage(old_page_id, true);
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+  return true;
+}
+
+/*
+ * Link a new overflow bucket after last_page_id and put the pair into it.
+ * Only buckets at the maximum depth of their directory ever get a chain, so a bucket
+ * with overflow pages is never split.
+ */
+bool ExtendibleHashTable::AppendOverflowBucket(page_id_t last_page_id, GenericKey *key, const RowId &value) {
+  page_id_t overflow_page_id;
+  auto overflow_page = buffer_pool_manager_->NewPage(overflow_page_id);
+  if (overflow_page == nullptr) {
+    LOG(ERROR) << "Out of memory when creating hash overflow bucket." << std::endl;
+    return false;
+  }
+  auto last_bucket = FetchBucketPage(last_page_id);
+  if (last_bucket == nullptr) {
+    buffer_pool_manager_->UnpinPage(overflow_page_id, false);
+    buffer_pool_manager_->DeletePage(overflow_page_id);
+    return false;
+  }
+  auto overflow_bucket = reinterpret_cast<HashTableBucketPage *>(overflow_page->GetData());
+  overflow_bucket->Init(processor_.GetKeySize(), bucket_max_size_);
+  overflow_bucket->Insert(key, value);
+  last_bucket->SetNextPageId(overflow_page_id);
+  buffer_pool_manager_->UnpinPage(last_page_id, true);
+  buffer_pool_manager_->UnpinPage(overflow_page_id, true);
+  return true;
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+/*
+ * Delete key & value pair associated with input key. Empty overflow buckets
+ * are unlinked from the chain, an empty bucket without overflow pages is
+ * merged with its split image. A directory stays in the header once created,
+ * its buckets merge back into one.
+ */
+void ExtendibleHashTable::Remove(const GenericKey *key, Txn *transaction) {
+  table_latch_.WLock();
+  uint32_t hash = Hash(key);
+  page_id_t dir_page_id = INVALID_PAGE_ID;
+  auto header_page = header_page_id_ == INVALID_PAGE_ID ? nullptr : FetchHeaderPage();
+  if (header_page != nullptr) {
+    dir_page_id = header_page->GetDirectoryPageId(header_page->HashToDirectoryIndex(hash));
+    buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  }
+  auto dir_page = dir_page_id == INVALID_PAGE_ID ? nullptr : FetchDirectoryPage(dir_page_id);
+  if (dir_page == nullptr) {
+    table_latch_.WUnlock();
+    return;
+  }
+  uint32_t bucket_idx = hash & dir_page->GetGlobalDepthMask();
+  page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+  page_id_t prev_page_id = INVALID_PAGE_ID;
+  bool merge = false;
+  for (page_id_t page_id = bucket_page_id; page_id != INVALID_PAGE_ID;) {
+    auto bucket = FetchBucketPage(page_id);
+    if (bucket == nullptr) {
+      break;
+    }
+    page_id_t next_page_id = bucket->GetNextPageId();
+    if (!bucket->Remove(key)) {
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      prev_page_id = page_id;
+      page_id = next_page_id;
+      continue;
+    }
+    bool empty = bucket->IsEmpty();
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    if (empty && prev_page_id != INVALID_PAGE_ID) {
+      auto prev_bucket = FetchBucketPage(prev_page_id);
+      prev_bucket->SetNextPageId(next_page_id);
+      buffer_pool_manager_->UnpinPage(prev_page_id, true);
+      buffer_pool_manager_->DeletePage(page_id);
+    }
+    break;
+  }
+  // the primary bucket may have been emptied earlier and only now lost its last overflow bucket
+  auto bucket = FetchBucketPage(bucket_page_id);
+  if (bucket != nullptr) {
+    merge = bucket->IsEmpty() && bucket->GetNextPageId() == INVALID_PAGE_ID;
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  }
+  if (merge) {
+    Merge(dir_page, bucket_idx);
+  }
+  buffer_pool_manager_->UnpinPage(dir_page_id, merge);
+  table_latch_.WUnlock();
+}
+
+/*
+ * Fold an empty bucket into its split image as long as both have the same
+ * local depth, then shrink the directory while no bucket needs its top bit.
+ */
+void ExtendibleHashTable::Merge(HashTableDirectoryPage *dir_page, uint32_t bucket_idx) {
+  while (true) {
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    if (local_depth == 0) {
+      return;
+    }
+    uint32_t image_idx = dir_page->GetSplitImageIndex(bucket_idx);
+    if (dir_page->GetLocalDepth(image_idx) != local_depth) {
+      return;
+    }
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    page_id_t image_page_id = dir_page->GetBucketPageId(image_idx);
+    auto bucket = FetchBucketPage(bucket_page_id);
+    if (bucket == nullptr) {
+      return;
+    }
+    bool empty = bucket->IsEmpty() && bucket->GetNextPageId() == INVALID_PAGE_ID;
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+    auto image = FetchBucketPage(image_page_id);
+    if (image == nullptr) {
+      return;
+    }
+    // a chained bucket sits at the maximum depth and must stay there
+    bool chained = image->GetNextPageId() != INVALID_PAGE_ID;
+    buffer_pool_manager_->UnpinPage(image_page_id, false);
+    if (!empty || chained) {
+      return;
+    }
+    for (uint32_t i = 0; i < dir_page->Size(); i++) {
+      page_id_t page_id = dir_page->GetBucketPageId(i);
+      if (page_id == bucket_page_id || page_id == image_page_id) {
+        dir_page->SetBucketPageId(i, image_page_id);
+        dir_page->SetLocalDepth(i, local_depth - 1);
+      }
+    }
+    buffer_pool_manager_->DeletePage(bucket_page_id);
+    while (dir_page->CanShrink()) {
+      dir_page->DecrGlobalDepth();
+    }
+    // the merged bucket may itself be empty and mergeable one level up
+    bucket_idx = image_idx & dir_page->GetGlobalDepthMask();
+  }
+}
+
+/*
+ * Give every bucket page, every directory page and the header page back to
+ * the buffer pool and drop the index from the index roots page.
+ */
+void ExtendibleHashTable::Destroy() {
+  table_latch_.WLock();
+  auto header_page = header_page_id_ == INVALID_PAGE_ID ? nullptr : FetchHeaderPage();
+  if (header_page != nullptr) {
+    std::vector<page_id_t> directories;
+    for (uint32_t d = 0; d < header_page->Size(); d++) {
+      if (header_page->GetDirectoryPageId(d) != INVALID_PAGE_ID) {
+        directories.push_back(header_page->GetDirectoryPageId(d));
+      }
+    }
+    buffer_pool_manager_->UnpinPage(header_page_id_, false);
+    for (auto dir_page_id : directories) {
+      auto dir_page = FetchDirectoryPage(dir_page_id);
+      if (dir_page == nullptr) {
+        continue;
+      }
+      std::set<page_id_t> buckets;
+      for (uint32_t i = 0; i < dir_page->Size(); i++) {
+        buckets.insert(dir_page->GetBucketPageId(i));
+      }
+      buffer_pool_manager_->UnpinPage(dir_page_id, false);
+      for (auto bucket_page_id : buckets) {
+        for (page_id_t page_id = bucket_page_id; page_id != INVALID_PAGE_ID;) {
+          auto bucket = FetchBucketPage(page_id);
+          if (bucket == nullptr) {
+            break;
+          }
+          page_id_t next_page_id = bucket->GetNextPageId();
+          buffer_pool_manager_->UnpinPage(page_id, false);
+          buffer_pool_manager_->DeletePage(page_id);
+          page_id = next_page_id;
+        }
+      }
+      buffer_pool_manager_->DeletePage(dir_page_id);
+    }
+    buffer_pool_manager_->DeletePage(header_page_id_);
+    header_page_id_ = INVALID_PAGE_ID;
+    UpdateHeaderPageId(-1);
+  }
+  table_latch_.WUnlock();
+}
+
+/*
+ * Update/Insert/Delete the header page id in the index roots page, so the
+ * hash table can be found again after the index is reopened.
+ * @parameter: insert_record 1 to insert a new record, -1 to delete the record,
+ * otherwise update the existing one.
+ */
+void ExtendibleHashTable::UpdateHeaderPageId(int insert_record) {
+  auto roots_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  if (roots_page == nullptr) {
+    return;
+  }
+  auto roots = reinterpret_cast<IndexRootsPage *>(roots_page->GetData());
+  if (insert_record == 1) {
+    roots->Insert(index_id_, header_page_id_);
+  } else if (insert_record == -1) {
+    roots->Delete(index_id_);
+  } else {
+    roots->Update(index_id_, header_page_id_);
+  }
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+}
@@ -0,0 +1,355 @@
+#include "index/fulltext_index.h"
+
+#include <algorithm>
+
+#include "index/text_tokenizer.h"
+#include "page/index_roots_page.h"
+
+FullTextIndex::FullTextIndex(index_id_t index_id, IndexSchema *key_schema, BufferPoolManager *buffer_pool_manager)
+    : Index(index_id, key_schema), buffer_pool_manager_(buffer_pool_manager) {
+  auto roots_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  if (roots_page == nullptr) {
+    return;
+  }
+  auto roots = reinterpret_cast<IndexRootsPage *>(roots_page->GetData());
+  if (!roots->GetRootId(index_id_, &lexicon_page_id_)) {
+    lexicon_page_id_ = INVALID_PAGE_ID;
+  }
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
+  LoadLexicon();
+}
+
+void FullTextIndex::LoadLexicon() {
+  for (page_id_t page_id = lexicon_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      break;
+    }
+    auto lexicon_page = reinterpret_cast<LexiconPage *>(page->GetData());
+    std::string token;
+    page_id_t posting_page_id;
+    for (int offset = lexicon_page->ReadAt(0, token, posting_page_id); offset >= 0;
+         offset = lexicon_page->ReadAt(offset, token, posting_page_id)) {
+      lexicon_[token] = Term{posting_page_id, INVALID_PAGE_ID};
+    }
+    lexicon_last_page_id_ = page_id;
+    page_id_t next_page_id = lexicon_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+bool FullTextIndex::AppendLexicon(const std::string &token, page_id_t posting_page_id) {
+  if (lexicon_last_page_id_ != INVALID_PAGE_ID) {
+    auto page = buffer_pool_manager_->FetchPage(lexicon_last_page_id_);
+    if (page == nullptr) {
+      return false;
+    }
+    auto lexicon_page = reinterpret_cast<LexiconPage *>(page->GetData());
+    bool appended = lexicon_page->Append(token, posting_page_id);
+    buffer_pool_manager_->UnpinPage(lexicon_last_page_id_, appended);
+    if (appended) {
+      return true;
+    }
+  }
+  // the last page is full, chain a new one
+  page_id_t new_page_id;
+  auto new_page = buffer_pool_manager_->NewPage(new_page_id);
+  if (new_page == nullptr) {
+    return false;
+  }
+  auto new_lexicon_page = reinterpret_cast<LexiconPage *>(new_page->GetData());
+  new_lexicon_page->Init();
+  new_lexicon_page->Append(token, posting_page_id);
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+  if (lexicon_last_page_id_ == INVALID_PAGE_ID) {
+    lexicon_page_id_ = new_page_id;
+    auto roots_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+    if (roots_page != nullptr) {
+      reinterpret_cast<IndexRootsPage *>(roots_page->GetData())->Insert(index_id_, lexicon_page_id_);
+      buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+    }
+  } else {
+    auto page = buffer_pool_manager_->FetchPage(lexicon_last_page_id_);
+    if (page != nullptr) {
+      reinterpret_cast<LexiconPage *>(page->GetData())->SetNextPageId(new_page_id);
+      buffer_pool_manager_->UnpinPage(lexicon_last_page_id_, true);
+    }
+  }
+  lexicon_last_page_id_ = new_page_id;
+  return true;
+}
+
+bool FullTextIndex::ReadPostings(const Term &term, std::vector<uint64_t> &values) {
+  for (page_id_t page_id = term.first_page_id; page_id != INVALID_PAGE_ID;) {
+    auto page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      return false;
+    }
+    auto posting_page = reinterpret_cast<PostingPage *>(page->GetData());
+    posting_page->Decode(values);
+    page_id_t next_page_id = posting_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  return true;
+}
+
+bool FullTextIndex::WritePostings(Term &term, const std::vector<uint64_t> &values) {
+  page_id_t page_id = term.first_page_id;
+  auto page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    return false;
+  }
+  auto posting_page = reinterpret_cast<PostingPage *>(page->GetData());
+  page_id_t next_page_id = posting_page->GetNextPageId();
+  posting_page->Init();
+  for (uint64_t value : values) {
+    if (posting_page->Append(value)) {
+      continue;
+    }
+    // move on to the next page of the old chain, or extend the chain
+    page_id_t following_page_id = next_page_id;
+    Page *following_page = nullptr;
+    if (following_page_id != INVALID_PAGE_ID) {
+      following_page = buffer_pool_manager_->FetchPage(following_page_id);
+    } else {
+      following_page = buffer_pool_manager_->NewPage(following_page_id);
+    }
+    if (following_page == nullptr) {
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      return false;
+    }
+    auto following_posting_page = reinterpret_cast<PostingPage *>(following_page->GetData());
+    next_page_id = next_page_id == INVALID_PAGE_ID ? INVALID_PAGE_ID : following_posting_page->GetNextPageId();
+    following_posting_page->Init();
+    posting_page->SetNextPageId(following_page_id);
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    page_id = following_page_id;
+    posting_page = following_posting_page;
+    posting_page->Append(value);
+  }
+  posting_page->SetNextPageId(INVALID_PAGE_ID);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  term.last_page_id = page_id;
+  // free the pages the shorter list no longer needs
+  while (next_page_id != INVALID_PAGE_ID) {
+    auto unused_page = buffer_pool_manager_->FetchPage(next_page_id);
+    if (unused_page == nullptr) {
+      break;
+    }
+    page_id_t unused_page_id = next_page_id;
+    next_page_id = reinterpret_cast<PostingPage *>(unused_page->GetData())->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(unused_page_id, false);
+    buffer_pool_manager_->DeletePage(unused_page_id);
+  }
+  return true;
+}
+
+bool FullTextIndex::AddPosting(const std::string &token, uint64_t value) {
+  auto iter = lexicon_.find(token);
+  if (iter == lexicon_.end()) {
+    page_id_t page_id;
+    auto page = buffer_pool_manager_->NewPage(page_id);
+    if (page == nullptr) {
+      return false;
+    }
+    auto posting_page = reinterpret_cast<PostingPage *>(page->GetData());
+    posting_page->Init();
+    posting_page->Append(value);
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    lexicon_[token] = Term{page_id, page_id};
+    return AppendLexicon(token, page_id);
+  }
+  Term &term = iter->second;
+  // find the tail of the chain once
+  if (term.last_page_id == INVALID_PAGE_ID) {
+    for (page_id_t page_id = term.first_page_id; page_id != INVALID_PAGE_ID;) {
+      auto page = buffer_pool_manager_->FetchPage(page_id);
+      if (page == nullptr) {
+        return false;
+      }
+      term.last_page_id = page_id;
+      page_id_t next_page_id = reinterpret_cast<PostingPage *>(page->GetData())->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      page_id = next_page_id;
+    }
+  }
+  auto page = buffer_pool_manager_->FetchPage(term.last_page_id);
+  if (page == nullptr) {
+    return false;
+  }
+  auto posting_page = reinterpret_cast<PostingPage *>(page->GetData());
+  if (posting_page->GetCount() > 0 && value <= posting_page->GetLastValue()) {
+    // out of heap order, rewrite the whole list
+    buffer_pool_manager_->UnpinPage(term.last_page_id, false);
+    std::vector<uint64_t> values;
+    if (!ReadPostings(term, values)) {
+      return false;
+    }
+    auto pos = std::lower_bound(values.begin(), values.end(), value);
+    if (pos != values.end() && *pos == value) {
+      return true;
+    }
+    values.insert(pos, value);
+    return WritePostings(term, values);
+  }
+  if (posting_page->Append(value)) {
+    buffer_pool_manager_->UnpinPage(term.last_page_id, true);
+    return true;
+  }
+  page_id_t new_page_id;
+  auto new_page = buffer_pool_manager_->NewPage(new_page_id);
+  if (new_page == nullptr) {
+    buffer_pool_manager_->UnpinPage(term.last_page_id, false);
+    return false;
+  }
+  auto new_posting_page = reinterpret_cast<PostingPage *>(new_page->GetData());
+  new_posting_page->Init();
+  new_posting_page->Append(value);
+  posting_page->SetNextPageId(new_page_id);
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+  buffer_pool_manager_->UnpinPage(term.last_page_id, true);
+  term.last_page_id = new_page_id;
+  return true;
+}
+
+bool FullTextIndex::RemovePosting(const std::string &token, uint64_t value) {
+  auto iter = lexicon_.find(token);
+  if (iter == lexicon_.end()) {
+    return true;
+  }
+  std::vector<uint64_t> values;
+  if (!ReadPostings(iter->second, values)) {
+    return false;
+  }
+  auto pos = std::lower_bound(values.begin(), values.end(), value);
+  if (pos == values.end() || *pos != value) {
+    return true;
+  }
+  values.erase(pos);
+  return WritePostings(iter->second, values);
+}
+
+std::vector<std::string> FullTextIndex::Tokens(const Row &key) {
+  std::vector<std::string> tokens;
+  Field *field = key.GetField(0);
+  if (!field->IsNull() && field->GetTypeId() == TypeId::kTypeChar) {
+    TokenizeText(field->GetData(), field->GetLength(), tokens);
+  }
+  return tokens;
+}
+
+dberr_t FullTextIndex::InsertEntry(const Row &key, RowId row_id, Txn * /*txn*/) {
+  std::lock_guard<std::mutex> guard(latch_);
+  for (const auto &token : Tokens(key)) {
+    if (!AddPosting(token, static_cast<uint64_t>(row_id.Get()))) {
+      return DB_FAILED;
+    }
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t FullTextIndex::RemoveEntry(const Row &key, RowId row_id, Txn * /*txn*/) {
+  std::lock_guard<std::mutex> guard(latch_);
+  for (const auto &token : Tokens(key)) {
+    if (!RemovePosting(token, static_cast<uint64_t>(row_id.Get()))) {
+      return DB_FAILED;
+    }
+  }
+  return DB_SUCCESS;
+}
+
+void FullTextIndex::IntersectPostings(std::vector<uint64_t> &lhs, const std::vector<uint64_t> &rhs) {
+  size_t kept = 0;
+  size_t begin = 0;
+  for (uint64_t value : lhs) {
+    // gallop until rhs[begin + bound] is not less than value, then binary search the last step
+    size_t bound = 1;
+    while (begin + bound < rhs.size() && rhs[begin + bound] < value) {
+      bound <<= 1;
+    }
+    auto first = rhs.begin() + begin + bound / 2;
+    auto last = rhs.begin() + std::min(begin + bound + 1, rhs.size());
+    auto pos = std::lower_bound(first, last, value);
+    begin = pos - rhs.begin();
+    if (begin == rhs.size()) {
+      break;
+    }
+    if (*pos == value) {
+      lhs[kept++] = value;
+    }
+  }
+  lhs.resize(kept);
+}
+
+dberr_t FullTextIndex::ScanKey(const Row &key, std::vector<RowId> &result, Txn * /*txn*/,
+                               std::string compare_operator) {
+  if (compare_operator != "match") {
+    return DB_FAILED;
+  }
+  std::vector<std::string> tokens = Tokens(key);
+  if (tokens.empty()) {
+    return DB_KEY_NOT_FOUND;
+  }
+  std::lock_guard<std::mutex> guard(latch_);
+  std::vector<std::vector<uint64_t>> postings;
+  for (const auto &token : tokens) {
+    auto iter = lexicon_.find(token);
+    if (iter == lexicon_.end()) {
+      return DB_KEY_NOT_FOUND;
+    }
+    postings.emplace_back();
+    if (!ReadPostings(iter->second, postings.back())) {
+      return DB_FAILED;
+    }
+  }
+  // start from the rarest token so every step probes with the fewest values
+  std::sort(postings.begin(), postings.end(),
+            [](const std::vector<uint64_t> &lhs, const std::vector<uint64_t> &rhs) { return lhs.size() < rhs.size(); });
+  std::vector<uint64_t> &matches = postings[0];
+  for (size_t i = 1; i < postings.size() && !matches.empty(); i++) {
+    IntersectPostings(matches, postings[i]);
+  }
+  for (uint64_t value : matches) {
+    result.emplace_back(static_cast<int64_t>(value));
+  }
+  return matches.empty() ? DB_KEY_NOT_FOUND : DB_SUCCESS;
+}
+
+IndexScanIteratorRef FullTextIndex::Scan(const Row * /*lower*/, bool /*lower_inclusive*/, const Row * /*upper*/,
+                                         bool /*upper_inclusive*/, Txn * /*txn*/) {
+  // the lists are keyed by token, not by the value of the column, so no range of values can be walked
+  return nullptr;
+}
+
+dberr_t FullTextIndex::Destroy() {
+  std::lock_guard<std::mutex> guard(latch_);
+  auto delete_chain = [this](page_id_t page_id, bool lexicon) {
+    while (page_id != INVALID_PAGE_ID) {
+      auto page = buffer_pool_manager_->FetchPage(page_id);
+      if (page == nullptr) {
+        break;
+      }
+      page_id_t next_page_id = lexicon ? reinterpret_cast<LexiconPage *>(page->GetData())->GetNextPageId()
+                                       : reinterpret_cast<PostingPage *>(page->GetData())->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      buffer_pool_manager_->DeletePage(page_id);
+      page_id = next_page_id;
+    }
+  };
+  for (const auto &entry : lexicon_) {
+    delete_chain(entry.second.first_page_id, false);
+  }
+  delete_chain(lexicon_page_id_, true);
+  if (lexicon_page_id_ != INVALID_PAGE_ID) {
+    auto roots_page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+    if (roots_page != nullptr) {
+      reinterpret_cast<IndexRootsPage *>(roots_page->GetData())->Delete(index_id_);
+      buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+    }
+  }
+  lexicon_.clear();
+  lexicon_page_id_ = lexicon_last_page_id_ = INVALID_PAGE_ID;
+  return DB_SUCCESS;
+}
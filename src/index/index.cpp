@@ -0,0 +1,83 @@
+#include "index/index.h"
+
+#include <algorithm>
+
+#include "storage/table_heap.h"
+
+IndexScanIteratorRef Index::Scan(const Row *lower, bool lower_inclusive, const Row *upper, bool upper_inclusive,
+                                 Txn *txn) {
+  std::vector<RowId> result;
+  if (IsPointRange(lower, upper)) {
+    if (!lower_inclusive || !upper_inclusive) {
+      return std::make_unique<MaterializedScanIterator>(std::move(result));
+    }
+    if (ScanKey(*lower, result, txn, "=") == DB_FAILED) {
+      return nullptr;
+    }
+    return std::make_unique<MaterializedScanIterator>(std::move(result));
+  }
+  if (lower == nullptr && upper == nullptr) {
+    return nullptr;
+  }
+  if (lower != nullptr && ScanKey(*lower, result, txn, lower_inclusive ? ">=" : ">") == DB_FAILED) {
+    return nullptr;
+  }
+  if (upper != nullptr) {
+    std::vector<RowId> upper_result;
+    if (ScanKey(*upper, upper_result, txn, upper_inclusive ? "<=" : "<") == DB_FAILED) {
+      return nullptr;
+    }
+    if (lower == nullptr) {
+      result = std::move(upper_result);
+    } else {
+      auto less = [](const RowId &lhs, const RowId &rhs) { return lhs.Get() < rhs.Get(); };
+      std::sort(result.begin(), result.end(), less);
+      std::sort(upper_result.begin(), upper_result.end(), less);
+      std::vector<RowId> both;
+      std::set_intersection(result.begin(), result.end(), upper_result.begin(), upper_result.end(),
+                            std::back_inserter(both), less);
+      result = std::move(both);
+    }
+  }
+  return std::make_unique<MaterializedScanIterator>(std::move(result));
+}
+
+bool Index::IsPointRange(const Row *lower, const Row *upper) {
+  if (lower == nullptr || upper == nullptr || lower->GetFieldCount() != upper->GetFieldCount()) {
+    return false;
+  }
+  if (lower == upper) {
+    return true;
+  }
+  for (uint32_t i = 0; i < lower->GetFieldCount(); i++) {
+    Field *x = lower->GetField(i);
+    Field *y = upper->GetField(i);
+    if (x->IsNull() || y->IsNull() || x->CompareEquals(*y) != CmpBool::kTrue) {
+      return false;
+    }
+  }
+  return true;
+}
+
+dberr_t Index::ScanKeys(const std::vector<Row> &keys, std::vector<RowId> &result, Txn *txn) {
+  for (const auto &key : keys) {
+    if (ScanKey(key, result, txn, "=") == DB_FAILED) {
+      return DB_FAILED;
+    }
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t Index::BuildFromHeap(TableHeap *table_heap, Txn *txn) {
+  for (auto row = table_heap->Begin(txn); row != table_heap->End(); row++) {
+    std::vector<Field> fields;
+    for (auto column : key_schema_->GetColumns()) {
+      fields.emplace_back(*row->GetField(column->GetTableInd()));
+    }
+    Row key(fields);
+    if (InsertEntry(key, row->GetRowId(), txn) != DB_SUCCESS) {
+      return DB_FAILED;
+    }
+  }
+  return DB_SUCCESS;
+}
@@ -0,0 +1,239 @@
+#include "index/roaring_bitmap.h"
+
+#include <algorithm>
+#include <iterator>
+
+static constexpr size_t BITMAP_WORDS = (1 << 16) / 64;
+
+void RoaringBitmap::Container::ToBitmap() {
+  words.assign(BITMAP_WORDS, 0);
+  for (uint16_t low : array) {
+    words[low >> 6] |= uint64_t{1} << (low & 63);
+  }
+  array.clear();
+  array.shrink_to_fit();
+}
+
+void RoaringBitmap::Container::ToArray() {
+  array.clear();
+  array.reserve(cardinality);
+  for (size_t i = 0; i < BITMAP_WORDS; i++) {
+    for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+      array.push_back(static_cast<uint16_t>(i * 64 + __builtin_ctzll(word)));
+    }
+  }
+  words.clear();
+  words.shrink_to_fit();
+}
+
+std::vector<RoaringBitmap::Container>::iterator RoaringBitmap::LowerBound(uint16_t key) {
+  return std::lower_bound(containers_.begin(), containers_.end(), key,
+                          [](const Container &container, uint16_t k) { return container.key < k; });
+}
+
+std::vector<RoaringBitmap::Container>::const_iterator RoaringBitmap::LowerBound(uint16_t key) const {
+  return std::lower_bound(containers_.begin(), containers_.end(), key,
+                          [](const Container &container, uint16_t k) { return container.key < k; });
+}
+
+bool RoaringBitmap::Add(uint32_t value) {
+  auto key = static_cast<uint16_t>(value >> 16);
+  auto low = static_cast<uint16_t>(value);
+  auto iter = LowerBound(key);
+  if (iter == containers_.end() || iter->key != key) {
+    iter = containers_.insert(iter, Container{key, 0, {}, {}});
+  }
+  Container &container = *iter;
+  if (container.IsBitmap()) {
+    uint64_t &word = container.words[low >> 6];
+    uint64_t bit = uint64_t{1} << (low & 63);
+    if (word & bit) {
+      return false;
+    }
+    word |= bit;
+  } else {
+    auto pos = std::lower_bound(container.array.begin(), container.array.end(), low);
+    if (pos != container.array.end() && *pos == low) {
+      return false;
+    }
+    container.array.insert(pos, low);
+    if (container.array.size() > ARRAY_CONTAINER_MAX_SIZE) {
+      container.ToBitmap();
+    }
+  }
+  container.cardinality++;
+  return true;
+}
+
+bool RoaringBitmap::Remove(uint32_t value) {
+  auto key = static_cast<uint16_t>(value >> 16);
+  auto low = static_cast<uint16_t>(value);
+  auto iter = LowerBound(key);
+  if (iter == containers_.end() || iter->key != key) {
+    return false;
+  }
+  Container &container = *iter;
+  if (container.IsBitmap()) {
+    uint64_t &word = container.words[low >> 6];
+    uint64_t bit = uint64_t{1} << (low & 63);
+    if ((word & bit) == 0) {
+      return false;
+    }
+    word &= ~bit;
+    if (--container.cardinality <= ARRAY_CONTAINER_MAX_SIZE) {
+      container.ToArray();
+    }
+  } else {
+    auto pos = std::lower_bound(container.array.begin(), container.array.end(), low);
+    if (pos == container.array.end() || *pos != low) {
+      return false;
+    }
+    container.array.erase(pos);
+    container.cardinality--;
+  }
+  if (container.cardinality == 0) {
+    containers_.erase(iter);
+  }
+  return true;
+}
+
+bool RoaringBitmap::Contains(uint32_t value) const {
+  auto key = static_cast<uint16_t>(value >> 16);
+  auto low = static_cast<uint16_t>(value);
+  auto iter = LowerBound(key);
+  if (iter == containers_.end() || iter->key != key) {
+    return false;
+  }
+  if (iter->IsBitmap()) {
+    return (iter->words[low >> 6] >> (low & 63)) & 1;
+  }
+  return std::binary_search(iter->array.begin(), iter->array.end(), low);
+}
+
+uint64_t RoaringBitmap::Cardinality() const {
+  uint64_t cardinality = 0;
+  for (const auto &container : containers_) {
+    cardinality += container.cardinality;
+  }
+  return cardinality;
+}
+
+void RoaringBitmap::Intersect(Container &lhs, const Container &rhs) {
+  if (lhs.IsBitmap() && rhs.IsBitmap()) {
+    uint32_t cardinality = 0;
+    for (size_t i = 0; i < BITMAP_WORDS; i++) {
+      lhs.words[i] &= rhs.words[i];
+      cardinality += __builtin_popcountll(lhs.words[i]);
+    }
+    lhs.cardinality = cardinality;
+    if (cardinality <= ARRAY_CONTAINER_MAX_SIZE) {
+      lhs.ToArray();
+    }
+    return;
+  }
+  std::vector<uint16_t> result;
+  if (lhs.IsBitmap() || rhs.IsBitmap()) {
+    // probe the bitmap with every value of the array
+    const Container &array = lhs.IsBitmap() ? rhs : lhs;
+    const Container &bitmap = lhs.IsBitmap() ? lhs : rhs;
+    for (uint16_t low : array.array) {
+      if ((bitmap.words[low >> 6] >> (low & 63)) & 1) {
+        result.push_back(low);
+      }
+    }
+    lhs.words.clear();
+    lhs.words.shrink_to_fit();
+  } else {
+    std::set_intersection(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(),
+                          std::back_inserter(result));
+  }
+  lhs.array = std::move(result);
+  lhs.cardinality = lhs.array.size();
+}
+
+void RoaringBitmap::Union(Container &lhs, const Container &rhs) {
+  if (!lhs.IsBitmap() && !rhs.IsBitmap() && lhs.array.size() + rhs.array.size() <= ARRAY_CONTAINER_MAX_SIZE) {
+    std::vector<uint16_t> result;
+    std::set_union(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(),
+                   std::back_inserter(result));
+    lhs.array = std::move(result);
+    lhs.cardinality = lhs.array.size();
+    return;
+  }
+  if (!lhs.IsBitmap()) {
+    lhs.ToBitmap();
+  }
+  if (rhs.IsBitmap()) {
+    for (size_t i = 0; i < BITMAP_WORDS; i++) {
+      lhs.words[i] |= rhs.words[i];
+    }
+  } else {
+    for (uint16_t low : rhs.array) {
+      lhs.words[low >> 6] |= uint64_t{1} << (low & 63);
+    }
+  }
+  uint32_t cardinality = 0;
+  for (size_t i = 0; i < BITMAP_WORDS; i++) {
+    cardinality += __builtin_popcountll(lhs.words[i]);
+  }
+  lhs.cardinality = cardinality;
+  if (cardinality <= ARRAY_CONTAINER_MAX_SIZE) {
+    lhs.ToArray();
+  }
+}
+
+void RoaringBitmap::IntersectWith(const RoaringBitmap &other) {
+  std::vector<Container> result;
+  auto rhs = other.containers_.begin();
+  for (auto &lhs : containers_) {
+    while (rhs != other.containers_.end() && rhs->key < lhs.key) {
+      ++rhs;
+    }
+    if (rhs == other.containers_.end()) {
+      break;
+    }
+    if (rhs->key == lhs.key) {
+      Intersect(lhs, *rhs);
+      if (lhs.cardinality > 0) {
+        result.push_back(std::move(lhs));
+      }
+    }
+  }
+  containers_ = std::move(result);
+}
+
+void RoaringBitmap::UnionWith(const RoaringBitmap &other) {
+  std::vector<Container> result;
+  result.reserve(containers_.size() + other.containers_.size());
+  auto lhs = containers_.begin();
+  auto rhs = other.containers_.begin();
+  while (lhs != containers_.end() || rhs != other.containers_.end()) {
+    if (rhs == other.containers_.end() || (lhs != containers_.end() && lhs->key < rhs->key)) {
+      result.push_back(std::move(*lhs++));
+    } else if (lhs == containers_.end() || rhs->key < lhs->key) {
+      result.push_back(*rhs++);
+    } else {
+      Union(*lhs, *rhs++);
+      result.push_back(std::move(*lhs++));
+    }
+  }
+  containers_ = std::move(result);
+}
+
+void RoaringBitmap::ToVector(std::vector<uint32_t> &values) const {
+  values.reserve(values.size() + Cardinality());
+  for (const auto &container : containers_) {
+    uint32_t high = static_cast<uint32_t>(container.key) << 16;
+    if (container.IsBitmap()) {
+      for (size_t i = 0; i < BITMAP_WORDS; i++) {
+        for (uint64_t word = container.words[i]; word != 0; word &= word - 1) {
+          values.push_back(high | static_cast<uint32_t>(i * 64 + __builtin_ctzll(word)));
+        }
+      }
+    } else {
+      for (uint16_t low : container.array) {
+        values.push_back(high | low);
+      }
+    }
+  }
+}
@@ -1,4 +1,6 @@
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 #include "executor/execute_engine.h"
 #include "glog/logging.h"
@@ -38,6 +40,15 @@ int main(int argc, char **argv) {
   char cmd[buf_size];
   // executor engine
   ExecuteEngine engine;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--tsv") == 0) {
+      // print the rows of a select as tab separated lines instead of a table
+      engine.SetResultFormat(ResultFormat::Tsv);
+    } else if (strcmp(argv[i], "--dop") == 0 && i + 1 < argc) {
+      // run the scans of a query on at most N threads, 1 runs every query serially
+      engine.SetMaxWorkers(static_cast<uint32_t>(atoi(argv[++i])));
+    }
+  }
   // for print syntax tree
   TreeFileManagers syntax_tree_file_mgr("syntax_tree_");
   uint32_t syntax_tree_id = 0;
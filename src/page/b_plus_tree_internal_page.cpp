@@ -65,7 +65,16 @@ void InternalPage::PairCopy(void *dest, void *src, int pair_num) {
  * 用了二分查找
  */
 page_id_t InternalPage::Lookup(const GenericKey *key, const KeyManager &KM) {
-  return INVALID_PAGE_ID;
+  return ValueAt(LookupIndex(key, KM));
+}
+
+int InternalPage::LookupIndex(const GenericKey *key, const KeyManager &KM) {
+  // 第一个不小于key的位置，相等时进入该子树，否则进入其左侧的子树
+  int index = KM.LowerBound(pairs_off, pair_size, 1, GetSize(), key);
+  if (index < GetSize() && KM.CompareKeys(KeyAt(index), key) == 0) {
+    return index;
+  }
+  return index - 1;
 }
 
 /*****************************************************************************
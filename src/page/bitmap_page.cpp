@@ -7,6 +7,20 @@
  */
 template <size_t PageSize>
 bool BitmapPage<PageSize>::AllocatePage(uint32_t &page_offset) {
+  if (page_allocated_ >= GetMaxSupportedSize()) {
+    return false;
+  }
+  // next_free_page_ is only a hint, the search wraps around from it
+  for (size_t i = 0; i < GetMaxSupportedSize(); i++) {
+    uint32_t offset = (next_free_page_ + i) % GetMaxSupportedSize();
+    if (IsPageFreeLow(offset / 8, offset % 8)) {
+      bytes[offset / 8] |= static_cast<unsigned char>(1 << (offset % 8));
+      page_allocated_++;
+      next_free_page_ = (offset + 1) % GetMaxSupportedSize();
+      page_offset = offset;
+      return true;
+    }
+  }
   return false;
 }
 
@@ -15,7 +29,13 @@ bool BitmapPage<PageSize>::AllocatePage(uint32_t &page_offset) {
  */
 template <size_t PageSize>
 bool BitmapPage<PageSize>::DeAllocatePage(uint32_t page_offset) {
-  return false;
+  if (page_offset >= GetMaxSupportedSize() || IsPageFreeLow(page_offset / 8, page_offset % 8)) {
+    return false;
+  }
+  bytes[page_offset / 8] &= static_cast<unsigned char>(~(1 << (page_offset % 8)));
+  page_allocated_--;
+  next_free_page_ = page_offset;
+  return true;
 }
 
 /**
@@ -23,12 +43,15 @@ bool BitmapPage<PageSize>::DeAllocatePage(uint32_t page_offset) {
  */
 template <size_t PageSize>
 bool BitmapPage<PageSize>::IsPageFree(uint32_t page_offset) const {
-  return false;
+  if (page_offset >= GetMaxSupportedSize()) {
+    return false;
+  }
+  return IsPageFreeLow(page_offset / 8, page_offset % 8);
 }
 
 template <size_t PageSize>
 bool BitmapPage<PageSize>::IsPageFreeLow(uint32_t byte_index, uint8_t bit_index) const {
-  return false;
+  return (bytes[byte_index] & (1 << bit_index)) == 0;
 }
 
 template class BitmapPage<64>;
@@ -0,0 +1,28 @@
+#include "page/brin_page.h"
+
+void BrinPage::Init(int key_size) {
+  key_size_ = key_size;
+  size_ = 0;
+  next_page_id_ = INVALID_PAGE_ID;
+  max_size_ = static_cast<int>(sizeof(data_)) / EntrySize();
+}
+
+void BrinPage::SetCountsAt(int index, uint32_t row_count, uint32_t null_count) {
+  memcpy(EntryPtrAt(index) + sizeof(uint32_t), &row_count, sizeof(uint32_t));
+  memcpy(EntryPtrAt(index) + 2 * sizeof(uint32_t), &null_count, sizeof(uint32_t));
+}
+
+GenericKey *BrinPage::MinKeyAt(int index) {
+  return reinterpret_cast<GenericKey *>(EntryPtrAt(index) + ENTRY_HEADER_SIZE);
+}
+
+GenericKey *BrinPage::MaxKeyAt(int index) {
+  return reinterpret_cast<GenericKey *>(EntryPtrAt(index) + ENTRY_HEADER_SIZE + key_size_);
+}
+
+int BrinPage::Append(uint32_t range_id) {
+  char *entry = EntryPtrAt(size_);
+  memset(entry, 0, EntrySize());
+  memcpy(entry, &range_id, sizeof(uint32_t));
+  return size_++;
+}
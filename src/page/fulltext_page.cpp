@@ -0,0 +1,63 @@
+#include "page/fulltext_page.h"
+
+bool PostingPage::Append(uint64_t value) {
+  // 页面上的第一个值直接存储，之后存储与前一个值的差
+  uint64_t delta = count_ == 0 ? value : value - last_value_;
+  char buf[10];
+  uint32_t length = 0;
+  do {
+    buf[length] = static_cast<char>(delta & 0x7f);
+    delta >>= 7;
+    if (delta != 0) {
+      buf[length] |= static_cast<char>(0x80);
+    }
+    length++;
+  } while (delta != 0);
+  if (size_ + length > sizeof(data_)) {
+    return false;
+  }
+  memcpy(data_ + size_, buf, length);
+  size_ += length;
+  count_++;
+  last_value_ = value;
+  return true;
+}
+
+void PostingPage::Decode(std::vector<uint64_t> &values) const {
+  uint64_t value = 0;
+  uint32_t offset = 0;
+  for (uint32_t i = 0; i < count_; i++) {
+    uint64_t delta = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      byte = static_cast<uint8_t>(data_[offset++]);
+      delta |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    value = i == 0 ? delta : value + delta;
+    values.push_back(value);
+  }
+}
+
+bool LexiconPage::Append(const std::string &token, page_id_t posting_page_id) {
+  uint32_t length = 1 + token.size() + sizeof(page_id_t);
+  if (token.size() > UINT8_MAX || size_ + length > sizeof(data_)) {
+    return false;
+  }
+  data_[size_] = static_cast<char>(token.size());
+  memcpy(data_ + size_ + 1, token.data(), token.size());
+  memcpy(data_ + size_ + 1 + token.size(), &posting_page_id, sizeof(page_id_t));
+  size_ += length;
+  return true;
+}
+
+int LexiconPage::ReadAt(int offset, std::string &token, page_id_t &posting_page_id) const {
+  if (offset < 0 || static_cast<uint32_t>(offset) >= size_) {
+    return -1;
+  }
+  auto length = static_cast<uint8_t>(data_[offset]);
+  token.assign(data_ + offset + 1, length);
+  memcpy(&posting_page_id, data_ + offset + 1 + length, sizeof(page_id_t));
+  return offset + 1 + length + static_cast<int>(sizeof(page_id_t));
+}
@@ -0,0 +1,62 @@
+#include "page/hash_table_bucket_page.h"
+
+void HashTableBucketPage::Init(int key_size, int max_size) {
+  key_size_ = key_size;
+  size_ = 0;
+  next_page_id_ = INVALID_PAGE_ID;
+  int capacity = static_cast<int>(sizeof(data_)) / PairSize();
+  max_size_ = (max_size <= 0 || max_size > capacity) ? capacity : max_size;
+}
+
+GenericKey *HashTableBucketPage::KeyAt(int index) { return reinterpret_cast<GenericKey *>(PairPtrAt(index)); }
+
+RowId HashTableBucketPage::ValueAt(int index) const {
+  RowId value;
+  memcpy(&value, data_ + index * PairSize() + key_size_, sizeof(RowId));
+  return value;
+}
+
+int HashTableBucketPage::KeyIndex(const GenericKey *key) {
+  for (int i = 0; i < size_; i++) {
+    if (memcmp(PairPtrAt(i), key, key_size_) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool HashTableBucketPage::Lookup(const GenericKey *key, RowId &value) {
+  int index = KeyIndex(key);
+  if (index == -1) {
+    return false;
+  }
+  value = ValueAt(index);
+  return true;
+}
+
+bool HashTableBucketPage::Insert(const GenericKey *key, const RowId &value) {
+  if (KeyIndex(key) != -1) {
+    return false;
+  }
+  char *pair = PairPtrAt(size_);
+  memcpy(pair, key, key_size_);
+  memcpy(pair + key_size_, &value, sizeof(RowId));
+  size_++;
+  return true;
+}
+
+void HashTableBucketPage::RemoveAt(int index) {
+  size_--;
+  if (index != size_) {
+    memcpy(PairPtrAt(index), PairPtrAt(size_), PairSize());
+  }
+}
+
+bool HashTableBucketPage::Remove(const GenericKey *key) {
+  int index = KeyIndex(key);
+  if (index == -1) {
+    return false;
+  }
+  RemoveAt(index);
+  return true;
+}
@@ -0,0 +1,56 @@
+#include "page/hash_table_directory_page.h"
+
+void HashTableDirectoryPage::Init(page_id_t page_id, uint32_t max_depth) {
+  page_id_ = page_id;
+  max_depth_ = max_depth > DIRECTORY_MAX_DEPTH ? DIRECTORY_MAX_DEPTH : max_depth;
+  global_depth_ = 0;
+  for (uint32_t i = 0; i < DIRECTORY_ARRAY_SIZE; i++) {
+    local_depths_[i] = 0;
+    bucket_page_ids_[i] = INVALID_PAGE_ID;
+  }
+}
+
+bool HashTableDirectoryPage::IncrGlobalDepth() {
+  if (global_depth_ >= max_depth_) {
+    return false;
+  }
+  uint32_t old_size = Size();
+  for (uint32_t i = 0; i < old_size; i++) {
+    local_depths_[i + old_size] = local_depths_[i];
+    bucket_page_ids_[i + old_size] = bucket_page_ids_[i];
+  }
+  global_depth_++;
+  return true;
+}
+
+void HashTableDirectoryPage::DecrGlobalDepth() {
+  if (global_depth_ == 0) {
+    return;
+  }
+  global_depth_--;
+  uint32_t new_size = Size();
+  for (uint32_t i = new_size; i < 2 * new_size; i++) {
+    local_depths_[i] = 0;
+    bucket_page_ids_[i] = INVALID_PAGE_ID;
+  }
+}
+
+bool HashTableDirectoryPage::CanShrink() const {
+  if (global_depth_ == 0) {
+    return false;
+  }
+  for (uint32_t i = 0; i < Size(); i++) {
+    if (local_depths_[i] >= global_depth_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t HashTableDirectoryPage::GetSplitImageIndex(uint32_t bucket_idx) const {
+  uint32_t local_depth = local_depths_[bucket_idx];
+  if (local_depth == 0) {
+    return bucket_idx;
+  }
+  return bucket_idx ^ (1U << (local_depth - 1));
+}
@@ -0,0 +1,9 @@
+#include "page/hash_table_header_page.h"
+
+void HashTableHeaderPage::Init(page_id_t page_id, uint32_t max_depth) {
+  page_id_ = page_id;
+  max_depth_ = max_depth > HTABLE_HEADER_MAX_DEPTH ? HTABLE_HEADER_MAX_DEPTH : max_depth;
+  for (uint32_t i = 0; i < HTABLE_HEADER_ARRAY_SIZE; i++) {
+    directory_page_ids_[i] = INVALID_PAGE_ID;
+  }
+}
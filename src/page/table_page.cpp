@@ -140,7 +140,8 @@ void TablePage::RollbackDelete(const RowId &rid, Txn *txn, LogManager *log_manag
   }
 }
 
-bool TablePage::GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_manager) {
+bool TablePage::GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_manager,
+                         const std::vector<bool> *needed_columns) {
   ASSERT(row != nullptr && row->GetRowId().Get() != INVALID_ROWID.Get(), "Invalid row.");
   // Get the current slot number.
   uint32_t slot_num = row->GetRowId().GetSlotNum();
@@ -156,7 +157,9 @@ bool TablePage::GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_m
   }
   // At this point, we have at least a shared lock on the RID. Copy the tuple data into our result.
   uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
-  uint32_t __attribute__((unused)) read_bytes = row->DeserializeFrom(GetData() + tuple_offset, schema);
+  uint32_t __attribute__((unused)) read_bytes =
+      needed_columns == nullptr ? row->DeserializeFrom(GetData() + tuple_offset, schema)
+                                : row->DeserializeColumns(GetData() + tuple_offset, schema, *needed_columns);
   ASSERT(tuple_size == read_bytes, "Unexpected behavior in tuple deserialize.");
   return true;
 }
@@ -582,7 +582,36 @@ char *yytext;
     #include "parser/minisql_yacc.h"
     int yywrap();
     extern YYSTYPE yylval;
-#line 585 "../../parser/minisql_lex.c"
+
+    /* keywords resolved by the identifier rule instead of a dedicated pattern */
+    static const struct {
+      const char *name;
+      int token;
+    } identifier_keywords[] = {
+        {"include", INCLUDE},
+        {"match", MATCH},
+        {"like", LIKE},
+        {"in", IN},
+        {"by", BY},
+        {"concurrently", CONCURRENTLY},
+        {"join", JOIN},
+        {"group", GROUP},
+        {"order", ORDER},
+        {"asc", ASC},
+        {"desc", DESC},
+        {"limit", LIMIT},
+        {"offset", OFFSET},
+    };
+
+    static int LookupIdentifierKeyword(const char *text) {
+      for (size_t i = 0; i < sizeof(identifier_keywords) / sizeof(identifier_keywords[0]); i++) {
+        if (strcmp(text, identifier_keywords[i].name) == 0) {
+          return identifier_keywords[i].token;
+        }
+      }
+      return 0;
+    }
+#line 602 "../../parser/minisql_lex.c"
 
 #define INITIAL 0
 
@@ -764,10 +793,10 @@ YY_DECL
 	register char *yy_cp, *yy_bp;
 	register int yy_act;
     
-#line 15 "minisql.l"
+#line 32 "minisql.l"
 
 
-#line 770 "../../parser/minisql_lex.c"
+#line 787 "../../parser/minisql_lex.c"
 
 	if ( !(yy_init) )
 		{
@@ -863,7 +892,7 @@ do_action:	/* This label is used only to access EOF actions. */
 case 1:
 /* rule 1 can match eol */
 YY_RULE_SETUP
-#line 17 "minisql.l"
+#line 34 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   yylval.syntax_node = CreateSyntaxNode(kNodeString, yytext);
@@ -872,7 +901,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 23 "minisql.l"
+#line 40 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return CREATE;
@@ -880,7 +909,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 28 "minisql.l"
+#line 45 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return DROP;
@@ -888,7 +917,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 33 "minisql.l"
+#line 50 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return SELECT;
@@ -896,7 +925,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 38 "minisql.l"
+#line 55 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return INSERT;
@@ -904,7 +933,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 43 "minisql.l"
+#line 60 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return DELETE;
@@ -912,7 +941,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 48 "minisql.l"
+#line 65 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return UPDATE;
@@ -920,7 +949,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 53 "minisql.l"
+#line 70 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return TRXBEGIN;
@@ -928,7 +957,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 58 "minisql.l"
+#line 75 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return TRXCOMMIT;
@@ -936,7 +965,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 63 "minisql.l"
+#line 80 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return TRXROLLBACK;
@@ -944,7 +973,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 68 "minisql.l"
+#line 85 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return QUIT;
@@ -952,7 +981,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 73 "minisql.l"
+#line 90 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return EXECFILE;
@@ -960,7 +989,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 78 "minisql.l"
+#line 95 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return SHOW;
@@ -968,7 +997,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 83 "minisql.l"
+#line 100 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return USE;
@@ -976,7 +1005,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 88 "minisql.l"
+#line 105 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return USING;
@@ -984,7 +1013,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 93 "minisql.l"
+#line 110 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return DATABASE;
@@ -992,7 +1021,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 98 "minisql.l"
+#line 115 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return DATABASES;
@@ -1000,7 +1029,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 103 "minisql.l"
+#line 120 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return TABLE;
@@ -1008,7 +1037,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 108 "minisql.l"
+#line 125 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return TABLES;
@@ -1016,7 +1045,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 113 "minisql.l"
+#line 130 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return INDEX;
@@ -1024,7 +1053,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 118 "minisql.l"
+#line 135 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return INDEXES;
@@ -1032,7 +1061,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 123 "minisql.l"
+#line 140 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ON;
@@ -1040,7 +1069,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 128 "minisql.l"
+#line 145 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return FROM;
@@ -1048,7 +1077,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 133 "minisql.l"
+#line 150 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return WHERE;
@@ -1056,7 +1085,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 138 "minisql.l"
+#line 155 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return INTO;
@@ -1064,7 +1093,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 143 "minisql.l"
+#line 160 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return SET;
@@ -1072,7 +1101,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 148 "minisql.l"
+#line 165 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return VALUES;
@@ -1080,7 +1109,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 153 "minisql.l"
+#line 170 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return PRIMARY;
@@ -1088,7 +1117,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 158 "minisql.l"
+#line 175 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return KEY;
@@ -1096,7 +1125,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 163 "minisql.l"
+#line 180 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return UNIQUE;
@@ -1104,7 +1133,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 168 "minisql.l"
+#line 185 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return CHAR;
@@ -1112,7 +1141,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 173 "minisql.l"
+#line 190 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return INT;
@@ -1120,7 +1149,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 178 "minisql.l"
+#line 195 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return FLOAT;
@@ -1128,7 +1157,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 183 "minisql.l"
+#line 200 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return AND;
@@ -1136,7 +1165,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 188 "minisql.l"
+#line 205 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return OR;
@@ -1144,7 +1173,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 193 "minisql.l"
+#line 210 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return NOT;
@@ -1152,7 +1181,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
-#line 198 "minisql.l"
+#line 215 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return IS;
@@ -1160,7 +1189,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 203 "minisql.l"
+#line 220 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return FLAGNULL;
@@ -1168,16 +1197,20 @@ YY_RULE_SETUP
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 208 "minisql.l"
+#line 225 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
+  int keyword = LookupIdentifierKeyword(yytext);
+  if (keyword != 0) {
+    return keyword;
+  }
   yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
   return IDENTIFIER;
 }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 214 "minisql.l"
+#line 235 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
@@ -1186,7 +1219,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 220 "minisql.l"
+#line 241 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
@@ -1195,7 +1228,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 226 "minisql.l"
+#line 247 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return EQ;
@@ -1203,7 +1236,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 231 "minisql.l"
+#line 252 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return NE;
@@ -1211,7 +1244,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 236 "minisql.l"
+#line 257 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return LE;
@@ -1219,7 +1252,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 241 "minisql.l"
+#line 262 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return GE;
@@ -1227,7 +1260,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 246 "minisql.l"
+#line 267 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return (',');
@@ -1235,7 +1268,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 251 "minisql.l"
+#line 272 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ('*');
@@ -1243,7 +1276,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
-#line 256 "minisql.l"
+#line 277 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return (';');
@@ -1251,7 +1284,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 49:
 YY_RULE_SETUP
-#line 261 "minisql.l"
+#line 282 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ('\'');
@@ -1259,7 +1292,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 50:
 YY_RULE_SETUP
-#line 266 "minisql.l"
+#line 287 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ('<');
@@ -1267,7 +1300,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 51:
 YY_RULE_SETUP
-#line 271 "minisql.l"
+#line 292 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ('>');
@@ -1275,7 +1308,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 52:
 YY_RULE_SETUP
-#line 276 "minisql.l"
+#line 297 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ('(');
@@ -1283,7 +1316,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 53:
 YY_RULE_SETUP
-#line 281 "minisql.l"
+#line 302 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return (')');
@@ -1292,15 +1325,19 @@ YY_RULE_SETUP
 case 54:
 /* rule 54 can match eol */
 YY_RULE_SETUP
-#line 286 "minisql.l"
+#line 307 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
 }
 	YY_BREAK
 case 55:
 YY_RULE_SETUP
-#line 290 "minisql.l"
+#line 311 "minisql.l"
 {
+  if (yytext[0] == '.') {
+    MinisqlParserMovePos(yylineno, yytext);
+    return ('.');
+  }
   char str[128] = {0};
   sprintf(str, "Unrecognized token [%s] in input sql.", yytext);
   MinisqlParserSetError(str);
@@ -1308,10 +1345,10 @@ YY_RULE_SETUP
 	YY_BREAK
 case 56:
 YY_RULE_SETUP
-#line 296 "minisql.l"
+#line 317 "minisql.l"
 ECHO;
 	YY_BREAK
-#line 1314 "../../parser/minisql_lex.c"
+#line 1335 "../../parser/minisql_lex.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -2320,7 +2357,7 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 296 "minisql.l"
+#line 317 "minisql.l"
 
 
 int yywrap() {
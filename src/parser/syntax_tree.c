@@ -171,6 +171,20 @@ const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
       return "kNodeTrxCommit";
     case kNodeTrxRollback:
       return "kNodeTrxRollback";
+    case kNodeIndexInclude:
+      return "kNodeIndexInclude";
+    case kNodeJoin:
+      return "kNodeJoin";
+    case kNodeFunction:
+      return "kNodeFunction";
+    case kNodeGroupBy:
+      return "kNodeGroupBy";
+    case kNodeOrderBy:
+      return "kNodeOrderBy";
+    case kNodeOrderItem:
+      return "kNodeOrderItem";
+    case kNodeLimit:
+      return "kNodeLimit";
     default:
       return "error type";
   }
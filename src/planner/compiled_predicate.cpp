@@ -0,0 +1,383 @@
+#include "planner/expressions/compiled_predicate.h"
+
+#include <algorithm>
+
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+
+namespace {
+/** The operator of a comparison string, false for the ones without a comparison kernel. */
+bool ParseCmpOp(const std::string &comp_type, CompiledPredicate::CmpOp &op) {
+  using CmpOp = CompiledPredicate::CmpOp;
+  static const std::pair<const char *, CmpOp> ops[] = {{"=", CmpOp::Eq}, {"<>", CmpOp::Ne}, {"<", CmpOp::Lt},
+                                                       {"<=", CmpOp::Le}, {">", CmpOp::Gt}, {">=", CmpOp::Ge}};
+  for (const auto &entry : ops) {
+    if (comp_type == entry.first) {
+      op = entry.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+/** @return op with its sides swapped, a < b is b > a */
+CompiledPredicate::CmpOp Mirror(CompiledPredicate::CmpOp op) {
+  using CmpOp = CompiledPredicate::CmpOp;
+  switch (op) {
+    case CmpOp::Lt:
+      return CmpOp::Gt;
+    case CmpOp::Le:
+      return CmpOp::Ge;
+    case CmpOp::Gt:
+      return CmpOp::Lt;
+    case CmpOp::Ge:
+      return CmpOp::Le;
+    default:
+      return op;
+  }
+}
+
+template <CompiledPredicate::CmpOp op, typename T>
+inline bool Apply(const T &lhs, const T &rhs) {
+  using CmpOp = CompiledPredicate::CmpOp;
+  if constexpr (op == CmpOp::Eq) {
+    return lhs == rhs;
+  } else if constexpr (op == CmpOp::Ne) {
+    return lhs != rhs;
+  } else if constexpr (op == CmpOp::Lt) {
+    return lhs < rhs;
+  } else if constexpr (op == CmpOp::Le) {
+    return lhs <= rhs;
+  } else if constexpr (op == CmpOp::Gt) {
+    return lhs > rhs;
+  } else {
+    return lhs >= rhs;
+  }
+}
+}  // namespace
+
+template <>
+int32_t CompiledPredicate::Read<int32_t>(const Field &field) {
+  return field.GetIntValue();
+}
+
+template <>
+float CompiledPredicate::Read<float>(const Field &field) {
+  return field.GetFloatValue();
+}
+
+/** A char field compares like memcmp over the common length and then by length, as a std::string_view does. */
+template <>
+std::string_view CompiledPredicate::Read<std::string_view>(const Field &field) {
+  return {field.GetCharData(), field.GetCharLength()};
+}
+
+template <>
+int32_t CompiledPredicate::Constant<int32_t>(const Instruction &instruction) {
+  return instruction.int_;
+}
+
+template <>
+float CompiledPredicate::Constant<float>(const Instruction &instruction) {
+  return instruction.float_;
+}
+
+template <>
+std::string_view CompiledPredicate::Constant<std::string_view>(const Instruction &instruction) {
+  return instruction.chars_;
+}
+
+template <>
+const std::vector<int32_t> &CompiledPredicate::Constants<int32_t>(const Instruction &instruction) {
+  return instruction.ints_;
+}
+
+template <>
+const std::vector<float> &CompiledPredicate::Constants<float>(const Instruction &instruction) {
+  return instruction.floats_;
+}
+
+template <>
+const std::vector<std::string> &CompiledPredicate::Constants<std::string>(const Instruction &instruction) {
+  return instruction.strings_;
+}
+
+template <typename T, CompiledPredicate::CmpOp op>
+CmpBool CompiledPredicate::ColumnConstantKernel(const Instruction &instruction, const Row *row) {
+  const Field *field = row->GetField(instruction.lhs_column_);
+  if (field->IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(Apply<op>(Read<T>(*field), Constant<T>(instruction)));
+}
+
+template <typename T, CompiledPredicate::CmpOp op>
+CmpBool CompiledPredicate::ColumnColumnKernel(const Instruction &instruction, const Row *row) {
+  const Field *lhs = row->GetField(instruction.lhs_column_);
+  const Field *rhs = row->GetField(instruction.rhs_column_);
+  if (lhs->IsNull() || rhs->IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(Apply<op>(Read<T>(*lhs), Read<T>(*rhs)));
+}
+
+template <typename T>
+CmpBool CompiledPredicate::InKernel(const Instruction &instruction, const Row *row) {
+  const Field *field = row->GetField(instruction.lhs_column_);
+  if (field->IsNull()) {
+    return CmpBool::kNull;
+  }
+  const auto &values = Constants<T>(instruction);
+  if constexpr (std::is_same_v<T, std::string>) {
+    auto value = Read<std::string_view>(*field);
+    auto it = std::lower_bound(values.begin(), values.end(), value,
+                               [](const std::string &lhs, std::string_view rhs) { return std::string_view(lhs) < rhs; });
+    if (it != values.end() && std::string_view(*it) == value) {
+      return CmpBool::kTrue;
+    }
+  } else {
+    if (std::binary_search(values.begin(), values.end(), Read<T>(*field))) {
+      return CmpBool::kTrue;
+    }
+  }
+  return instruction.has_null_ ? CmpBool::kNull : CmpBool::kFalse;
+}
+
+template <bool is_null>
+CmpBool CompiledPredicate::NullKernel(const Instruction &instruction, const Row *row) {
+  return GetCmpBool(row->GetField(instruction.lhs_column_)->IsNull() == is_null);
+}
+
+CmpBool CompiledPredicate::InterpretKernel(const Instruction &instruction, const Row *row) {
+  Field result = instruction.expr_->Evaluate(row);
+  if (result.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return result.CompareEquals(Field(kTypeInt, 1)) == CmpBool::kTrue ? CmpBool::kTrue : CmpBool::kFalse;
+}
+
+template <typename T>
+CompiledPredicate::Kernel CompiledPredicate::ColumnConstantKernelFor(CmpOp op) {
+  switch (op) {
+    case CmpOp::Eq:
+      return &ColumnConstantKernel<T, CmpOp::Eq>;
+    case CmpOp::Ne:
+      return &ColumnConstantKernel<T, CmpOp::Ne>;
+    case CmpOp::Lt:
+      return &ColumnConstantKernel<T, CmpOp::Lt>;
+    case CmpOp::Le:
+      return &ColumnConstantKernel<T, CmpOp::Le>;
+    case CmpOp::Gt:
+      return &ColumnConstantKernel<T, CmpOp::Gt>;
+    default:
+      return &ColumnConstantKernel<T, CmpOp::Ge>;
+  }
+}
+
+template <typename T>
+CompiledPredicate::Kernel CompiledPredicate::ColumnColumnKernelFor(CmpOp op) {
+  switch (op) {
+    case CmpOp::Eq:
+      return &ColumnColumnKernel<T, CmpOp::Eq>;
+    case CmpOp::Ne:
+      return &ColumnColumnKernel<T, CmpOp::Ne>;
+    case CmpOp::Lt:
+      return &ColumnColumnKernel<T, CmpOp::Lt>;
+    case CmpOp::Le:
+      return &ColumnColumnKernel<T, CmpOp::Le>;
+    case CmpOp::Gt:
+      return &ColumnColumnKernel<T, CmpOp::Gt>;
+    default:
+      return &ColumnColumnKernel<T, CmpOp::Ge>;
+  }
+}
+
+std::shared_ptr<const CompiledPredicate> CompiledPredicate::Compile(const AbstractExpressionRef &expr) {
+  if (expr == nullptr) {
+    return nullptr;
+  }
+  auto predicate = std::make_shared<CompiledPredicate>();
+  predicate->Emit(expr);
+  // replay the stack effect of the program to size the stack of Evaluate
+  size_t depth = 0;
+  for (const auto &instruction : predicate->program_) {
+    if (instruction.code_ == OpCode::Leaf) {
+      predicate->max_depth_ = std::max(predicate->max_depth_, ++depth);
+    } else if (instruction.code_ == OpCode::And || instruction.code_ == OpCode::Or) {
+      depth--;
+    }
+  }
+  return predicate;
+}
+
+void CompiledPredicate::Emit(const AbstractExpressionRef &expr) {
+  if (expr->GetType() == ExpressionType::LogicExpression) {
+    bool is_and = dynamic_cast<LogicExpression *>(expr.get())->logic_type_ == LogicType::And;
+    // the left side alone decides an "and" that is false and an "or" that is true
+    Emit(expr->GetChildAt(0));
+    size_t jump = program_.size();
+    program_.emplace_back();
+    program_[jump].code_ = is_and ? OpCode::AndJump : OpCode::OrJump;
+    Emit(expr->GetChildAt(1));
+    program_.emplace_back();
+    program_.back().code_ = is_and ? OpCode::And : OpCode::Or;
+    program_[jump].target_ = program_.size();
+    return;
+  }
+  if (expr->GetType() == ExpressionType::ComparisonExpression && EmitComparison(expr)) {
+    return;
+  }
+  program_.emplace_back();
+  program_.back().kernel_ = &InterpretKernel;
+  program_.back().expr_ = expr;
+}
+
+bool CompiledPredicate::EmitComparison(const AbstractExpressionRef &comparison) {
+  auto comp_type = dynamic_cast<ComparisonExpression *>(comparison.get())->GetComparisonType();
+  const auto &children = comparison->GetChildren();
+  auto is_column = [](const AbstractExpressionRef &child) {
+    return child->GetType() == ExpressionType::ColumnExpression;
+  };
+  auto is_constant = [](const AbstractExpressionRef &child) {
+    return child->GetType() == ExpressionType::ConstantExpression;
+  };
+  auto column_of = [](const AbstractExpressionRef &child) {
+    return dynamic_cast<ColumnValueExpression *>(child.get())->GetColIdx();
+  };
+  auto value_of = [](const AbstractExpressionRef &child) -> const Field & {
+    return dynamic_cast<ConstantValueExpression *>(child.get())->val_;
+  };
+  Instruction instruction;
+  if (comp_type == "is" || comp_type == "not") {
+    if (!is_column(children[0])) {
+      return false;
+    }
+    instruction.lhs_column_ = column_of(children[0]);
+    instruction.kernel_ = comp_type == "is" ? &NullKernel<true> : &NullKernel<false>;
+    program_.push_back(std::move(instruction));
+    return true;
+  }
+  TypeId type = children[0]->GetReturnType();
+  if (comp_type == "in") {
+    if (!is_column(children[0])) {
+      return false;
+    }
+    instruction.lhs_column_ = column_of(children[0]);
+    for (size_t i = 1; i < children.size(); i++) {
+      if (!is_constant(children[i]) || children[i]->GetReturnType() != type) {
+        return false;
+      }
+      const Field &value = value_of(children[i]);
+      if (value.IsNull()) {
+        instruction.has_null_ = true;
+      } else if (type == TypeId::kTypeInt) {
+        instruction.ints_.push_back(value.GetIntValue());
+      } else if (type == TypeId::kTypeFloat) {
+        instruction.floats_.push_back(value.GetFloatValue());
+      } else {
+        instruction.strings_.emplace_back(value.GetCharData(), value.GetCharLength());
+      }
+    }
+    std::sort(instruction.ints_.begin(), instruction.ints_.end());
+    std::sort(instruction.floats_.begin(), instruction.floats_.end());
+    std::sort(instruction.strings_.begin(), instruction.strings_.end());
+    instruction.kernel_ = type == TypeId::kTypeInt     ? &InKernel<int32_t>
+                          : type == TypeId::kTypeFloat ? &InKernel<float>
+                                                       : &InKernel<std::string>;
+    program_.push_back(std::move(instruction));
+    return true;
+  }
+  CmpOp op;
+  if (children.size() != 2 || !ParseCmpOp(comp_type, op) || children[1]->GetReturnType() != type ||
+      (type != TypeId::kTypeInt && type != TypeId::kTypeFloat && type != TypeId::kTypeChar)) {
+    return false;
+  }
+  if (is_column(children[0]) && is_column(children[1])) {
+    instruction.lhs_column_ = column_of(children[0]);
+    instruction.rhs_column_ = column_of(children[1]);
+    instruction.kernel_ = type == TypeId::kTypeInt     ? ColumnColumnKernelFor<int32_t>(op)
+                          : type == TypeId::kTypeFloat ? ColumnColumnKernelFor<float>(op)
+                                                       : ColumnColumnKernelFor<std::string_view>(op);
+    program_.push_back(std::move(instruction));
+    return true;
+  }
+  // a constant on the left is moved to the right, 5 < id is id > 5
+  size_t column = is_column(children[0]) ? 0 : 1;
+  if (!is_column(children[column]) || !is_constant(children[1 - column])) {
+    return false;
+  }
+  const Field &value = value_of(children[1 - column]);
+  if (value.IsNull()) {
+    return false;
+  }
+  if (column == 1) {
+    op = Mirror(op);
+  }
+  instruction.lhs_column_ = column_of(children[column]);
+  if (type == TypeId::kTypeInt) {
+    instruction.int_ = value.GetIntValue();
+    instruction.kernel_ = ColumnConstantKernelFor<int32_t>(op);
+  } else if (type == TypeId::kTypeFloat) {
+    instruction.float_ = value.GetFloatValue();
+    instruction.kernel_ = ColumnConstantKernelFor<float>(op);
+  } else {
+    instruction.chars_.assign(value.GetCharData(), value.GetCharLength());
+    instruction.kernel_ = ColumnConstantKernelFor<std::string_view>(op);
+  }
+  program_.push_back(std::move(instruction));
+  return true;
+}
+
+CmpBool CompiledPredicate::Evaluate(const Row *row) const {
+  constexpr size_t LOCAL_DEPTH = 16;
+  CmpBool local[LOCAL_DEPTH];
+  std::vector<CmpBool> heap;
+  CmpBool *stack = local;
+  if (max_depth_ > LOCAL_DEPTH) {
+    heap.resize(max_depth_);
+    stack = heap.data();
+  }
+  size_t top = 0;
+  for (size_t pc = 0; pc < program_.size(); pc++) {
+    const Instruction &instruction = program_[pc];
+    switch (instruction.code_) {
+      case OpCode::Leaf:
+        stack[top++] = instruction.kernel_(instruction, row);
+        break;
+      case OpCode::AndJump:
+        if (stack[top - 1] == CmpBool::kFalse) {
+          pc = instruction.target_ - 1;
+        }
+        break;
+      case OpCode::OrJump:
+        if (stack[top - 1] == CmpBool::kTrue) {
+          pc = instruction.target_ - 1;
+        }
+        break;
+      case OpCode::And: {
+        CmpBool rhs = stack[--top];
+        CmpBool lhs = stack[top - 1];
+        stack[top - 1] = lhs == CmpBool::kFalse || rhs == CmpBool::kFalse ? CmpBool::kFalse
+                         : lhs == CmpBool::kTrue && rhs == CmpBool::kTrue ? CmpBool::kTrue
+                                                                          : CmpBool::kNull;
+        break;
+      }
+      case OpCode::Or: {
+        CmpBool rhs = stack[--top];
+        CmpBool lhs = stack[top - 1];
+        stack[top - 1] = lhs == CmpBool::kTrue || rhs == CmpBool::kTrue     ? CmpBool::kTrue
+                         : lhs == CmpBool::kFalse && rhs == CmpBool::kFalse ? CmpBool::kFalse
+                                                                            : CmpBool::kNull;
+        break;
+      }
+    }
+  }
+  return stack[0];
+}
+
+size_t CompiledPredicate::GetInterpretedCount() const {
+  return std::count_if(program_.begin(), program_.end(),
+                       [](const Instruction &instruction) { return instruction.kernel_ == &InterpretKernel; });
+}
@@ -3,6 +3,11 @@
 //
 #include "planner/planner.h"
 
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
 void Planner::PlanQuery(pSyntaxNode ast) {
   switch (ast->type_) {
     case kNodeSelect: {
@@ -33,26 +38,757 @@ void Planner::PlanQuery(pSyntaxNode ast) {
       throw std::logic_error("the statement is not supported in planner yet");
   }
 }
+/**
+ * Collect the compare operators applied to every column in the predicate.
+ */
+static void CollectCompareOperators(const AbstractExpressionRef &predicate,
+                                    std::unordered_map<uint32_t, std::vector<std::string>> &operators) {
+  if (predicate == nullptr) {
+    return;
+  }
+  if (predicate->GetType() == ExpressionType::ComparisonExpression) {
+    if (!dynamic_pointer_cast<ComparisonExpression>(predicate)->ComparesToConstants()) {
+      return;
+    }
+    uint32_t col_idx = dynamic_pointer_cast<ColumnValueExpression>(predicate->GetChildAt(0))->GetColIdx();
+    auto compare_operator = dynamic_pointer_cast<ComparisonExpression>(predicate)->GetComparisonType();
+    if (compare_operator == "like") {
+      // only a pattern starting with literal characters bounds an index range
+      Field pattern = predicate->GetChildAt(1)->Evaluate(nullptr);
+      if (pattern.IsNull() || ComparisonExpression::LikePrefix(pattern.GetData(), pattern.GetLength()).empty()) {
+        return;
+      }
+    }
+    operators[col_idx].push_back(compare_operator);
+    return;
+  }
+  for (const auto &child : predicate->GetChildren()) {
+    CollectCompareOperators(child, operators);
+  }
+}
+
+/**
+ * @return true if bitmap indexes on bitmap_columns narrow down the rows of predicate: every comparison of an "or"
+ * is on such a column and so is at least one comparison of an "and". A bitmap index only answers the comparison
+ * operators and "in" with constants of the type of its column, like and match need the rows themselves.
+ */
+static bool CoveredByBitmaps(const AbstractExpressionRef &predicate,
+                             const std::unordered_set<uint32_t> &bitmap_columns) {
+  if (predicate->GetType() == ExpressionType::ComparisonExpression) {
+    auto comparison = dynamic_pointer_cast<ComparisonExpression>(predicate);
+    if (!comparison->ComparesToConstants()) {
+      return false;
+    }
+    static const std::unordered_set<std::string> bitmap_operators{"=", "<>", "<", "<=", ">", ">=", "is", "not", "in"};
+    const auto &compare_operator = comparison->GetComparisonType();
+    if (bitmap_operators.count(compare_operator) == 0) {
+      return false;
+    }
+    auto column = predicate->GetChildAt(0);
+    if (compare_operator != "is" && compare_operator != "not") {
+      for (size_t i = 1; i < predicate->GetChildren().size(); i++) {
+        if (predicate->GetChildAt(i)->Evaluate(nullptr).GetTypeId() != column->GetReturnType()) {
+          return false;
+        }
+      }
+    }
+    uint32_t col_idx = dynamic_pointer_cast<ColumnValueExpression>(column)->GetColIdx();
+    return bitmap_columns.count(col_idx) > 0;
+  }
+  if (predicate->GetType() != ExpressionType::LogicExpression) {
+    return false;
+  }
+  bool lhs = CoveredByBitmaps(predicate->GetChildAt(0), bitmap_columns);
+  bool rhs = CoveredByBitmaps(predicate->GetChildAt(1), bitmap_columns);
+  if (dynamic_pointer_cast<LogicExpression>(predicate)->logic_type_ == LogicType::And) {
+    return lhs || rhs;
+  }
+  return lhs && rhs;
+}
+
+/**
+ * Collect the operands of the top level "and"s of predicate.
+ */
+static void SplitConjuncts(const AbstractExpressionRef &predicate, std::vector<AbstractExpressionRef> &conjuncts) {
+  if (predicate == nullptr) {
+    return;
+  }
+  if (predicate->GetType() == ExpressionType::LogicExpression &&
+      dynamic_pointer_cast<LogicExpression>(predicate)->logic_type_ == LogicType::And) {
+    SplitConjuncts(predicate->GetChildAt(0), conjuncts);
+    SplitConjuncts(predicate->GetChildAt(1), conjuncts);
+    return;
+  }
+  conjuncts.push_back(predicate);
+}
+
+/**
+ * Collect the columns predicate reads and whether it has an "or".
+ */
+static void CollectColumns(const AbstractExpressionRef &predicate, std::vector<uint32_t> &columns, bool &has_or) {
+  if (predicate->GetType() == ExpressionType::ColumnExpression) {
+    uint32_t col_idx = dynamic_pointer_cast<ColumnValueExpression>(predicate)->GetColIdx();
+    if (std::find(columns.begin(), columns.end(), col_idx) == columns.end()) {
+      columns.push_back(col_idx);
+    }
+    return;
+  }
+  if (predicate->GetType() == ExpressionType::LogicExpression &&
+      dynamic_pointer_cast<LogicExpression>(predicate)->logic_type_ == LogicType::Or) {
+    has_or = true;
+  }
+  for (const auto &child : predicate->GetChildren()) {
+    CollectColumns(child, columns, has_or);
+  }
+}
+
+/**
+ * Copy predicate with every column rebound by rebind, which maps a column index to a (row index, column index) pair.
+ */
+static AbstractExpressionRef RebindColumns(const AbstractExpressionRef &predicate,
+                                           const std::function<std::pair<uint32_t, uint32_t>(uint32_t)> &rebind) {
+  switch (predicate->GetType()) {
+    case ExpressionType::ColumnExpression: {
+      auto bound = rebind(dynamic_pointer_cast<ColumnValueExpression>(predicate)->GetColIdx());
+      return std::make_shared<ColumnValueExpression>(bound.first, bound.second, predicate->GetReturnType());
+    }
+    case ExpressionType::ComparisonExpression: {
+      std::vector<AbstractExpressionRef> children;
+      for (const auto &child : predicate->GetChildren()) {
+        children.push_back(RebindColumns(child, rebind));
+      }
+      return std::make_shared<ComparisonExpression>(
+          std::move(children), dynamic_pointer_cast<ComparisonExpression>(predicate)->GetComparisonType());
+    }
+    case ExpressionType::LogicExpression:
+      return std::make_shared<LogicExpression>(RebindColumns(predicate->GetChildAt(0), rebind),
+                                               RebindColumns(predicate->GetChildAt(1), rebind),
+                                               dynamic_pointer_cast<LogicExpression>(predicate)->logic_type_);
+    default:
+      return predicate;
+  }
+}
+
+static AbstractExpressionRef MakeConjunction(const AbstractExpressionRef &lhs, const AbstractExpressionRef &rhs) {
+  return lhs == nullptr ? rhs : std::make_shared<LogicExpression>(lhs, rhs, LogicType::And);
+}
+
+/**
+ * There are no table statistics, a plan counts as selective when it can only produce a few rows: a point lookup on
+ * the leading key column of an index, a fulltext or bitmap lookup, or an index join driven by such a plan.
+ */
+static bool IsSelective(const AbstractPlanNodeRef &plan) {
+  switch (plan->GetType()) {
+    case PlanType::BitmapScan:
+      return true;
+    case PlanType::IndexScan: {
+      auto index_scan = dynamic_pointer_cast<const IndexScanPlanNode>(plan);
+      IndexInfo *index = index_scan->indexes_.front();
+      if (index->IsFullTextIndex()) {
+        return true;
+      }
+      std::unordered_map<uint32_t, std::vector<std::string>> operators;
+      CollectCompareOperators(index_scan->GetPredicate(), operators);
+      const auto &ops = operators[index->GetIndexKeySchema()->GetColumn(0)->GetTableInd()];
+      return std::any_of(ops.begin(), ops.end(), [](const std::string &op) { return op == "=" || op == "in"; });
+    }
+    case PlanType::IndexNestedLoopJoin:
+      return IsSelective(dynamic_pointer_cast<const IndexNestedLoopJoinPlanNode>(plan)->GetOuterPlan());
+    default:
+      return false;
+  }
+}
+
+/**
+ * @return the position of the output column a plan produces its rows in ascending order of, -1 if there is none.
+ * A single B+ tree index scan walks its leaves in the order of the leading key column, an in list is looked up
+ * value by value and loses that order.
+ */
+static int SortedColumn(const AbstractPlanNodeRef &plan) {
+  uint32_t col_idx;
+  switch (plan->GetType()) {
+    case PlanType::IndexScan: {
+      auto index_scan = dynamic_pointer_cast<const IndexScanPlanNode>(plan);
+      IndexInfo *index = index_scan->indexes_.front();
+      if (index_scan->indexes_.size() != 1 || !index->IsBPlusTreeIndex()) {
+        return -1;
+      }
+      std::unordered_map<uint32_t, std::vector<std::string>> operators;
+      CollectCompareOperators(index_scan->GetPredicate(), operators);
+      for (const auto &ops : operators) {
+        if (std::find(ops.second.begin(), ops.second.end(), "in") != ops.second.end()) {
+          return -1;
+        }
+      }
+      col_idx = index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
+      break;
+    }
+    case PlanType::MergeJoin:
+      col_idx = dynamic_pointer_cast<const ColumnValueExpression>(
+                    dynamic_pointer_cast<const MergeJoinPlanNode>(plan)->GetLeftKey())
+                    ->GetColIdx();
+      break;
+    case PlanType::Sort: {
+      const auto &order_by = dynamic_pointer_cast<const SortPlanNode>(plan)->GetOrderBy().front();
+      if (order_by.first != OrderByType::Asc || order_by.second->GetType() != ExpressionType::ColumnExpression) {
+        return -1;
+      }
+      col_idx = dynamic_pointer_cast<const ColumnValueExpression>(order_by.second)->GetColIdx();
+      break;
+    }
+    default:
+      return -1;
+  }
+  const auto &columns = plan->OutputSchema()->GetColumns();
+  for (uint32_t i = 0; i < columns.size(); i++) {
+    if (columns[i]->GetTableInd() == col_idx) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+/**
+ * @return true if the key columns of index start with the keys of order_by, all ascending. Null keys sort first
+ * in a B+ tree like in a sort.
+ */
+static bool IndexMatchesOrder(IndexInfo *index,
+                              const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_by) {
+  if (!index->IsBPlusTreeIndex() || order_by.size() > index->GetKeyColumnCount()) {
+    return false;
+  }
+  for (size_t i = 0; i < order_by.size(); i++) {
+    if (order_by[i].first != OrderByType::Asc || order_by[i].second->GetType() != ExpressionType::ColumnExpression ||
+        dynamic_pointer_cast<ColumnValueExpression>(order_by[i].second)->GetColIdx() !=
+            index->GetIndexKeySchema()->GetColumn(i)->GetTableInd()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @return true if an "in" list on a key column of index would make the index scan look its values up one by one */
+static bool HasInListOnKey(IndexInfo *index, const AbstractExpressionRef &predicate) {
+  std::unordered_map<uint32_t, std::vector<std::string>> operators;
+  CollectCompareOperators(predicate, operators);
+  for (auto column : index->GetIndexKeySchema()->GetColumns()) {
+    const auto &ops = operators[column->GetTableInd()];
+    if (std::find(ops.begin(), ops.end(), "in") != ops.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 AbstractPlanNodeRef Planner::PlanSelect(std::shared_ptr<SelectStatement> statement) {
-  auto out_schema = MakeOutputSchema(statement->column_list_);
+  bool aggregation = !statement->group_by_.empty() || !statement->aggregates_.empty();
+  bool ordered = !statement->order_by_.empty();
+  CollectNeededColumns(statement, aggregation);
+  auto output_schema = MakeOutputSchema(statement->column_list_);
+  TableInfo *info = nullptr;
+  context_->GetCatalog()->GetTable(statement->table_name_, info);
+  bool single_table = statement->table_names_.size() == 1;
+  if (!aggregation) {
+    if (!single_table && !ordered) {
+      return PlanLimit(statement, PlanJoin(statement, output_schema));
+    }
+    if (single_table) {
+      auto scan = PlanScan(statement->table_name_, output_schema, statement->where_,
+                           statement->column_in_condition_, statement->has_or);
+      // a single B+ tree index scan already returns its rows in key order
+      if (!ordered || (scan->GetType() == PlanType::IndexScan &&
+                       dynamic_pointer_cast<const IndexScanPlanNode>(scan)->indexes_.size() == 1 &&
+                       IndexMatchesOrder(dynamic_pointer_cast<const IndexScanPlanNode>(scan)->indexes_.front(),
+                                         statement->order_by_) &&
+                       !HasInListOnKey(dynamic_pointer_cast<const IndexScanPlanNode>(scan)->indexes_.front(),
+                                       statement->where_))) {
+        return PlanLimit(statement, scan);
+      }
+      // with a limit, walking an index in key order stops after the first rows instead of reading the whole table
+      if (statement->has_limit_ && !statement->has_or) {
+        auto ordered_scan = PlanOrderedIndexScan(statement, output_schema);
+        if (ordered_scan != nullptr) {
+          return PlanLimit(statement, ordered_scan);
+        }
+      }
+    }
+    // the sort reads whole rows and picks the select list
+    AbstractPlanNodeRef child =
+        single_table ? PlanScan(statement->table_name_, info->GetSchema(), statement->where_,
+                                statement->column_in_condition_, statement->has_or)
+                     : PlanJoin(statement, nullptr);
+    return PlanOrderBy(statement, child, output_schema, statement->order_by_);
+  }
+  // the aggregation reads whole rows, the select list refers to its groups
+  AbstractPlanNodeRef child;
+  if (!single_table) {
+    child = PlanJoin(statement, nullptr);
+  } else {
+    child = PlanScan(statement->table_name_, info->GetSchema(), statement->where_, statement->column_in_condition_,
+                     statement->has_or);
+  }
+  child = make_shared<AggregationPlanNode>(output_schema, Parallelize(child), statement->group_by_, statement->aggregates_,
+                                           statement->agg_types_);
+  if (!ordered) {
+    return PlanLimit(statement, child);
+  }
+  // the groups are sorted after the aggregation, a key has to be a group by column of the select list
+  std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys;
+  for (const auto &order_by : statement->order_by_) {
+    uint32_t col_idx = dynamic_pointer_cast<ColumnValueExpression>(order_by.second)->GetColIdx();
+    const auto &group_by = statement->group_by_;
+    auto group = std::find_if(group_by.begin(), group_by.end(), [col_idx](const AbstractExpressionRef &expr) {
+      return dynamic_pointer_cast<ColumnValueExpression>(expr)->GetColIdx() == col_idx;
+    });
+    const auto &columns = statement->column_list_;
+    auto column = std::find_if(columns.begin(), columns.end(), [&](const auto &entry) {
+      return group != group_by.end() &&
+             dynamic_pointer_cast<ColumnValueExpression>(entry.second)->GetColIdx() == group - group_by.begin();
+    });
+    if (column == columns.end()) {
+      throw std::logic_error("an order by column of a grouped select must be a group by column in the select list");
+    }
+    order_bys.emplace_back(order_by.first,
+                           std::make_shared<ColumnValueExpression>(0, column - columns.begin(),
+                                                                   order_by.second->GetReturnType()));
+  }
+  return PlanOrderBy(statement, child, output_schema, order_bys);
+}
+
+void Planner::CollectNeededColumns(std::shared_ptr<SelectStatement> statement, bool aggregation) {
+  // the select list of a grouped select refers to the groups, the columns it shows are group by columns
+  std::vector<AbstractExpressionRef> referenced;
+  if (statement->where_ != nullptr) {
+    referenced.push_back(statement->where_);
+  }
+  if (!aggregation) {
+    for (const auto &column : statement->column_list_) {
+      referenced.push_back(column.second);
+    }
+  }
+  for (const auto &group_by : statement->group_by_) {
+    referenced.push_back(group_by);
+  }
+  for (const auto &aggregate : statement->aggregates_) {
+    if (aggregate != nullptr) {
+      referenced.push_back(aggregate);
+    }
+  }
+  for (const auto &order_by : statement->order_by_) {
+    referenced.push_back(order_by.second);
+  }
+  std::vector<uint32_t> columns;
+  bool has_or = false;
+  for (const auto &expr : referenced) {
+    CollectColumns(expr, columns, has_or);
+  }
+  needed_columns_.clear();
+  const auto &tables = statement->table_names_;
+  const auto &offsets = statement->table_offsets_;
+  for (const auto &table : tables) {
+    TableInfo *info = nullptr;
+    context_->GetCatalog()->GetTable(table, info);
+    needed_columns_[table].resize(info->GetSchema()->GetColumnCount(), false);
+  }
+  for (auto col_idx : columns) {
+    auto table = std::upper_bound(offsets.begin(), offsets.end(), col_idx) - offsets.begin() - 1;
+    needed_columns_[tables[table]][col_idx - offsets[table]] = true;
+  }
+}
+
+std::vector<bool> Planner::GetNeededColumns(const std::string &table_name,
+                                            const std::vector<uint32_t> &filter_columns) const {
+  auto it = needed_columns_.find(table_name);
+  if (it == needed_columns_.end()) {
+    return {};
+  }
+  std::vector<bool> needed(it->second);
+  for (auto col_idx : filter_columns) {
+    needed[col_idx] = true;
+  }
+  if (std::all_of(needed.begin(), needed.end(), [](bool column) { return column; })) {
+    return {};
+  }
+  return needed;
+}
+
+AbstractPlanNodeRef Planner::PlanOrderBy(std::shared_ptr<SelectStatement> statement, AbstractPlanNodeRef child,
+                                         const Schema *out_schema,
+                                         std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys) {
+  uint64_t top_rows = static_cast<uint64_t>(statement->limit_) + statement->offset_;
+  child = Parallelize(std::move(child));
+  if (!statement->has_limit_ || top_rows > MAX_TOP_N_ROWS) {
+    return PlanLimit(statement, make_shared<SortPlanNode>(out_schema, std::move(child), std::move(order_bys)));
+  }
+  AbstractPlanNodeRef plan =
+      make_shared<TopNPlanNode>(out_schema, std::move(child), std::move(order_bys), static_cast<uint32_t>(top_rows));
+  if (statement->offset_ == 0) {
+    return plan;
+  }
+  return make_shared<LimitPlanNode>(out_schema, plan, statement->limit_, statement->offset_);
+}
+
+AbstractPlanNodeRef Planner::Parallelize(AbstractPlanNodeRef plan) {
+  if (context_->GetMaxWorkers() <= 1 || plan->GetType() != PlanType::SeqScan) {
+    return plan;
+  }
+  auto out_schema = plan->OutputSchema();
+  return make_shared<GatherPlanNode>(out_schema, std::move(plan), context_->GetMaxWorkers());
+}
+
+AbstractPlanNodeRef Planner::PlanLimit(std::shared_ptr<SelectStatement> statement, AbstractPlanNodeRef child) {
+  if (!statement->has_limit_) {
+    return child;
+  }
+  auto out_schema = child->OutputSchema();
+  return make_shared<LimitPlanNode>(out_schema, std::move(child), statement->limit_, statement->offset_);
+}
+
+AbstractPlanNodeRef Planner::PlanOrderedIndexScan(std::shared_ptr<SelectStatement> statement,
+                                                  const Schema *out_schema) {
   vector<IndexInfo *> indexes;
-  vector<IndexInfo *> available_index;
   context_->GetCatalog()->GetTableIndexes(statement->table_name_, indexes);
+  std::vector<uint32_t> needed_columns(statement->column_in_condition_);
+  for (auto column : out_schema->GetColumns()) {
+    needed_columns.push_back(column->GetTableInd());
+  }
+  for (auto index : indexes) {
+    if (index->IsBuilding() || !IndexMatchesOrder(index, statement->order_by_) ||
+        HasInListOnKey(index, statement->where_)) {
+      continue;
+    }
+    const auto &index_columns = index->GetIndexKeySchema()->GetColumns();
+    bool covering = std::all_of(needed_columns.begin(), needed_columns.end(), [&index_columns](uint32_t col_id) {
+      return std::any_of(index_columns.begin(), index_columns.end(),
+                         [col_id](const Column *column) { return column->GetTableInd() == col_id; });
+    });
+    return make_shared<IndexScanPlanNode>(out_schema, statement->table_name_, vector<IndexInfo *>{index}, true,
+                                          statement->where_, covering);
+  }
+  return nullptr;
+}
+
+AbstractPlanNodeRef Planner::PlanJoin(std::shared_ptr<SelectStatement> statement, const Schema *join_schema) {
+  // columns are bound to the row of all tables concatenated, a left deep join tree builds that row table by table
+  const auto &tables = statement->table_names_;
+  const auto &offsets = statement->table_offsets_;
+  auto table_of = [&offsets](uint32_t col_idx) {
+    return static_cast<uint32_t>(std::upper_bound(offsets.begin(), offsets.end(), col_idx) - offsets.begin() - 1);
+  };
+  std::vector<AbstractExpressionRef> conjuncts;
+  SplitConjuncts(statement->where_, conjuncts);
+  // a conjunct on a single table filters its scan, the others are checked by the join that adds their last table
+  std::vector<AbstractExpressionRef> table_filters(tables.size());
+  std::vector<std::vector<AbstractExpressionRef>> join_conditions(tables.size());
+  for (const auto &conjunct : conjuncts) {
+    std::vector<uint32_t> columns;
+    bool has_or = false;
+    CollectColumns(conjunct, columns, has_or);
+    uint32_t first = tables.size();
+    uint32_t last = 0;
+    for (auto col_idx : columns) {
+      first = std::min(first, table_of(col_idx));
+      last = std::max(last, table_of(col_idx));
+    }
+    if (first == last) {
+      uint32_t offset = offsets[first];
+      auto filter = RebindColumns(conjunct, [offset](uint32_t col_idx) { return std::make_pair(0u, col_idx - offset); });
+      table_filters[first] = MakeConjunction(table_filters[first], filter);
+    } else {
+      join_conditions[last].push_back(conjunct);
+    }
+  }
+  auto plan_table = [this, &tables, &table_filters](uint32_t table) {
+    TableInfo *info = nullptr;
+    context_->GetCatalog()->GetTable(tables[table], info);
+    std::vector<uint32_t> columns;
+    bool has_or = false;
+    if (table_filters[table] != nullptr) {
+      CollectColumns(table_filters[table], columns, has_or);
+    }
+    return PlanScan(tables[table], info->GetSchema(), table_filters[table], columns, has_or);
+  };
+  AbstractPlanNodeRef plan = plan_table(0);
+  for (uint32_t table = 1; table < tables.size(); table++) {
+    uint32_t offset = offsets[table];
+    auto rebind = [offset](uint32_t col_idx) {
+      return col_idx < offset ? std::make_pair(0u, col_idx) : std::make_pair(1u, col_idx - offset);
+    };
+    // an equality of a column of the tables before and a column of the new table can be a join key
+    std::vector<std::pair<std::shared_ptr<ColumnValueExpression>, std::shared_ptr<ColumnValueExpression>>> equalities;
+    std::vector<AbstractExpressionRef> others;
+    for (const auto &condition : join_conditions[table]) {
+      if (condition->GetType() == ExpressionType::ComparisonExpression &&
+          dynamic_pointer_cast<ComparisonExpression>(condition)->GetComparisonType() == "=" &&
+          condition->GetChildAt(1)->GetType() == ExpressionType::ColumnExpression) {
+        auto lhs = dynamic_pointer_cast<ColumnValueExpression>(condition->GetChildAt(0));
+        auto rhs = dynamic_pointer_cast<ColumnValueExpression>(condition->GetChildAt(1));
+        if (lhs->GetColIdx() >= offset) {
+          std::swap(lhs, rhs);
+        }
+        if (lhs->GetColIdx() < offset && rhs->GetColIdx() >= offset) {
+          equalities.emplace_back(lhs, rhs);
+          continue;
+        }
+      }
+      others.push_back(condition);
+    }
+    // the last join projects the select list, the ones below keep every column
+    const Schema *out_schema = nullptr;
+    if (table + 1 == tables.size() && join_schema != nullptr) {
+      out_schema = join_schema;
+    } else {
+      std::vector<Column *> columns;
+      for (uint32_t i = 0; i <= table; i++) {
+        TableInfo *info = nullptr;
+        context_->GetCatalog()->GetTable(tables[i], info);
+        for (auto column : info->GetSchema()->GetColumns()) {
+          uint32_t col_idx = offsets[i] + column->GetTableInd();
+          if (column->GetType() != TypeId::kTypeChar) {
+            columns.push_back(new Column(column->GetName(), column->GetType(), col_idx, false, false));
+          } else {
+            columns.push_back(new Column(column->GetName(), column->GetType(), column->GetLength(), col_idx, false,
+                                         false));
+          }
+        }
+      }
+      intermediate_schemas_.emplace_back(new Schema(columns));
+      out_schema = intermediate_schemas_.back().get();
+    }
+    IndexInfo *index = nullptr;
+    std::vector<size_t> key_equalities;
+    if (IsSelective(plan)) {
+      FindJoinIndex(tables[table], offset, equalities, index, key_equalities);
+    }
+    if (index != nullptr) {
+      // a few outer rows probe the index of the new table instead of hashing all of it
+      std::vector<AbstractExpressionRef> outer_keys;
+      for (auto i : key_equalities) {
+        const auto &outer_column = equalities[i].first;
+        outer_keys.push_back(
+            std::make_shared<ColumnValueExpression>(0, outer_column->GetColIdx(), outer_column->GetReturnType()));
+      }
+      AbstractExpressionRef predicate = nullptr;
+      for (size_t i = 0; i < equalities.size(); i++) {
+        if (std::find(key_equalities.begin(), key_equalities.end(), i) == key_equalities.end()) {
+          predicate = MakeConjunction(predicate, RebindColumns(std::make_shared<ComparisonExpression>(
+                                                                   equalities[i].first, equalities[i].second, "="),
+                                                               rebind));
+        }
+      }
+      for (const auto &condition : others) {
+        predicate = MakeConjunction(predicate, RebindColumns(condition, rebind));
+      }
+      TableInfo *info = nullptr;
+      context_->GetCatalog()->GetTable(tables[table], info);
+      const auto &index_columns = index->GetIndexKeySchema()->GetColumns();
+      bool index_only = std::all_of(
+          info->GetSchema()->GetColumns().begin(), info->GetSchema()->GetColumns().end(),
+          [&index_columns](const Column *column) {
+            return std::any_of(index_columns.begin(), index_columns.end(), [column](const Column *index_column) {
+              return index_column->GetTableInd() == column->GetTableInd();
+            });
+          });
+      plan = make_shared<IndexNestedLoopJoinPlanNode>(out_schema, plan, tables[table], index, std::move(outer_keys),
+                                                      table_filters[table], predicate, index_only);
+      continue;
+    }
+    // inputs that already arrive in key order are merged, only a side out of order is sorted first
+    AbstractPlanNodeRef right_plan = plan_table(table);
+    int left_sorted = SortedColumn(plan);
+    int right_sorted = SortedColumn(right_plan);
+    size_t merge_equality = equalities.size();
+    for (size_t i = 0; i < equalities.size(); i++) {
+      bool left_in_order = static_cast<int>(equalities[i].first->GetColIdx()) == left_sorted;
+      bool right_in_order = static_cast<int>(equalities[i].second->GetColIdx() - offset) == right_sorted;
+      if (left_in_order && right_in_order) {
+        merge_equality = i;
+        break;
+      }
+      if ((left_in_order || right_in_order) && merge_equality == equalities.size()) {
+        merge_equality = i;
+      }
+    }
+    if (merge_equality < equalities.size()) {
+      const auto &equality = equalities[merge_equality];
+      auto left_key =
+          std::make_shared<ColumnValueExpression>(0, equality.first->GetColIdx(), equality.first->GetReturnType());
+      auto right_key = std::make_shared<ColumnValueExpression>(0, equality.second->GetColIdx() - offset,
+                                                               equality.second->GetReturnType());
+      if (static_cast<int>(left_key->GetColIdx()) != left_sorted) {
+        plan = make_shared<SortPlanNode>(plan->OutputSchema(), plan,
+                                         std::vector<std::pair<OrderByType, AbstractExpressionRef>>{
+                                             {OrderByType::Asc, left_key}});
+      }
+      if (static_cast<int>(right_key->GetColIdx()) != right_sorted) {
+        right_plan = make_shared<SortPlanNode>(right_plan->OutputSchema(), right_plan,
+                                               std::vector<std::pair<OrderByType, AbstractExpressionRef>>{
+                                                   {OrderByType::Asc, right_key}});
+      }
+      AbstractExpressionRef predicate = nullptr;
+      for (size_t i = 0; i < equalities.size(); i++) {
+        if (i != merge_equality) {
+          predicate = MakeConjunction(predicate, RebindColumns(std::make_shared<ComparisonExpression>(
+                                                                   equalities[i].first, equalities[i].second, "="),
+                                                               rebind));
+        }
+      }
+      for (const auto &condition : others) {
+        predicate = MakeConjunction(predicate, RebindColumns(condition, rebind));
+      }
+      plan = make_shared<MergeJoinPlanNode>(out_schema, plan, right_plan, left_key, right_key, predicate);
+      continue;
+    }
+    std::vector<AbstractExpressionRef> left_keys;
+    std::vector<AbstractExpressionRef> right_keys;
+    for (const auto &equality : equalities) {
+      left_keys.push_back(
+          std::make_shared<ColumnValueExpression>(0, equality.first->GetColIdx(), equality.first->GetReturnType()));
+      right_keys.push_back(std::make_shared<ColumnValueExpression>(0, equality.second->GetColIdx() - offset,
+                                                                   equality.second->GetReturnType()));
+    }
+    AbstractExpressionRef predicate = nullptr;
+    for (const auto &condition : others) {
+      predicate = MakeConjunction(predicate, RebindColumns(condition, rebind));
+    }
+    plan = make_shared<HashJoinPlanNode>(out_schema, plan, right_plan, std::move(left_keys),
+                                         std::move(right_keys), predicate);
+  }
+  return plan;
+}
+
+void Planner::FindJoinIndex(
+    const std::string &table_name, uint32_t offset,
+    const std::vector<std::pair<std::shared_ptr<ColumnValueExpression>, std::shared_ptr<ColumnValueExpression>>>
+        &equalities,
+    IndexInfo *&index, std::vector<size_t> &key_equalities) {
+  vector<IndexInfo *> indexes;
+  context_->GetCatalog()->GetTableIndexes(table_name, indexes);
+  for (auto candidate : indexes) {
+    if (!candidate->IsBPlusTreeIndex() || candidate->IsBuilding()) {
+      continue;
+    }
+    // every key column of the longest leftmost prefix needs an equality with the outer row
+    auto key_schema = candidate->GetIndexKeySchema();
+    std::vector<size_t> prefix;
+    for (uint32_t i = 0; i < candidate->GetKeyColumnCount(); i++) {
+      uint32_t col_id = key_schema->GetColumn(i)->GetTableInd();
+      auto it = std::find_if(equalities.begin(), equalities.end(), [col_id, offset](const auto &equality) {
+        return equality.second->GetColIdx() - offset == col_id;
+      });
+      if (it == equalities.end()) {
+        break;
+      }
+      prefix.push_back(it - equalities.begin());
+    }
+    if (!prefix.empty() && prefix.size() > key_equalities.size()) {
+      index = candidate;
+      key_equalities = std::move(prefix);
+    }
+  }
+}
+
+AbstractPlanNodeRef Planner::PlanScan(const std::string &table_name, const Schema *out_schema,
+                                      const AbstractExpressionRef &where, const std::vector<uint32_t> &filter_columns,
+                                      bool has_or) {
+  auto table_columns = GetNeededColumns(table_name, filter_columns);
+  vector<IndexInfo *> indexes;
+  vector<IndexInfo *> available_index;
+  context_->GetCatalog()->GetTableIndexes(table_name, indexes);
+  std::unordered_map<uint32_t, std::vector<std::string>> operators;
+  CollectCompareOperators(where, operators);
+  // an index can drive the scan once its leading key column is filtered, the executor then matches the longest
+  // leftmost prefix of its key; a hash index needs an equality on every key column, or an in list on the last one
+  auto has_operator = [&operators](uint32_t col_id, const char *compare_operator) {
+    const auto &ops = operators[col_id];
+    return std::find(ops.begin(), ops.end(), compare_operator) != ops.end();
+  };
+  vector<IndexInfo *> bitmap_indexes;
+  IndexInfo *fulltext_index = nullptr;
+  std::unordered_set<uint32_t> bitmap_columns;
   for (auto index : indexes) {
-    if (index->GetIndexKeySchema()->GetColumns().size() == 1) {
-      auto col_id = index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
-      if (std::find(statement->column_in_condition_.begin(), statement->column_in_condition_.end(), col_id) !=
-          statement->column_in_condition_.end()) {
-        available_index.push_back(index);
+    // an index that is still built concurrently misses rows
+    if (index->IsBuilding()) {
+      continue;
+    }
+    // a block range index can not locate rows, the sequential scan consults it to skip pages instead
+    if (index->IsBrinIndex()) {
+      continue;
+    }
+    // a fulltext index only answers match(...) on its column
+    if (index->IsFullTextIndex()) {
+      const auto &ops = operators[index->GetIndexKeySchema()->GetColumn(0)->GetTableInd()];
+      if (fulltext_index == nullptr && std::find(ops.begin(), ops.end(), "match") != ops.end()) {
+        fulltext_index = index;
+      }
+      continue;
+    }
+    if (index->IsBitmapIndex()) {
+      bitmap_indexes.push_back(index);
+      bitmap_columns.insert(index->GetIndexKeySchema()->GetColumn(0)->GetTableInd());
+      continue;
+    }
+    auto key_schema = index->GetIndexKeySchema();
+    if (operators.count(key_schema->GetColumn(0)->GetTableInd()) == 0) {
+      continue;
+    }
+    if (index->IsHashIndex()) {
+      bool all_equal = true;
+      uint32_t key_count = index->GetKeyColumnCount();
+      for (uint32_t i = 0; i < key_count; i++) {
+        uint32_t col_id = key_schema->GetColumn(i)->GetTableInd();
+        all_equal = all_equal && (has_operator(col_id, "=") || (i + 1 == key_count && has_operator(col_id, "in")));
+      }
+      if (!all_equal) {
+        continue;
+      }
+    }
+    available_index.push_back(index);
+  }
+  if (fulltext_index != nullptr && !has_or) {
+    return make_shared<IndexScanPlanNode>(out_schema, table_name, vector<IndexInfo *>{fulltext_index}, true,
+                                          where);
+  }
+  // bitmaps also answer "or", but an ordered index is preferred for a plain conjunction
+  if (where != nullptr && !bitmap_indexes.empty() && (available_index.empty() || has_or) &&
+      CoveredByBitmaps(where, bitmap_columns)) {
+    return make_shared<BitmapScanPlanNode>(out_schema, table_name, bitmap_indexes, where);
+  }
+  if (available_index.empty() || has_or) {
+    auto scan = make_shared<SeqScanPlanNode>(out_schema, table_name, where);
+    scan->needed_columns_ = std::move(table_columns);
+    return scan;
+  }
+  // a B+ tree index whose key and include columns hold every projected and filtered column answers the query alone
+  std::vector<uint32_t> needed_columns(filter_columns);
+  if (table_columns.empty()) {
+    for (auto column : out_schema->GetColumns()) {
+      needed_columns.push_back(column->GetTableInd());
+    }
+  } else {
+    for (uint32_t i = 0; i < table_columns.size(); i++) {
+      if (table_columns[i]) {
+        needed_columns.push_back(i);
       }
     }
   }
-  if (available_index.empty() || statement->has_or) {
-    return make_shared<SeqScanPlanNode>(out_schema, statement->table_name_, statement->where_);
+  for (auto index : available_index) {
+    if (!index->IsBPlusTreeIndex()) {
+      continue;
+    }
+    const auto &index_columns = index->GetIndexKeySchema()->GetColumns();
+    bool covering = std::all_of(needed_columns.begin(), needed_columns.end(), [&index_columns](uint32_t col_id) {
+      return std::any_of(index_columns.begin(), index_columns.end(),
+                         [col_id](const Column *column) { return column->GetTableInd() == col_id; });
+    });
+    if (covering) {
+      return make_shared<IndexScanPlanNode>(out_schema, table_name, vector<IndexInfo *>{index}, true,
+                                            where, true);
+    }
   }
-  return make_shared<IndexScanPlanNode>(out_schema, statement->table_name_, available_index,
-                                        available_index.size() != statement->column_in_condition_.size(),
-                                        statement->where_);
+  auto scan = make_shared<IndexScanPlanNode>(out_schema, table_name, available_index, true, where);
+  scan->needed_columns_ = std::move(table_columns);
+  return scan;
 }
 
 AbstractPlanNodeRef Planner::PlanInsert(std::shared_ptr<InsertStatement> statement) {
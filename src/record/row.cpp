@@ -1,5 +1,7 @@
 #include "record/row.h"
 
+#include <bitset>
+
 /**
  * TODO: Student Implement
  */
@@ -99,6 +101,31 @@ uint32_t Row::DeserializeFrom(char *buf, Schema *schema) {
   return offset;
 }
 
+uint32_t Row::DeserializeColumns(char *buf, Schema *schema, const std::vector<bool> &needed_columns) {
+  ASSERT(schema != nullptr, "Invalid schema before serialize.");
+  ASSERT(fields_.empty(), "Non empty field in row.");
+  size_t field_nums = MACH_READ_FROM(size_t, buf);
+  const char *null_bitmaps = buf + sizeof(size_t);
+  uint32_t offset = sizeof(size_t) + (field_nums + 7) / 8;
+  fields_.reserve(field_nums);
+  for (uint32_t i = 0; i < field_nums; i++) {
+    TypeId field_type = schema->GetColumn(i)->GetType();
+    bool is_null = ((null_bitmaps[i / 8] >> (7 - i % 8)) & 1) == 0;
+    if (i < needed_columns.size() && needed_columns[i]) {
+      Field *field = nullptr;
+      offset += Field::DeserializeFrom(buf + offset, field_type, &field, is_null);
+      fields_.push_back(field);
+      continue;
+    }
+    if (!is_null) {
+      offset += field_type == TypeId::kTypeChar ? sizeof(uint32_t) + MACH_READ_UINT32(buf + offset)
+                                                : Type::GetTypeSize(field_type);
+    }
+    fields_.push_back(new Field(field_type));
+  }
+  return offset;
+}
+
 /* 序列化的长度由三部分决定
      * 1. Field Nums
      * 2. Null bitmaps
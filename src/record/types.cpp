@@ -101,6 +101,10 @@ uint32_t TypeInt::GetSerializedSize(const Field &field, bool is_null) const {
   return GetTypeSize(type_id_);
 }
 
+const char *TypeInt::GetData(const Field &val) const {
+  return reinterpret_cast<const char *>(&val.value_.integer_);
+}
+
 CmpBool TypeInt::CompareEquals(const Field &left, const Field &right) const {
   ASSERT(left.CheckComparable(right), "Not comparable.");
   if (left.IsNull() || right.IsNull()) {
@@ -176,6 +180,10 @@ uint32_t TypeFloat::GetSerializedSize(const Field &field, bool is_null) const {
   return GetTypeSize(type_id_);
 }
 
+const char *TypeFloat::GetData(const Field &val) const {
+  return reinterpret_cast<const char *>(&val.value_.float_);
+}
+
 CmpBool TypeFloat::CompareEquals(const Field &left, const Field &right) const {
   ASSERT(left.CheckComparable(right), "Not comparable.");
   if (left.IsNull() || right.IsNull()) {
@@ -51,29 +51,77 @@ void DiskManager::WritePage(page_id_t logical_page_id, const char *page_data) {
  * TODO: Student Implement
  */
 page_id_t DiskManager::AllocatePage() {
-  ASSERT(false, "Not implemented yet.");
-  return INVALID_PAGE_ID;
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  auto meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  // the first extent with a free page, a new one behind the last if all are full
+  uint32_t extent_id = 0;
+  while (extent_id < meta_page->num_extents_ && meta_page->extent_used_page_[extent_id] >= BITMAP_SIZE) {
+    extent_id++;
+  }
+  if (static_cast<page_id_t>(extent_id * BITMAP_SIZE) >= MAX_VALID_PAGE_ID) {
+    return INVALID_PAGE_ID;
+  }
+  char bitmap_data[PAGE_SIZE];
+  page_id_t bitmap_page_id = BitmapPhysicalPageId(extent_id);
+  if (extent_id == meta_page->num_extents_) {
+    memset(bitmap_data, 0, PAGE_SIZE);
+    meta_page->num_extents_++;
+    meta_page->extent_used_page_[extent_id] = 0;
+  } else {
+    ReadPhysicalPage(bitmap_page_id, bitmap_data);
+  }
+  uint32_t page_offset;
+  if (!reinterpret_cast<BitmapPage<PAGE_SIZE> *>(bitmap_data)->AllocatePage(page_offset)) {
+    return INVALID_PAGE_ID;
+  }
+  WritePhysicalPage(bitmap_page_id, bitmap_data);
+  meta_page->num_allocated_pages_++;
+  meta_page->extent_used_page_[extent_id]++;
+  return extent_id * BITMAP_SIZE + page_offset;
 }
 
 /**
  * TODO: Student Implement
  */
 void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
-  ASSERT(false, "Not implemented yet.");
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  auto meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  uint32_t extent_id = logical_page_id / BITMAP_SIZE;
+  if (logical_page_id < 0 || extent_id >= meta_page->num_extents_) {
+    return;
+  }
+  char bitmap_data[PAGE_SIZE];
+  page_id_t bitmap_page_id = BitmapPhysicalPageId(extent_id);
+  ReadPhysicalPage(bitmap_page_id, bitmap_data);
+  if (!reinterpret_cast<BitmapPage<PAGE_SIZE> *>(bitmap_data)->DeAllocatePage(logical_page_id % BITMAP_SIZE)) {
+    return;
+  }
+  WritePhysicalPage(bitmap_page_id, bitmap_data);
+  meta_page->num_allocated_pages_--;
+  meta_page->extent_used_page_[extent_id]--;
 }
 
 /**
  * TODO: Student Implement
  */
 bool DiskManager::IsPageFree(page_id_t logical_page_id) {
-  return false;
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  auto meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  uint32_t extent_id = logical_page_id / BITMAP_SIZE;
+  if (extent_id >= meta_page->num_extents_) {
+    return true;
+  }
+  char bitmap_data[PAGE_SIZE];
+  ReadPhysicalPage(BitmapPhysicalPageId(extent_id), bitmap_data);
+  return reinterpret_cast<BitmapPage<PAGE_SIZE> *>(bitmap_data)->IsPageFree(logical_page_id % BITMAP_SIZE);
 }
 
 /**
  * TODO: Student Implement
  */
 page_id_t DiskManager::MapPageId(page_id_t logical_page_id) {
-  return 0;
+  // the meta page, then per extent its bitmap page followed by its pages
+  return logical_page_id + logical_page_id / BITMAP_SIZE + 2;
 }
 
 int DiskManager::GetFileSize(const std::string &file_name) {
@@ -123,7 +123,7 @@ void TableHeap::RollbackDelete(const RowId &rid, Txn *txn) {
 /**
  * TODO: Student Implement
  */
-bool TableHeap::GetTuple(Row *row, Txn *txn) {
+bool TableHeap::GetTuple(Row *row, Txn *txn, const std::vector<bool> *needed_columns) {
   // step 1: Find the page which contains the tuple.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(row->GetRowId().GetPageId()));
   if (page == nullptr) {
@@ -131,7 +131,7 @@ bool TableHeap::GetTuple(Row *row, Txn *txn) {
   }
   // step 2: Get the tuple from the page.
   page->RLatch();
-  bool get_tuple = page->GetTuple(row, schema_, txn, lock_manager_);
+  bool get_tuple = page->GetTuple(row, schema_, txn, lock_manager_, needed_columns);
   page->RUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), false);
   if (!get_tuple) {
@@ -205,4 +205,30 @@ TableIterator TableHeap::Begin(Txn *txn) {
 TableIterator TableHeap::End() {
   // end返回的是指向容器最后一个元素的下一个位置的迭代器
   return TableIterator(this, RowId(INVALID_ROWID), nullptr);
-}
\ No newline at end of file
+}
+TableIterator TableHeap::BeginAfterPage(page_id_t page_id, Txn *txn) {
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return End();
+  }
+  page_id_t next_page_id = page->GetNextPageId();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  // 沿着链表找到第一个有tuple的page
+  while (next_page_id != INVALID_PAGE_ID) {
+    page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
+    if (page == nullptr) {
+      return End();
+    }
+    RowId rid;
+    page->RLatch();
+    bool get_first_tuple = page->GetFirstTupleRid(&rid);
+    page_id_t current_page_id = next_page_id;
+    next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(current_page_id, false);
+    if (get_first_tuple) {
+      return TableIterator(this, rid, txn);
+    }
+  }
+  return End();
+}
@@ -71,4 +71,49 @@ TEST(BufferPoolManagerTest, BinaryDataTest) {
 
   delete bpm;
   delete disk_manager;
-}
\ No newline at end of file
+}
+TEST(BufferPoolManagerTest, ChildFrameHintTest) {
+  const std::string db_name = "bpm_child_frame_test.db";
+  const size_t buffer_pool_size = 4;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager, true);
+
+  page_id_t parent_id, child_id, other_id;
+  Page *parent = bpm->NewPage(parent_id);
+  ASSERT_NE(nullptr, parent);
+  Page *child = bpm->NewPage(child_id);
+  ASSERT_NE(nullptr, child);
+  std::strcpy(child->GetData(), "child");
+  ASSERT_TRUE(bpm->UnpinPage(child, true));
+
+  // Scenario: the first descent goes through the page table, the second one through the frame hint.
+  Page *fetched = bpm->FetchChildPage(parent, 0, child_id);
+  ASSERT_EQ(child, fetched);
+  ASSERT_TRUE(bpm->UnpinPage(fetched, false));
+  fetched = bpm->FetchChildPage(parent, 0, child_id);
+  ASSERT_EQ(child, fetched);
+  EXPECT_EQ(1, fetched->GetPinCount());
+  ASSERT_TRUE(bpm->UnpinPage(fetched, false));
+  EXPECT_FALSE(bpm->UnpinPage(fetched, false));
+
+  // Scenario: once the child was evicted, the stale hint is detected and the page is read back from disk.
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    if (bpm->NewPage(other_id) != nullptr) {
+      bpm->UnpinPage(other_id, false);
+    }
+  }
+  fetched = bpm->FetchChildPage(parent, 0, child_id);
+  ASSERT_NE(nullptr, fetched);
+  EXPECT_EQ(child_id, fetched->GetPageId());
+  EXPECT_EQ(0, std::strcmp(fetched->GetData(), "child"));
+  ASSERT_TRUE(bpm->UnpinPage(fetched, false));
+  ASSERT_TRUE(bpm->UnpinPage(parent_id, false));
+
+  disk_manager->Close();
+  remove(db_name.c_str());
+
+  delete bpm;
+  delete disk_manager;
+}
@@ -39,6 +39,41 @@ TEST(CatalogTest, CatalogMetaTest) {
   delete other;
 }
 
+TEST(CatalogTest, TableMetadataTest) {
+  char *buf = new char[PAGE_SIZE];
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto *meta = TableMetadata::Create(3, "people", 7, new Schema(columns));
+  uint32_t size = meta->SerializeTo(buf);
+  ASSERT_EQ(meta->GetSerializedSize(), size);
+  TableMetadata *other = nullptr;
+  ASSERT_EQ(size, TableMetadata::DeserializeFrom(buf, other));
+  ASSERT_EQ("people", other->GetTableName());
+  ASSERT_EQ(7, other->GetFirstPageId());
+  ASSERT_EQ(2, other->GetSchema()->GetColumnCount());
+  delete meta;
+  delete other;
+  delete[] buf;
+}
+
+TEST(CatalogTest, IndexMetadataTest) {
+  char *buf = new char[PAGE_SIZE];
+  auto *meta = IndexMetadata::Create(5, "idx_name_id", 2, {1, 0}, "art", {3});
+  uint32_t size = meta->SerializeTo(buf);
+  ASSERT_EQ(meta->GetSerializedSize(), size);
+  IndexMetadata *other = nullptr;
+  ASSERT_EQ(size, IndexMetadata::DeserializeFrom(buf, other));
+  ASSERT_EQ(5, other->GetIndexId());
+  ASSERT_EQ("idx_name_id", other->GetIndexName());
+  ASSERT_EQ(2, other->GetTableId());
+  ASSERT_EQ(std::vector<uint32_t>({1, 0}), other->GetKeyMapping());
+  ASSERT_EQ("art", other->GetIndexType());
+  ASSERT_EQ(std::vector<uint32_t>({3}), other->GetIncludeMapping());
+  delete meta;
+  delete other;
+  delete[] buf;
+}
+
 TEST(CatalogTest, CatalogTableTest) {
   /** Stage 2: Testing simple operation */
   auto db_01 = new DBStorageEngine(db_file_name, true);
@@ -126,4 +161,49 @@ TEST(CatalogTest, CatalogIndexTest) {
     ASSERT_EQ(rid.Get(), ret_02[i].Get());
   }
   delete db_02;
-}
\ No newline at end of file
+}
+TEST(CatalogTest, CatalogInMemoryIndexReloadTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  std::vector<RowId> rids;
+  for (int i = 0; i < 10; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i),
+                              Field(TypeId::kTypeChar, const_cast<char *>(i % 2 ? "odd" : "even"), i % 2 ? 3 : 4, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+    rids.push_back(row.GetRowId());
+  }
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "art-index", {"id"}, &txn, index_info, "art"));
+  ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->BuildFromHeap(table_info->GetTableHeap(), &txn));
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "bitmap-index", {"name"}, &txn, index_info, "bitmap"));
+  ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->BuildFromHeap(table_info->GetTableHeap(), &txn));
+  delete db_01;
+  /** Neither index keeps anything on disk, both must be rebuilt from the heap when the catalog is loaded */
+  auto db_02 = new DBStorageEngine(db_file_name, false);
+  auto &catalog_02 = db_02->catalog_mgr_;
+  IndexInfo *art_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetIndex("table-1", "art-index", art_info));
+  for (int i = 0; i < 10; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row key(fields);
+    std::vector<RowId> result;
+    ASSERT_EQ(DB_SUCCESS, art_info->GetIndex()->ScanKey(key, result, &txn));
+    ASSERT_EQ(1, result.size());
+    ASSERT_EQ(rids[i].Get(), result[0].Get());
+  }
+  IndexInfo *bitmap_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetIndex("table-1", "bitmap-index", bitmap_info));
+  std::vector<Field> fields{Field(TypeId::kTypeChar, const_cast<char *>("odd"), 3, true)};
+  Row key(fields);
+  std::vector<RowId> result;
+  ASSERT_EQ(DB_SUCCESS, bitmap_info->GetIndex()->ScanKey(key, result, &txn));
+  ASSERT_EQ(5, result.size());
+  delete db_02;
+}
@@ -0,0 +1,147 @@
+#include "planner/expressions/comparison_expression.h"
+
+#include "gtest/gtest.h"
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/compiled_predicate.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+
+static bool Like(const std::string &text, const std::string &pattern) {
+  return ComparisonExpression::LikeMatch(text.data(), text.size(), pattern.data(), pattern.size());
+}
+
+TEST(ComparisonExpressionTest, LikeMatchTest) {
+  ASSERT_TRUE(Like("abc", "abc"));
+  ASSERT_FALSE(Like("abc", "ab"));
+  ASSERT_TRUE(Like("abc", "ab%"));
+  ASSERT_TRUE(Like("ab", "ab%"));
+  ASSERT_TRUE(Like("abc", "%c"));
+  ASSERT_TRUE(Like("abc", "a_c"));
+  ASSERT_FALSE(Like("abbc", "a_c"));
+  ASSERT_TRUE(Like("", "%"));
+  ASSERT_FALSE(Like("", "_"));
+  // a mismatch after a '%' retries one character further
+  ASSERT_TRUE(Like("mississippi", "%iss%ppi"));
+  ASSERT_TRUE(Like("aaab", "%a%ab"));
+  ASSERT_FALSE(Like("mississippi", "%iss%pi%x"));
+  ASSERT_TRUE(Like("100%", "100%"));
+  ASSERT_EQ("abc", ComparisonExpression::LikePrefix("abc%d_", 6));
+  ASSERT_EQ("", ComparisonExpression::LikePrefix("%abc", 4));
+}
+
+TEST(ComparisonExpressionTest, EvaluateLikeTest) {
+  std::vector<Column *> columns = {new Column("name", TypeId::kTypeChar, 16, 0, true, false)};
+  Schema schema(columns);
+  auto column = std::make_shared<ColumnValueExpression>(0, 0, TypeId::kTypeChar);
+  auto pattern =
+      std::make_shared<ConstantValueExpression>(Field(TypeId::kTypeChar, const_cast<char *>("jo_n%"), 5, true));
+  ComparisonExpression like(column, pattern, "like");
+  auto evaluate = [&like](const char *name) {
+    std::vector<Field> fields;
+    if (name == nullptr) {
+      fields.emplace_back(TypeId::kTypeChar);
+    } else {
+      fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(name), strlen(name), true);
+    }
+    Row row(fields);
+    return like.Evaluate(&row);
+  };
+  ASSERT_TRUE(evaluate("john smith").CompareEquals(Field(kTypeInt, 1)));
+  ASSERT_TRUE(evaluate("joan").CompareEquals(Field(kTypeInt, 1)));
+  ASSERT_FALSE(evaluate("jon").CompareEquals(Field(kTypeInt, 1)));
+  ASSERT_FALSE(evaluate(nullptr).CompareEquals(Field(kTypeInt, 1)));
+}
+
+TEST(ComparisonExpressionTest, EvaluateInTest) {
+  auto column = std::make_shared<ColumnValueExpression>(0, 0, TypeId::kTypeInt);
+  std::vector<AbstractExpressionRef> children{column};
+  for (int32_t value : {3, 1, 4}) {
+    children.push_back(std::make_shared<ConstantValueExpression>(Field(TypeId::kTypeInt, value)));
+  }
+  ComparisonExpression in(children, "in");
+  children.push_back(std::make_shared<ConstantValueExpression>(Field(TypeId::kTypeInt)));
+  ComparisonExpression in_with_null(children, "in");
+  auto evaluate = [](const ComparisonExpression &expression, const int32_t *id) {
+    std::vector<Field> fields;
+    if (id == nullptr) {
+      fields.emplace_back(TypeId::kTypeInt);
+    } else {
+      fields.emplace_back(TypeId::kTypeInt, *id);
+    }
+    Row row(fields);
+    return expression.Evaluate(&row);
+  };
+  int32_t one = 1;
+  int32_t two = 2;
+  ASSERT_TRUE(evaluate(in, &one).CompareEquals(Field(kTypeInt, 1)));
+  ASSERT_TRUE(evaluate(in, &two).CompareEquals(Field(kTypeInt, 0)));
+  ASSERT_FALSE(evaluate(in, nullptr).CompareEquals(Field(kTypeInt, 1)));
+  // a value that matches none of the list is unknown, not false, once the list holds a null
+  ASSERT_TRUE(evaluate(in_with_null, &one).CompareEquals(Field(kTypeInt, 1)));
+  ASSERT_FALSE(evaluate(in_with_null, &two).CompareEquals(Field(kTypeInt, 0)));
+}
+
+TEST(CompiledPredicateTest, MatchesExpressionTree) {
+  // rows of (id int, other int, score float, name char) over small domains with nulls, so every outcome occurs
+  auto id = std::make_shared<ColumnValueExpression>(0, 0, TypeId::kTypeInt);
+  auto other = std::make_shared<ColumnValueExpression>(0, 1, TypeId::kTypeInt);
+  auto score = std::make_shared<ColumnValueExpression>(0, 2, TypeId::kTypeFloat);
+  auto name = std::make_shared<ColumnValueExpression>(0, 3, TypeId::kTypeChar);
+  auto int_value = [](int32_t value) { return std::make_shared<ConstantValueExpression>(Field(kTypeInt, value)); };
+  auto char_value = [](const char *value) {
+    return std::make_shared<ConstantValueExpression>(
+        Field(kTypeChar, const_cast<char *>(value), strlen(value), true));
+  };
+  auto compare = [](AbstractExpressionRef lhs, AbstractExpressionRef rhs, const char *op) {
+    return std::make_shared<ComparisonExpression>(std::move(lhs), std::move(rhs), op);
+  };
+  auto logic = [](AbstractExpressionRef lhs, AbstractExpressionRef rhs, LogicType type) {
+    return std::make_shared<LogicExpression>(std::move(lhs), std::move(rhs), type);
+  };
+  std::vector<AbstractExpressionRef> in_children{id, int_value(1), int_value(3),
+                                                 std::make_shared<ConstantValueExpression>(Field(kTypeInt))};
+  std::vector<AbstractExpressionRef> name_in{name, char_value("c"), char_value("a")};
+  std::vector<std::pair<AbstractExpressionRef, size_t>> predicates = {
+      {logic(compare(id, int_value(2), "<"), compare(name, char_value("b"), "="), LogicType::And), 0},
+      {logic(compare(int_value(3), id, ">="),
+             compare(score, std::make_shared<ConstantValueExpression>(Field(kTypeFloat, 1.5f)), "<>"), LogicType::Or),
+       0},
+      {logic(std::make_shared<ComparisonExpression>(in_children, "in"),
+             compare(name, std::make_shared<ConstantValueExpression>(Field(kTypeChar)), "is"), LogicType::Or),
+       0},
+      {logic(compare(id, other, "<="), compare(name, char_value("a%"), "like"), LogicType::And), 1},
+      {logic(std::make_shared<ComparisonExpression>(name_in, "in"), compare(id, int_value(2), "<>"), LogicType::Or),
+       0},
+  };
+  // a right deep chain deeper than the stack kept on the call stack
+  AbstractExpressionRef chain = compare(id, int_value(4), "<=");
+  for (int32_t i = 0; i < 20; i++) {
+    chain = logic(compare(other, int_value(i - 10), ">="), chain, i % 2 == 0 ? LogicType::And : LogicType::Or);
+  }
+  predicates.emplace_back(chain, 0);
+
+  const char *names[] = {"a", "b", "c", "ab"};
+  for (const auto &entry : predicates) {
+    auto compiled = CompiledPredicate::Compile(entry.first);
+    ASSERT_EQ(entry.second, compiled->GetInterpretedCount());
+    for (int32_t i = 0; i < 5 * 5 * 4 * 5; i++) {
+      std::vector<Field> fields;
+      int32_t id_value = i % 5;
+      int32_t other_value = i / 5 % 5;
+      int32_t score_value = i / 25 % 4;
+      int32_t name_value = i / 100 % 5;
+      fields.push_back(id_value == 4 ? Field(kTypeInt) : Field(kTypeInt, id_value));
+      fields.push_back(other_value == 4 ? Field(kTypeInt) : Field(kTypeInt, other_value));
+      fields.push_back(score_value == 3 ? Field(kTypeFloat) : Field(kTypeFloat, score_value * 0.75f));
+      fields.push_back(name_value == 4 ? Field(kTypeChar)
+                                       : Field(kTypeChar, const_cast<char *>(names[name_value]),
+                                               strlen(names[name_value]), true));
+      Row row(fields);
+      // an unknown comparison is false to the tree and null to the program, a row matches in both or in neither
+      Field expected = entry.first->Evaluate(&row);
+      bool expected_match = !expected.IsNull() && expected.CompareEquals(Field(kTypeInt, 1)) == CmpBool::kTrue;
+      ASSERT_EQ(expected_match, compiled->Matches(&row));
+    }
+  }
+  ASSERT_EQ(nullptr, CompiledPredicate::Compile(nullptr));
+}
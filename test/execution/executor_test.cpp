@@ -1,11 +1,24 @@
 //
 // Created by njz on 2023/1/26.
 //
+#include "executor/executors/aggregation_executor.h"
+#include "executor/executors/bitmap_scan_executor.h"
+#include "executor/executors/gather_executor.h"
+#include "executor/executors/hash_join_executor.h"
+#include "executor/executors/index_nested_loop_join_executor.h"
+#include "executor/executors/limit_executor.h"
+#include "executor/executors/merge_join_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "executor/executors/sort_executor.h"
+#include "executor/executors/topn_executor.h"
+#include "executor/executors/values_executor.h"
 #include "executor/plans/delete_plan.h"
+#include "executor/plans/gather_plan.h"
 #include "executor/plans/insert_plan.h"
 #include "executor/plans/seq_scan_plan.h"
 #include "executor/plans/update_plan.h"
 #include "executor/plans/values_plan.h"
+#include "executor/query_scheduler.h"
 #include "executor_test_util.h"  // NOLINT
 
 // SELECT id FROM table-1 WHERE id < 500
@@ -155,3 +168,908 @@ TEST_F(ExecutorTest, SimpleUpdateTest) {
     ASSERT_TRUE(row.GetField(1)->CompareEquals(Field(kTypeChar, const_cast<char *>("minisql"), 7, false)));
   }
 }
+
+TEST_F(ExecutorTest, UpdateIndexRollbackTest) {
+  TableInfo *table_info = CreateTable("rollback", 10);
+  const Schema *schema = table_info->GetSchema();
+  auto catalog = GetExecutorContext()->GetCatalog();
+  IndexInfo *id_index = nullptr;
+  IndexInfo *name_index = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateIndex("rollback", "rollback_id", {"id"}, GetTxn(), id_index, "bptree"));
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateIndex("rollback", "rollback_name", {"name"}, GetTxn(), name_index, "bptree"));
+  auto key_of = [&](const Row &row, IndexInfo *index_info) {
+    Row key;
+    const_cast<Row &>(row).GetKeyFromRow(schema, index_info->GetIndexKeySchema(), key);
+    return key;
+  };
+  RowId rid3;
+  for (auto iter = table_info->GetTableHeap()->Begin(GetTxn()); iter != table_info->GetTableHeap()->End(); ++iter) {
+    Row row = *iter;
+    ASSERT_EQ(DB_SUCCESS, id_index->InsertEntry(key_of(row, id_index), iter.GetRowId(), GetTxn()));
+    ASSERT_EQ(DB_SUCCESS, name_index->InsertEntry(key_of(row, name_index), iter.GetRowId(), GetTxn()));
+    if (row.GetField(0)->CompareEquals(Field(kTypeInt, 3))) {
+      rid3 = iter.GetRowId();
+    }
+  }
+  // UPDATE rollback SET id = 5, name = 'renamed' WHERE id = 3: the id index already holds 5
+  auto predicate = MakeComparisonExpression(MakeColumnValueExpression(*schema, 0, "id"),
+                                            MakeConstantValueExpression(Field(kTypeInt, 3)), "=");
+  auto scan_plan = make_shared<SeqScanPlanNode>(schema, "rollback", predicate);
+  std::unordered_map<uint32_t, AbstractExpressionRef> update_attrs{};
+  update_attrs.emplace(0, MakeConstantValueExpression(Field(kTypeInt, 5)));
+  update_attrs.emplace(1, MakeConstantValueExpression(Field(kTypeChar, const_cast<char *>("renamed"), 7, true)));
+  auto update_plan = std::make_shared<UpdatePlanNode>(schema, scan_plan, "rollback", update_attrs);
+  std::vector<Row> result_set{};
+  ASSERT_EQ(DB_FAILED, GetExecutionEngine()->ExecutePlan(update_plan, &result_set, GetTxn(), GetExecutorContext()));
+  // the heap and both indexes still hold the old row
+  Row row(rid3);
+  ASSERT_TRUE(table_info->GetTableHeap()->GetTuple(&row, GetTxn()));
+  ASSERT_TRUE(row.GetField(0)->CompareEquals(Field(kTypeInt, 3)));
+  std::vector<RowId> result;
+  ASSERT_EQ(DB_SUCCESS, id_index->ScanKey(key_of(row, id_index), result, GetTxn()));
+  ASSERT_EQ(1, result.size());
+  ASSERT_EQ(rid3, result[0]);
+  result.clear();
+  ASSERT_EQ(DB_SUCCESS, name_index->ScanKey(key_of(row, name_index), result, GetTxn()));
+  ASSERT_EQ(1, result.size());
+  ASSERT_EQ(rid3, result[0]);
+  result.clear();
+  Fields renamed{Field(kTypeChar, const_cast<char *>("renamed"), 7, true)};
+  ASSERT_EQ(DB_KEY_NOT_FOUND, name_index->ScanKey(Row(renamed), result, GetTxn()));
+}
+
+// SELECT table-1.id, table-2.ref FROM table-1, table-2 WHERE table-1.id = table-2.ref
+TEST_F(ExecutorTest, HashJoinTest) {
+  TableInfo *left_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", left_info);
+  std::vector<Column *> columns = {new Column("ref", TypeId::kTypeInt, 0, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *right_info = nullptr;
+  GetExecutorContext()->GetCatalog()->CreateTable("table-2", schema.get(), GetTxn(), right_info);
+  // every id below 500 is referenced four times, a null never matches
+  for (int i = 0; i <= 2000; i++) {
+    Fields fields{i < 2000 ? Field(TypeId::kTypeInt, i % 500) : Field(TypeId::kTypeInt)};
+    Row row(fields);
+    ASSERT_TRUE(right_info->GetTableHeap()->InsertTuple(row, nullptr));
+  }
+  auto left_key = MakeColumnValueExpression(*left_info->GetSchema(), 0, "id");
+  auto right_key = MakeColumnValueExpression(*right_info->GetSchema(), 0, "ref");
+  auto left_plan = std::make_shared<SeqScanPlanNode>(left_info->GetSchema(), "table-1");
+  auto right_plan = std::make_shared<SeqScanPlanNode>(right_info->GetSchema(), "table-2");
+  std::vector<Column *> out_columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                       new Column("ref", TypeId::kTypeInt, 3, false, false)};
+  Schema out_schema(out_columns);
+  // a budget the inputs fit in, and one that forces every partition onto pages
+  for (uint32_t budget : {1u << 30, static_cast<uint32_t>(PAGE_SIZE)}) {
+    HashJoinPlanNode plan(&out_schema, left_plan, right_plan, {left_key}, {right_key}, nullptr, budget);
+    HashJoinExecutor executor(GetExecutorContext(), &plan,
+                              std::make_unique<SeqScanExecutor>(GetExecutorContext(), left_plan.get()),
+                              std::make_unique<SeqScanExecutor>(GetExecutorContext(), right_plan.get()));
+    executor.Init();
+    ASSERT_EQ(budget < PAGE_SIZE * 2, executor.IsPartitioned());
+    std::vector<uint32_t> matches(500, 0);
+    Row row;
+    RowId rid;
+    uint32_t count = 0;
+    while (executor.Next(&row, &rid)) {
+      ASSERT_TRUE(row.GetField(0)->CompareEquals(*row.GetField(1)));
+      matches[std::stoi(row.GetField(0)->toString())]++;
+      count++;
+    }
+    ASSERT_EQ(2000, count);
+    for (auto match : matches) {
+      ASSERT_EQ(4, match);
+    }
+  }
+}
+
+// SELECT a.ref, b.ref FROM table-2 a, table-2 b WHERE a.ref = b.ref, with a single key on both sides
+TEST_F(ExecutorTest, HashJoinSkewTest) {
+  std::vector<Column *> columns = {new Column("ref", TypeId::kTypeInt, 0, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  GetExecutorContext()->GetCatalog()->CreateTable("table-2", schema.get(), GetTxn(), table_info);
+  for (int i = 0; i < 200; i++) {
+    Fields fields{Field(TypeId::kTypeInt, 42)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, nullptr));
+  }
+  auto left_key = MakeColumnValueExpression(*table_info->GetSchema(), 0, "ref");
+  auto right_key = MakeColumnValueExpression(*table_info->GetSchema(), 1, "ref");
+  auto left_plan = std::make_shared<SeqScanPlanNode>(table_info->GetSchema(), "table-2");
+  auto right_plan = std::make_shared<SeqScanPlanNode>(table_info->GetSchema(), "table-2");
+  std::vector<Column *> out_columns = {new Column("ref", TypeId::kTypeInt, 0, false, false),
+                                       new Column("ref", TypeId::kTypeInt, 1, false, false)};
+  Schema out_schema(out_columns);
+  // splitting the partition again never separates equal keys, the last level is built in memory
+  HashJoinPlanNode plan(&out_schema, left_plan, right_plan, {left_key}, {right_key}, nullptr, PAGE_SIZE);
+  HashJoinExecutor executor(GetExecutorContext(), &plan,
+                            std::make_unique<SeqScanExecutor>(GetExecutorContext(), left_plan.get()),
+                            std::make_unique<SeqScanExecutor>(GetExecutorContext(), right_plan.get()));
+  executor.Init();
+  ASSERT_TRUE(executor.IsRepartitioned());
+  Row row;
+  RowId rid;
+  uint32_t count = 0;
+  while (executor.Next(&row, &rid)) {
+    count++;
+  }
+  ASSERT_EQ(200 * 200, count);
+}
+
+// a row larger than a page can not be written to a partition page
+TEST_F(ExecutorTest, HashJoinOversizeRowTest) {
+  std::vector<Column *> columns;
+  std::vector<AbstractExpressionRef> values;
+  std::string text(VARCHAR_MAX_LEN - 1, 'x');
+  for (uint32_t i = 0; i < 3; i++) {
+    columns.push_back(new Column("text" + std::to_string(i), TypeId::kTypeChar, VARCHAR_MAX_LEN, i, true, false));
+    values.push_back(
+        MakeConstantValueExpression(Field(kTypeChar, const_cast<char *>(text.c_str()), text.size(), true)));
+  }
+  Schema schema(columns);
+  std::vector<std::vector<AbstractExpressionRef>> raw_values(4, values);
+  auto values_plan = std::make_shared<ValuesPlanNode>(&schema, raw_values);
+  auto left_key = MakeColumnValueExpression(schema, 0, "text0");
+  auto right_key = MakeColumnValueExpression(schema, 1, "text0");
+  std::vector<Column *> out_columns = {new Column("text0", TypeId::kTypeChar, VARCHAR_MAX_LEN, 0, true, false)};
+  Schema out_schema(out_columns);
+  // neither side fits the budget, so both are partitioned and the first spill meets a row too large for a page
+  HashJoinPlanNode plan(&out_schema, values_plan, values_plan, {left_key}, {right_key}, nullptr, PAGE_SIZE);
+  HashJoinExecutor executor(GetExecutorContext(), &plan,
+                            std::make_unique<ValuesExecutor>(GetExecutorContext(), values_plan.get()),
+                            std::make_unique<ValuesExecutor>(GetExecutorContext(), values_plan.get()));
+  ASSERT_THROW(executor.Init(), std::runtime_error);
+}
+
+/** A ValuesExecutor that counts its Next calls. */
+class CountingValuesExecutor : public ValuesExecutor {
+ public:
+  using ValuesExecutor::ValuesExecutor;
+
+  bool Next(Row *row, RowId *rid) override {
+    calls_++;
+    return ValuesExecutor::Next(row, rid);
+  }
+
+  uint32_t calls_{0};
+};
+
+TEST_F(ExecutorTest, IndexNestedLoopJoinTest) {
+  TableInfo *inner_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", inner_info);
+  IndexInfo *index_info = nullptr;
+  std::vector<std::string> index_keys{"id"};
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-1", index_keys, GetTxn(),
+                                                                        index_info, "bptree"));
+  ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->BuildFromHeap(inner_info->GetTableHeap(), GetTxn()));
+  // a repeated key is probed once, a missing key and a null find nothing
+  std::vector<std::vector<AbstractExpressionRef>> raw_values;
+  for (const auto &field : {Field(kTypeInt, 42), Field(kTypeInt, 7), Field(kTypeInt, 5000), Field(kTypeInt),
+                            Field(kTypeInt, 42)}) {
+    raw_values.push_back({MakeConstantValueExpression(field)});
+  }
+  std::vector<Column *> outer_columns = {new Column("ref", TypeId::kTypeInt, 0, true, false)};
+  Schema outer_schema(outer_columns);
+  auto outer_plan = std::make_shared<ValuesPlanNode>(&outer_schema, raw_values);
+  auto outer_key = MakeColumnValueExpression(outer_schema, 0, "ref");
+  std::vector<Column *> out_columns = {new Column("ref", TypeId::kTypeInt, 0, false, false),
+                                       new Column("id", TypeId::kTypeInt, 1, false, false)};
+  Schema out_schema(out_columns);
+  IndexNestedLoopJoinPlanNode plan(&out_schema, outer_plan, "table-1", index_info, {outer_key}, nullptr, nullptr);
+  auto outer = std::make_unique<CountingValuesExecutor>(GetExecutorContext(), outer_plan.get());
+  auto outer_calls = &outer->calls_;
+  IndexNestedLoopJoinExecutor executor(GetExecutorContext(), &plan, std::move(outer));
+  executor.Init();
+  std::vector<int32_t> ids;
+  Row row;
+  RowId rid;
+  while (executor.Next(&row, &rid)) {
+    ASSERT_TRUE(row.GetField(0)->CompareEquals(*row.GetField(1)));
+    ids.push_back(std::stoi(row.GetField(1)->toString()));
+  }
+  ASSERT_EQ((std::vector<int32_t>{7, 42, 42}), ids);
+  // the outer side is not read again once it ended
+  ASSERT_FALSE(executor.Next(&row, &rid));
+  ASSERT_EQ(raw_values.size() + 1, *outer_calls);
+}
+
+TEST_F(ExecutorTest, SortTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  auto scan_plan = std::make_shared<SeqScanPlanNode>(table_info->GetSchema(), "table-1");
+  auto col_id = MakeColumnValueExpression(*table_info->GetSchema(), 0, "id");
+  // a budget every row fits in, and one that writes many runs and merges them
+  for (uint32_t budget : {1u << 30, static_cast<uint32_t>(PAGE_SIZE)}) {
+    SortPlanNode plan(table_info->GetSchema(), scan_plan, {{OrderByType::Desc, col_id}}, budget);
+    SortExecutor executor(GetExecutorContext(), &plan,
+                          std::make_unique<SeqScanExecutor>(GetExecutorContext(), scan_plan.get()));
+    executor.Init();
+    ASSERT_EQ(budget < PAGE_SIZE * 2, executor.GetSpilledRunCount() > 1);
+    Row row;
+    RowId rid;
+    int32_t expected = 999;
+    while (executor.Next(&row, &rid)) {
+      ASSERT_TRUE(row.GetField(0)->CompareEquals(Field(kTypeInt, expected)));
+      expected--;
+    }
+    ASSERT_EQ(-1, expected);
+  }
+}
+
+TEST_F(ExecutorTest, SortOversizeRowTest) {
+  std::vector<Column *> columns;
+  std::vector<AbstractExpressionRef> values;
+  std::string text(VARCHAR_MAX_LEN - 1, 'x');
+  for (uint32_t i = 0; i < 3; i++) {
+    columns.push_back(new Column("text" + std::to_string(i), TypeId::kTypeChar, VARCHAR_MAX_LEN, i, true, false));
+    values.push_back(
+        MakeConstantValueExpression(Field(kTypeChar, const_cast<char *>(text.c_str()), text.size(), true)));
+  }
+  Schema schema(columns);
+  std::vector<std::vector<AbstractExpressionRef>> raw_values(4, values);
+  auto values_plan = std::make_shared<ValuesPlanNode>(&schema, raw_values);
+  auto col_text = MakeColumnValueExpression(schema, 0, "text0");
+  // the rows exceed the budget, and writing the first run meets a row too large for a page
+  SortPlanNode plan(&schema, values_plan, {{OrderByType::Asc, col_text}}, PAGE_SIZE);
+  SortExecutor executor(GetExecutorContext(), &plan,
+                        std::make_unique<ValuesExecutor>(GetExecutorContext(), values_plan.get()));
+  ASSERT_THROW(executor.Init(), std::runtime_error);
+}
+
+TEST(SortKeyTest, NormalizedKeyOrder) {
+  // every field sorts after the ones before it
+  auto check = [](const std::vector<Field> &fields, bool descending) {
+    std::vector<std::string> keys;
+    for (const auto &field : fields) {
+      keys.emplace_back();
+      SortExecutor::AppendSortKey(field, descending, keys.back());
+    }
+    for (size_t i = 1; i < keys.size(); i++) {
+      ASSERT_LT(keys[i - 1], keys[i]) << i;
+    }
+  };
+  check({Field(kTypeInt), Field(kTypeInt, INT32_MIN), Field(kTypeInt, -1), Field(kTypeInt, 0), Field(kTypeInt, 1),
+         Field(kTypeInt, INT32_MAX)},
+        false);
+  check({Field(kTypeInt, 256), Field(kTypeInt, 255), Field(kTypeInt, -255), Field(kTypeInt)}, true);
+  check({Field(kTypeFloat), Field(kTypeFloat, -2.5f), Field(kTypeFloat, -0.5f), Field(kTypeFloat, 0.0f),
+         Field(kTypeFloat, 0.25f), Field(kTypeFloat, 3.0f)},
+        false);
+  char a[] = "a", ab[] = "ab", b[] = "b", nul[] = {'a', 0, 'c'};
+  check({Field(kTypeChar), Field(kTypeChar, a, 1, false), Field(kTypeChar, nul, 3, false),
+         Field(kTypeChar, ab, 2, false), Field(kTypeChar, b, 1, false)},
+        false);
+  std::string negative_zero, zero;
+  SortExecutor::AppendSortKey(Field(kTypeFloat, -0.0f), false, negative_zero);
+  SortExecutor::AppendSortKey(Field(kTypeFloat, 0.0f), false, zero);
+  ASSERT_EQ(zero, negative_zero);
+}
+
+// SELECT * FROM table-1 LIMIT 5 OFFSET 990, then LIMIT 0
+TEST_F(ExecutorTest, LimitTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  auto scan_plan = std::make_shared<SeqScanPlanNode>(table_info->GetSchema(), "table-1");
+  // a short row may fill a gap of an earlier page, so the ids are compared in scan order rather than id order
+  std::vector<Row> scanned{};
+  GetExecutionEngine()->ExecutePlan(scan_plan, &scanned, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(1000, scanned.size());
+  LimitPlanNode plan(table_info->GetSchema(), scan_plan, 5, 990);
+  LimitExecutor executor(GetExecutorContext(), &plan,
+                         std::make_unique<SeqScanExecutor>(GetExecutorContext(), scan_plan.get()));
+  executor.Init();
+  Row row;
+  RowId rid;
+  size_t expected = 990;
+  while (executor.Next(&row, &rid)) {
+    ASSERT_TRUE(row.GetField(0)->CompareEquals(*scanned[expected].GetField(0)));
+    expected++;
+  }
+  ASSERT_EQ(995, expected);
+  ASSERT_FALSE(executor.Next(&row, &rid));
+  LimitPlanNode empty_plan(table_info->GetSchema(), scan_plan, 0);
+  LimitExecutor empty_executor(GetExecutorContext(), &empty_plan,
+                               std::make_unique<SeqScanExecutor>(GetExecutorContext(), scan_plan.get()));
+  empty_executor.Init();
+  ASSERT_FALSE(empty_executor.Next(&row, &rid));
+}
+
+TEST_F(ExecutorTest, TopNTest) {
+  // keys with duplicates and nulls, the second column records the arrival order
+  std::vector<Column *> columns = {new Column("k", TypeId::kTypeInt, 0, true, false),
+                                   new Column("seq", TypeId::kTypeInt, 1, false, false)};
+  Schema schema(columns);
+  std::vector<std::vector<AbstractExpressionRef>> raw_values;
+  std::vector<std::pair<int32_t, int32_t>> rows;
+  for (int32_t i = 0; i < 500; i++) {
+    int32_t key = (i * 37) % 50;
+    Field field = key == 7 ? Field(kTypeInt) : Field(kTypeInt, key);
+    raw_values.push_back({MakeConstantValueExpression(field), MakeConstantValueExpression(Field(kTypeInt, i))});
+    rows.emplace_back(key == 7 ? INT32_MAX : key, i);
+  }
+  auto values_plan = std::make_shared<ValuesPlanNode>(&schema, raw_values);
+  auto col_k = MakeColumnValueExpression(schema, 0, "k");
+  std::vector<Column *> out_columns = {new Column("seq", TypeId::kTypeInt, 1, false, false)};
+  Schema out_schema(out_columns);
+  // descending puts the nulls last, equal keys keep their arrival order
+  std::stable_sort(rows.begin(), rows.end(), [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+  std::stable_partition(rows.begin(), rows.end(), [](const auto &entry) { return entry.first != INT32_MAX; });
+  for (uint32_t n : {0u, 1u, 25u, 500u, 1000u}) {
+    TopNPlanNode plan(&out_schema, values_plan, {{OrderByType::Desc, col_k}}, n);
+    TopNExecutor executor(GetExecutorContext(), &plan,
+                          std::make_unique<ValuesExecutor>(GetExecutorContext(), values_plan.get()));
+    executor.Init();
+    std::vector<int32_t> result;
+    Row row;
+    RowId rid;
+    while (executor.Next(&row, &rid)) {
+      ASSERT_EQ(1u, row.GetFieldCount());
+      result.push_back(std::stoi(row.GetField(0)->toString()));
+    }
+    std::vector<int32_t> expected;
+    for (size_t i = 0; i < std::min<size_t>(n, rows.size()); i++) {
+      expected.push_back(rows[i].second);
+    }
+    ASSERT_EQ(expected, result) << n;
+  }
+}
+
+TEST(ResultStreamTest, TableAndTsv) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, true, false),
+                                   new Column("name", TypeId::kTypeChar, 16, 1, true, false)};
+  Schema schema(columns);
+  char plain[] = "ab", special[] = "a\tb\\c";
+  std::vector<std::vector<Field>> values = {{Field(kTypeInt, 7), Field(kTypeChar, plain, 2, false)},
+                                            {Field(kTypeInt, 12345), Field(kTypeChar, special, 5, false)},
+                                            {Field(kTypeInt, 1), Field(kTypeChar)}};
+  std::vector<Row> rows;
+  for (auto &fields : values) {
+    rows.emplace_back(fields);
+  }
+  std::stringstream tsv;
+  ResultStream tsv_stream(tsv, &schema, ResultFormat::Tsv);
+  for (const auto &row : rows) {
+    tsv_stream.Push(row);
+  }
+  tsv_stream.Finish();
+  ASSERT_EQ("id\tname\n7\tab\n12345\ta\\tb\\\\c\n1\t\\N\n", tsv.str());
+  ASSERT_EQ(3u, tsv_stream.GetRowCount());
+  // a result shorter than the sample is laid out on all of its rows
+  std::stringstream table;
+  ResultStream table_stream(table, &schema, ResultFormat::Table);
+  table_stream.Push(rows[0]);
+  table_stream.Push(rows[1]);
+  table_stream.Finish();
+  std::string line;
+  std::vector<std::string> lines;
+  while (std::getline(table, line)) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(6u, lines.size());
+  ASSERT_EQ(lines[0], lines[2]);
+  ASSERT_EQ(lines[0], lines[5]);
+  for (const auto &text : lines) {
+    ASSERT_EQ(lines[0].size(), text.size());
+  }
+  ASSERT_EQ("| 7     | ab    |", lines[3]);
+}
+
+TEST_F(ExecutorTest, MergeJoinTest) {
+  // both sides ordered by their key, with duplicates on both sides and nulls that never match
+  auto make_values = [this](const std::vector<Field> &fields) {
+    std::vector<std::vector<AbstractExpressionRef>> raw_values;
+    for (const auto &field : fields) {
+      raw_values.push_back({MakeConstantValueExpression(field)});
+    }
+    return raw_values;
+  };
+  std::vector<Column *> left_columns = {new Column("a", TypeId::kTypeInt, 0, true, false)};
+  Schema left_schema(left_columns);
+  std::vector<Column *> right_columns = {new Column("b", TypeId::kTypeInt, 0, true, false)};
+  Schema right_schema(right_columns);
+  auto left_plan = std::make_shared<ValuesPlanNode>(
+      &left_schema, make_values({Field(kTypeInt), Field(kTypeInt, 1), Field(kTypeInt, 2), Field(kTypeInt, 2),
+                                 Field(kTypeInt, 4), Field(kTypeInt, 5)}));
+  auto right_plan = std::make_shared<ValuesPlanNode>(
+      &right_schema, make_values({Field(kTypeInt), Field(kTypeInt, 2), Field(kTypeInt, 2), Field(kTypeInt, 2),
+                                  Field(kTypeInt, 3), Field(kTypeInt, 5)}));
+  std::vector<Column *> out_columns = {new Column("a", TypeId::kTypeInt, 0, false, false),
+                                       new Column("b", TypeId::kTypeInt, 1, false, false)};
+  Schema out_schema(out_columns);
+  MergeJoinPlanNode plan(&out_schema, left_plan, right_plan, MakeColumnValueExpression(left_schema, 0, "a"),
+                         MakeColumnValueExpression(right_schema, 0, "b"));
+  MergeJoinExecutor executor(GetExecutorContext(), &plan,
+                             std::make_unique<ValuesExecutor>(GetExecutorContext(), left_plan.get()),
+                             std::make_unique<ValuesExecutor>(GetExecutorContext(), right_plan.get()));
+  executor.Init();
+  std::vector<int32_t> keys;
+  Row row;
+  RowId rid;
+  while (executor.Next(&row, &rid)) {
+    ASSERT_TRUE(row.GetField(0)->CompareEquals(*row.GetField(1)));
+    keys.push_back(std::stoi(row.GetField(0)->toString()));
+  }
+  ASSERT_EQ((std::vector<int32_t>{2, 2, 2, 2, 2, 2, 5}), keys);
+}
+
+// SELECT k, count(*), sum(v), min(v), max(v), avg(v) FROM table-2 GROUP BY k
+TEST_F(ExecutorTest, AggregationTest) {
+  std::vector<Column *> columns = {new Column("k", TypeId::kTypeInt, 0, true, false),
+                                   new Column("v", TypeId::kTypeInt, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  GetExecutorContext()->GetCatalog()->CreateTable("table-2", schema.get(), GetTxn(), table_info);
+  for (int i = 0; i < 2000; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i % 10), Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, nullptr));
+  }
+  auto scan_plan = std::make_shared<SeqScanPlanNode>(table_info->GetSchema(), "table-2");
+  auto col_k = MakeColumnValueExpression(*table_info->GetSchema(), 0, "k");
+  auto col_v = MakeColumnValueExpression(*table_info->GetSchema(), 0, "v");
+  std::vector<Column *> out_columns = {
+      new Column("k", TypeId::kTypeInt, 0, false, false),      new Column("count", TypeId::kTypeInt, 1, false, false),
+      new Column("sum", TypeId::kTypeInt, 2, false, false),    new Column("min", TypeId::kTypeInt, 3, false, false),
+      new Column("max", TypeId::kTypeInt, 4, false, false),    new Column("avg", TypeId::kTypeFloat, 5, false, false)};
+  Schema out_schema(out_columns);
+  // a budget all groups fit in, and one that writes partial groups to pages after every batch
+  for (uint32_t budget : {1u << 30, 1u}) {
+    AggregationPlanNode plan(&out_schema, scan_plan, {col_k}, {nullptr, col_v, col_v, col_v, col_v},
+                             {AggregationType::CountStar, AggregationType::Sum, AggregationType::Min,
+                              AggregationType::Max, AggregationType::Avg},
+                             budget);
+    AggregationExecutor executor(GetExecutorContext(), &plan,
+                                 std::make_unique<SeqScanExecutor>(GetExecutorContext(), scan_plan.get()));
+    executor.Init();
+    ASSERT_EQ(budget == 1, executor.IsSpilled());
+    ASSERT_EQ(budget == 1, executor.IsRepartitioned());
+    std::vector<bool> seen(10, false);
+    Row row;
+    RowId rid;
+    while (executor.Next(&row, &rid)) {
+      int32_t k = std::stoi(row.GetField(0)->toString());
+      ASSERT_FALSE(seen[k]);
+      seen[k] = true;
+      ASSERT_TRUE(row.GetField(1)->CompareEquals(Field(kTypeInt, 200)));
+      ASSERT_TRUE(row.GetField(2)->CompareEquals(Field(kTypeInt, 200 * k + 199000)));
+      ASSERT_TRUE(row.GetField(3)->CompareEquals(Field(kTypeInt, k)));
+      ASSERT_TRUE(row.GetField(4)->CompareEquals(Field(kTypeInt, 1990 + k)));
+      ASSERT_TRUE(row.GetField(5)->CompareEquals(Field(kTypeFloat, (200.f * k + 199000) / 200)));
+    }
+    ASSERT_EQ(std::vector<bool>(10, true), seen);
+  }
+  // without group by there is exactly one group, even for no input
+  std::vector<Column *> count_columns = {new Column("count", TypeId::kTypeInt, 0, false, false),
+                                         new Column("sum", TypeId::kTypeInt, 1, false, false)};
+  Schema count_schema(count_columns);
+  auto empty_plan = std::make_shared<SeqScanPlanNode>(table_info->GetSchema(), "table-2",
+                                                      MakeComparisonExpression(col_k, MakeConstantValueExpression(
+                                                                                          Field(kTypeInt, 10)),
+                                                                               "="));
+  for (const auto &child_plan : {scan_plan, empty_plan}) {
+    AggregationPlanNode plan(&count_schema, child_plan, {}, {nullptr, col_v},
+                             {AggregationType::CountStar, AggregationType::Sum});
+    AggregationExecutor executor(GetExecutorContext(), &plan,
+                                 std::make_unique<SeqScanExecutor>(GetExecutorContext(), child_plan.get()));
+    executor.Init();
+    Row row;
+    RowId rid;
+    ASSERT_TRUE(executor.Next(&row, &rid));
+    if (child_plan == scan_plan) {
+      ASSERT_TRUE(row.GetField(0)->CompareEquals(Field(kTypeInt, 2000)));
+      ASSERT_TRUE(row.GetField(1)->CompareEquals(Field(kTypeInt, 1999000)));
+    } else {
+      ASSERT_TRUE(row.GetField(0)->CompareEquals(Field(kTypeInt, 0)));
+      ASSERT_TRUE(row.GetField(1)->IsNull());
+    }
+    ASSERT_FALSE(executor.Next(&row, &rid));
+  }
+}
+
+// SELECT k, count(*), sum(v) FROM table-2 GROUP BY k, with more groups than one partition holds
+TEST_F(ExecutorTest, AggregationRepartitionTest) {
+  std::vector<Column *> columns = {new Column("k", TypeId::kTypeInt, 0, true, false),
+                                   new Column("v", TypeId::kTypeInt, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  GetExecutorContext()->GetCatalog()->CreateTable("table-2", schema.get(), GetTxn(), table_info);
+  for (int i = 0; i < 8000; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i % 4000), Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, nullptr));
+  }
+  auto scan_plan = std::make_shared<SeqScanPlanNode>(table_info->GetSchema(), "table-2");
+  auto col_k = MakeColumnValueExpression(*table_info->GetSchema(), 0, "k");
+  auto col_v = MakeColumnValueExpression(*table_info->GetSchema(), 0, "v");
+  std::vector<Column *> out_columns = {new Column("k", TypeId::kTypeInt, 0, false, false),
+                                       new Column("count", TypeId::kTypeInt, 1, false, false),
+                                       new Column("sum", TypeId::kTypeInt, 2, false, false)};
+  Schema out_schema(out_columns);
+  // a sixteenth of the groups exceeds the budget, a split of it fits
+  AggregationPlanNode plan(&out_schema, scan_plan, {col_k}, {nullptr, col_v},
+                           {AggregationType::CountStar, AggregationType::Sum}, 16 * 1024);
+  AggregationExecutor executor(GetExecutorContext(), &plan,
+                               std::make_unique<SeqScanExecutor>(GetExecutorContext(), scan_plan.get()));
+  executor.Init();
+  ASSERT_TRUE(executor.IsSpilled());
+  std::vector<bool> seen(4000, false);
+  Row row;
+  RowId rid;
+  while (executor.Next(&row, &rid)) {
+    int32_t k = std::stoi(row.GetField(0)->toString());
+    ASSERT_FALSE(seen[k]);
+    seen[k] = true;
+    ASSERT_TRUE(row.GetField(1)->CompareEquals(Field(kTypeInt, 2)));
+    ASSERT_TRUE(row.GetField(2)->CompareEquals(Field(kTypeInt, 2 * k + 4000)));
+  }
+  ASSERT_TRUE(executor.IsRepartitioned());
+  ASSERT_EQ(std::vector<bool>(4000, true), seen);
+}
+
+TEST_F(ExecutorTest, AggregationOversizeGroupTest) {
+  std::vector<Column *> columns;
+  std::vector<AbstractExpressionRef> values;
+  std::vector<AbstractExpressionRef> group_bys;
+  std::string text(VARCHAR_MAX_LEN - 1, 'x');
+  for (uint32_t i = 0; i < 3; i++) {
+    columns.push_back(new Column("text" + std::to_string(i), TypeId::kTypeChar, VARCHAR_MAX_LEN, i, true, false));
+    values.push_back(
+        MakeConstantValueExpression(Field(kTypeChar, const_cast<char *>(text.c_str()), text.size(), true)));
+  }
+  Schema schema(columns);
+  for (uint32_t i = 0; i < 3; i++) {
+    group_bys.push_back(MakeColumnValueExpression(schema, 0, "text" + std::to_string(i)));
+  }
+  std::vector<std::vector<AbstractExpressionRef>> raw_values(4, values);
+  auto values_plan = std::make_shared<ValuesPlanNode>(&schema, raw_values);
+  std::vector<Column *> out_columns = {new Column("count", TypeId::kTypeInt, 3, false, false)};
+  Schema out_schema(out_columns);
+  // the single group exceeds the budget, and spilling it meets a group too large for a page
+  AggregationPlanNode plan(&out_schema, values_plan, group_bys, {nullptr}, {AggregationType::CountStar}, PAGE_SIZE);
+  AggregationExecutor executor(GetExecutorContext(), &plan,
+                               std::make_unique<ValuesExecutor>(GetExecutorContext(), values_plan.get()));
+  ASSERT_THROW(executor.Init(), std::runtime_error);
+}
+
+// SELECT sum(v) FROM table-2 where the sum does not fit in an int
+TEST_F(ExecutorTest, AggregationOverflowTest) {
+  std::vector<Column *> columns = {new Column("v", TypeId::kTypeInt, 0, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  GetExecutorContext()->GetCatalog()->CreateTable("table-2", schema.get(), GetTxn(), table_info);
+  for (int i = 0; i < 3; i++) {
+    Fields fields{Field(TypeId::kTypeInt, 1 << 30)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, nullptr));
+  }
+  auto scan_plan = std::make_shared<SeqScanPlanNode>(table_info->GetSchema(), "table-2");
+  auto col_v = MakeColumnValueExpression(*table_info->GetSchema(), 0, "v");
+  std::vector<Column *> out_columns = {new Column("sum", TypeId::kTypeInt, 0, false, false),
+                                       new Column("avg", TypeId::kTypeFloat, 1, false, false)};
+  Schema out_schema(out_columns);
+  AggregationPlanNode plan(&out_schema, scan_plan, {}, {col_v, col_v}, {AggregationType::Sum, AggregationType::Avg});
+  AggregationExecutor executor(GetExecutorContext(), &plan,
+                               std::make_unique<SeqScanExecutor>(GetExecutorContext(), scan_plan.get()));
+  executor.Init();
+  Row row;
+  RowId rid;
+  ASSERT_THROW(executor.Next(&row, &rid), std::overflow_error);
+}
+
+TEST(QuerySchedulerTest, RunAndRepartition) {
+  ThreadPool pool(3);
+  QueryScheduler scheduler(8, &pool);
+  ASSERT_EQ(4, scheduler.GetWorkerCount());
+  // every worker runs once and routes its own items
+  std::atomic<uint32_t> runs{0};
+  RepartitionExchange<int> exchange(scheduler.GetWorkerCount(), 3);
+  scheduler.Run([&](uint32_t worker) {
+    runs += 1u << (worker * 8);
+    for (int i = 0; i < 30; i++) {
+      exchange.Push(worker, i % 3, worker * 100 + i);
+    }
+  });
+  ASSERT_EQ(0x01010101u, runs.load());
+  ASSERT_EQ(3, exchange.GetPartitionCount());
+  for (uint32_t partition = 0; partition < 3; partition++) {
+    auto items = exchange.TakePartition(partition);
+    ASSERT_EQ(40, items.size());
+    for (auto item : items) {
+      ASSERT_EQ(partition, item % 100 % 3);
+    }
+    ASSERT_TRUE(exchange.TakePartition(partition).empty());
+  }
+  // the first exception of a worker reaches the caller after all of them stopped
+  ASSERT_THROW(scheduler.Run([](uint32_t worker) {
+    if (worker == 0) {
+      throw std::runtime_error("worker failed");
+    }
+  }),
+               std::runtime_error);
+  // a group waits only for the tasks that started
+  TaskGroup group(&pool);
+  std::atomic<int> done{0};
+  for (int i = 0; i < 100; i++) {
+    group.Submit([&done]() { done++; });
+  }
+  group.Wait();
+  int finished = done.load();
+  ASSERT_LE(finished, 100);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ASSERT_EQ(finished, done.load());
+}
+
+TEST_F(ExecutorTest, GatherTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  auto scan_plan = std::make_shared<SeqScanPlanNode>(table_info->GetSchema(), "table-1");
+  auto gather_plan = std::make_shared<GatherPlanNode>(table_info->GetSchema(), scan_plan, 4);
+  // every row comes out exactly once, in any order
+  GatherExecutor executor(GetExecutorContext(), gather_plan.get());
+  executor.Init();
+  std::vector<bool> seen(1000, false);
+  Row row;
+  RowId rid;
+  while (executor.Next(&row, &rid)) {
+    int32_t value = *reinterpret_cast<const int32_t *>(row.GetField(0)->GetData());
+    ASSERT_FALSE(seen[value]);
+    seen[value] = true;
+  }
+  ASSERT_EQ(std::vector<bool>(1000, true), seen);
+  // an aggregation over a gather folds on the workers and gives the same groups as over the scan
+  auto col_id = MakeColumnValueExpression(*table_info->GetSchema(), 0, "id");
+  std::vector<Column *> columns = {new Column("count", TypeId::kTypeInt, 0, false, false),
+                                   new Column("sum", TypeId::kTypeInt, 1, false, false)};
+  Schema out_schema(columns);
+  AggregationPlanNode plan(&out_schema, gather_plan, {}, {nullptr, col_id},
+                           {AggregationType::CountStar, AggregationType::Sum});
+  AggregationExecutor aggregation(GetExecutorContext(), &plan,
+                                  std::make_unique<GatherExecutor>(GetExecutorContext(), gather_plan.get()));
+  aggregation.Init();
+  ASSERT_TRUE(aggregation.Next(&row, &rid));
+  ASSERT_TRUE(row.GetField(0)->CompareEquals(Field(kTypeInt, 1000)));
+  ASSERT_TRUE(row.GetField(1)->CompareEquals(Field(kTypeInt, 499500)));
+  ASSERT_FALSE(aggregation.Next(&row, &rid));
+}
+
+TEST_F(ExecutorTest, IndexOnlyScanTest) {
+  TableInfo *table_info = CreateTable("cover", 1000);
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("cover", "cover_id", {"id"}, GetTxn(),
+                                                                        index_info, "bptree", {"name"}));
+  ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->BuildFromHeap(table_info->GetTableHeap(), GetTxn()));
+  // the key and include columns hold the whole projection
+  auto plan = PlanQuery("select id, name from cover where id < 100;");
+  ASSERT_EQ(PlanType::IndexScan, plan->GetType());
+  ASSERT_TRUE(dynamic_pointer_cast<const IndexScanPlanNode>(plan)->index_only_);
+  // the rows come from the index entries alone, they are still found once the heap lost them
+  std::vector<RowId> row_ids;
+  for (auto iter = table_info->GetTableHeap()->Begin(GetTxn()); iter != table_info->GetTableHeap()->End(); ++iter) {
+    row_ids.push_back(iter.GetRowId());
+  }
+  for (const auto &rid : row_ids) {
+    table_info->GetTableHeap()->ApplyDelete(rid, GetTxn());
+  }
+  std::vector<Row> result_set{};
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(100, result_set.size());
+  for (size_t i = 0; i < result_set.size(); i++) {
+    std::string name = "name" + std::to_string(i);
+    ASSERT_TRUE(result_set[i].GetField(0)->CompareEquals(Field(kTypeInt, static_cast<int32_t>(i))));
+    ASSERT_TRUE(result_set[i].GetField(1)->CompareEquals(
+        Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), false)));
+  }
+}
+
+TEST_F(ExecutorTest, IndexScanUncoveredTest) {
+  TableInfo *table_info = CreateTable("cover", 1000);
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("cover", "cover_id", {"id"}, GetTxn(),
+                                                                        index_info, "bptree", {"name"}));
+  ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->BuildFromHeap(table_info->GetTableHeap(), GetTxn()));
+  // account is neither a key nor an include column, the rows are read from the heap
+  auto plan = PlanQuery("select id, account from cover where id < 100;");
+  ASSERT_EQ(PlanType::IndexScan, plan->GetType());
+  ASSERT_FALSE(dynamic_pointer_cast<const IndexScanPlanNode>(plan)->index_only_);
+  std::vector<Row> result_set{};
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(100, result_set.size());
+  for (size_t i = 0; i < result_set.size(); i++) {
+    ASSERT_TRUE(result_set[i].GetField(0)->CompareEquals(Field(kTypeInt, static_cast<int32_t>(i))));
+    ASSERT_TRUE(result_set[i].GetField(1)->CompareEquals(Field(kTypeFloat, i / 2.f)));
+  }
+}
+
+TEST_F(ExecutorTest, BitmapCountTest) {
+  TableInfo *table_info = CreateTable("bits", 1000);
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("bits", "bits_id", {"id"}, GetTxn(),
+                                                                        index_info, "bitmap"));
+  ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->BuildFromHeap(table_info->GetTableHeap(), GetTxn()));
+  auto plan = PlanQuery("select count(*) from bits where id < 100 or id = 500;");
+  ASSERT_EQ(PlanType::Aggregation, plan->GetType());
+  ASSERT_EQ(PlanType::BitmapScan, plan->GetChildAt(0)->GetType());
+  // the bitmaps answer the whole predicate, the count comes from them even once the heap lost the rows
+  std::vector<RowId> row_ids;
+  for (auto iter = table_info->GetTableHeap()->Begin(GetTxn()); iter != table_info->GetTableHeap()->End(); ++iter) {
+    row_ids.push_back(iter.GetRowId());
+  }
+  for (const auto &rid : row_ids) {
+    table_info->GetTableHeap()->ApplyDelete(rid, GetTxn());
+  }
+  std::vector<Row> result_set{};
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(1, result_set.size());
+  ASSERT_TRUE(result_set[0].GetField(0)->CompareEquals(Field(kTypeInt, 101)));
+  // the name filter is not in a bitmap, the candidate rows are fetched and none is left
+  plan = PlanQuery("select count(*) from bits where id < 100 and name = \"name5\";");
+  ASSERT_EQ(PlanType::BitmapScan, plan->GetChildAt(0)->GetType());
+  result_set.clear();
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(1, result_set.size());
+  ASSERT_TRUE(result_set[0].GetField(0)->CompareEquals(Field(kTypeInt, 0)));
+}
+
+TEST_F(ExecutorTest, BitmapScanFallbackTest) {
+  TableInfo *table_info = CreateTable("bits", 1000);
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("bits", "bits_name", {"name"}, GetTxn(),
+                                                                        index_info, "bitmap"));
+  ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->BuildFromHeap(table_info->GetTableHeap(), GetTxn()));
+  auto plan = PlanQuery("select id from bits where name = \"name7\" or name = \"name9\";");
+  ASSERT_EQ(PlanType::BitmapScan, plan->GetType());
+  // a bitmap index can not answer like, the table is scanned instead
+  plan = PlanQuery("select id from bits where name like \"name99%\" or name = \"name7\";");
+  ASSERT_NE(PlanType::BitmapScan, plan->GetType());
+  std::vector<Row> result_set{};
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  std::vector<int32_t> ids;
+  for (const auto &row : result_set) {
+    ids.push_back(std::stoi(row.GetField(0)->toString()));
+  }
+  std::sort(ids.begin(), ids.end());
+  ASSERT_EQ((std::vector<int32_t>{7, 99, 990, 991, 992, 993, 994, 995, 996, 997, 998, 999}), ids);
+}
+
+TEST_F(ExecutorTest, LikeBinderTest) {
+  CreateTable("texts", 100);
+  auto plan = PlanQuery("select id from texts where name like \"name1%\";");
+  std::vector<Row> result_set{};
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(11, result_set.size());
+  // a number column is never read as text
+  ASSERT_THROW(PlanQuery("select id from texts where id like 1;"), std::logic_error);
+  ASSERT_THROW(PlanQuery("select id from texts where account like 1;"), std::logic_error);
+}
+
+TEST_F(ExecutorTest, PrimaryKeyWithoutPayloadTest) {
+  ExecuteEngine engine;
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(engine, "create database payload_test;"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(engine, "use payload_test;"));
+  // rows live in the table heap only, a table can not be organized by its primary key
+  ASSERT_NE(DB_SUCCESS, ExecuteSql(engine,
+                                   "create table people(id int, name char(16), account float, primary key(id)) "
+                                   "organized by primary key;"));
+  ASSERT_EQ(DB_SUCCESS,
+            ExecuteSql(engine, "create table people(id int, name char(16), account float, primary key(id));"));
+  // neither the primary key index nor a secondary index carries columns that were not asked for
+  auto catalog = engine.GetCurrentDatabase()->catalog_mgr_;
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->GetIndex("people", "people_primary_key", index_info));
+  ASSERT_EQ(1, index_info->GetIndexKeySchema()->GetColumnCount());
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(engine, "create index people_name on people(name);"));
+  ASSERT_EQ(DB_SUCCESS, catalog->GetIndex("people", "people_name", index_info));
+  ASSERT_EQ(1, index_info->GetIndexKeySchema()->GetColumnCount());
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(engine, "drop database payload_test;"));
+}
+
+TEST_F(ExecutorTest, ConcurrentBuildSideLogTest) {
+  TableInfo *table_info = CreateTable("build", 100);
+  auto heap = table_info->GetTableHeap();
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("build", "build_id", {"id"}, GetTxn(),
+                                                                        index_info, "bptree", {}, true));
+  ASSERT_TRUE(index_info->IsBuilding());
+  auto key_of = [&](Row &row) {
+    Row key;
+    row.GetKeyFromRow(table_info->GetSchema(), index_info->GetIndexKeySchema(), key);
+    return key;
+  };
+  auto id_key = [](int32_t id) {
+    Fields fields{Field(kTypeInt, id)};
+    return Row(fields);
+  };
+  // the heap scan of the build, split so that writers run in the middle of it
+  auto scan = [&](int32_t begin, int32_t end) {
+    for (auto iter = heap->Begin(GetTxn()); iter != heap->End(); ++iter) {
+      int32_t id = std::stoi(iter->GetField(0)->toString());
+      if (begin <= id && id < end) {
+        Row row = *iter;
+        ASSERT_EQ(DB_SUCCESS, index_info->BuildEntry(key_of(row), iter.GetRowId(), GetTxn()));
+      }
+    }
+  };
+  auto contains = [&](int32_t id) {
+    std::vector<RowId> result;
+    return index_info->GetIndex()->ScanKey(id_key(id), result, GetTxn()) == DB_SUCCESS;
+  };
+  scan(0, 50);
+  // the planner does not read a building index
+  ASSERT_NE(PlanType::IndexScan, PlanQuery("select * from build where id = 5;")->GetType());
+  // an insert only reaches the side log, a key lookup through the IndexInfo still sees it
+  std::string name = "name200";
+  Fields fields{Field(kTypeInt, 200), Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                Field(kTypeFloat, 100.f)};
+  Row inserted(fields);
+  ASSERT_TRUE(heap->InsertTuple(inserted, GetTxn()));
+  ASSERT_EQ(DB_SUCCESS, index_info->InsertEntry(key_of(inserted), inserted.GetRowId(), GetTxn()));
+  ASSERT_FALSE(contains(200));
+  std::vector<RowId> result;
+  ASSERT_EQ(DB_SUCCESS, index_info->ScanKey(id_key(200), result, GetTxn()));
+  ASSERT_EQ(1, result.size());
+  // deletes of a scanned row and of a row the scan has not reached yet
+  std::vector<std::pair<Row, RowId>> deleted;
+  for (auto iter = heap->Begin(GetTxn()); iter != heap->End(); ++iter) {
+    int32_t id = std::stoi(iter->GetField(0)->toString());
+    if (id == 10 || id == 90) {
+      Row row = *iter;
+      deleted.emplace_back(key_of(row), iter.GetRowId());
+    }
+  }
+  for (auto &entry : deleted) {
+    heap->ApplyDelete(entry.second, GetTxn());
+    ASSERT_EQ(DB_SUCCESS, index_info->RemoveEntry(entry.first, entry.second, GetTxn()));
+  }
+  ASSERT_TRUE(contains(10));
+  result.clear();
+  ASSERT_EQ(DB_KEY_NOT_FOUND, index_info->ScanKey(id_key(10), result, GetTxn()));
+  // the rest of the scan also meets the inserted row, replaying its log entry then adds nothing
+  scan(50, 1000);
+  ASSERT_EQ(DB_SUCCESS, index_info->FinishConcurrentBuild(GetTxn()));
+  ASSERT_FALSE(index_info->IsBuilding());
+  ASSERT_TRUE(contains(5));
+  ASSERT_TRUE(contains(60));
+  ASSERT_TRUE(contains(200));
+  ASSERT_FALSE(contains(10));
+  ASSERT_FALSE(contains(90));
+  ASSERT_EQ(PlanType::IndexScan, PlanQuery("select * from build where id = 5;")->GetType());
+}
+
+TEST_F(ExecutorTest, ConcurrentBuildUniqueConflictTest) {
+  TableInfo *table_info = CreateTable("build", 100);
+  auto heap = table_info->GetTableHeap();
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("build", "build_id", {"id"}, GetTxn(),
+                                                                        index_info, "bptree", {}, true));
+  ASSERT_TRUE(index_info->IsBuilding());
+  std::vector<std::pair<Row, RowId>> rows;
+  for (auto iter = heap->Begin(GetTxn()); iter != heap->End(); ++iter) {
+    Row row = *iter;
+    Row key;
+    row.GetKeyFromRow(table_info->GetSchema(), index_info->GetIndexKeySchema(), key);
+    rows.emplace_back(key, iter.GetRowId());
+  }
+  for (int32_t id = 0; id < 50; id++) {
+    ASSERT_EQ(DB_SUCCESS, index_info->BuildEntry(rows[id].first, rows[id].second, GetTxn()));
+  }
+  // a duplicate of a scanned row is seen by the insert check, one of a row not scanned yet is not
+  std::vector<RowId> result;
+  ASSERT_EQ(DB_SUCCESS, index_info->ScanKey(rows[20].first, result, GetTxn()));
+  result.clear();
+  ASSERT_EQ(DB_KEY_NOT_FOUND, index_info->ScanKey(rows[80].first, result, GetTxn()));
+  std::string name = "name80";
+  Fields fields{Field(kTypeInt, 80), Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                Field(kTypeFloat, 40.f)};
+  Row duplicate(fields);
+  ASSERT_TRUE(heap->InsertTuple(duplicate, GetTxn()));
+  ASSERT_EQ(DB_SUCCESS, index_info->InsertEntry(rows[80].first, duplicate.GetRowId(), GetTxn()));
+  for (int32_t id = 50; id < 100; id++) {
+    ASSERT_EQ(DB_SUCCESS, index_info->BuildEntry(rows[id].first, rows[id].second, GetTxn()));
+  }
+  // replaying the logged duplicate fails the build, the index must not become visible
+  ASSERT_EQ(DB_FAILED, index_info->FinishConcurrentBuild(GetTxn()));
+  ASSERT_TRUE(index_info->IsBuilding());
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->DropIndex("build", "build_id"));
+  ASSERT_NE(DB_SUCCESS, GetExecutorContext()->GetCatalog()->GetIndex("build", "build_id", index_info));
+}
@@ -6,6 +6,7 @@
 #define MINISQL_EXECUTOR_TEST_UTIL_H
 
 #include <cstdio>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -21,8 +22,15 @@
 #include "planner/expressions/column_value_expression.h"
 #include "planner/expressions/comparison_expression.h"
 #include "planner/expressions/constant_value_expression.h"
+#include "planner/planner.h"
 #include "utils/utils.h"
 
+extern "C" {
+int yyparse(void);
+#include "parser/minisql_lex.h"
+#include "parser/parser.h"
+}
+
 /**
  * The ExecutorTest class defines a test fixture for executor tests.
  * Any test that is defined as part of the `ExecutorTest` fixture
@@ -76,6 +84,75 @@ class ExecutorTest : public ::testing::Test {
   /** @return Get the recovery for our test instance. */
   Txn *GetTxn() { return txn_; }
 
+  /**
+   * Create a table of the columns of table-1 whose name the parser accepts, row i holds id i, name "name<i>" and
+   * account i / 2.
+   */
+  TableInfo *CreateTable(const std::string &table_name, int row_count) {
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                     new Column("name", TypeId::kTypeChar, 16, 1, true, false),
+                                     new Column("account", TypeId::kTypeFloat, 2, true, false)};
+    Schema schema(columns);
+    TableInfo *table_info = nullptr;
+    EXPECT_EQ(DB_SUCCESS, db_test_->catalog_mgr_->CreateTable(table_name, &schema, txn_, table_info));
+    for (int i = 0; i < row_count; i++) {
+      std::string name = "name" + std::to_string(i);
+      Fields fields{Field(TypeId::kTypeInt, i),
+                    Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                    Field(TypeId::kTypeFloat, i / 2.f)};
+      Row row(fields);
+      EXPECT_TRUE(table_info->GetTableHeap()->InsertTuple(row, txn_));
+    }
+    return table_info;
+  }
+
+  /**
+   * Parse one statement and plan it the way the execution engine does.
+   * @param context The context of the database to plan against, the one of the fixture if null
+   * @return the plan, null if the statement does not parse
+   */
+  AbstractPlanNodeRef PlanQuery(const std::string &sql, ExecuteContext *context = nullptr) {
+    AbstractPlanNodeRef plan = nullptr;
+    Parse(sql, [&](pSyntaxNode ast) {
+      Planner planner(context == nullptr ? GetExecutorContext() : context);
+      planner.PlanQuery(ast);
+      plan = planner.plan_;
+    });
+    return plan;
+  }
+
+  /**
+   * Run one statement through engine the way the shell does, DDL included.
+   * @return the result of the statement, DB_FAILED if it does not parse
+   */
+  dberr_t ExecuteSql(ExecuteEngine &engine, const std::string &sql) {
+    dberr_t result = DB_FAILED;
+    Parse(sql, [&](pSyntaxNode ast) { result = engine.Execute(ast); });
+    return result;
+  }
+
+  /** Parse sql and hand its syntax tree to visit, an exception of visit is raised once the parser is reset. */
+  void Parse(const std::string &sql, const std::function<void(pSyntaxNode)> &visit) {
+    YY_BUFFER_STATE bp = yy_scan_string(sql.c_str());
+    yy_switch_to_buffer(bp);
+    MinisqlParserInit();
+    yyparse();
+    std::exception_ptr error = nullptr;
+    if (!MinisqlParserGetError()) {
+      try {
+        visit(MinisqlGetParserRootNode());
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    MinisqlParserFinish();
+    yy_delete_buffer(bp);
+    yylex_destroy();
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
   /**
    * Make a column value expression.
    * @param schema The schema for the expression
@@ -0,0 +1,149 @@
+#include "index/adaptive_radix_tree.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "index/art_index.h"
+#include "utils/utils.h"
+
+static std::string EncodeInt(int32_t value) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+  std::string bytes;
+  ArtIndex::EncodeKey(Row(fields), bytes);
+  return bytes;
+}
+
+TEST(AdaptiveRadixTreeTests, SampleTest) {
+  AdaptiveRadixTree tree;
+  // spread keys over a few hundred values so that every node size is used
+  const int n = 20000;
+  vector<int> order(n);
+  for (int i = 0; i < n; i++) {
+    order[i] = (i - n / 2) * 7;
+  }
+  ShuffleArray(order);
+  for (int v : order) {
+    ASSERT_TRUE(tree.Insert(EncodeInt(v), RowId(v, 0)));
+  }
+  ASSERT_FALSE(tree.Insert(EncodeInt(order[0]), RowId(0, 0)));
+  ASSERT_EQ(n, tree.Size());
+  RowId rid;
+  for (int v : order) {
+    ASSERT_TRUE(tree.Lookup(EncodeInt(v), rid));
+    ASSERT_EQ(v, rid.GetPageId());
+    ASSERT_FALSE(tree.Lookup(EncodeInt(v + 1), rid));
+  }
+  // Range scans come out in key order, negative keys first
+  vector<RowId> result;
+  std::string lower = EncodeInt(-70);
+  std::string upper = EncodeInt(70);
+  tree.Range(&lower, false, &upper, true, result);
+  ASSERT_EQ(20, result.size());
+  for (size_t i = 0; i < result.size(); i++) {
+    ASSERT_EQ(-63 + 7 * static_cast<int>(i), result[i].GetPageId());
+  }
+  result.clear();
+  tree.Range(nullptr, false, nullptr, false, result);
+  ASSERT_EQ(n, result.size());
+  // Remove half of the keys, nodes shrink and paths collapse
+  for (int i = 0; i < n; i += 2) {
+    ASSERT_TRUE(tree.Remove(EncodeInt(order[i])));
+  }
+  ASSERT_FALSE(tree.Remove(EncodeInt(order[0])));
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(i % 2 == 1, tree.Lookup(EncodeInt(order[i]), rid));
+  }
+  for (int i = 1; i < n; i += 2) {
+    ASSERT_TRUE(tree.Remove(EncodeInt(order[i])));
+  }
+  ASSERT_EQ(0, tree.Size());
+  ASSERT_FALSE(tree.Lookup(EncodeInt(order[1]), rid));
+}
+
+TEST(AdaptiveRadixTreeTests, CompositeKeyTest) {
+  AdaptiveRadixTree tree;
+  // (id, name) keys, a row with the id only bounds every name of that id
+  for (int32_t id = 0; id < 10; id++) {
+    for (auto name : {"a", "ab", "b", "minisql"}) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, id),
+                                Field(TypeId::kTypeChar, const_cast<char *>(name), strlen(name), true)};
+      std::string bytes;
+      ArtIndex::EncodeKey(Row(fields), bytes);
+      ASSERT_TRUE(tree.Insert(bytes, RowId(id, strlen(name))));
+    }
+  }
+  std::string prefix = EncodeInt(3);
+  vector<RowId> result;
+  tree.Range(&prefix, true, &prefix, true, result);
+  ASSERT_EQ(4, result.size());
+  // names in order: "a" < "ab" < "b" < "minisql"
+  vector<uint32_t> lengths{1, 2, 1, 7};
+  for (size_t i = 0; i < result.size(); i++) {
+    ASSERT_EQ(3, result[i].GetPageId());
+    ASSERT_EQ(lengths[i], result[i].GetSlotNum());
+  }
+  result.clear();
+  tree.Range(&prefix, false, nullptr, false, result);
+  ASSERT_EQ(24, result.size());
+}
+
+TEST(AdaptiveRadixTreeTests, ConcurrentLookupTest) {
+  AdaptiveRadixTree tree;
+  const int n = 20000;
+  for (int v = 0; v < n; v += 2) {
+    ASSERT_TRUE(tree.Insert(EncodeInt(v), RowId(v, 0)));
+  }
+  // readers never miss the even keys while a writer inserts and removes the odd ones
+  std::atomic<bool> done{false};
+  std::atomic<int> misses{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&tree, &done, &misses, t] {
+      RowId rid;
+      for (int v = t * 2; !done.load(); v = (v + 8) % n) {
+        if (!tree.Lookup(EncodeInt(v), rid) || rid.GetPageId() != v) {
+          misses++;
+        }
+      }
+    });
+  }
+  for (int v = 1; v < n; v += 2) {
+    tree.Insert(EncodeInt(v), RowId(v, 0));
+  }
+  for (int v = 1; v < n; v += 2) {
+    tree.Remove(EncodeInt(v));
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(0, misses.load());
+  ASSERT_EQ(n / 2, tree.Size());
+}
+
+TEST(AdaptiveRadixTreeTests, PointScanTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  const TableSchema table_schema(columns);
+  std::vector<uint32_t> index_key_map{0};
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  ArtIndex index(0, key_schema);
+  for (int32_t v = 0; v < 10; v++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, v)};
+    ASSERT_EQ(DB_SUCCESS, index.InsertEntry(Row(fields), RowId(v, 0), nullptr));
+  }
+  // distinct rows holding the same key are a point lookup, not only the same row twice
+  std::vector<Field> lower_fields{Field(TypeId::kTypeInt, 4)};
+  std::vector<Field> upper_fields{Field(TypeId::kTypeInt, 4)};
+  Row lower(lower_fields);
+  Row upper(upper_fields);
+  auto cursor = index.Scan(&lower, true, &upper, true, nullptr);
+  ASSERT_NE(nullptr, cursor);
+  RowId rid;
+  ASSERT_TRUE(cursor->Next(rid));
+  ASSERT_EQ(4, rid.GetPageId());
+  ASSERT_FALSE(cursor->Next(rid));
+  cursor = index.Scan(&lower, true, &upper, false, nullptr);
+  ASSERT_FALSE(cursor->Next(rid));
+  index.Destroy();
+  delete key_schema;
+}
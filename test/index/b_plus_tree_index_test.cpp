@@ -25,6 +25,63 @@ TEST(BPlusTreeTests, BPlusTreeIndexGenericKeyTest) {
   Row copy_key(fields);
   KP.SerializeFromKey(k2, copy_key, key_schema);
   ASSERT_EQ(0, KP.CompareKeys(k1, k2));
+  // a key padded with nulls sorts before every key of its prefix
+  std::vector<Field> prefix_fields{Field(TypeId::kTypeInt, 27), Field(TypeId::kTypeChar)};
+  Row prefix(prefix_fields);
+  GenericKey *k3 = KP.InitKey();
+  KP.SerializeFromKey(k3, prefix, key_schema);
+  ASSERT_EQ(-1, KP.CompareKeys(k3, k1));
+  ASSERT_EQ(1, KP.CompareKeys(k1, k3));
+  ASSERT_EQ(0, KP.CompareKeys(k3, k1, 1));
+  free(k1);
+  free(k2);
+  free(k3);
+}
+
+TEST(BPlusTreeTests, BPlusTreeIndexKeySearchTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 1, true, false)};
+  const TableSchema table_schema(columns);
+  for (uint32_t key_column : {0, 1}) {
+    std::vector<uint32_t> index_key_map{key_column};
+    auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+    KeyManager KP(key_schema, 16);
+    // a null key followed by 200 sorted keys, as laid out in a leaf page
+    const size_t stride = 16 + sizeof(RowId);
+    std::vector<char> page(201 * stride);
+    for (int i = 0; i <= 200; i++) {
+      std::vector<Field> fields;
+      if (i == 0) {
+        fields.emplace_back(key_schema->GetColumn(0)->GetType());
+      } else if (key_column == 0) {
+        fields.emplace_back(TypeId::kTypeInt, (i - 100) * 2);
+      } else {
+        fields.emplace_back(TypeId::kTypeFloat, (i - 100) * 2.5f);
+      }
+      Row key(fields);
+      KP.SerializeFromKey(reinterpret_cast<GenericKey *>(page.data() + i * stride), key, key_schema);
+    }
+    GenericKey *probe = KP.InitKey();
+    for (int v = -210; v <= 210; v++) {
+      std::vector<Field> fields;
+      if (key_column == 0) {
+        fields.emplace_back(TypeId::kTypeInt, v);
+      } else {
+        fields.emplace_back(TypeId::kTypeFloat, v * 1.25f);
+      }
+      Row key(fields);
+      KP.SerializeFromKey(probe, key, key_schema);
+      int expected = 0;
+      while (expected <= 200 &&
+             KP.CompareKeys(reinterpret_cast<GenericKey *>(page.data() + expected * stride), probe) < 0) {
+        expected++;
+      }
+      ASSERT_EQ(expected, KP.LowerBound(page.data(), stride, 0, 201, probe));
+      ASSERT_EQ(std::max(expected, 1), KP.LowerBound(page.data(), stride, 1, 201, probe));
+    }
+    free(probe);
+    delete key_schema;
+  }
 }
 
 TEST(BPlusTreeTests, BPlusTreeIndexSimpleTest) {
@@ -74,6 +131,42 @@ TEST(BPlusTreeTests, BPlusTreeIndexSimpleTest) {
     i++;
   }
   ASSERT_EQ(10, i);
+  // Range Scan (3, 7]
+  std::vector<Field> lower_fields{Field(TypeId::kTypeInt, 3),
+                                  Field(TypeId::kTypeChar, const_cast<char *>("minisql"), 7, true)};
+  std::vector<Field> upper_fields{Field(TypeId::kTypeInt, 7),
+                                  Field(TypeId::kTypeChar, const_cast<char *>("minisql"), 7, true)};
+  Row lower(lower_fields);
+  Row upper(upper_fields);
+  auto cursor = index->Scan(&lower, false, &upper, true, nullptr);
+  i = 4;
+  for (RowId rid; cursor->Next(rid); i++) {
+    ASSERT_EQ(i, rid.GetSlotNum());
+  }
+  ASSERT_EQ(8, i);
+  // Prefix Scan, id = 5 on the (id, name) key
+  std::vector<Field> prefix_fields{Field(TypeId::kTypeInt, 5)};
+  Row prefix(prefix_fields);
+  cursor = index->Scan(&prefix, true, &prefix, true, nullptr);
+  i = 0;
+  for (RowId rid; cursor->Next(rid); i++) {
+    ASSERT_EQ(5, rid.GetSlotNum());
+  }
+  ASSERT_EQ(1, i);
+  // Batched point lookups, out of order, with a duplicate and a missing key
+  std::vector<Row> keys;
+  for (int id : {8, 2, 42, 8, 0}) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, id),
+                              Field(TypeId::kTypeChar, const_cast<char *>("minisql"), 7, true)};
+    keys.emplace_back(fields);
+  }
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index->ScanKeys(keys, ret, nullptr));
+  ASSERT_EQ(3, ret.size());
+  ASSERT_EQ(0, ret[0].GetSlotNum());
+  ASSERT_EQ(2, ret[1].GetSlotNum());
+  ASSERT_EQ(8, ret[2].GetSlotNum());
+  cursor.reset();
   index->Destroy();
   delete index;
   delete bpm_;
@@ -0,0 +1,117 @@
+#include "index/bitmap_index.h"
+
+#include <functional>
+#include <random>
+#include <set>
+
+#include "gtest/gtest.h"
+
+static std::vector<uint32_t> Values(const RoaringBitmap &bitmap) {
+  std::vector<uint32_t> values;
+  bitmap.ToVector(values);
+  return values;
+}
+
+TEST(RoaringBitmapTests, SampleTest) {
+  // a dense run turns its container into a bitmap, the sparse values stay in arrays
+  RoaringBitmap lhs;
+  RoaringBitmap rhs;
+  std::set<uint32_t> lhs_values;
+  std::set<uint32_t> rhs_values;
+  std::mt19937 gen(15445);
+  for (uint32_t i = 0; i < 20000; i++) {
+    ASSERT_TRUE(lhs.Add(i * 3));
+    lhs_values.insert(i * 3);
+    uint32_t value = gen() % (1 << 20);
+    ASSERT_EQ(rhs_values.insert(value).second, rhs.Add(value));
+  }
+  ASSERT_FALSE(lhs.Add(3));
+  ASSERT_EQ(lhs_values.size(), lhs.Cardinality());
+  ASSERT_EQ(rhs_values.size(), rhs.Cardinality());
+  ASSERT_TRUE(lhs.Contains(300));
+  ASSERT_FALSE(lhs.Contains(301));
+  // shrinking a bitmap container back into an array keeps every value
+  for (uint32_t i = 0; i < 15000; i++) {
+    ASSERT_TRUE(lhs.Remove(i * 3));
+    lhs_values.erase(i * 3);
+  }
+  ASSERT_FALSE(lhs.Remove(0));
+  ASSERT_EQ(std::vector<uint32_t>(lhs_values.begin(), lhs_values.end()), Values(lhs));
+  for (uint32_t i = 0; i < 15000; i++) {
+    lhs.Add(i * 3);
+    lhs_values.insert(i * 3);
+  }
+
+  std::vector<uint32_t> expected;
+  RoaringBitmap both = lhs;
+  both.IntersectWith(rhs);
+  std::set_intersection(lhs_values.begin(), lhs_values.end(), rhs_values.begin(), rhs_values.end(),
+                        std::back_inserter(expected));
+  ASSERT_EQ(expected, Values(both));
+  ASSERT_EQ(expected.size(), both.Cardinality());
+
+  expected.clear();
+  RoaringBitmap either = lhs;
+  either.UnionWith(rhs);
+  std::set_union(lhs_values.begin(), lhs_values.end(), rhs_values.begin(), rhs_values.end(),
+                 std::back_inserter(expected));
+  ASSERT_EQ(expected, Values(either));
+  ASSERT_EQ(expected.size(), either.Cardinality());
+}
+
+TEST(BitmapIndexTests, LookupTest) {
+  std::vector<Column *> columns = {
+      new Column("status", TypeId::kTypeInt, 0, true, false),
+  };
+  Schema *key_schema = new Schema(columns);
+  BitmapIndex index(0, key_schema);
+  // status cycles through 0..3, every tenth row has none
+  const int n = 5000;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields;
+    if (i % 10 == 9) {
+      fields.emplace_back(TypeId::kTypeInt);
+    } else {
+      fields.emplace_back(TypeId::kTypeInt, i % 4);
+    }
+    ASSERT_EQ(DB_SUCCESS, index.InsertEntry(Row(fields), RowId(i / 100, i % 100), nullptr));
+  }
+  ASSERT_EQ(5u, index.GetKeyCount());
+  auto count = [&index](const std::string &compare_operator, int value) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+    RoaringBitmap result;
+    EXPECT_TRUE(index.Lookup(Row(fields), compare_operator, result));
+    return result.Cardinality();
+  };
+  auto expect = [n](const std::function<bool(int)> &match) {
+    uint64_t matched = 0;
+    for (int i = 0; i < n; i++) {
+      matched += i % 10 != 9 && match(i % 4);
+    }
+    return matched;
+  };
+  ASSERT_EQ(expect([](int v) { return v == 2; }), count("=", 2));
+  ASSERT_EQ(expect([](int v) { return v != 2; }), count("<>", 2));
+  ASSERT_EQ(expect([](int v) { return v < 2; }), count("<", 2));
+  ASSERT_EQ(expect([](int v) { return v <= 2; }), count("<=", 2));
+  ASSERT_EQ(expect([](int v) { return v > 2; }), count(">", 2));
+  ASSERT_EQ(expect([](int v) { return v >= 2; }), count(">=", 2));
+  ASSERT_EQ(static_cast<uint64_t>(n / 10), count("is", 0));
+  ASSERT_EQ(static_cast<uint64_t>(n - n / 10), count("not", 0));
+  ASSERT_EQ(0u, count("=", 7));
+  // row ids come back from the ordinals
+  std::vector<Field> fields{Field(TypeId::kTypeInt, 3)};
+  std::vector<RowId> result;
+  ASSERT_EQ(DB_SUCCESS, index.ScanKey(Row(fields), result, nullptr, "="));
+  ASSERT_EQ(RowId(0, 3), result[0]);
+  ASSERT_EQ(RowId(0, 7), result[1]);
+  // removing the last row of a key drops its bitmap
+  for (int i = 3; i < n; i += 4) {
+    if (i % 10 != 9) {
+      ASSERT_EQ(DB_SUCCESS, index.RemoveEntry(Row(fields), RowId(i / 100, i % 100), nullptr));
+    }
+  }
+  ASSERT_EQ(0u, count("=", 3));
+  ASSERT_EQ(4u, index.GetKeyCount());
+  delete key_schema;
+}
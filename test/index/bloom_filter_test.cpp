@@ -0,0 +1,81 @@
+#include "index/bloom_filter.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+static Row MakeKey(int32_t id) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, id)};
+  return Row(fields);
+}
+
+TEST(BloomFilterTests, AddRemoveTest) {
+  CountingBloomFilter filter(1, 1000);
+  for (int32_t i = 0; i < 1000; i += 2) {
+    filter.Add(MakeKey(i));
+  }
+  // no false negatives
+  for (int32_t i = 0; i < 1000; i += 2) {
+    ASSERT_TRUE(filter.MayContain(MakeKey(i)));
+  }
+  // most keys that were never added are rejected
+  int false_positives = 0;
+  for (int32_t i = 1; i < 1000; i += 2) {
+    false_positives += filter.MayContain(MakeKey(i));
+  }
+  ASSERT_LT(false_positives, 50);
+  // removed keys are rejected again, the others stay
+  for (int32_t i = 0; i < 1000; i += 4) {
+    filter.Remove(MakeKey(i));
+  }
+  int still_present = 0;
+  for (int32_t i = 0; i < 1000; i += 4) {
+    still_present += filter.MayContain(MakeKey(i));
+  }
+  ASSERT_LT(still_present, 25);
+  for (int32_t i = 2; i < 1000; i += 4) {
+    ASSERT_TRUE(filter.MayContain(MakeKey(i)));
+  }
+  ASSERT_EQ(250, filter.GetKeyCount());
+  ASSERT_FALSE(filter.IsOverloaded());
+}
+
+TEST(BloomFilterTests, IncludeColumnsTest) {
+  // only the key column is hashed, the include column may differ between the entry and the probe
+  CountingBloomFilter filter(1);
+  std::vector<Field> entry_fields{Field(TypeId::kTypeInt, 7), Field(TypeId::kTypeFloat, 1.5f)};
+  std::vector<Field> probe_fields{Field(TypeId::kTypeInt, 7), Field(TypeId::kTypeFloat)};
+  filter.Add(Row(entry_fields));
+  ASSERT_TRUE(filter.MayContain(Row(probe_fields)));
+}
+
+TEST(BloomFilterTests, FloatZeroTest) {
+  // -0.0 equals 0.0, a key added with one sign must be found with the other
+  CountingBloomFilter filter(1);
+  std::vector<Field> negative_zero{Field(TypeId::kTypeFloat, -0.0f)};
+  std::vector<Field> positive_zero{Field(TypeId::kTypeFloat, 0.0f)};
+  filter.Add(Row(negative_zero));
+  ASSERT_TRUE(filter.MayContain(Row(positive_zero)));
+  filter.Remove(Row(positive_zero));
+  ASSERT_FALSE(filter.MayContain(Row(negative_zero)));
+}
+
+TEST(BloomFilterTests, ConcurrentAddTest) {
+  CountingBloomFilter filter(1, 4000);
+  std::vector<std::thread> threads;
+  for (int32_t t = 0; t < 4; t++) {
+    threads.emplace_back([&filter, t]() {
+      for (int32_t i = t; i < 4000; i += 4) {
+        filter.Add(MakeKey(i));
+        filter.MayContain(MakeKey(i + 1));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(4000, filter.GetKeyCount());
+  for (int32_t i = 0; i < 4000; i++) {
+    ASSERT_TRUE(filter.MayContain(MakeKey(i)));
+  }
+}
@@ -0,0 +1,54 @@
+#include "index/brin_index.h"
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+
+static const std::string db_name = "brin_index_test.db";
+
+TEST(BrinIndexTests, SummaryTest) {
+  // Init engine
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {
+      new Column("int", TypeId::kTypeInt, 0, true, false),
+  };
+  Schema *table_schema = new Schema(columns);
+  const int pages = 4 * BRIN_PAGES_PER_RANGE;
+  {
+    BrinIndex index(0, table_schema, 16, engine.bpm_);
+    // ten increasing values per table page, the last range also holds a null
+    for (int page_id = 0; page_id < pages; page_id++) {
+      for (int slot = 0; slot < 10; slot++) {
+        std::vector<Field> fields{Field(TypeId::kTypeInt, page_id * 100 + slot)};
+        ASSERT_EQ(DB_SUCCESS, index.InsertEntry(Row(fields), RowId(page_id, slot), nullptr));
+      }
+    }
+    std::vector<Field> null_fields{Field(TypeId::kTypeInt)};
+    ASSERT_EQ(DB_SUCCESS, index.InsertEntry(Row(null_fields), RowId(pages - 1, 10), nullptr));
+  }
+  // summaries are read back from disk
+  BrinIndex index(0, table_schema, 16, engine.bpm_);
+  Field in_second_range(TypeId::kTypeInt, BRIN_PAGES_PER_RANGE * 100 + 5);
+  ASSERT_FALSE(index.PageMayMatch(0, "=", in_second_range));
+  ASSERT_TRUE(index.PageMayMatch(BRIN_PAGES_PER_RANGE, "=", in_second_range));
+  ASSERT_TRUE(index.PageMayMatch(BRIN_PAGES_PER_RANGE + 3, "=", in_second_range));
+  ASSERT_FALSE(index.PageMayMatch(2 * BRIN_PAGES_PER_RANGE, "=", in_second_range));
+  ASSERT_TRUE(index.PageMayMatch(0, "<", in_second_range));
+  ASSERT_FALSE(index.PageMayMatch(2 * BRIN_PAGES_PER_RANGE, "<=", in_second_range));
+  ASSERT_FALSE(index.PageMayMatch(0, ">=", in_second_range));
+  ASSERT_TRUE(index.PageMayMatch(3 * BRIN_PAGES_PER_RANGE, ">", in_second_range));
+  ASSERT_TRUE(index.PageMayMatch(0, "<>", in_second_range));
+  // nulls
+  ASSERT_FALSE(index.PageMayMatch(0, "is", in_second_range));
+  ASSERT_TRUE(index.PageMayMatch(pages - 1, "is", in_second_range));
+  ASSERT_TRUE(index.PageMayMatch(pages - 1, "not", in_second_range));
+  // a range without a summary may hold rows the index has not seen
+  ASSERT_TRUE(index.PageMayMatch(pages, "not", in_second_range));
+  ASSERT_TRUE(index.PageMayMatch(pages, "=", in_second_range));
+  // deletes leave the summaries conservative
+  std::vector<Field> fields{Field(TypeId::kTypeInt, BRIN_PAGES_PER_RANGE * 100 + 5)};
+  ASSERT_EQ(DB_SUCCESS, index.RemoveEntry(Row(fields), RowId(BRIN_PAGES_PER_RANGE, 5), nullptr));
+  ASSERT_TRUE(index.PageMayMatch(BRIN_PAGES_PER_RANGE, "=", in_second_range));
+  ASSERT_EQ(DB_SUCCESS, index.Destroy());
+  ASSERT_TRUE(index.PageMayMatch(0, "=", in_second_range));
+  delete table_schema;
+}
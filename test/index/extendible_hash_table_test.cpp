@@ -0,0 +1,136 @@
+#include "index/extendible_hash_table.h"
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/extendible_hash_index.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "hash_table_test.db";
+
+TEST(ExtendibleHashTableTests, SampleTest) {
+  // Init engine
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {
+      new Column("int", TypeId::kTypeInt, 0, false, false),
+  };
+  Schema *table_schema = new Schema(columns);
+  KeyManager KP(table_schema, 16);
+  // small buckets so that the directory has to grow
+  ExtendibleHashTable table(0, engine.bpm_, KP, 8);
+  // Prepare data
+  const int n = 2000;
+  vector<GenericKey *> keys;
+  vector<RowId> values;
+  for (int i = 0; i < n; i++) {
+    GenericKey *key = KP.InitKey();
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    KP.SerializeFromKey(key, Row(fields), table_schema);
+    keys.push_back(key);
+    values.push_back(RowId(i, i));
+  }
+  vector<int> order(n);
+  for (int i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  ShuffleArray(order);
+  // Insert data
+  for (int i : order) {
+    ASSERT_TRUE(table.Insert(keys[i], values[i]));
+  }
+  ASSERT_GT(table.GetGlobalDepth(), 0u);
+  // Duplicate keys are rejected
+  ASSERT_FALSE(table.Insert(keys[0], RowId(0, 1)));
+  // Search keys
+  vector<RowId> ans;
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(table.GetValue(keys[i], ans));
+    ASSERT_EQ(values[i], ans.back());
+  }
+  // Delete half keys
+  for (int i = 0; i < n / 2; i++) {
+    table.Remove(keys[order[i]]);
+  }
+  for (int i = 0; i < n / 2; i++) {
+    ASSERT_FALSE(table.GetValue(keys[order[i]], ans));
+  }
+  for (int i = n / 2; i < n; i++) {
+    ASSERT_TRUE(table.GetValue(keys[order[i]], ans));
+    ASSERT_EQ(values[order[i]], ans.back());
+  }
+  // Delete the rest, buckets merge back
+  for (int i = n / 2; i < n; i++) {
+    table.Remove(keys[order[i]]);
+  }
+  ASSERT_TRUE(table.IsEmpty());
+  table.Destroy();
+  for (auto key : keys) {
+    free(key);
+  }
+}
+
+TEST(ExtendibleHashTableTests, OverflowTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {
+      new Column("int", TypeId::kTypeInt, 0, false, false),
+  };
+  Schema *table_schema = new Schema(columns);
+  KeyManager KP(table_schema, 16);
+  // 2 directories of at most 4 buckets of 4 pairs, most keys end up in overflow chains
+  ExtendibleHashTable table(1, engine.bpm_, KP, 4, 1, 2);
+  const int n = 1000;
+  vector<GenericKey *> keys;
+  for (int i = 0; i < n; i++) {
+    GenericKey *key = KP.InitKey();
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    KP.SerializeFromKey(key, Row(fields), table_schema);
+    keys.push_back(key);
+  }
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(table.Insert(keys[i], RowId(i, i)));
+  }
+  ASSERT_EQ(2u, table.GetGlobalDepth());
+  // keys deep in a chain are still found, and still rejected as duplicates
+  vector<RowId> ans;
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(table.GetValue(keys[i], ans));
+    ASSERT_EQ(RowId(i, i), ans.back());
+    ASSERT_FALSE(table.Insert(keys[i], RowId(i, i + 1)));
+  }
+  // remove every other key, the chains shrink and the rest stays reachable
+  for (int i = 0; i < n; i += 2) {
+    table.Remove(keys[i]);
+  }
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(i % 2 == 1, table.GetValue(keys[i], ans));
+  }
+  for (int i = 1; i < n; i += 2) {
+    table.Remove(keys[i]);
+  }
+  ASSERT_TRUE(table.IsEmpty());
+  table.Destroy();
+  for (auto key : keys) {
+    free(key);
+  }
+}
+
+TEST(ExtendibleHashTableTests, FloatKeyTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("float", TypeId::kTypeFloat, 0, false, false)};
+  const TableSchema table_schema(columns);
+  std::vector<uint32_t> index_key_map{0};
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  ExtendibleHashIndex index(2, key_schema, 16, engine.bpm_);
+  std::vector<Field> zero{Field(TypeId::kTypeFloat, 0.0f)};
+  std::vector<Field> negative_zero{Field(TypeId::kTypeFloat, -0.0f)};
+  ASSERT_EQ(DB_SUCCESS, index.InsertEntry(Row(zero), RowId(1, 1), nullptr));
+  // -0.0 equals 0.0, it finds the entry and is a duplicate of it
+  std::vector<RowId> result;
+  ASSERT_EQ(DB_SUCCESS, index.ScanKey(Row(negative_zero), result, nullptr));
+  ASSERT_EQ(RowId(1, 1), result.back());
+  ASSERT_EQ(DB_FAILED, index.InsertEntry(Row(negative_zero), RowId(1, 2), nullptr));
+  index.RemoveEntry(Row(negative_zero), RowId(1, 1), nullptr);
+  result.clear();
+  ASSERT_EQ(DB_KEY_NOT_FOUND, index.ScanKey(Row(zero), result, nullptr));
+  index.Destroy();
+  delete key_schema;
+}
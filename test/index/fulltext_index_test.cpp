@@ -0,0 +1,87 @@
+#include "index/fulltext_index.h"
+
+#include <random>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/text_tokenizer.h"
+
+static const std::string db_name = "fulltext_index_test.db";
+
+TEST(FullTextIndexTests, TokenizeTest) {
+  std::string text = "The quick, brown fox -- the QUICK dog42!";
+  std::vector<std::string> tokens;
+  TokenizeText(text.data(), text.size(), tokens);
+  ASSERT_EQ(std::vector<std::string>({"brown", "dog42", "fox", "quick", "the"}), tokens);
+}
+
+TEST(FullTextIndexTests, PostingPageTest) {
+  auto page = std::make_unique<PostingPage>();
+  page->Init();
+  std::vector<uint64_t> values;
+  uint64_t value = 0;
+  std::mt19937 gen(15445);
+  // small gaps take one byte, gaps across table pages take five
+  while (page->Append(value)) {
+    values.push_back(value);
+    value += (gen() % 8 == 0) ? (uint64_t{1} << 32) : gen() % 100 + 1;
+  }
+  ASSERT_GT(values.size(), 1000u);
+  std::vector<uint64_t> decoded;
+  page->Decode(decoded);
+  ASSERT_EQ(values, decoded);
+}
+
+TEST(FullTextIndexTests, IntersectTest) {
+  std::vector<uint64_t> rare{3, 40, 41, 999, 5000, 100000};
+  std::vector<uint64_t> common;
+  for (uint64_t i = 0; i < 10000; i++) {
+    common.push_back(i * 2 + 1);
+  }
+  FullTextIndex::IntersectPostings(rare, common);
+  ASSERT_EQ(std::vector<uint64_t>({3, 41, 999}), rare);
+  std::vector<uint64_t> none{0, 2, 4};
+  FullTextIndex::IntersectPostings(none, common);
+  ASSERT_TRUE(none.empty());
+}
+
+TEST(FullTextIndexTests, MatchTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {
+      new Column("text", TypeId::kTypeChar, 64, 0, true, false),
+  };
+  Schema *key_schema = new Schema(columns);
+  const char *texts[] = {"red apple", "green apple", "red car", "blue car"};
+  const int n = 2000;
+  {
+    FullTextIndex index(0, key_schema, engine.bpm_);
+    for (int i = 0; i < n; i++) {
+      const char *text = texts[i % 4];
+      std::vector<Field> fields{Field(TypeId::kTypeChar, const_cast<char *>(text), strlen(text), true)};
+      ASSERT_EQ(DB_SUCCESS, index.InsertEntry(Row(fields), RowId(i / 50, i % 50), nullptr));
+    }
+  }
+  // the lexicon and the posting lists are read back from disk
+  FullTextIndex index(0, key_schema, engine.bpm_);
+  auto match = [&index](const char *query) {
+    std::vector<Field> fields{Field(TypeId::kTypeChar, const_cast<char *>(query), strlen(query), true)};
+    std::vector<RowId> result;
+    index.ScanKey(Row(fields), result, nullptr, "match");
+    return result;
+  };
+  ASSERT_EQ(static_cast<size_t>(n / 4), match("RED apple").size());
+  ASSERT_EQ(static_cast<size_t>(n / 2), match("car").size());
+  ASSERT_TRUE(match("green car").empty());
+  ASSERT_TRUE(match("purple").empty());
+  ASSERT_EQ(RowId(0, 2), match("car red")[0]);
+  // out of order inserts and deletes rewrite the list
+  std::vector<Field> fields{Field(TypeId::kTypeChar, const_cast<char *>("red car"), 7, true)};
+  ASSERT_EQ(DB_SUCCESS, index.RemoveEntry(Row(fields), RowId(0, 2), nullptr));
+  ASSERT_EQ(RowId(0, 6), match("car red")[0]);
+  ASSERT_EQ(DB_SUCCESS, index.InsertEntry(Row(fields), RowId(0, 2), nullptr));
+  ASSERT_EQ(RowId(0, 2), match("car red")[0]);
+  ASSERT_EQ(static_cast<size_t>(n / 4), match("car red").size());
+  ASSERT_EQ(DB_SUCCESS, index.Destroy());
+  ASSERT_TRUE(match("car").empty());
+  delete key_schema;
+}
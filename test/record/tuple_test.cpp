@@ -105,4 +105,35 @@ TEST(TupleTest, RowTest) {
   }
   ASSERT_TRUE(table_page.MarkDelete(row.GetRowId(), nullptr, nullptr, nullptr));
   table_page.ApplyDelete(row.GetRowId(), nullptr, nullptr);
-}
\ No newline at end of file
+}
+TEST(TupleTest, DeserializeNeededColumnsTest) {
+  TablePage table_page;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("note", TypeId::kTypeChar, 64, 2, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 3, true, false)};
+  std::vector<Field> fields = {Field(TypeId::kTypeInt, 188),
+                               Field(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), false),
+                               Field(TypeId::kTypeChar), Field(TypeId::kTypeFloat, 19.99f)};
+  auto schema = std::make_shared<Schema>(columns);
+  Row row(fields);
+  table_page.Init(0, INVALID_PAGE_ID, nullptr, nullptr);
+  table_page.InsertTuple(row, schema.get(), nullptr, nullptr, nullptr);
+  // the columns after a skipped char value and a skipped null are still read from the right offset
+  std::vector<bool> needed = {false, false, true, true};
+  Row partial(row.GetRowId());
+  ASSERT_TRUE(table_page.GetTuple(&partial, schema.get(), nullptr, nullptr, &needed));
+  ASSERT_EQ(4, partial.GetFieldCount());
+  ASSERT_TRUE(partial.GetField(0)->IsNull());
+  ASSERT_EQ(TypeId::kTypeInt, partial.GetField(0)->GetTypeId());
+  ASSERT_TRUE(partial.GetField(1)->IsNull());
+  ASSERT_TRUE(partial.GetField(2)->IsNull());
+  ASSERT_EQ(CmpBool::kTrue, partial.GetField(3)->CompareEquals(fields[3]));
+  // a short mask leaves the columns past its end out
+  std::vector<bool> first = {true, true};
+  Row prefix(row.GetRowId());
+  ASSERT_TRUE(table_page.GetTuple(&prefix, schema.get(), nullptr, nullptr, &first));
+  ASSERT_EQ(CmpBool::kTrue, prefix.GetField(0)->CompareEquals(fields[0]));
+  ASSERT_EQ(CmpBool::kTrue, prefix.GetField(1)->CompareEquals(fields[1]));
+  ASSERT_TRUE(prefix.GetField(3)->IsNull());
+}